@@ -0,0 +1,20 @@
+
+
+#ifndef MARSTECH_ACTIVECONFIGBATCHCALLBACK_MOCK_H
+#define MARSTECH_ACTIVECONFIGBATCHCALLBACK_MOCK_H
+
+
+#include "mconfig/mactivecfg/IMsvActiveConfigBatchCallback.h"
+
+#include <gmock/gmock.h>
+
+
+class MsvActiveConfigBatchCallback_Mock:
+	public IMsvActiveConfigBatchCallback
+{
+public:
+	MOCK_METHOD1(OnValuesChanged, void(const std::vector<MsvConfigValueUpdate>&));
+};
+
+
+#endif // MARSTECH_ACTIVECONFIGBATCHCALLBACK_MOCK_H
@@ -13,6 +13,8 @@ class MsvActiveConfigStorageCallback_Mock:
 	public IMsvActiveConfigStorageCallback
 {
 public:
+	using IMsvActiveConfigStorageCallback::OnValueChanged;
+
 	MOCK_METHOD2(OnValueChanged, void(int32_t, bool));
 	MOCK_METHOD2(OnValueChanged, void(int32_t, double));
 	MOCK_METHOD2(OnValueChanged, void(int32_t, int64_t));
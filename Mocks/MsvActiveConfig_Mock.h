@@ -19,6 +19,7 @@ class MsvActiveConfig_Mock:
 public:
 	MOCK_METHOD3(Initialize, MsvErrorCode(const std::shared_ptr<IMsvConfigKeyMap<IMsvDefaultValue>> spConfigKeyMap, const char* configPath, const char* tableName));
 	MOCK_METHOD0(Uninitialize, MsvErrorCode());
+	MOCK_METHOD2(Retarget, MsvErrorCode(const char* configPath, const char* groupName));
 	MOCK_CONST_METHOD0(Initialized, bool());
 
 	MOCK_CONST_METHOD2(GetValue, MsvErrorCode(int32_t cfgId, bool& value));
@@ -31,10 +32,30 @@ public:
 	MOCK_METHOD2(SetValue, MsvErrorCode(int32_t cfgId, double value));
 	MOCK_METHOD2(SetValue, MsvErrorCode(int32_t cfgId, int64_t value));
 	MOCK_METHOD2(SetValue, MsvErrorCode(int32_t cfgId, const std::string& value));
+	MOCK_METHOD2(SetValue, MsvErrorCode(int32_t cfgId, std::string&& value));
+	MOCK_METHOD2(SetValue, MsvErrorCode(int32_t cfgId, const std::shared_ptr<const std::string>& spValue));
 	MOCK_METHOD2(SetValue, MsvErrorCode(int32_t cfgId, uint64_t value));
+	MOCK_METHOD1(SetValues, MsvErrorCode(const std::vector<MsvConfigValueUpdate>& values));
 
 	MOCK_METHOD1(RegisterCallback, MsvErrorCode(std::shared_ptr<IMsvActiveConfigCallback> spCallback));
+	MOCK_METHOD2(RegisterCallback, MsvErrorCode(std::shared_ptr<IMsvActiveConfigCallback> spCallback, int32_t cfgId));
+	MOCK_METHOD3(RegisterCallback, MsvErrorCode(std::shared_ptr<IMsvActiveConfigCallback> spCallback, int32_t firstCfgId, int32_t lastCfgId));
+	MOCK_METHOD2(RegisterCallback, MsvErrorCode(std::shared_ptr<IMsvActiveConfigCallback> spCallback, const std::vector<int32_t>& cfgIds));
 	MOCK_METHOD1(UnregisterCallback, MsvErrorCode(std::shared_ptr<IMsvActiveConfigCallback> spCallback));
+
+	MOCK_METHOD1(RegisterBatchCallback, MsvErrorCode(std::shared_ptr<IMsvActiveConfigBatchCallback> spCallback));
+	MOCK_METHOD1(UnregisterBatchCallback, MsvErrorCode(std::shared_ptr<IMsvActiveConfigBatchCallback> spCallback));
+
+	MOCK_CONST_METHOD1(GetVersion, MsvErrorCode(uint64_t& version));
+	MOCK_CONST_METHOD4(WaitForChange, MsvErrorCode(int32_t cfgId, uint64_t sinceVersion, uint32_t timeoutMs, uint64_t& version));
+	MOCK_CONST_METHOD4(WaitForChange, MsvErrorCode(const std::vector<int32_t>& cfgIds, uint64_t sinceVersion, uint32_t timeoutMs, uint64_t& version));
+	MOCK_CONST_METHOD3(PollChanges, MsvErrorCode(uint64_t lastSequence, std::vector<MsvConfigValueJournalEntry>& changes, uint64_t& sequence));
+
+	MOCK_METHOD1(GetNotificationHandle, MsvErrorCode(int& handle));
+	MOCK_METHOD1(DrainChanges, MsvErrorCode(std::vector<int32_t>& changedCfgIds));
+	MOCK_CONST_METHOD1(GetSnapshot, MsvErrorCode(std::shared_ptr<const MsvConfigSnapshot>& spSnapshot));
+	MOCK_METHOD1(PushOverrides, MsvErrorCode(const std::vector<MsvConfigValueUpdate>& values));
+	MOCK_METHOD0(PopOverrides, MsvErrorCode());
 };
 
 
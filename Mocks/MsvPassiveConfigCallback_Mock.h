@@ -0,0 +1,20 @@
+
+
+#ifndef MARSTECH_PASSIVECONFIGCALLBACK_MOCK_H
+#define MARSTECH_PASSIVECONFIGCALLBACK_MOCK_H
+
+
+#include "mconfig/mpassivecfg/IMsvPassiveConfigCallback.h"
+
+#include <gmock/gmock.h>
+
+
+class MsvPassiveConfigCallback_Mock:
+	public IMsvPassiveConfigCallback
+{
+public:
+	MOCK_METHOD1(OnConfigurationChanged, void(const std::vector<MsvConfigValueChange>& changes));
+};
+
+
+#endif // MARSTECH_PASSIVECONFIGCALLBACK_MOCK_H
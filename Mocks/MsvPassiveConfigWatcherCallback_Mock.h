@@ -0,0 +1,20 @@
+
+
+#ifndef MARSTECH_PASSIVECONFIGWATCHERCALLBACK_MOCK_H
+#define MARSTECH_PASSIVECONFIGWATCHERCALLBACK_MOCK_H
+
+
+#include "mconfig/mpassivecfg/IMsvPassiveConfigWatcherCallback.h"
+
+#include <gmock/gmock.h>
+
+
+class MsvPassiveConfigWatcherCallback_Mock:
+	public IMsvPassiveConfigWatcherCallback
+{
+public:
+	MOCK_METHOD2(OnConfigurationReloaded, void(MsvErrorCode errorCode, const std::vector<int32_t>& changedCfgIds));
+};
+
+
+#endif // MARSTECH_PASSIVECONFIGWATCHERCALLBACK_MOCK_H
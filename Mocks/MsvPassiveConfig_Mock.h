@@ -23,6 +23,16 @@ public:
 
 	MOCK_CONST_METHOD2(ReadFailedData, void(int32_t& lineNumber, int32_t& cfgId));
 	MOCK_METHOD0(ReloadConfiguration, MsvErrorCode());
+	MOCK_METHOD1(ReloadConfiguration, MsvErrorCode(std::vector<int32_t>& changedCfgIds));
+
+	MOCK_METHOD1(RegisterCallback, MsvErrorCode(std::shared_ptr<IMsvPassiveConfigCallback> spCallback));
+	MOCK_METHOD1(UnregisterCallback, MsvErrorCode(std::shared_ptr<IMsvPassiveConfigCallback> spCallback));
+
+	MOCK_METHOD1(GetNotificationHandle, MsvErrorCode(int& handle));
+	MOCK_METHOD1(DrainChanges, MsvErrorCode(std::vector<int32_t>& changedCfgIds));
+	MOCK_CONST_METHOD1(GetSnapshot, MsvErrorCode(std::shared_ptr<const MsvConfigSnapshot>& spSnapshot));
+	MOCK_METHOD1(PushOverrides, MsvErrorCode(const std::vector<MsvConfigValueUpdate>& values));
+	MOCK_METHOD0(PopOverrides, MsvErrorCode());
 };
 
 
@@ -19,6 +19,7 @@ public:
 
 	MOCK_METHOD3(CreateTableIfNotExists, MsvErrorCode(const char* tableName, const char* tableDef, const char* postCreateDefs));
 	MOCK_METHOD2(Execute, MsvErrorCode(const char* query, MsvSQLiteResult& result));
+	MOCK_METHOD3(Execute, MsvErrorCode(const char* query, const std::string& parameter, MsvSQLiteResult& result));
 
 	MOCK_METHOD1(RegisterCallback, MsvErrorCode(std::shared_ptr<IMsvSQLiteCallback> spCallback));
 	MOCK_METHOD1(UnregisterCallback, MsvErrorCode(std::shared_ptr<IMsvSQLiteCallback> spCallback));
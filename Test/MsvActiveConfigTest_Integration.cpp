@@ -3,8 +3,13 @@
 
 
 #include "mconfig/mactivecfg/MsvActiveConfig.h"
+#include "mconfig/mactivecfg/MsvActiveConfigBinding.h"
+#include "mconfig/mactivecfg/MsvActiveConfigFlags.h"
+#include "mconfig/mactivecfg/MsvActiveConfigShardedStorage.h"
+#include "mconfig/msqlitewrapper/MsvSQLite.h"
 #include "mconfig/common/MsvConfigKeyMapBase.h"
 #include "mconfig/common/MsvDefaultValue.h"
+#include "mconfig/Mocks/MsvActiveConfigBatchCallback_Mock.h"
 #include "mconfig/Mocks/MsvActiveConfigCallback_Mock.h"
 
 #include "merror/MsvErrorCodes.h"
@@ -12,7 +17,20 @@
 MSV_DISABLE_ALL_WARNINGS
 
 #include <stdio.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
 #include <fstream>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#endif
 
 MSV_ENABLE_WARNINGS
 
@@ -22,6 +40,17 @@ using namespace ::testing;
 
 const char* const TEST_CONFIG_PATH = "test_config.db";
 const char* const TEST_CONFIG_GROUP = "MsvTestConfig";
+const char* const TEST_SNAPSHOT_PATH = "test_config.snapshot";
+
+
+struct MsvTestSettings
+{
+	bool m_bool = false;
+	double m_double = 0.0;
+	int64_t m_integer = 0;
+	std::string m_string;
+	uint64_t m_unsigned = 0;
+};
 
 
 class MsvConfigKeyMapTest:
@@ -68,6 +97,7 @@ public:
 		
 		//delete config database (new database for each test)
 		remove(TEST_CONFIG_PATH);
+		remove(TEST_SNAPSHOT_PATH);
 
 		m_spConfigKeyMap.reset(new (std::nothrow) MsvConfigKeyMapTest());
 		EXPECT_TRUE(m_spConfigKeyMap != nullptr);
@@ -87,6 +117,7 @@ public:
 
 		//delete config database (new database for each test)
 		remove(TEST_CONFIG_PATH);
+		remove(TEST_SNAPSHOT_PATH);
 	}
 
 	bool FileExists(const char* fileName)
@@ -322,10 +353,436 @@ TEST_F(MsvActiveConfig_Integration, ItShouldExecuteCallbacksWithNewValues)
 	EXPECT_EQ(m_spActiveCfg->Uninitialize(), MSV_SUCCESS);
 }
 
-/*
-//This test does not work because SQLite callbacks works fine just for one connection.
-//It means it can work only in one process. Cross process update detection does not work.
-//Probably look for another storage.
+TEST_F(MsvActiveConfig_Integration, ItShouldExecuteOnlyInterestedCallbacks)
+{
+	EXPECT_EQ(m_spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	std::shared_ptr<StrictMock<MsvActiveConfigCallback_Mock>> spCfgIdCallback(new (std::nothrow) StrictMock<MsvActiveConfigCallback_Mock>());
+	std::shared_ptr<StrictMock<MsvActiveConfigCallback_Mock>> spRangeCallback(new (std::nothrow) StrictMock<MsvActiveConfigCallback_Mock>());
+	std::shared_ptr<StrictMock<MsvActiveConfigCallback_Mock>> spGroupCallback(new (std::nothrow) StrictMock<MsvActiveConfigCallback_Mock>());
+	EXPECT_TRUE(spCfgIdCallback != nullptr);
+	EXPECT_TRUE(spRangeCallback != nullptr);
+	EXPECT_TRUE(spGroupCallback != nullptr);
+
+	//register callbacks
+	EXPECT_EQ(m_spActiveCfg->RegisterCallback(spCfgIdCallback, static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1)), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->RegisterCallback(spCfgIdCallback, static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1)), MSV_ALREADY_REGISTERED_INFO);
+	EXPECT_EQ(m_spActiveCfg->RegisterCallback(spRangeCallback, static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1), static_cast<int32_t>(ConfigId::MSV_TEST_DOUBLE_2)), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->RegisterCallback(spRangeCallback, static_cast<int32_t>(ConfigId::MSV_TEST_DOUBLE_2), static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1)), MSV_INVALID_DATA_ERROR);
+	EXPECT_EQ(m_spActiveCfg->RegisterCallback(spGroupCallback, std::vector<int32_t>({ static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1), static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_2) })), MSV_SUCCESS);
+
+	//group callback is registered for all changes too -> it must be notified only once
+	EXPECT_EQ(m_spActiveCfg->RegisterCallback(spGroupCallback), MSV_SUCCESS);
+
+	//set callback expectations
+	EXPECT_CALL(*spCfgIdCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), Matcher<int64_t>(10ll)));
+	EXPECT_CALL(*spRangeCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1), Matcher<bool>(true)));
+	EXPECT_CALL(*spRangeCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_DOUBLE_2), Matcher<double>(10.1)));
+	EXPECT_CALL(*spGroupCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), Matcher<int64_t>(10ll)));
+	EXPECT_CALL(*spGroupCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1), Matcher<bool>(true)));
+	EXPECT_CALL(*spGroupCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_DOUBLE_2), Matcher<double>(10.1)));
+	EXPECT_CALL(*spGroupCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_2), Matcher<uint64_t>(11ull)));
+
+	EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), 10ll), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1), true), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_DOUBLE_2), 10.1), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_2), 11ull), MSV_SUCCESS);
+
+	//unregistered callbacks are not notified at all
+	EXPECT_EQ(m_spActiveCfg->UnregisterCallback(spCfgIdCallback), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->UnregisterCallback(spRangeCallback), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->UnregisterCallback(spGroupCallback), MSV_SUCCESS);
+
+	EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), 11ll), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1), false), MSV_SUCCESS);
+
+	EXPECT_EQ(m_spActiveCfg->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvActiveConfig_Integration, ItShouldAllowCallbackToUnregisterItselfDuringNotification)
+{
+	EXPECT_EQ(m_spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	std::shared_ptr<StrictMock<MsvActiveConfigCallback_Mock>> spSelfRemovingCallback(new (std::nothrow) StrictMock<MsvActiveConfigCallback_Mock>());
+	std::shared_ptr<StrictMock<MsvActiveConfigCallback_Mock>> spOtherCallback(new (std::nothrow) StrictMock<MsvActiveConfigCallback_Mock>());
+	EXPECT_TRUE(spSelfRemovingCallback != nullptr);
+	EXPECT_TRUE(spOtherCallback != nullptr);
+
+	EXPECT_EQ(m_spActiveCfg->RegisterCallback(spSelfRemovingCallback), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->RegisterCallback(spSelfRemovingCallback, static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1)), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->RegisterCallback(spOtherCallback), MSV_SUCCESS);
+
+	//first notification unregisters callback (running notification still notifies other callback), second one is not delivered
+	std::shared_ptr<IMsvActiveConfig> spActiveCfg = m_spActiveCfg;
+	std::weak_ptr<StrictMock<MsvActiveConfigCallback_Mock>> wpSelfRemovingCallback = spSelfRemovingCallback;
+	EXPECT_CALL(*spSelfRemovingCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), Matcher<int64_t>(10ll))).WillOnce(Invoke([spActiveCfg, wpSelfRemovingCallback](int32_t, int64_t)
+	{
+		EXPECT_EQ(spActiveCfg->UnregisterCallback(wpSelfRemovingCallback.lock()), MSV_SUCCESS);
+	}));
+	EXPECT_CALL(*spOtherCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), Matcher<int64_t>(10ll)));
+	EXPECT_CALL(*spOtherCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), Matcher<int64_t>(11ll)));
+
+	EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), 10ll), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), 11ll), MSV_SUCCESS);
+
+	EXPECT_EQ(m_spActiveCfg->UnregisterCallback(spOtherCallback), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvActiveConfig_Integration, ItShouldExecuteCallbacksAsynchronouslyInOrder)
+{
+	std::shared_ptr<MsvActiveConfig> spActiveCfg(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_TRUE(spActiveCfg != nullptr);
+	EXPECT_EQ(spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	std::shared_ptr<MsvActiveConfigDispatcher> spDispatcher(new (std::nothrow) MsvActiveConfigDispatcher(16, 2, m_spLogger));
+	EXPECT_TRUE(spDispatcher != nullptr);
+	EXPECT_EQ(spDispatcher->Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetDispatcher(spDispatcher), MSV_SUCCESS);
+
+	EXPECT_EQ(spActiveCfg->RegisterCallback(m_spActiveCfgCallback), MSV_SUCCESS);
+
+	//set callback expectations (notifications of one callback must keep order)
+	{
+		InSequence sequence;
+		EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), Matcher<int64_t>(10ll)));
+		EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1), Matcher<const char*>(StrEq("10"))));
+		EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), Matcher<int64_t>(11ll)));
+	}
+
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), 10ll), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1), std::string("10")), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), 11ll), MSV_SUCCESS);
+
+	spDispatcher->Drain();
+	EXPECT_EQ(spDispatcher->GetQueuedCount(), 0u);
+	EXPECT_EQ(spDispatcher->GetRejectedCount(), 0u);
+
+	EXPECT_EQ(spActiveCfg->UnregisterCallback(m_spActiveCfgCallback), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Uninitialize(), MSV_SUCCESS);
+	EXPECT_EQ(spDispatcher->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvActiveConfig_Integration, ItShouldRejectNotificationsWhenDispatcherQueueIsFull)
+{
+	std::shared_ptr<MsvActiveConfig> spActiveCfg(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_TRUE(spActiveCfg != nullptr);
+	EXPECT_EQ(spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	//user executor which runs tasks only on request
+	std::vector<std::function<void()>> tasks;
+	std::shared_ptr<MsvActiveConfigDispatcher> spDispatcher(new (std::nothrow) MsvActiveConfigDispatcher([&tasks](std::function<void()> task) { tasks.push_back(task); }, 2, m_spLogger));
+	EXPECT_TRUE(spDispatcher != nullptr);
+	EXPECT_EQ(spDispatcher->Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetDispatcher(spDispatcher), MSV_SUCCESS);
+
+	EXPECT_EQ(spActiveCfg->RegisterCallback(m_spActiveCfgCallback), MSV_SUCCESS);
+
+	//third notification is rejected (queue is full), value is stored anyway
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), 10ull), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), 11ull), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), 12ull), MSV_SUCCESS);
+
+	EXPECT_EQ(spDispatcher->GetQueuedCount(), 2u);
+	EXPECT_EQ(spDispatcher->GetRejectedCount(), 1u);
+
+	uint64_t testUnsigned1;
+	EXPECT_EQ(spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), testUnsigned1), MSV_SUCCESS);
+	EXPECT_EQ(testUnsigned1, 12ull);
+
+	//one subscriber -> one scheduled task which delivers all its queued notifications
+	{
+		InSequence sequence;
+		EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), Matcher<uint64_t>(10ull)));
+		EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), Matcher<uint64_t>(11ull)));
+	}
+
+	EXPECT_EQ(tasks.size(), 1u);
+	tasks[0]();
+	EXPECT_EQ(spDispatcher->GetQueuedCount(), 0u);
+
+	EXPECT_EQ(spActiveCfg->UnregisterCallback(m_spActiveCfgCallback), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Uninitialize(), MSV_SUCCESS);
+	EXPECT_EQ(spDispatcher->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvActiveConfig_Integration, ItShouldNotifyBatchCallbackOncePerMultiKeyWrite)
+{
+	EXPECT_EQ(m_spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	std::shared_ptr<StrictMock<MsvActiveConfigBatchCallback_Mock>> spBatchCallback(new (std::nothrow) StrictMock<MsvActiveConfigBatchCallback_Mock>());
+	EXPECT_TRUE(spBatchCallback != nullptr);
+	EXPECT_EQ(m_spActiveCfg->RegisterBatchCallback(spBatchCallback), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->RegisterBatchCallback(spBatchCallback), MSV_ALREADY_REGISTERED_INFO);
+
+	//invalid batches are not set at all
+	EXPECT_EQ(m_spActiveCfg->SetValues({ { static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1), MsvConfigValue(true) }, { static_cast<int32_t>(ConfigId::MSV_TEST_DOUBLE_1), MsvConfigValue(int64_t(10)) } }), MSV_INVALID_DATA_ERROR);
+	EXPECT_EQ(m_spActiveCfg->SetValues({ { static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1), MsvConfigValue(true) }, { 1000, MsvConfigValue(true) } }), MSV_NOT_FOUND_ERROR);
+
+	std::vector<MsvConfigValueUpdate> changes;
+	EXPECT_CALL(*spBatchCallback, OnValuesChanged(_)).WillOnce(SaveArg<0>(&changes));
+
+	EXPECT_EQ(m_spActiveCfg->SetValues({ { static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2), MsvConfigValue(std::string("11")) }, { static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1), MsvConfigValue(true) }, { static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), MsvConfigValue(uint64_t(10)) } }), MSV_SUCCESS);
+
+	ASSERT_EQ(changes.size(), 3u);
+	EXPECT_EQ(changes[0].m_cfgId, static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1));
+	EXPECT_EQ(std::get<bool>(changes[0].m_newValue), true);
+	EXPECT_EQ(changes[1].m_cfgId, static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2));
+	EXPECT_EQ(std::get<std::string>(changes[1].m_newValue), "11");
+	EXPECT_EQ(changes[2].m_cfgId, static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1));
+	EXPECT_EQ(std::get<uint64_t>(changes[2].m_newValue), 10ull);
+
+	bool testBool1;
+	EXPECT_EQ(m_spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1), testBool1), MSV_SUCCESS);
+	EXPECT_EQ(testBool1, true);
+
+	EXPECT_EQ(m_spActiveCfg->UnregisterBatchCallback(spBatchCallback), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvActiveConfig_Integration, ItShouldCoalesceSingleWritesInWindow)
+{
+	std::shared_ptr<MsvActiveConfig> spActiveCfg(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_TRUE(spActiveCfg != nullptr);
+	EXPECT_EQ(spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetCoalescingWindow(50), MSV_SUCCESS);
+
+	std::shared_ptr<StrictMock<MsvActiveConfigBatchCallback_Mock>> spBatchCallback(new (std::nothrow) StrictMock<MsvActiveConfigBatchCallback_Mock>());
+	EXPECT_TRUE(spBatchCallback != nullptr);
+	EXPECT_EQ(spActiveCfg->RegisterBatchCallback(spBatchCallback), MSV_SUCCESS);
+
+	std::promise<std::vector<MsvConfigValueUpdate>> notified;
+	EXPECT_CALL(*spBatchCallback, OnValuesChanged(_)).WillOnce(Invoke([&notified](const std::vector<MsvConfigValueUpdate>& values) { notified.set_value(values); }));
+
+	//three single writes -> one batch with last value of each config ID
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), 10ll), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_DOUBLE_1), 10.0), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), 11ll), MSV_SUCCESS);
+
+	std::future<std::vector<MsvConfigValueUpdate>> changes = notified.get_future();
+	ASSERT_EQ(changes.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+
+	std::vector<MsvConfigValueUpdate> values = changes.get();
+	ASSERT_EQ(values.size(), 2u);
+	EXPECT_EQ(values[0].m_cfgId, static_cast<int32_t>(ConfigId::MSV_TEST_DOUBLE_1));
+	EXPECT_EQ(std::get<double>(values[0].m_newValue), 10.0);
+	EXPECT_EQ(values[1].m_cfgId, static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1));
+	EXPECT_EQ(std::get<int64_t>(values[1].m_newValue), 11ll);
+
+	EXPECT_EQ(spActiveCfg->UnregisterBatchCallback(spBatchCallback), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvActiveConfig_Integration, CoalescedBatchCallbackShouldWriteWhileOtherThreadWrites)
+{
+	std::shared_ptr<MsvActiveConfig> spActiveCfg(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_TRUE(spActiveCfg != nullptr);
+	EXPECT_EQ(spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetCoalescingWindow(1), MSV_SUCCESS);
+
+	std::shared_ptr<NiceMock<MsvActiveConfigBatchCallback_Mock>> spBatchCallback(new (std::nothrow) NiceMock<MsvActiveConfigBatchCallback_Mock>());
+	EXPECT_TRUE(spBatchCallback != nullptr);
+	EXPECT_EQ(spActiveCfg->RegisterBatchCallback(spBatchCallback), MSV_SUCCESS);
+
+	//batch callback writes config from flush thread (it must not deadlock with writer which notifies this instance)
+	std::atomic<bool> stop(false);
+	std::atomic<int> callbackWrites(0);
+	ON_CALL(*spBatchCallback, OnValuesChanged(_)).WillByDefault(Invoke([spActiveCfg, &stop, &callbackWrites](const std::vector<MsvConfigValueUpdate>&)
+	{
+		if (!stop && MSV_SUCCEEDED(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), static_cast<uint64_t>(callbackWrites + 1))))
+		{
+			++callbackWrites;
+		}
+	}));
+
+	std::future<void> writer = std::async(std::launch::async, [spActiveCfg]()
+	{
+		for (int64_t i = 0; i < 200; ++i)
+		{
+			EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), i), MSV_SUCCESS);
+		}
+	});
+
+	ASSERT_EQ(writer.wait_for(std::chrono::seconds(30)), std::future_status::ready);
+	stop = true;
+	EXPECT_GT(callbackWrites, 0);
+
+	EXPECT_EQ(spActiveCfg->SetCoalescingWindow(0), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->UnregisterBatchCallback(spBatchCallback), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvActiveConfig_Integration, ItShouldReadValuesWhileOtherThreadWrites)
+{
+	EXPECT_EQ(m_spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	const int64_t writeCount = 100;
+	std::atomic<bool> stop(false);
+	std::atomic<int64_t> failedReads(0);
+	std::vector<std::thread> readers;
+
+	//readers must always see some written value and values must not go back
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		readers.emplace_back([this, &stop, &failedReads]()
+		{
+			int64_t lastValue = 0;
+			while (!stop)
+			{
+				int64_t value = 0;
+				if (MSV_FAILED(m_spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), value)) || value < lastValue)
+				{
+					++failedReads;
+				}
+				lastValue = value;
+			}
+		});
+	}
+
+	for (int64_t i = 1; i <= writeCount; ++i)
+	{
+		EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), i), MSV_SUCCESS);
+	}
+
+	stop = true;
+	for (std::thread& reader : readers)
+	{
+		reader.join();
+	}
+
+	EXPECT_EQ(failedReads.load(), 0);
+
+	int64_t value = 0;
+	EXPECT_EQ(m_spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), value), MSV_SUCCESS);
+	EXPECT_EQ(value, writeCount);
+
+	EXPECT_EQ(m_spActiveCfg->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvActiveConfig_Integration, DISABLED_ConcurrentReadsShouldScaleWithThreads)
+{
+	EXPECT_EQ(m_spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	const int64_t readsPerThread = 1000000;
+	uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	double singleThreadThroughput = 0.0;
+
+	for (uint32_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+	{
+		std::vector<std::thread> readers;
+		std::atomic<int64_t> checksum(0);
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < threadCount; ++i)
+		{
+			readers.emplace_back([this, readsPerThread, &checksum]()
+			{
+				int64_t sum = 0;
+				for (int64_t j = 0; j < readsPerThread; ++j)
+				{
+					int64_t testInteger2 = 0;
+					m_spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_2), testInteger2);
+					sum += testInteger2;
+				}
+				checksum += sum;
+			});
+		}
+
+		for (std::thread& reader : readers)
+		{
+			reader.join();
+		}
+		std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+		//default value of MSV_TEST_INTEGER_2 is 1
+		EXPECT_EQ(checksum.load(), readsPerThread * threadCount);
+
+		double throughput = static_cast<double>(readsPerThread * threadCount) / duration.count();
+		if (threadCount == 1)
+		{
+			singleThreadThroughput = throughput;
+		}
+
+		std::cout << "threads: " << threadCount << ", reads/s: " << static_cast<int64_t>(throughput) << ", scaling: " << throughput / singleThreadThroughput << std::endl;
+	}
+
+	EXPECT_EQ(m_spActiveCfg->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvActiveConfig_Integration, ItShouldLoadValuesOnFirstAccessInLazyMode)
+{
+	//create database with default values
+	EXPECT_EQ(m_spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->Uninitialize(), MSV_SUCCESS);
+
+	std::shared_ptr<MsvActiveConfig> spActiveCfg(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_TRUE(spActiveCfg != nullptr);
+	EXPECT_EQ(spActiveCfg->Prefetch(std::vector<int32_t>({ static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1) })), MSV_NOT_INITIALIZED_ERROR);
+	EXPECT_EQ(spActiveCfg->SetLazyLoading(true), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetLazyLoading(false), MSV_ALREADY_INITIALIZED_INFO);
+
+	//warm one value only
+	EXPECT_EQ(spActiveCfg->Prefetch(std::vector<int32_t>({ static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1) })), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Prefetch(std::vector<int32_t>({ 1000 })), MSV_NOT_FOUND_ERROR);
+
+	//change values behind config (other connection -> no notification)
+	MsvSQLite sqlite(m_spLogger);
+	MsvSQLiteResult sqlResult;
+	EXPECT_EQ(sqlite.Initialize(TEST_CONFIG_PATH), MSV_SUCCESS);
+	EXPECT_EQ(sqlite.Execute("UPDATE MsvTestConfig SET Value = 42 WHERE Id = 4 OR Id = 5;", sqlResult), MSV_SUCCESS);
+	EXPECT_EQ(sqlite.Uninitialize(), MSV_SUCCESS);
+
+	//prefetched value is cached, not accessed value is loaded now
+	int64_t value = 0;
+	EXPECT_EQ(spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), value), MSV_SUCCESS);
+	EXPECT_EQ(value, 0ll);
+	EXPECT_EQ(spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_2), value), MSV_SUCCESS);
+	EXPECT_EQ(value, 42ll);
+
+	//not existing values and values with different type are not loaded
+	bool boolValue = false;
+	EXPECT_EQ(spActiveCfg->GetValue(1000, value), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_2), boolValue), MSV_NOT_FOUND_ERROR);
+
+	//not accessed value can be set
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), 7ull), MSV_SUCCESS);
+	uint64_t unsignedValue = 0;
+	EXPECT_EQ(spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), unsignedValue), MSV_SUCCESS);
+	EXPECT_EQ(unsignedValue, 7ull);
+
+	EXPECT_EQ(spActiveCfg->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvActiveConfig_Integration, ItShouldLoadValueOnlyOnceOnConcurrentFirstAccess)
+{
+	std::shared_ptr<MsvActiveConfig> spActiveCfg(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_TRUE(spActiveCfg != nullptr);
+	EXPECT_EQ(spActiveCfg->SetLazyLoading(true), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	std::atomic<int32_t> failedReads(0);
+	std::vector<std::thread> readers;
+	for (uint32_t i = 0; i < 8; ++i)
+	{
+		readers.emplace_back([spActiveCfg, &failedReads]()
+		{
+			std::string value;
+			if (MSV_FAILED(spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2), value)) || value != "1")
+			{
+				++failedReads;
+			}
+		});
+	}
+
+	for (std::thread& reader : readers)
+	{
+		reader.join();
+	}
+
+	EXPECT_EQ(failedReads.load(), 0);
+	EXPECT_EQ(spActiveCfg->Uninitialize(), MSV_SUCCESS);
+}
 
 TEST_F(MsvActiveConfig_Integration, ItShouldExecuteCallbacksWithNewValuesOnOtherConfigInstances)
 {
@@ -339,6 +796,9 @@ TEST_F(MsvActiveConfig_Integration, ItShouldExecuteCallbacksWithNewValuesOnOther
 	EXPECT_TRUE(spActiveCfg2 != nullptr);
 	EXPECT_EQ(spActiveCfg2->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
 
+	//both instances share one database (storage, connection and cache)
+	EXPECT_EQ(MsvActiveConfigRegistry::Get().GetDatabaseCount(), 1);
+
 	//register callback
 	EXPECT_EQ(spActiveCfg2->RegisterCallback(m_spActiveCfgCallback), MSV_SUCCESS);
 
@@ -374,9 +834,917 @@ TEST_F(MsvActiveConfig_Integration, ItShouldExecuteCallbacksWithNewValuesOnOther
 	EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), 10ull), MSV_SUCCESS);
 	EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_2), 11ull), MSV_SUCCESS);
 
+	//other instance reads new values from shared cache
+	bool boolValue = false;
+	int64_t integerValue = 0;
+	std::string stringValue;
+	EXPECT_EQ(spActiveCfg2->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1), boolValue), MSV_SUCCESS);
+	EXPECT_EQ(boolValue, true);
+	EXPECT_EQ(spActiveCfg2->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_2), integerValue), MSV_SUCCESS);
+	EXPECT_EQ(integerValue, 11ll);
+	EXPECT_EQ(spActiveCfg2->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2), stringValue), MSV_SUCCESS);
+	EXPECT_STREQ(stringValue.c_str(), "11");
+
 	//unregister callback
 	EXPECT_EQ(spActiveCfg2->UnregisterCallback(m_spActiveCfgCallback), MSV_SUCCESS);
 
+	//database is kept while it is used by some instance
 	EXPECT_EQ(m_spActiveCfg->Uninitialize(), MSV_SUCCESS);
+	EXPECT_EQ(MsvActiveConfigRegistry::Get().GetDatabaseCount(), 1);
+	EXPECT_EQ(spActiveCfg2->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), integerValue), MSV_SUCCESS);
+	EXPECT_EQ(integerValue, 10ll);
+
 	EXPECT_EQ(spActiveCfg2->Uninitialize(), MSV_SUCCESS);
-}*/
+	EXPECT_EQ(MsvActiveConfigRegistry::Get().GetDatabaseCount(), 0);
+}
+
+TEST_F(MsvActiveConfig_Integration, ItShouldServeSnapshotAndNotifyDifferencesAfterVerification)
+{
+	//create database and snapshot (it is saved by uninitialize)
+	std::shared_ptr<MsvActiveConfig> spActiveCfg(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_TRUE(spActiveCfg != nullptr);
+	EXPECT_EQ(spActiveCfg->SetSnapshotPath(TEST_SNAPSHOT_PATH), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SaveSnapshot(), MSV_NOT_INITIALIZED_ERROR);
+	EXPECT_EQ(spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetSnapshotPath(nullptr), MSV_ALREADY_INITIALIZED_INFO);
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), 10ll), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1), std::string("snapshot")), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Uninitialize(), MSV_SUCCESS);
+	EXPECT_TRUE(FileExists(TEST_SNAPSHOT_PATH));
+
+	//change value behind snapshot (other connection -> no notification)
+	MsvSQLite sqlite(m_spLogger);
+	MsvSQLiteResult sqlResult;
+	EXPECT_EQ(sqlite.Initialize(TEST_CONFIG_PATH), MSV_SUCCESS);
+	EXPECT_EQ(sqlite.Execute("UPDATE MsvTestConfig SET Value = 42 WHERE Id = 4;", sqlResult), MSV_SUCCESS);
+	EXPECT_EQ(sqlite.Uninitialize(), MSV_SUCCESS);
+
+	//only difference is notified
+	EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), Matcher<int64_t>(42ll)));
+
+	spActiveCfg.reset(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_TRUE(spActiveCfg != nullptr);
+	EXPECT_EQ(spActiveCfg->RegisterCallback(m_spActiveCfgCallback), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetSnapshotPath(TEST_SNAPSHOT_PATH), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	//value is readable immediately (from snapshot or already verified)
+	int64_t integerValue = 0;
+	std::string stringValue;
+	EXPECT_EQ(spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), integerValue), MSV_SUCCESS);
+	EXPECT_TRUE(integerValue == 10ll || integerValue == 42ll);
+	EXPECT_EQ(spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1), stringValue), MSV_SUCCESS);
+	EXPECT_EQ(stringValue, "snapshot");
+
+	//save waits for verification
+	EXPECT_EQ(spActiveCfg->SaveSnapshot(), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), integerValue), MSV_SUCCESS);
+	EXPECT_EQ(integerValue, 42ll);
+
+	//writes work after verification
+	EXPECT_EQ(spActiveCfg->UnregisterCallback(m_spActiveCfgCallback), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_2), 11ll), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvActiveConfig_Integration, ItShouldServeSnapshotWhenStorageCanNotBeOpened)
+{
+	std::shared_ptr<MsvActiveConfig> spActiveCfg(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_TRUE(spActiveCfg != nullptr);
+	EXPECT_EQ(spActiveCfg->SetSnapshotPath(TEST_SNAPSHOT_PATH), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), 7ull), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SaveSnapshot(), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Uninitialize(), MSV_SUCCESS);
+
+	//database in not existing directory can not be opened -> reads are served from snapshot only
+	spActiveCfg.reset(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_TRUE(spActiveCfg != nullptr);
+	EXPECT_EQ(spActiveCfg->SetSnapshotPath(TEST_SNAPSHOT_PATH), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Initialize(m_spConfigKeyMap, "not_existing_directory/test_config.db", TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	uint64_t unsignedValue = 0;
+	bool boolValue = false;
+	EXPECT_EQ(spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), unsignedValue), MSV_SUCCESS);
+	EXPECT_EQ(unsignedValue, 7ull);
+	EXPECT_EQ(spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_2), boolValue), MSV_SUCCESS);
+	EXPECT_EQ(boolValue, true);
+
+	//writes fail with open error (storage is not opened), snapshot is not overwritten
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), 8ull), MSV_OPEN_ERROR);
+	EXPECT_EQ(spActiveCfg->SaveSnapshot(), MSV_OPEN_ERROR);
+
+	//open is retried in background -> writes succeed when directory appears
+	std::error_code fsError;
+	EXPECT_TRUE(std::filesystem::create_directory("not_existing_directory", fsError));
+	MsvErrorCode errorCode = MSV_OPEN_ERROR;
+	for (int32_t i = 0; i < 200 && MSV_FAILED(errorCode); ++i)
+	{
+		errorCode = spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), 8ull);
+		if (MSV_FAILED(errorCode))
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		}
+	}
+	EXPECT_EQ(errorCode, MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), unsignedValue), MSV_SUCCESS);
+	EXPECT_EQ(unsignedValue, 8ull);
+	EXPECT_EQ(spActiveCfg->Uninitialize(), MSV_SUCCESS);
+
+	std::filesystem::remove_all("not_existing_directory", fsError);
+}
+
+TEST_F(MsvActiveConfig_Integration, BindingShouldMirrorValuesIntoStruct)
+{
+	EXPECT_EQ(m_spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	MsvActiveConfigBinding<MsvTestSettings> binding(m_spLogger);
+	EXPECT_EQ(binding.Bind(static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_2), &MsvTestSettings::m_bool), MSV_SUCCESS);
+	EXPECT_EQ(binding.Bind(static_cast<int32_t>(ConfigId::MSV_TEST_DOUBLE_2), &MsvTestSettings::m_double), MSV_SUCCESS);
+	EXPECT_EQ(binding.Bind(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_2), &MsvTestSettings::m_integer), MSV_SUCCESS);
+	EXPECT_EQ(binding.Bind(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2), &MsvTestSettings::m_string), MSV_SUCCESS);
+	EXPECT_EQ(binding.Bind(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_2), &MsvTestSettings::m_unsigned), MSV_SUCCESS);
+	EXPECT_EQ(binding.Attach(m_spActiveCfg), MSV_SUCCESS);
+	EXPECT_EQ(binding.Attach(m_spActiveCfg), MSV_ALREADY_INITIALIZED_INFO);
+	EXPECT_EQ(binding.Bind(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), &MsvTestSettings::m_integer), MSV_ALREADY_INITIALIZED_INFO);
+
+	//values are loaded by attach
+	std::shared_ptr<const MsvTestSettings> spSettings = binding.Get();
+	EXPECT_EQ(spSettings->m_bool, true);
+	EXPECT_EQ(spSettings->m_double, 1.1);
+	EXPECT_EQ(spSettings->m_integer, 1ll);
+	EXPECT_EQ(spSettings->m_string, "1");
+	EXPECT_EQ(spSettings->m_unsigned, 1ull);
+
+	//multi-key write is applied as one unit, held instance is not changed
+	std::vector<MsvConfigValueUpdate> values;
+	values.push_back(MsvConfigValueUpdate{ static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_2), MsvConfigValue(int64_t(20)) });
+	values.push_back(MsvConfigValueUpdate{ static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2), MsvConfigValue(std::string("twenty")) });
+	EXPECT_EQ(m_spActiveCfg->SetValues(values), MSV_SUCCESS);
+
+	std::shared_ptr<const MsvTestSettings> spNewSettings = binding.Get();
+	EXPECT_EQ(spNewSettings->m_integer, 20ll);
+	EXPECT_EQ(spNewSettings->m_string, "twenty");
+	EXPECT_EQ(spNewSettings->m_bool, true);
+	EXPECT_EQ(spSettings->m_integer, 1ll);
+	EXPECT_EQ(spSettings->m_string, "1");
+
+	//not bound value does not create new instance
+	EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), 5ll), MSV_SUCCESS);
+	EXPECT_EQ(binding.Get(), spNewSettings);
+
+	//detached binding keeps last values
+	EXPECT_EQ(binding.Detach(), MSV_SUCCESS);
+	EXPECT_EQ(binding.Detach(), MSV_NOT_INITIALIZED_INFO);
+	EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_2), 7ull), MSV_SUCCESS);
+	EXPECT_EQ(binding.Get()->m_unsigned, 1ull);
+
+	EXPECT_EQ(m_spActiveCfg->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvActiveConfig_Integration, DestroyedBindingShouldIgnoreQueuedNotification)
+{
+	std::shared_ptr<MsvActiveConfig> spActiveCfg(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_TRUE(spActiveCfg != nullptr);
+	EXPECT_EQ(spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	//user executor which runs tasks only on request
+	std::vector<std::function<void()>> tasks;
+	std::shared_ptr<MsvActiveConfigDispatcher> spDispatcher(new (std::nothrow) MsvActiveConfigDispatcher([&tasks](std::function<void()> task) { tasks.push_back(task); }, 16, m_spLogger));
+	EXPECT_TRUE(spDispatcher != nullptr);
+	EXPECT_EQ(spDispatcher->Initialize(), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetDispatcher(spDispatcher), MSV_SUCCESS);
+
+	std::unique_ptr<MsvActiveConfigBinding<MsvTestSettings>> spBinding(new (std::nothrow) MsvActiveConfigBinding<MsvTestSettings>(m_spLogger));
+	EXPECT_TRUE(spBinding != nullptr);
+	EXPECT_EQ(spBinding->Bind(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_2), &MsvTestSettings::m_integer), MSV_SUCCESS);
+	EXPECT_EQ(spBinding->Attach(spActiveCfg), MSV_SUCCESS);
+
+	//notification is queued, binding is destroyed before it is delivered
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_2), 20ll), MSV_SUCCESS);
+	EXPECT_EQ(spDispatcher->GetQueuedCount(), 1u);
+	spBinding.reset();
+
+	//queued notification is dropped (it does not touch destroyed binding)
+	EXPECT_EQ(tasks.size(), 1u);
+	tasks[0]();
+	EXPECT_EQ(spDispatcher->GetQueuedCount(), 0u);
+
+	EXPECT_EQ(spActiveCfg->Uninitialize(), MSV_SUCCESS);
+	EXPECT_EQ(spDispatcher->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvActiveConfig_Integration, ItShouldWakeWaiterOnlyOnRelevantChange)
+{
+	uint64_t version = 0;
+	EXPECT_EQ(m_spActiveCfg->GetVersion(version), MSV_NOT_INITIALIZED_ERROR);
+	EXPECT_EQ(m_spActiveCfg->WaitForChange(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), 0, 0, version), MSV_NOT_INITIALIZED_ERROR);
+
+	EXPECT_EQ(m_spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->WaitForChange(-1, 0, 0, version), MSV_NOT_FOUND_ERROR);
+
+	uint64_t sinceVersion = 0;
+	EXPECT_EQ(m_spActiveCfg->GetVersion(sinceVersion), MSV_SUCCESS);
+
+	//nothing has been changed -> timeout keeps since version
+	EXPECT_EQ(m_spActiveCfg->WaitForChange(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), sinceVersion, 10, version), MSV_SUCCESS);
+	EXPECT_EQ(version, sinceVersion);
+
+	std::vector<int32_t> cfgIds;
+	cfgIds.push_back(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1));
+	cfgIds.push_back(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1));
+
+	std::shared_ptr<IMsvActiveConfig> spActiveCfg = m_spActiveCfg;
+	std::future<uint64_t> waiter = std::async(std::launch::async, [spActiveCfg, cfgIds, sinceVersion]()
+	{
+		uint64_t changedVersion = 0;
+		EXPECT_EQ(spActiveCfg->WaitForChange(cfgIds, sinceVersion, MSV_ACTIVECONFIG_WAIT_INFINITE, changedVersion), MSV_SUCCESS);
+		return changedVersion;
+	});
+
+	//not watched config ID does not wake waiter
+	EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1), false), MSV_SUCCESS);
+	EXPECT_EQ(waiter.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+
+	EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1), "changed"), MSV_SUCCESS);
+	EXPECT_EQ(waiter.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+	uint64_t changedVersion = waiter.get();
+	EXPECT_GT(changedVersion, sinceVersion);
+
+	std::string value;
+	EXPECT_EQ(m_spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1), value), MSV_SUCCESS);
+	EXPECT_EQ(value, "changed");
+
+	//change which has been already seen is not returned again, new one is returned without waiting
+	EXPECT_EQ(m_spActiveCfg->WaitForChange(cfgIds, changedVersion, 0, version), MSV_SUCCESS);
+	EXPECT_EQ(version, changedVersion);
+	EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), 3ll), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->WaitForChange(cfgIds, changedVersion, 0, version), MSV_SUCCESS);
+	EXPECT_GT(version, changedVersion);
+
+	EXPECT_EQ(m_spActiveCfg->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvActiveConfig_Integration, ItShouldPollJournaledChangesAndSignalOverrun)
+{
+	std::shared_ptr<MsvActiveConfig> spActiveCfg(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_EQ(spActiveCfg->SetJournalSize(2), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetJournalSize(4), MSV_ALREADY_INITIALIZED_INFO);
+
+	uint64_t lastSequence = 0;
+	EXPECT_EQ(spActiveCfg->GetVersion(lastSequence), MSV_SUCCESS);
+
+	//nothing has been changed
+	std::vector<MsvConfigValueJournalEntry> changes;
+	uint64_t sequence = 0;
+	EXPECT_EQ(spActiveCfg->PollChanges(lastSequence, changes, sequence), MSV_SUCCESS);
+	EXPECT_TRUE(changes.empty());
+	EXPECT_EQ(sequence, lastSequence);
+
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), int64_t(5)), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1), std::string("five")), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->PollChanges(lastSequence, changes, sequence), MSV_SUCCESS);
+	ASSERT_EQ(changes.size(), 2u);
+	EXPECT_EQ(changes[0].m_sequence, lastSequence + 1);
+	EXPECT_EQ(changes[0].m_cfgId, static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1));
+	EXPECT_EQ(std::get<int64_t>(changes[0].m_newValue), 5ll);
+	EXPECT_EQ(changes[1].m_sequence, lastSequence + 2);
+	EXPECT_EQ(std::get<std::string>(changes[1].m_newValue), "five");
+	EXPECT_EQ(sequence, lastSequence + 2);
+	lastSequence = sequence;
+
+	//consumer behind journal size must resync and continue from returned sequence
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1), true), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_DOUBLE_1), 2.5), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), uint64_t(7)), MSV_SUCCESS);
+	changes.clear();
+	EXPECT_EQ(spActiveCfg->PollChanges(lastSequence, changes, sequence), MSV_NOT_FOUND_ERROR);
+	EXPECT_TRUE(changes.empty());
+	EXPECT_EQ(sequence, lastSequence + 3);
+	EXPECT_EQ(spActiveCfg->PollChanges(sequence + 1, changes, sequence), MSV_NOT_FOUND_ERROR);
+
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), uint64_t(8)), MSV_SUCCESS);
+	lastSequence = sequence;
+	EXPECT_EQ(spActiveCfg->PollChanges(lastSequence, changes, sequence), MSV_SUCCESS);
+	ASSERT_EQ(changes.size(), 1u);
+	EXPECT_EQ(std::get<uint64_t>(changes[0].m_newValue), 8ull);
+
+	EXPECT_EQ(spActiveCfg->Uninitialize(), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->PollChanges(0, changes, sequence), MSV_NOT_INITIALIZED_ERROR);
+}
+
+TEST_F(MsvActiveConfig_Integration, ItShouldReportAndQuarantineSlowCallback)
+{
+	std::shared_ptr<MsvActiveConfig> spActiveCfg(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_TRUE(spActiveCfg != nullptr);
+	EXPECT_EQ(spActiveCfg->SetCallbackBudget(5000, true), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->RegisterCallback(m_spActiveCfgCallback), MSV_SUCCESS);
+
+	//first call is slow and synchronous, second one is delivered by quarantine dispatcher
+	std::thread::id writerId = std::this_thread::get_id();
+	std::promise<std::thread::id> quarantinedCall;
+	{
+		InSequence sequence;
+		EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), Matcher<int64_t>(10ll)))
+			.WillOnce(Invoke([](int32_t, int64_t) { std::this_thread::sleep_for(std::chrono::milliseconds(20)); }));
+		EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), Matcher<int64_t>(11ll)))
+			.WillOnce(Invoke([&quarantinedCall](int32_t, int64_t) { quarantinedCall.set_value(std::this_thread::get_id()); }));
+	}
+
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), 10ll), MSV_SUCCESS);
+
+	std::vector<MsvCallbackReport> report;
+	spActiveCfg->GetCallbackReport(report);
+	ASSERT_EQ(report.size(), 1u);
+	EXPECT_EQ(report[0].m_pCallback, m_spActiveCfgCallback.get());
+	EXPECT_EQ(report[0].m_callCount, 1u);
+	EXPECT_EQ(report[0].m_slowCallCount, 1u);
+	EXPECT_GE(report[0].m_maxTime, std::chrono::milliseconds(20));
+	EXPECT_TRUE(report[0].m_quarantined);
+
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), 11ll), MSV_SUCCESS);
+	std::future<std::thread::id> quarantinedCallId = quarantinedCall.get_future();
+	EXPECT_EQ(quarantinedCallId.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+	EXPECT_NE(quarantinedCallId.get(), writerId);
+
+	//unregistered callback is removed from report
+	EXPECT_EQ(spActiveCfg->UnregisterCallback(m_spActiveCfgCallback), MSV_SUCCESS);
+	spActiveCfg->GetCallbackReport(report);
+	EXPECT_TRUE(report.empty());
+
+	EXPECT_EQ(spActiveCfg->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvActiveConfig_Integration, SnapshotShouldKeepValuesWhileConfigChanges)
+{
+	std::shared_ptr<const MsvConfigSnapshot> spSnapshot;
+	EXPECT_EQ(m_spActiveCfg->GetSnapshot(spSnapshot), MSV_NOT_INITIALIZED_ERROR);
+
+	//lazy snapshot loads values which have not been accessed yet
+	std::shared_ptr<MsvActiveConfig> spActiveCfg(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_TRUE(spActiveCfg != nullptr);
+	EXPECT_EQ(spActiveCfg->SetLazyLoading(true), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), int64_t(5)), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->GetSnapshot(spSnapshot), MSV_SUCCESS);
+	ASSERT_TRUE(spSnapshot != nullptr);
+
+	int64_t value = 0;
+	std::string stringValue;
+	EXPECT_EQ(spSnapshot->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), value), MSV_SUCCESS);
+	EXPECT_EQ(value, 5ll);
+	EXPECT_EQ(spSnapshot->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_2), value), MSV_SUCCESS);
+	EXPECT_EQ(spSnapshot->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1), stringValue), MSV_SUCCESS);
+	EXPECT_EQ(spSnapshot->GetValue(1000, value), MSV_NOT_FOUND_ERROR);
+
+	//snapshot is cached until next change
+	std::shared_ptr<const MsvConfigSnapshot> spSameSnapshot;
+	EXPECT_EQ(spActiveCfg->GetSnapshot(spSameSnapshot), MSV_SUCCESS);
+	EXPECT_EQ(spSameSnapshot, spSnapshot);
+
+	//changes are not visible in taken snapshot
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), int64_t(6)), MSV_SUCCESS);
+	EXPECT_EQ(spSnapshot->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), value), MSV_SUCCESS);
+	EXPECT_EQ(value, 5ll);
+
+	std::shared_ptr<const MsvConfigSnapshot> spNewSnapshot;
+	EXPECT_EQ(spActiveCfg->GetSnapshot(spNewSnapshot), MSV_SUCCESS);
+	EXPECT_NE(spNewSnapshot, spSnapshot);
+	EXPECT_EQ(spNewSnapshot->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), value), MSV_SUCCESS);
+	EXPECT_EQ(value, 6ll);
+
+	//snapshot outlives config
+	EXPECT_EQ(spActiveCfg->Uninitialize(), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->GetSnapshot(spSameSnapshot), MSV_NOT_INITIALIZED_ERROR);
+	EXPECT_EQ(spNewSnapshot->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), value), MSV_SUCCESS);
+	EXPECT_EQ(value, 6ll);
+}
+
+TEST_F(MsvActiveConfig_Integration, RetargetShouldSwitchDatabaseAndNotifyOnlyDifferences)
+{
+	const char* const retargetGroup = "MsvTestConfigRetarget";
+
+	EXPECT_EQ(m_spActiveCfg->Retarget(TEST_CONFIG_PATH, retargetGroup), MSV_NOT_INITIALIZED_ERROR);
+	EXPECT_EQ(m_spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), 5ll), MSV_SUCCESS);
+
+	//other service prepares new group (it keeps it opened, database is shared after retarget)
+	std::shared_ptr<MsvActiveConfig> spActiveCfg(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_TRUE(spActiveCfg != nullptr);
+	EXPECT_EQ(spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, retargetGroup), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), 7ll), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1), std::string("seven")), MSV_SUCCESS);
+
+	//only values which differ are notified
+	EXPECT_EQ(m_spActiveCfg->RegisterCallback(m_spActiveCfgCallback), MSV_SUCCESS);
+	EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(_, Matcher<bool>(_))).Times(0);
+	EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(_, Matcher<double>(_))).Times(0);
+	EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(_, Matcher<uint64_t>(_))).Times(0);
+	EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(_, Matcher<int64_t>(_))).Times(0);
+	EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(_, Matcher<const char*>(_))).Times(0);
+	EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), Matcher<int64_t>(7ll)));
+	EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1), Matcher<const char*>(StrEq("seven"))));
+
+	//readers never see uninitialized config
+	std::atomic<bool> stop(false);
+	std::atomic<int> failedReads(0);
+	std::thread reader([this, &stop, &failedReads]()
+	{
+		while (!stop)
+		{
+			int64_t value = 0;
+			if (m_spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), value) != MSV_SUCCESS || (value != 5 && value != 7))
+			{
+				++failedReads;
+			}
+		}
+	});
+
+	EXPECT_EQ(m_spActiveCfg->Retarget(TEST_CONFIG_PATH, retargetGroup), MSV_SUCCESS);
+	stop = true;
+	reader.join();
+	EXPECT_EQ(failedReads, 0);
+
+	int64_t value = 0;
+	EXPECT_EQ(m_spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), value), MSV_SUCCESS);
+	EXPECT_EQ(value, 7ll);
+
+	//already used database -> nothing to notify
+	EXPECT_EQ(m_spActiveCfg->Retarget(TEST_CONFIG_PATH, retargetGroup), MSV_SUCCESS);
+
+	//writes go to new database (shared with other service)
+	EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), Matcher<int64_t>(8ll)));
+	EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), 8ll), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), value), MSV_SUCCESS);
+	EXPECT_EQ(value, 8ll);
+
+	EXPECT_EQ(m_spActiveCfg->Uninitialize(), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvActiveConfig_Integration, RetargetShouldWakeChangeWaitersOfOldDatabase)
+{
+	const char* const retargetGroup = "MsvTestConfigRetarget";
+
+	EXPECT_EQ(m_spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	uint64_t sinceVersion = 0;
+	EXPECT_EQ(m_spActiveCfg->GetVersion(sinceVersion), MSV_SUCCESS);
+
+	std::shared_ptr<IMsvActiveConfig> spActiveCfg = m_spActiveCfg;
+	std::future<MsvErrorCode> waiter = std::async(std::launch::async, [spActiveCfg, sinceVersion]()
+	{
+		uint64_t changedVersion = 0;
+		MsvErrorCode errorCode = spActiveCfg->WaitForChange(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), sinceVersion, MSV_ACTIVECONFIG_WAIT_INFINITE, changedVersion);
+		EXPECT_EQ(changedVersion, sinceVersion);
+		return errorCode;
+	});
+
+	EXPECT_EQ(waiter.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+
+	//waiter of old database is woken and has to resync
+	EXPECT_EQ(m_spActiveCfg->Retarget(TEST_CONFIG_PATH, retargetGroup), MSV_SUCCESS);
+	EXPECT_EQ(waiter.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+	EXPECT_EQ(waiter.get(), MSV_BUSY_ERROR);
+
+	//waiter which has resynced waits for changes of new database
+	EXPECT_EQ(m_spActiveCfg->GetVersion(sinceVersion), MSV_SUCCESS);
+	waiter = std::async(std::launch::async, [spActiveCfg, sinceVersion]()
+	{
+		uint64_t changedVersion = 0;
+		MsvErrorCode errorCode = spActiveCfg->WaitForChange(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), sinceVersion, MSV_ACTIVECONFIG_WAIT_INFINITE, changedVersion);
+		EXPECT_GT(changedVersion, sinceVersion);
+		return errorCode;
+	});
+
+	EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), 9ll), MSV_SUCCESS);
+	EXPECT_EQ(waiter.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+	EXPECT_EQ(waiter.get(), MSV_SUCCESS);
+
+	EXPECT_EQ(m_spActiveCfg->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvActiveConfig_Integration, DerivedValueShouldBeRecomputedOnlyWhenDependencyChanges)
+{
+	const int32_t derivedCfgId = 1000;
+	const int32_t chainedCfgId = 1001;
+	const int32_t integer1 = static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1);
+	const int32_t integer2 = static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_2);
+
+	std::atomic<int> computeCount(0);
+	MsvActiveConfigDerivedFunction sum = [integer1, integer2, &computeCount](const IMsvActiveConfig& config, MsvConfigValue& value)
+	{
+		++computeCount;
+		int64_t value1 = 0;
+		int64_t value2 = 0;
+		MsvErrorCode errorCode = config.GetValue(integer1, value1);
+		if (MSV_SUCCEEDED(errorCode))
+		{
+			errorCode = config.GetValue(integer2, value2);
+		}
+		value = value1 + value2;
+		return errorCode;
+	};
+	MsvActiveConfigDerivedFunction label = [derivedCfgId](const IMsvActiveConfig& config, MsvConfigValue& value)
+	{
+		int64_t sumValue = 0;
+		MsvErrorCode errorCode = config.GetValue(derivedCfgId, sumValue);
+		value = "sum " + std::to_string(sumValue);
+		return errorCode;
+	};
+
+	std::shared_ptr<MsvActiveConfig> spActiveCfg(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_TRUE(spActiveCfg != nullptr);
+	EXPECT_EQ(spActiveCfg->RegisterDerivedValue(derivedCfgId, { integer1, integer2 }, sum), MSV_NOT_INITIALIZED_ERROR);
+	EXPECT_EQ(spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	//invalid registrations
+	EXPECT_EQ(spActiveCfg->RegisterDerivedValue(integer1, { integer2 }, sum), MSV_ALREADY_EXISTS_ERROR);
+	EXPECT_EQ(spActiveCfg->RegisterDerivedValue(derivedCfgId, { integer1, 2000 }, sum), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(spActiveCfg->RegisterDerivedValue(derivedCfgId, { derivedCfgId }, sum), MSV_INVALID_DATA_ERROR);
+
+	EXPECT_EQ(spActiveCfg->RegisterDerivedValue(derivedCfgId, { integer1, integer2 }, sum), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->RegisterDerivedValue(chainedCfgId, { derivedCfgId }, label), MSV_SUCCESS);
+	EXPECT_EQ(computeCount, 1);
+
+	//replaced definition would close cycle -> previous one is kept
+	EXPECT_EQ(spActiveCfg->RegisterDerivedValue(derivedCfgId, { integer1, chainedCfgId }, sum), MSV_INVALID_DATA_ERROR);
+	EXPECT_EQ(spActiveCfg->UnregisterDerivedValue(derivedCfgId), MSV_BUSY_ERROR);
+
+	//derived values are read like stored ones (memoized, they are not computed by reads)
+	int64_t value = 0;
+	std::string stringValue;
+	EXPECT_EQ(spActiveCfg->GetValue(derivedCfgId, value), MSV_SUCCESS);
+	EXPECT_EQ(value, 1ll);
+	EXPECT_EQ(spActiveCfg->GetValue(chainedCfgId, stringValue), MSV_SUCCESS);
+	EXPECT_EQ(stringValue, "sum 1");
+	EXPECT_EQ(spActiveCfg->GetValue(chainedCfgId, value), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(computeCount, 1);
+
+	//unrelated change does not recompute anything
+	EXPECT_EQ(m_spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1), true), MSV_SUCCESS);
+	EXPECT_EQ(computeCount, 1);
+
+	//change of dependency (made by other instance) recomputes whole chain and it is notified
+	EXPECT_EQ(spActiveCfg->RegisterCallback(m_spActiveCfgCallback), MSV_SUCCESS);
+	EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(integer1, Matcher<int64_t>(5ll)));
+	EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(derivedCfgId, Matcher<int64_t>(6ll)));
+	EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(chainedCfgId, Matcher<const char*>(StrEq("sum 6"))));
+	EXPECT_EQ(m_spActiveCfg->SetValue(integer1, 5ll), MSV_SUCCESS);
+	EXPECT_EQ(computeCount, 2);
+	EXPECT_EQ(spActiveCfg->GetValue(derivedCfgId, value), MSV_SUCCESS);
+	EXPECT_EQ(value, 6ll);
+	EXPECT_EQ(spActiveCfg->GetValue(chainedCfgId, stringValue), MSV_SUCCESS);
+	EXPECT_EQ(stringValue, "sum 6");
+
+	//recomputed value which has not been changed is not notified (its dependents are not recomputed)
+	EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(integer1, Matcher<int64_t>(5ll)));
+	EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(derivedCfgId, Matcher<int64_t>(_))).Times(0);
+	EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(chainedCfgId, Matcher<const char*>(_))).Times(0);
+	EXPECT_EQ(m_spActiveCfg->SetValue(integer1, 5ll), MSV_SUCCESS);
+	EXPECT_EQ(computeCount, 3);
+
+	EXPECT_EQ(spActiveCfg->UnregisterDerivedValue(chainedCfgId), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->UnregisterDerivedValue(chainedCfgId), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(spActiveCfg->GetValue(chainedCfgId, stringValue), MSV_NOT_FOUND_ERROR);
+
+	EXPECT_EQ(m_spActiveCfg->Uninitialize(), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvActiveConfig_Integration, FlagsShouldCompileRulesOnChangeAndEvaluateSubjects)
+{
+	const int32_t enabledCfgId = static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1);
+	const int32_t percentageCfgId = static_cast<int32_t>(ConfigId::MSV_TEST_DOUBLE_1);
+	const int32_t allowCfgId = static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1);
+	const int32_t denyCfgId = static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2);
+
+	//flag 0 uses all rules, flag 1 has no rules (always enabled), flag 2 shares percentage with flag 0
+	MsvActiveConfigFlags flags({
+		{ enabledCfgId, percentageCfgId, allowCfgId, denyCfgId },
+		{ MSV_ACTIVECONFIGFLAGS_NO_CFGID, MSV_ACTIVECONFIGFLAGS_NO_CFGID, MSV_ACTIVECONFIGFLAGS_NO_CFGID, MSV_ACTIVECONFIGFLAGS_NO_CFGID },
+		{ MSV_ACTIVECONFIGFLAGS_NO_CFGID, percentageCfgId, MSV_ACTIVECONFIGFLAGS_NO_CFGID, MSV_ACTIVECONFIGFLAGS_NO_CFGID } }, 3, m_spLogger);
+	EXPECT_FALSE(flags.IsEnabled(1, "alice"));
+	EXPECT_EQ(flags.Attach(m_spActiveCfg), MSV_NOT_INITIALIZED_ERROR);
+
+	EXPECT_EQ(m_spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+	EXPECT_EQ(flags.Attach(m_spActiveCfg), MSV_SUCCESS);
+	EXPECT_EQ(flags.Attach(m_spActiveCfg), MSV_ALREADY_INITIALIZED_INFO);
+
+	//default values: switched off, 0 %, allowed "0", denied "1"
+	EXPECT_FALSE(flags.IsEnabled(0, "0"));
+	EXPECT_TRUE(flags.IsEnabled(1, "alice"));
+	EXPECT_FALSE(flags.IsEnabled(2, "alice"));
+	EXPECT_FALSE(flags.IsEnabled(3, "alice"));
+
+	//allow list has precedence over percentage, deny list over allow list
+	EXPECT_EQ(m_spActiveCfg->SetValues({ { enabledCfgId, true }, { allowCfgId, std::string(" alice, bob,,carol ") }, { denyCfgId, std::string("bob") } }), MSV_SUCCESS);
+	EXPECT_TRUE(flags.IsEnabled(0, "alice"));
+	EXPECT_TRUE(flags.IsEnabled(0, MsvActiveConfigFlags::HashSubject("carol")));
+	EXPECT_FALSE(flags.IsEnabled(0, "bob"));
+	EXPECT_FALSE(flags.IsEnabled(0, "dave"));
+
+	//rollout percentage enables stable part of subjects (buckets differ per flag)
+	EXPECT_EQ(m_spActiveCfg->SetValue(percentageCfgId, 30.0), MSV_SUCCESS);
+	size_t enabledCount = 0;
+	size_t sameCount = 0;
+	for (int i = 0; i < 10000; ++i)
+	{
+		std::string subject = "user" + std::to_string(i);
+		bool enabled = flags.IsEnabled(2, subject.c_str());
+		EXPECT_EQ(enabled, flags.IsEnabled(2, subject.c_str()));
+		enabledCount += enabled ? 1 : 0;
+		sameCount += (enabled == flags.IsEnabled(0, subject.c_str())) ? 1 : 0;
+	}
+	EXPECT_GT(enabledCount, 2700u);
+	EXPECT_LT(enabledCount, 3300u);
+	EXPECT_LT(sameCount, 9000u);
+
+	EXPECT_EQ(m_spActiveCfg->SetValue(percentageCfgId, 100.0), MSV_SUCCESS);
+	EXPECT_TRUE(flags.IsEnabled(0, "dave"));
+	EXPECT_FALSE(flags.IsEnabled(0, "bob"));
+
+	//list exceeding capacity disables flag
+	EXPECT_EQ(m_spActiveCfg->SetValue(denyCfgId, std::string("bob,eve,frank,grace")), MSV_SUCCESS);
+	EXPECT_FALSE(flags.IsEnabled(0, "dave"));
+	EXPECT_TRUE(flags.IsEnabled(2, "dave"));
+
+	//detached flags keep last compiled rules
+	EXPECT_EQ(m_spActiveCfg->SetValue(denyCfgId, std::string("bob")), MSV_SUCCESS);
+	EXPECT_EQ(flags.Detach(), MSV_SUCCESS);
+	EXPECT_EQ(flags.Detach(), MSV_NOT_INITIALIZED_INFO);
+	EXPECT_EQ(m_spActiveCfg->SetValue(enabledCfgId, false), MSV_SUCCESS);
+	EXPECT_TRUE(flags.IsEnabled(0, "dave"));
+
+	EXPECT_EQ(m_spActiveCfg->Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvActiveConfig_Integration, OverridesShouldBeVisibleOnlyInPushingThread)
+{
+	const int32_t integer1 = static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1);
+	const int32_t string1 = static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1);
+
+	EXPECT_EQ(m_spActiveCfg->PushOverrides({ { integer1, int64_t(5) } }), MSV_NOT_INITIALIZED_ERROR);
+	EXPECT_EQ(m_spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	std::shared_ptr<IMsvActiveConfig> spActiveCfg(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_TRUE(spActiveCfg != nullptr);
+	EXPECT_EQ(spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	//invalid overrides are rejected as a whole
+	EXPECT_EQ(m_spActiveCfg->PushOverrides({ { integer1, int64_t(5) }, { 2000, int64_t(5) } }), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(m_spActiveCfg->PushOverrides({ { integer1, std::string("5") } }), MSV_INVALID_DATA_ERROR);
+	EXPECT_EQ(m_spActiveCfg->PopOverrides(), MSV_NOT_FOUND_ERROR);
+
+	int64_t value = 0;
+	std::string stringValue;
+	{
+		MsvConfigOverrideScope<IMsvActiveConfig> scope(*m_spActiveCfg, { { integer1, int64_t(5) }, { string1, std::string("override") } });
+		EXPECT_EQ(scope.GetErrorCode(), MSV_SUCCESS);
+
+		EXPECT_EQ(m_spActiveCfg->GetValue(integer1, value), MSV_SUCCESS);
+		EXPECT_EQ(value, 5ll);
+		EXPECT_EQ(m_spActiveCfg->GetValue(string1, stringValue), MSV_SUCCESS);
+		EXPECT_EQ(stringValue, "override");
+
+		//nested frame wins until it is popped
+		EXPECT_EQ(m_spActiveCfg->PushOverrides({ { integer1, int64_t(6) } }), MSV_SUCCESS);
+		EXPECT_EQ(m_spActiveCfg->GetValue(integer1, value), MSV_SUCCESS);
+		EXPECT_EQ(value, 6ll);
+		EXPECT_EQ(m_spActiveCfg->PopOverrides(), MSV_SUCCESS);
+		EXPECT_EQ(m_spActiveCfg->GetValue(integer1, value), MSV_SUCCESS);
+		EXPECT_EQ(value, 5ll);
+
+		//other instance and other thread read stored values
+		EXPECT_EQ(spActiveCfg->GetValue(integer1, value), MSV_SUCCESS);
+		EXPECT_EQ(value, 0ll);
+
+		std::thread reader([this, integer1]()
+		{
+			int64_t threadValue = -1;
+			EXPECT_EQ(m_spActiveCfg->GetValue(integer1, threadValue), MSV_SUCCESS);
+			EXPECT_EQ(threadValue, 0ll);
+		});
+		reader.join();
+
+		//write goes to storage, override still hides it in this thread
+		EXPECT_EQ(m_spActiveCfg->SetValue(integer1, int64_t(7)), MSV_SUCCESS);
+		EXPECT_EQ(m_spActiveCfg->GetValue(integer1, value), MSV_SUCCESS);
+		EXPECT_EQ(value, 5ll);
+	}
+
+	//scope has popped its frame -> stored value is visible again
+	EXPECT_EQ(m_spActiveCfg->GetValue(integer1, value), MSV_SUCCESS);
+	EXPECT_EQ(value, 7ll);
+	EXPECT_EQ(m_spActiveCfg->GetValue(string1, stringValue), MSV_SUCCESS);
+	EXPECT_EQ(stringValue, "0");
+	EXPECT_EQ(m_spActiveCfg->PopOverrides(), MSV_NOT_FOUND_ERROR);
+}
+
+TEST_F(MsvActiveConfig_Integration, ShardedWritesShouldRunConcurrentlyAndKeepValuesInPartitions)
+{
+	const size_t shardCount = 4;
+	const int64_t writeCount = 50;
+	const int32_t integer1 = static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1);
+	const int32_t integer2 = static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_2);
+	const int32_t string1 = static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1);
+	const int32_t string2 = static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2);
+	const int32_t unsigned1 = static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1);
+
+	//config IDs are spread by modulo -> integer 1 and unsigned 1 share shard, others have their own
+	EXPECT_EQ(MsvActiveConfigWriteLock::GetShard(integer1, shardCount), MsvActiveConfigWriteLock::GetShard(unsigned1, shardCount));
+	EXPECT_NE(MsvActiveConfigWriteLock::GetShard(integer1, shardCount), MsvActiveConfigWriteLock::GetShard(integer2, shardCount));
+
+	std::vector<std::string> partitionPaths;
+	for (size_t i = 1; i < shardCount; ++i)
+	{
+		partitionPaths.push_back(MsvActiveConfigShardedStorage::GetPartitionPath(TEST_CONFIG_PATH, i));
+		remove(partitionPaths.back().c_str());
+	}
+
+	//value stored without shards is moved to its partition
+	EXPECT_EQ(m_spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->SetValue(integer2, int64_t(42)), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->Uninitialize(), MSV_SUCCESS);
+
+	std::shared_ptr<MsvActiveConfig> spActiveCfg(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_TRUE(spActiveCfg != nullptr);
+	EXPECT_EQ(spActiveCfg->SetWriteShards(shardCount), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->SetWriteShards(1), MSV_ALREADY_INITIALIZED_INFO);
+
+	for (std::vector<std::string>::const_iterator it = partitionPaths.begin(); it != partitionPaths.end(); ++it)
+	{
+		EXPECT_TRUE(FileExists(it->c_str()));
+	}
+
+	int64_t value = 0;
+	EXPECT_EQ(spActiveCfg->GetValue(integer2, value), MSV_SUCCESS);
+	EXPECT_EQ(value, 42ll);
+
+	//each writer has its own shard
+	std::vector<std::thread> writers;
+	const int32_t integerCfgIds[] = { integer1, integer2 };
+	const int32_t stringCfgIds[] = { string1, string2 };
+	for (size_t i = 0; i < 2; ++i)
+	{
+		writers.emplace_back([&spActiveCfg, writeCount, cfgId = integerCfgIds[i]]()
+		{
+			for (int64_t j = 1; j <= writeCount; ++j)
+			{
+				EXPECT_EQ(spActiveCfg->SetValue(cfgId, j), MSV_SUCCESS);
+			}
+		});
+		writers.emplace_back([&spActiveCfg, writeCount, cfgId = stringCfgIds[i]]()
+		{
+			for (int64_t j = 1; j <= writeCount; ++j)
+			{
+				EXPECT_EQ(spActiveCfg->SetValue(cfgId, std::to_string(j)), MSV_SUCCESS);
+			}
+		});
+	}
+
+	for (std::vector<std::thread>::iterator it = writers.begin(); it != writers.end(); ++it)
+	{
+		it->join();
+	}
+
+	//every write has been recorded
+	uint64_t version = 0;
+	EXPECT_EQ(spActiveCfg->GetVersion(version), MSV_SUCCESS);
+	EXPECT_EQ(version, static_cast<uint64_t>(4 * writeCount));
+
+	//synchronous callback might write only its own shard (other shard or batch would deadlock with other writer)
+	EXPECT_EQ(spActiveCfg->RegisterCallback(m_spActiveCfgCallback, integer1), MSV_SUCCESS);
+	EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(integer1, Matcher<int64_t>(7ll))).WillOnce(Invoke([&spActiveCfg, integer2, unsigned1](int32_t, int64_t)
+	{
+		EXPECT_EQ(spActiveCfg->SetValue(integer2, int64_t(8)), MSV_BUSY_ERROR);
+		EXPECT_EQ(spActiveCfg->SetValues({ { unsigned1, uint64_t(8) } }), MSV_BUSY_ERROR);
+		EXPECT_EQ(spActiveCfg->SetValue(unsigned1, uint64_t(8)), MSV_SUCCESS);
+	}));
+	EXPECT_EQ(spActiveCfg->SetValue(integer1, int64_t(7)), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg->Uninitialize(), MSV_SUCCESS);
+
+	//values are read from partitions
+	std::shared_ptr<MsvActiveConfig> spReopenedCfg(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_TRUE(spReopenedCfg != nullptr);
+	EXPECT_EQ(spReopenedCfg->SetWriteShards(shardCount), MSV_SUCCESS);
+	EXPECT_EQ(spReopenedCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	std::string stringValue;
+	uint64_t unsignedValue = 0;
+	EXPECT_EQ(spReopenedCfg->GetValue(integer1, value), MSV_SUCCESS);
+	EXPECT_EQ(value, 7ll);
+	EXPECT_EQ(spReopenedCfg->GetValue(integer2, value), MSV_SUCCESS);
+	EXPECT_EQ(value, writeCount);
+	EXPECT_EQ(spReopenedCfg->GetValue(string2, stringValue), MSV_SUCCESS);
+	EXPECT_EQ(stringValue, std::to_string(writeCount));
+	EXPECT_EQ(spReopenedCfg->GetValue(unsigned1, unsignedValue), MSV_SUCCESS);
+	EXPECT_EQ(unsignedValue, 8ull);
+	EXPECT_EQ(spReopenedCfg->Uninitialize(), MSV_SUCCESS);
+
+	for (std::vector<std::string>::const_iterator it = partitionPaths.begin(); it != partitionPaths.end(); ++it)
+	{
+		remove(it->c_str());
+	}
+}
+
+class MsvSharedStringCallback_Mock:
+	public MsvActiveConfigCallback_Mock
+{
+public:
+	using MsvActiveConfigCallback_Mock::OnValueChanged;
+
+	MOCK_METHOD2(OnValueChanged, void(int32_t, const std::shared_ptr<const std::string>&));
+};
+
+TEST_F(MsvActiveConfig_Integration, StringValueShouldBeSharedByCacheStorageAndCallbacks)
+{
+	const int32_t string1 = static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1);
+	const int32_t string2 = static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2);
+
+	EXPECT_EQ(m_spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	std::shared_ptr<StrictMock<MsvSharedStringCallback_Mock>> spSharedCallback(new (std::nothrow) StrictMock<MsvSharedStringCallback_Mock>());
+	EXPECT_TRUE(spSharedCallback != nullptr);
+	EXPECT_EQ(m_spActiveCfg->RegisterCallback(spSharedCallback), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->RegisterCallback(m_spActiveCfgCallback), MSV_SUCCESS);
+
+	//shared value is passed to callbacks (callback without shared overload gets const char*), quotes are bound (not escaped)
+	std::shared_ptr<const std::string> spValue = std::make_shared<const std::string>(std::string(1 << 20, 'x') + "'); DROP TABLE MsvTestConfig; --");
+	std::shared_ptr<const std::string> spReceived;
+	EXPECT_CALL(*spSharedCallback, OnValueChanged(string1, _)).WillOnce(SaveArg<1>(&spReceived));
+	EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(string1, Matcher<const char*>(StrEq(*spValue))));
+	EXPECT_EQ(m_spActiveCfg->SetValue(string1, spValue), MSV_SUCCESS);
+	EXPECT_EQ(spReceived.get(), spValue.get());
+
+	//moved value keeps its buffer
+	std::string value(1 << 20, 'y');
+	const char* pBuffer = value.data();
+	EXPECT_CALL(*spSharedCallback, OnValueChanged(string2, _)).WillOnce(SaveArg<1>(&spReceived));
+	EXPECT_CALL(*m_spActiveCfgCallback, OnValueChanged(string2, Matcher<const char*>(_)));
+	EXPECT_EQ(m_spActiveCfg->SetValue(string2, std::move(value)), MSV_SUCCESS);
+	EXPECT_EQ(spReceived->data(), pBuffer);
+
+	EXPECT_EQ(m_spActiveCfg->SetValue(string1, std::shared_ptr<const std::string>()), MSV_INVALID_DATA_ERROR);
+
+	EXPECT_EQ(m_spActiveCfg->UnregisterCallback(spSharedCallback), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->UnregisterCallback(m_spActiveCfgCallback), MSV_SUCCESS);
+
+	std::string readValue;
+	EXPECT_EQ(m_spActiveCfg->GetValue(string1, readValue), MSV_SUCCESS);
+	EXPECT_EQ(readValue, *spValue);
+
+	//values have been stored as they are
+	EXPECT_EQ(m_spActiveCfg->Uninitialize(), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->GetValue(string1, readValue), MSV_SUCCESS);
+	EXPECT_EQ(readValue, *spValue);
+	EXPECT_EQ(m_spActiveCfg->GetValue(string2, readValue), MSV_SUCCESS);
+	EXPECT_EQ(readValue, std::string(1 << 20, 'y'));
+
+	EXPECT_EQ(m_spActiveCfg->Uninitialize(), MSV_SUCCESS);
+}
+
+#ifdef __linux__
+
+TEST_F(MsvActiveConfig_Integration, NotificationHandleShouldSignalChangesOfAllInstances)
+{
+	//handle might be opened before initialize
+	int handle = -1;
+	EXPECT_EQ(m_spActiveCfg->GetNotificationHandle(handle), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	std::shared_ptr<MsvActiveConfig> spActiveCfg2(new (std::nothrow) MsvActiveConfig(m_spLogger));
+	EXPECT_EQ(spActiveCfg2->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH, TEST_CONFIG_GROUP), MSV_SUCCESS);
+
+	pollfd pollHandle = { handle, POLLIN, 0 };
+	EXPECT_EQ(poll(&pollHandle, 1, 0), 0);
+
+	//value is cached before handle is signaled
+	EXPECT_EQ(spActiveCfg2->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1), std::string("polled")), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg2->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), int64_t(9)), MSV_SUCCESS);
+	EXPECT_EQ(spActiveCfg2->SetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1), std::string("polled again")), MSV_SUCCESS);
+	EXPECT_EQ(poll(&pollHandle, 1, 0), 1);
+
+	std::vector<int32_t> changedCfgIds;
+	EXPECT_EQ(m_spActiveCfg->DrainChanges(changedCfgIds), MSV_SUCCESS);
+	EXPECT_EQ(changedCfgIds, std::vector<int32_t>({ static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1) }));
+	EXPECT_EQ(poll(&pollHandle, 1, 0), 0);
+
+	std::string value;
+	EXPECT_EQ(m_spActiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1), value), MSV_SUCCESS);
+	EXPECT_EQ(value, "polled again");
+
+	//instance without opened handle does not collect changes
+	EXPECT_EQ(spActiveCfg2->DrainChanges(changedCfgIds), MSV_SUCCESS);
+	EXPECT_TRUE(changedCfgIds.empty());
+
+	EXPECT_EQ(spActiveCfg2->Uninitialize(), MSV_SUCCESS);
+	EXPECT_EQ(m_spActiveCfg->Uninitialize(), MSV_SUCCESS);
+}
+
+#endif // __linux__
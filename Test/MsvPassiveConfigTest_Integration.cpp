@@ -6,10 +6,32 @@
 #include "mconfig/common/MsvConfigKeyMapBase.h"
 #include "mconfig/common/MsvConfigKey.h"
 #include "mconfig/common/MsvDefaultValue.h"
+#include "mconfig/mpassivecfg/MsvPassiveConfigArgsSource.h"
+#include "mconfig/mpassivecfg/MsvPassiveConfigBinding.h"
+#include "mconfig/mpassivecfg/MsvPassiveConfigEnvSource.h"
+#include "mconfig/mpassivecfg/MsvPassiveConfigLayered.h"
+#include "mconfig/mpassivecfg/MsvPassiveConfigMapped.h"
+#include "mconfig/mpassivecfg/MsvPassiveConfigWatcher.h"
+#include "mconfig/Mocks/MsvPassiveConfigCallback_Mock.h"
+#include "mconfig/Mocks/MsvPassiveConfigWatcherCallback_Mock.h"
 
 MSV_DISABLE_ALL_WARNINGS
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#endif
 
 MSV_ENABLE_WARNINGS
 
@@ -18,6 +40,7 @@ using namespace ::testing;
 
 
 const char* const TEST_CONFIG_PATH = "test_config.ini";
+const char* const TEST_CONFIG_IMAGE_PATH = "test_config.ini.img";
 
 const char* const TEST_CONFIG_GROUP1 = "GROUP_1";
 const char* const TEST_CONFIG_GROUP2 = "GROUP_2";
@@ -92,8 +115,9 @@ public:
 		EXPECT_NE(m_spConfigKeyMap, nullptr);
 		EXPECT_TRUE(MSV_SUCCEEDED(m_spConfigKeyMap->Initialize()));
 
-		//delete config ini file
+		//delete config ini file and its image
 		remove(TEST_CONFIG_PATH);
+		RemoveImages();
 
 		m_spPassiveCfg.reset(new (std::nothrow) MsvPassiveConfig());
 		EXPECT_NE(m_spPassiveCfg, nullptr);
@@ -104,8 +128,27 @@ public:
 		m_spPassiveCfg.reset();
 		m_spConfigKeyMap.reset();
 
-		//delete config ini file
+		//delete config ini file and its image
 		remove(TEST_CONFIG_PATH);
+		RemoveImages();
+	}
+
+	void RemoveImages()
+	{
+		//images are versioned (image path with version suffix)
+		std::vector<std::filesystem::path> images;
+		for (std::filesystem::directory_iterator it("."); it != std::filesystem::directory_iterator(); ++it)
+		{
+			if (it->path().filename().string().compare(0, strlen(TEST_CONFIG_IMAGE_PATH), TEST_CONFIG_IMAGE_PATH) == 0)
+			{
+				images.push_back(it->path());
+			}
+		}
+
+		for (std::vector<std::filesystem::path>::const_iterator it = images.begin(); it != images.end(); ++it)
+		{
+			std::filesystem::remove(*it);
+		}
 	}
 
 	void CreateConfigIniFile()
@@ -199,6 +242,15 @@ public:
 TEST_F(MsvPassiveConfig_Integration, ItShouldFailedWhenIniFileDoesNotExists)
 {
 	EXPECT_EQ(m_spPassiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_PARSE_ERROR);
+	EXPECT_EQ(m_spPassiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_PARSE_ERROR);
+
+	//failed initialization can be retried
+	CreateConfigIniFile();
+	EXPECT_EQ(m_spPassiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+
+	bool testBool1;
+	EXPECT_EQ(m_spPassiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1), testBool1), MSV_SUCCESS);
+	EXPECT_EQ(testBool1, true);
 }
 
 TEST_F(MsvPassiveConfig_Integration, ItShouldSuccededWhenAlreadyInitialized)
@@ -366,4 +418,670 @@ TEST_F(MsvPassiveConfig_Integration, ItShouldReloadValues)
 	EXPECT_EQ(testString2, "ten");
 	EXPECT_EQ(testUnsigned1, 11);
 	EXPECT_EQ(testUnsigned2, 10);
-}
\ No newline at end of file
+}
+
+TEST_F(MsvPassiveConfig_Integration, ItShouldReturnChangedIdsOnReload)
+{
+	CreateConfigIniFile2();
+	EXPECT_EQ(m_spPassiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+
+	//nothing has changed -> no changed ids
+	std::vector<int32_t> changedCfgIds;
+	EXPECT_EQ(m_spPassiveCfg->ReloadConfiguration(changedCfgIds), MSV_SUCCESS);
+	EXPECT_TRUE(changedCfgIds.empty());
+
+	//group 1 and group 2 values has been swapped -> all ids has changed
+	CreateConfigIniFile3();
+	EXPECT_EQ(m_spPassiveCfg->ReloadConfiguration(changedCfgIds), MSV_SUCCESS);
+	EXPECT_EQ(changedCfgIds.size(), 10);
+
+	//group 2 has been removed -> default values are used for group 2, group 1 is the same as in previous file
+	CreateConfigIniFile();
+	EXPECT_EQ(m_spPassiveCfg->ReloadConfiguration(changedCfgIds), MSV_SUCCESS);
+	EXPECT_EQ(changedCfgIds, std::vector<int32_t>({ static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1), static_cast<int32_t>(ConfigId::MSV_TEST_DOUBLE_1), static_cast<int32_t>(ConfigId::MSV_TEST_DOUBLE_2), static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_2), static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1), static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2), static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_2) }));
+}
+
+TEST_F(MsvPassiveConfig_Integration, ItShouldNotifyChangedValuesOnReload)
+{
+	std::shared_ptr<MsvPassiveConfigCallback_Mock> spCallback(new (std::nothrow) MsvPassiveConfigCallback_Mock());
+	EXPECT_NE(spCallback, nullptr);
+	EXPECT_EQ(m_spPassiveCfg->RegisterCallback(spCallback), MSV_SUCCESS);
+	EXPECT_EQ(m_spPassiveCfg->RegisterCallback(spCallback), MSV_ALREADY_REGISTERED_INFO);
+
+	//initial load and reload without changes are not notified
+	EXPECT_CALL(*spCallback, OnConfigurationChanged(_)).Times(0);
+	CreateConfigIniFile2();
+	EXPECT_EQ(m_spPassiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+	EXPECT_EQ(m_spPassiveCfg->ReloadConfiguration(), MSV_SUCCESS);
+	Mock::VerifyAndClearExpectations(spCallback.get());
+
+	//group 2 has been removed -> default values are used for group 2
+	std::vector<MsvConfigValueChange> changes;
+	EXPECT_CALL(*spCallback, OnConfigurationChanged(_)).WillOnce(SaveArg<0>(&changes));
+	CreateConfigIniFile();
+	EXPECT_EQ(m_spPassiveCfg->ReloadConfiguration(), MSV_SUCCESS);
+	Mock::VerifyAndClearExpectations(spCallback.get());
+
+	ASSERT_EQ(changes.size(), 5);
+	EXPECT_EQ(changes[0].m_cfgId, static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_2));
+	EXPECT_EQ(std::get<bool>(changes[0].m_oldValue), false);
+	EXPECT_EQ(std::get<bool>(changes[0].m_newValue), true);
+	EXPECT_EQ(changes[1].m_cfgId, static_cast<int32_t>(ConfigId::MSV_TEST_DOUBLE_2));
+	EXPECT_EQ(std::get<double>(changes[1].m_oldValue), 11.1);
+	EXPECT_EQ(std::get<double>(changes[1].m_newValue), 1.1);
+	EXPECT_EQ(changes[2].m_cfgId, static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_2));
+	EXPECT_EQ(std::get<int64_t>(changes[2].m_oldValue), 11);
+	EXPECT_EQ(std::get<int64_t>(changes[2].m_newValue), 1);
+	EXPECT_EQ(changes[3].m_cfgId, static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2));
+	EXPECT_EQ(std::get<std::string>(changes[3].m_oldValue), "eleven");
+	EXPECT_EQ(std::get<std::string>(changes[3].m_newValue), "one");
+	EXPECT_EQ(changes[4].m_cfgId, static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_2));
+	EXPECT_EQ(std::get<uint64_t>(changes[4].m_oldValue), 11);
+	EXPECT_EQ(std::get<uint64_t>(changes[4].m_newValue), 1);
+
+	//unregistered callback is not notified
+	EXPECT_EQ(m_spPassiveCfg->UnregisterCallback(spCallback), MSV_SUCCESS);
+	EXPECT_CALL(*spCallback, OnConfigurationChanged(_)).Times(0);
+	CreateConfigIniFile3();
+	EXPECT_EQ(m_spPassiveCfg->ReloadConfiguration(), MSV_SUCCESS);
+}
+
+TEST_F(MsvPassiveConfig_Integration, MappedConfigShouldNotifyChangedValuesOnReload)
+{
+	CreateConfigIniFile2();
+	std::shared_ptr<MsvPassiveConfigMapped> spMappedCfg(new (std::nothrow) MsvPassiveConfigMapped());
+	EXPECT_NE(spMappedCfg, nullptr);
+	EXPECT_EQ(spMappedCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+
+	std::shared_ptr<MsvPassiveConfigCallback_Mock> spCallback(new (std::nothrow) MsvPassiveConfigCallback_Mock());
+	EXPECT_NE(spCallback, nullptr);
+	EXPECT_EQ(spMappedCfg->RegisterCallback(spCallback), MSV_SUCCESS);
+
+	std::vector<MsvConfigValueChange> changes;
+	EXPECT_CALL(*spCallback, OnConfigurationChanged(_)).WillOnce(SaveArg<0>(&changes));
+	CreateConfigIniFile();
+	EXPECT_EQ(spMappedCfg->ReloadConfiguration(), MSV_SUCCESS);
+
+	ASSERT_EQ(changes.size(), 5);
+	EXPECT_EQ(changes[3].m_cfgId, static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2));
+	EXPECT_EQ(std::get<std::string>(changes[3].m_oldValue), "eleven");
+	EXPECT_EQ(std::get<std::string>(changes[3].m_newValue), "one");
+}
+
+TEST_F(MsvPassiveConfig_Integration, MappedConfigShouldFailedWhenIniFileDoesNotExists)
+{
+	std::shared_ptr<MsvPassiveConfigMapped> spMappedCfg(new (std::nothrow) MsvPassiveConfigMapped());
+	EXPECT_NE(spMappedCfg, nullptr);
+	EXPECT_EQ(spMappedCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_PARSE_ERROR);
+	EXPECT_EQ(spMappedCfg->ReloadConfiguration(), MSV_NOT_INITIALIZED_ERROR);
+}
+
+TEST_F(MsvPassiveConfig_Integration, MappedConfigShouldReturnValuesFromImage)
+{
+	CreateConfigIniFile2();
+	std::shared_ptr<MsvPassiveConfigMapped> spMappedCfg(new (std::nothrow) MsvPassiveConfigMapped());
+	EXPECT_NE(spMappedCfg, nullptr);
+	EXPECT_EQ(spMappedCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+
+	//image has been compiled -> another config should map it
+	std::string imagePath;
+	EXPECT_EQ(spMappedCfg->GetMappedImagePath(imagePath), MSV_SUCCESS);
+	EXPECT_EQ(imagePath.compare(0, strlen(TEST_CONFIG_IMAGE_PATH), TEST_CONFIG_IMAGE_PATH), 0);
+	std::ifstream imageFile(imagePath);
+	EXPECT_TRUE(imageFile.good());
+	imageFile.close();
+
+	std::shared_ptr<MsvPassiveConfigMapped> spMappedCfg2(new (std::nothrow) MsvPassiveConfigMapped());
+	EXPECT_NE(spMappedCfg2, nullptr);
+	EXPECT_EQ(spMappedCfg2->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+
+	bool testBool1, testBool2;
+	EXPECT_EQ(spMappedCfg2->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1), testBool1), MSV_SUCCESS);
+	EXPECT_EQ(spMappedCfg2->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_2), testBool2), MSV_SUCCESS);
+
+	double testDouble1, testDouble2;
+	EXPECT_EQ(spMappedCfg2->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_DOUBLE_1), testDouble1), MSV_SUCCESS);
+	EXPECT_EQ(spMappedCfg2->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_DOUBLE_2), testDouble2), MSV_SUCCESS);
+
+	int64_t testInteger1, testInteger2;
+	EXPECT_EQ(spMappedCfg2->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), testInteger1), MSV_SUCCESS);
+	EXPECT_EQ(spMappedCfg2->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_2), testInteger2), MSV_SUCCESS);
+
+	std::string testString1;
+	const char* testString2;
+	EXPECT_EQ(spMappedCfg2->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1), testString1), MSV_SUCCESS);
+	EXPECT_EQ(spMappedCfg2->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2), testString2), MSV_SUCCESS);
+
+	uint64_t testUnsigned1, testUnsigned2;
+	EXPECT_EQ(spMappedCfg2->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_1), testUnsigned1), MSV_SUCCESS);
+	EXPECT_EQ(spMappedCfg2->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_2), testUnsigned2), MSV_SUCCESS);
+
+	EXPECT_EQ(testBool1, true);
+	EXPECT_EQ(testBool2, false);
+	EXPECT_EQ(testDouble1, 10.0);
+	EXPECT_EQ(testDouble2, 11.1);
+	EXPECT_EQ(testInteger1, 10);
+	EXPECT_EQ(testInteger2, 11);
+	EXPECT_EQ(testString1, "ten");
+	EXPECT_STREQ(testString2, "eleven");
+	EXPECT_EQ(testUnsigned1, 10);
+	EXPECT_EQ(testUnsigned2, 11);
+
+	//wrong type and unknown config ID
+	EXPECT_EQ(spMappedCfg2->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1), testInteger1), MSV_NOT_FOUND_ERROR);
+	EXPECT_EQ(spMappedCfg2->GetValue(1000, testBool1), MSV_NOT_FOUND_ERROR);
+}
+
+TEST_F(MsvPassiveConfig_Integration, MappedConfigShouldRecompileStaleOrCorruptedImage)
+{
+	CreateConfigIniFile2();
+	std::shared_ptr<MsvPassiveConfigMapped> spMappedCfg(new (std::nothrow) MsvPassiveConfigMapped());
+	EXPECT_NE(spMappedCfg, nullptr);
+	EXPECT_EQ(spMappedCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+
+	//config file has not changed -> image is up to date
+	std::vector<int32_t> changedCfgIds;
+	EXPECT_EQ(spMappedCfg->ReloadConfiguration(changedCfgIds), MSV_SUCCESS);
+	EXPECT_TRUE(changedCfgIds.empty());
+
+	//config file has changed -> image is stale
+	CreateConfigIniFile3();
+	EXPECT_EQ(spMappedCfg->ReloadConfiguration(changedCfgIds), MSV_SUCCESS);
+	EXPECT_EQ(changedCfgIds.size(), 10);
+
+	//corrupt image (keep its size) -> it should be compiled again
+	std::string imagePath;
+	EXPECT_EQ(spMappedCfg->GetMappedImagePath(imagePath), MSV_SUCCESS);
+	std::fstream imageFile(imagePath, std::fstream::in | std::fstream::out | std::fstream::binary);
+	imageFile.seekp(-2, std::fstream::end);
+	imageFile.put('x');
+	imageFile.close();
+
+	std::shared_ptr<MsvPassiveConfigMapped> spMappedCfg2(new (std::nothrow) MsvPassiveConfigMapped());
+	EXPECT_NE(spMappedCfg2, nullptr);
+	EXPECT_EQ(spMappedCfg2->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+
+	std::string testString1;
+	EXPECT_EQ(spMappedCfg2->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_1), testString1), MSV_SUCCESS);
+	EXPECT_EQ(testString1, "eleven");
+}
+
+TEST_F(MsvPassiveConfig_Integration, MappedConfigShouldMapNewImageVersionOnReload)
+{
+	CreateConfigIniFile2();
+	std::shared_ptr<MsvPassiveConfigMapped> spMappedCfg(new (std::nothrow) MsvPassiveConfigMapped());
+	std::shared_ptr<MsvPassiveConfigMapped> spMappedCfg2(new (std::nothrow) MsvPassiveConfigMapped());
+	EXPECT_NE(spMappedCfg, nullptr);
+	EXPECT_NE(spMappedCfg2, nullptr);
+	EXPECT_EQ(spMappedCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+	EXPECT_EQ(spMappedCfg2->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+
+	//both configs map the same image
+	std::string oldImagePath, imagePath, imagePath2;
+	EXPECT_EQ(spMappedCfg->GetMappedImagePath(oldImagePath), MSV_SUCCESS);
+	EXPECT_EQ(spMappedCfg2->GetMappedImagePath(imagePath2), MSV_SUCCESS);
+	EXPECT_EQ(imagePath2, oldImagePath);
+
+	//changed config is compiled to new image (mapped image is not replaced)
+	std::string testString2;
+	CreateConfigIniFile();
+	EXPECT_EQ(spMappedCfg->ReloadConfiguration(), MSV_SUCCESS);
+	EXPECT_EQ(spMappedCfg->GetMappedImagePath(imagePath), MSV_SUCCESS);
+	EXPECT_NE(imagePath, oldImagePath);
+	EXPECT_EQ(spMappedCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2), testString2), MSV_SUCCESS);
+	EXPECT_EQ(testString2, "one");
+
+	//other config still reads its image until it reloads
+	const char* pTestString2;
+	EXPECT_EQ(spMappedCfg2->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2), pTestString2), MSV_SUCCESS);
+	EXPECT_STREQ(pTestString2, "eleven");
+	EXPECT_EQ(spMappedCfg2->ReloadConfiguration(), MSV_SUCCESS);
+	EXPECT_EQ(spMappedCfg2->GetMappedImagePath(imagePath2), MSV_SUCCESS);
+	EXPECT_EQ(imagePath2, imagePath);
+	EXPECT_EQ(spMappedCfg2->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2), testString2), MSV_SUCCESS);
+	EXPECT_EQ(testString2, "one");
+
+	//old image is not used anymore -> it has been removed
+	std::ifstream oldImageFile(oldImagePath);
+	EXPECT_FALSE(oldImageFile.good());
+}
+
+TEST_F(MsvPassiveConfig_Integration, MappedConfigShouldKeepReturnedStringsValidAfterReload)
+{
+	CreateConfigIniFile2();
+	std::shared_ptr<MsvPassiveConfigMapped> spMappedCfg(new (std::nothrow) MsvPassiveConfigMapped());
+	EXPECT_NE(spMappedCfg, nullptr);
+	EXPECT_EQ(spMappedCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+
+	const char* pOldString2;
+	EXPECT_EQ(spMappedCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2), pOldString2), MSV_SUCCESS);
+	EXPECT_STREQ(pOldString2, "eleven");
+
+	//new version is mapped, old image is retired (still mapped)
+	const char* pTestString2;
+	CreateConfigIniFile();
+	EXPECT_EQ(spMappedCfg->ReloadConfiguration(), MSV_SUCCESS);
+	EXPECT_EQ(spMappedCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2), pTestString2), MSV_SUCCESS);
+	EXPECT_STREQ(pTestString2, "one");
+	EXPECT_STREQ(pOldString2, "eleven");
+
+	//reload of the same version keeps current image
+	const char* pSameString2;
+	EXPECT_EQ(spMappedCfg->ReloadConfiguration(), MSV_SUCCESS);
+	EXPECT_EQ(spMappedCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2), pSameString2), MSV_SUCCESS);
+	EXPECT_EQ(pSameString2, pTestString2);
+}
+
+TEST_F(MsvPassiveConfig_Integration, MappedConfigShouldRemoveStaleImagesOnInitialize)
+{
+	CreateConfigIniFile();
+
+	//image of old version left by killed process and unrelated file with similar name
+	std::string staleImagePath = std::string(TEST_CONFIG_IMAGE_PATH) + ".0123456789abcdef";
+	std::string otherFilePath = std::string(TEST_CONFIG_IMAGE_PATH) + ".backup";
+	std::ofstream staleImageFile(staleImagePath, std::ofstream::out | std::ofstream::trunc);
+	staleImageFile << "stale";
+	staleImageFile.close();
+	std::ofstream otherFile(otherFilePath, std::ofstream::out | std::ofstream::trunc);
+	otherFile << "other";
+	otherFile.close();
+
+	std::shared_ptr<MsvPassiveConfigMapped> spMappedCfg(new (std::nothrow) MsvPassiveConfigMapped());
+	EXPECT_NE(spMappedCfg, nullptr);
+	EXPECT_EQ(spMappedCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+
+	std::string imagePath;
+	EXPECT_EQ(spMappedCfg->GetMappedImagePath(imagePath), MSV_SUCCESS);
+	EXPECT_TRUE(std::filesystem::exists(imagePath));
+	EXPECT_FALSE(std::filesystem::exists(staleImagePath));
+	EXPECT_TRUE(std::filesystem::exists(otherFilePath));
+}
+
+TEST_F(MsvPassiveConfig_Integration, LayeredConfigShouldResolvePrecedence)
+{
+	CreateConfigIniFile();
+
+#ifdef _WIN32
+	_putenv_s("MSVTEST_GROUP_1_INT64_T_VALUE", "20");
+	_putenv_s("MSVTEST_GROUP_2_STRING_VALUE", "env");
+#else
+	setenv("MSVTEST_GROUP_1_INT64_T_VALUE", "20", 1);
+	setenv("MSVTEST_GROUP_2_STRING_VALUE", "env", 1);
+#endif
+
+	const char* argv[] = { "test", "--GROUP_1.int64_t_value=30", "--group_2.uint64_t_value=31", "other" };
+
+	std::shared_ptr<MsvPassiveConfigLayered> spLayeredCfg(new (std::nothrow) MsvPassiveConfigLayered());
+	EXPECT_NE(spLayeredCfg, nullptr);
+	EXPECT_EQ(spLayeredCfg->AddSource(std::shared_ptr<IMsvPassiveConfigSource>(new (std::nothrow) MsvPassiveConfigEnvSource("MSVTEST_"))), MSV_SUCCESS);
+	EXPECT_EQ(spLayeredCfg->AddSource(std::shared_ptr<IMsvPassiveConfigSource>(new (std::nothrow) MsvPassiveConfigArgsSource(4, argv))), MSV_SUCCESS);
+	EXPECT_EQ(spLayeredCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+
+	bool testBool1;
+	double testDouble2;
+	int64_t testInteger1;
+	std::string testString2;
+	uint64_t testUnsigned2;
+	EXPECT_EQ(spLayeredCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1), testBool1), MSV_SUCCESS);
+	EXPECT_EQ(spLayeredCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_DOUBLE_2), testDouble2), MSV_SUCCESS);
+	EXPECT_EQ(spLayeredCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), testInteger1), MSV_SUCCESS);
+	EXPECT_EQ(spLayeredCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2), testString2), MSV_SUCCESS);
+	EXPECT_EQ(spLayeredCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_UNSIGNED_2), testUnsigned2), MSV_SUCCESS);
+
+	EXPECT_EQ(testBool1, true);
+	EXPECT_EQ(testDouble2, 1.1);
+	EXPECT_EQ(testInteger1, 30);
+	EXPECT_EQ(testString2, "env");
+	EXPECT_EQ(testUnsigned2, 31);
+
+	std::string source;
+	EXPECT_EQ(spLayeredCfg->GetValueSource(static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_1), source), MSV_SUCCESS);
+	EXPECT_EQ(source, std::string("ini:") + TEST_CONFIG_PATH);
+	EXPECT_EQ(spLayeredCfg->GetValueSource(static_cast<int32_t>(ConfigId::MSV_TEST_DOUBLE_2), source), MSV_SUCCESS);
+	EXPECT_EQ(source, "default");
+	EXPECT_EQ(spLayeredCfg->GetValueSource(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), source), MSV_SUCCESS);
+	EXPECT_EQ(source, "cmdline");
+	EXPECT_EQ(spLayeredCfg->GetValueSource(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2), source), MSV_SUCCESS);
+	EXPECT_EQ(source, "env");
+	EXPECT_EQ(spLayeredCfg->GetValueSource(1000, source), MSV_NOT_FOUND_ERROR);
+
+#ifdef _WIN32
+	_putenv_s("MSVTEST_GROUP_1_INT64_T_VALUE", "");
+	_putenv_s("MSVTEST_GROUP_2_STRING_VALUE", "");
+#else
+	unsetenv("MSVTEST_GROUP_1_INT64_T_VALUE");
+	unsetenv("MSVTEST_GROUP_2_STRING_VALUE");
+#endif
+}
+
+TEST_F(MsvPassiveConfig_Integration, LayeredConfigShouldFailedWhenValueIsInvalid)
+{
+	CreateConfigIniFile();
+
+	const char* argv[] = { "test", "--GROUP_2.bool_value=maybe" };
+
+	std::shared_ptr<MsvPassiveConfigLayered> spLayeredCfg(new (std::nothrow) MsvPassiveConfigLayered());
+	EXPECT_NE(spLayeredCfg, nullptr);
+	EXPECT_EQ(spLayeredCfg->AddSource(std::shared_ptr<IMsvPassiveConfigSource>(new (std::nothrow) MsvPassiveConfigArgsSource(2, argv))), MSV_SUCCESS);
+	EXPECT_EQ(spLayeredCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_INVALID_DATA_ERROR);
+
+	int32_t lineNumberWithError;
+	int32_t cfgIdWithError;
+	spLayeredCfg->ReadFailedData(lineNumberWithError, cfgIdWithError);
+	EXPECT_EQ(cfgIdWithError, static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_2));
+}
+
+TEST_F(MsvPassiveConfig_Integration, ScalarReadsShouldBeConsistentDuringReload)
+{
+	CreateConfigIniFile2();
+	EXPECT_EQ(m_spPassiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+
+	std::atomic<bool> stop(false);
+	std::atomic<int32_t> failures(0);
+	std::vector<std::thread> readers;
+
+	for (int32_t i = 0; i < 4; ++i)
+	{
+		readers.emplace_back([this, &stop, &failures]()
+		{
+			while (!stop.load())
+			{
+				int64_t testInteger1;
+				double testDouble2;
+				if (m_spPassiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), testInteger1) != MSV_SUCCESS || (testInteger1 != 10 && testInteger1 != 11)
+					|| m_spPassiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_DOUBLE_2), testDouble2) != MSV_SUCCESS || (testDouble2 != 10.0 && testDouble2 != 11.1))
+				{
+					++failures;
+				}
+			}
+		});
+	}
+
+	//swap values between two files while readers are running
+	for (int32_t i = 0; i < 50; ++i)
+	{
+		if (i % 2)
+		{
+			CreateConfigIniFile2();
+		}
+		else
+		{
+			CreateConfigIniFile3();
+		}
+
+		EXPECT_EQ(m_spPassiveCfg->ReloadConfiguration(), MSV_SUCCESS);
+	}
+
+	stop.store(true);
+	for (std::thread& reader : readers)
+	{
+		reader.join();
+	}
+
+	EXPECT_EQ(failures.load(), 0);
+}
+
+//benchmark (run with --gtest_also_run_disabled_tests), read throughput should scale linearly with threads
+TEST_F(MsvPassiveConfig_Integration, DISABLED_ScalarReadThroughputShouldScaleWithThreads)
+{
+	CreateConfigIniFile();
+	EXPECT_EQ(m_spPassiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+
+	const int64_t readsPerThread = 10000000;
+	uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	double singleThreadThroughput = 0.0;
+
+	for (uint32_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+	{
+		std::vector<std::thread> readers;
+		std::atomic<int64_t> checksum(0);
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < threadCount; ++i)
+		{
+			readers.emplace_back([this, readsPerThread, &checksum]()
+			{
+				int64_t sum = 0;
+				for (int64_t j = 0; j < readsPerThread; ++j)
+				{
+					int64_t testInteger1;
+					m_spPassiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), testInteger1);
+					sum += testInteger1;
+				}
+				checksum += sum;
+			});
+		}
+
+		for (std::thread& reader : readers)
+		{
+			reader.join();
+		}
+		std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+		EXPECT_EQ(checksum.load(), 10 * readsPerThread * threadCount);
+
+		double throughput = static_cast<double>(readsPerThread * threadCount) / duration.count();
+		if (threadCount == 1)
+		{
+			singleThreadThroughput = throughput;
+		}
+
+		std::cout << "threads: " << threadCount << ", reads/s: " << static_cast<int64_t>(throughput) << ", scaling: " << throughput / singleThreadThroughput << std::endl;
+	}
+}
+
+#ifdef __linux__
+
+TEST_F(MsvPassiveConfig_Integration, WatcherShouldReloadReplacedFile)
+{
+	CreateConfigIniFile2();
+	EXPECT_EQ(m_spPassiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+
+	std::promise<std::vector<int32_t>> reloaded;
+	std::shared_ptr<MsvPassiveConfigWatcherCallback_Mock> spCallback(new (std::nothrow) MsvPassiveConfigWatcherCallback_Mock());
+	EXPECT_NE(spCallback, nullptr);
+	EXPECT_CALL(*spCallback, OnConfigurationReloaded(MSV_SUCCESS, _)).WillOnce(Invoke([&reloaded](MsvErrorCode, const std::vector<int32_t>& changedCfgIds) { reloaded.set_value(changedCfgIds); }));
+
+	MsvPassiveConfigWatcher watcher(m_spLogger);
+	EXPECT_EQ(watcher.Initialize(m_spPassiveCfg, TEST_CONFIG_PATH, spCallback), MSV_SUCCESS);
+
+	//write new file aside and rename it over the watched one (atomic replace)
+	std::string tempPath = std::string(TEST_CONFIG_PATH) + ".tmp";
+	std::ofstream iniConfigFile(tempPath, std::ofstream::out | std::ofstream::trunc);
+	iniConfigFile << "[" << TEST_CONFIG_GROUP1 << "]" << std::endl;
+	iniConfigFile << TEST_CONFIG_BOOLVAL << "=" << true << std::endl;
+	iniConfigFile << TEST_CONFIG_DOUBLEVAL << "=" << 10.0 << std::endl;
+	iniConfigFile << TEST_CONFIG_INT64VAL << "=" << 12 << std::endl;
+	iniConfigFile << TEST_CONFIG_STRINGVAL << "=" << "ten" << std::endl;
+	iniConfigFile << TEST_CONFIG_UINT64VAL << "=" << 10 << std::endl;
+	iniConfigFile << "[" << TEST_CONFIG_GROUP2 << "]" << std::endl;
+	iniConfigFile << TEST_CONFIG_BOOLVAL << "=" << false << std::endl;
+	iniConfigFile << TEST_CONFIG_DOUBLEVAL << "=" << 11.1 << std::endl;
+	iniConfigFile << TEST_CONFIG_INT64VAL << "=" << 11 << std::endl;
+	iniConfigFile << TEST_CONFIG_STRINGVAL << "=" << "eleven" << std::endl;
+	iniConfigFile << TEST_CONFIG_UINT64VAL << "=" << 11 << std::endl;
+	iniConfigFile.close();
+	EXPECT_EQ(rename(tempPath.c_str(), TEST_CONFIG_PATH), 0);
+
+	std::future<std::vector<int32_t>> changed = reloaded.get_future();
+	ASSERT_EQ(changed.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+	EXPECT_EQ(changed.get(), std::vector<int32_t>({ static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1) }));
+
+	int64_t testInteger1;
+	EXPECT_EQ(m_spPassiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), testInteger1), MSV_SUCCESS);
+	EXPECT_EQ(testInteger1, 12);
+
+	EXPECT_EQ(watcher.Uninitialize(), MSV_SUCCESS);
+}
+
+TEST_F(MsvPassiveConfig_Integration, WatcherShouldReportLostDirectoryAndWatchItAgain)
+{
+	//config file in own directory (directory is removed by test)
+	std::string directory = "watched_config_directory";
+	std::string configPath = directory + "/" + TEST_CONFIG_PATH;
+	std::error_code fsError;
+	std::filesystem::remove_all(directory, fsError);
+	EXPECT_TRUE(std::filesystem::create_directory(directory, fsError));
+	CreateConfigIniFile2();
+	EXPECT_TRUE(std::filesystem::copy_file(TEST_CONFIG_PATH, configPath, fsError));
+	EXPECT_EQ(m_spPassiveCfg->Initialize(m_spConfigKeyMap, configPath.c_str()), MSV_SUCCESS);
+
+	MsvPassiveConfigWatcher watcher(m_spLogger);
+	std::promise<MsvErrorCode> lost;
+	std::promise<std::vector<int32_t>> reloaded;
+	std::shared_ptr<MsvPassiveConfigWatcherCallback_Mock> spCallback(new (std::nothrow) MsvPassiveConfigWatcherCallback_Mock());
+	EXPECT_NE(spCallback, nullptr);
+	EXPECT_CALL(*spCallback, OnConfigurationReloaded(MSV_OPEN_ERROR, _)).WillOnce(Invoke([&lost, &watcher](MsvErrorCode, const std::vector<int32_t>&) { lost.set_value(watcher.Uninitialize()); }));
+	EXPECT_CALL(*spCallback, OnConfigurationReloaded(MSV_SUCCESS, _)).WillOnce(Invoke([&reloaded](MsvErrorCode, const std::vector<int32_t>& changedCfgIds) { reloaded.set_value(changedCfgIds); }));
+	EXPECT_EQ(watcher.Initialize(m_spPassiveCfg, configPath.c_str(), spCallback), MSV_SUCCESS);
+
+	//removed directory is reported (watcher can not be uninitialized from its callback)
+	std::filesystem::remove_all(directory, fsError);
+	std::future<MsvErrorCode> lostResult = lost.get_future();
+	ASSERT_EQ(lostResult.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+	EXPECT_EQ(lostResult.get(), MSV_BUSY_ERROR);
+	EXPECT_TRUE(watcher.Initialized());
+
+	//directory is watched again when it exists
+	EXPECT_TRUE(std::filesystem::create_directory(directory, fsError));
+	CreateConfigIniFile();
+	EXPECT_TRUE(std::filesystem::copy_file(TEST_CONFIG_PATH, configPath, fsError));
+
+	std::future<std::vector<int32_t>> changed = reloaded.get_future();
+	ASSERT_EQ(changed.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+	EXPECT_FALSE(changed.get().empty());
+
+	int64_t testInteger1;
+	EXPECT_EQ(m_spPassiveCfg->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_1), testInteger1), MSV_SUCCESS);
+	EXPECT_EQ(testInteger1, 10);
+
+	EXPECT_EQ(watcher.Uninitialize(), MSV_SUCCESS);
+	std::filesystem::remove_all(directory, fsError);
+}
+
+#endif // __linux__
+
+TEST_F(MsvPassiveConfig_Integration, BindingShouldMirrorReloadedValuesIntoStruct)
+{
+	struct MsvTestSettings
+	{
+		bool m_bool = false;
+		int64_t m_integer = 0;
+		std::string m_string;
+	};
+
+	MsvPassiveConfigBinding<MsvTestSettings> binding(m_spLogger);
+	EXPECT_EQ(binding.Bind(static_cast<int32_t>(ConfigId::MSV_TEST_BOOL_2), &MsvTestSettings::m_bool), MSV_SUCCESS);
+	EXPECT_EQ(binding.Bind(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_2), &MsvTestSettings::m_integer), MSV_SUCCESS);
+	EXPECT_EQ(binding.Bind(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2), &MsvTestSettings::m_string), MSV_SUCCESS);
+
+	//config is not initialized -> values can not be loaded
+	EXPECT_EQ(binding.Attach(m_spPassiveCfg), MSV_NOT_INITIALIZED_ERROR);
+
+	CreateConfigIniFile2();
+	EXPECT_EQ(m_spPassiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+	EXPECT_EQ(binding.Attach(m_spPassiveCfg), MSV_SUCCESS);
+
+	std::shared_ptr<const MsvTestSettings> spSettings = binding.Get();
+	EXPECT_EQ(spSettings->m_bool, false);
+	EXPECT_EQ(spSettings->m_integer, 11);
+	EXPECT_EQ(spSettings->m_string, "eleven");
+
+	//all changes of reload are applied together
+	CreateConfigIniFile();
+	EXPECT_EQ(m_spPassiveCfg->ReloadConfiguration(), MSV_SUCCESS);
+
+	std::shared_ptr<const MsvTestSettings> spNewSettings = binding.Get();
+	EXPECT_EQ(spNewSettings->m_bool, true);
+	EXPECT_EQ(spNewSettings->m_integer, 1);
+	EXPECT_EQ(spNewSettings->m_string, "one");
+	EXPECT_EQ(spSettings->m_integer, 11);
+
+	EXPECT_EQ(binding.Detach(), MSV_SUCCESS);
+}
+
+TEST_F(MsvPassiveConfig_Integration, SnapshotShouldKeepValuesOfOneReload)
+{
+	std::shared_ptr<MsvPassiveConfigMapped> spMappedCfg(new (std::nothrow) MsvPassiveConfigMapped());
+	EXPECT_NE(spMappedCfg, nullptr);
+
+	std::shared_ptr<const MsvConfigSnapshot> spSnapshot;
+	EXPECT_EQ(m_spPassiveCfg->GetSnapshot(spSnapshot), MSV_NOT_INITIALIZED_ERROR);
+	EXPECT_EQ(spMappedCfg->GetSnapshot(spSnapshot), MSV_NOT_INITIALIZED_ERROR);
+
+	CreateConfigIniFile2();
+	EXPECT_EQ(m_spPassiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+	EXPECT_EQ(spMappedCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+
+	std::vector<std::shared_ptr<IMsvPassiveConfig>> configs({ m_spPassiveCfg, spMappedCfg });
+	std::vector<std::shared_ptr<const MsvConfigSnapshot>> snapshots;
+	for (std::vector<std::shared_ptr<IMsvPassiveConfig>>::iterator it = configs.begin(); it != configs.end(); ++it)
+	{
+		EXPECT_EQ((*it)->GetSnapshot(spSnapshot), MSV_SUCCESS);
+		ASSERT_TRUE(spSnapshot != nullptr);
+		snapshots.push_back(spSnapshot);
+
+		//nothing has changed -> snapshot is cached
+		EXPECT_EQ((*it)->ReloadConfiguration(), MSV_SUCCESS);
+		std::shared_ptr<const MsvConfigSnapshot> spSameSnapshot;
+		EXPECT_EQ((*it)->GetSnapshot(spSameSnapshot), MSV_SUCCESS);
+		EXPECT_EQ(spSameSnapshot, spSnapshot);
+	}
+
+	CreateConfigIniFile();
+	for (size_t i = 0; i < configs.size(); ++i)
+	{
+		EXPECT_EQ(configs[i]->ReloadConfiguration(), MSV_SUCCESS);
+
+		//taken snapshot keeps all values of previous reload
+		int64_t value = 0;
+		std::string stringValue;
+		EXPECT_EQ(snapshots[i]->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_2), value), MSV_SUCCESS);
+		EXPECT_EQ(value, 11);
+		EXPECT_EQ(snapshots[i]->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2), stringValue), MSV_SUCCESS);
+		EXPECT_EQ(stringValue, "eleven");
+		EXPECT_EQ(snapshots[i]->GetValue(1000, value), MSV_NOT_FOUND_ERROR);
+
+		EXPECT_EQ(configs[i]->GetSnapshot(spSnapshot), MSV_SUCCESS);
+		EXPECT_NE(spSnapshot, snapshots[i]);
+		EXPECT_EQ(spSnapshot->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_INTEGER_2), value), MSV_SUCCESS);
+		EXPECT_EQ(value, 1);
+		EXPECT_EQ(spSnapshot->GetValue(static_cast<int32_t>(ConfigId::MSV_TEST_STRING_2), stringValue), MSV_SUCCESS);
+		EXPECT_EQ(stringValue, "one");
+	}
+}
+
+#ifdef __linux__
+
+TEST_F(MsvPassiveConfig_Integration, NotificationHandleShouldSignalReloadedChanges)
+{
+	CreateConfigIniFile2();
+	EXPECT_EQ(m_spPassiveCfg->Initialize(m_spConfigKeyMap, TEST_CONFIG_PATH), MSV_SUCCESS);
+
+	int handle = -1;
+	EXPECT_EQ(m_spPassiveCfg->GetNotificationHandle(handle), MSV_SUCCESS);
+	pollfd pollHandle = { handle, POLLIN, 0 };
+	EXPECT_EQ(poll(&pollHandle, 1, 0), 0);
+
+	//nothing has changed -> handle is not signaled
+	EXPECT_EQ(m_spPassiveCfg->ReloadConfiguration(), MSV_SUCCESS);
+	EXPECT_EQ(poll(&pollHandle, 1, 0), 0);
+
+	//changes of two reloads are drained at once
+	CreateConfigIniFile3();
+	EXPECT_EQ(m_spPassiveCfg->ReloadConfiguration(), MSV_SUCCESS);
+	CreateConfigIniFile();
+	EXPECT_EQ(m_spPassiveCfg->ReloadConfiguration(), MSV_SUCCESS);
+	EXPECT_EQ(poll(&pollHandle, 1, 0), 1);
+
+	std::vector<int32_t> changedCfgIds;
+	EXPECT_EQ(m_spPassiveCfg->DrainChanges(changedCfgIds), MSV_SUCCESS);
+	EXPECT_EQ(changedCfgIds.size(), 10);
+	EXPECT_TRUE(std::is_sorted(changedCfgIds.begin(), changedCfgIds.end()));
+	EXPECT_EQ(poll(&pollHandle, 1, 0), 0);
+
+	EXPECT_EQ(m_spPassiveCfg->DrainChanges(changedCfgIds), MSV_SUCCESS);
+	EXPECT_TRUE(changedCfgIds.empty());
+}
+
+#endif // __linux__
@@ -0,0 +1,159 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Callback Watchdog
+* @details		Measures time spent in callbacks and attributes it to subscribers.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "MsvCallbackWatchdog.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvCallbackWatchdog::MsvCallbackWatchdog():
+	m_budget(0),
+	m_quarantinedCount(0)
+{
+
+}
+
+
+/********************************************************************************************************************************
+*															MsvCallbackWatchdog public methods
+********************************************************************************************************************************/
+
+
+void MsvCallbackWatchdog::SetBudget(std::chrono::microseconds budget)
+{
+	m_budget.store(budget.count(), std::memory_order_relaxed);
+}
+
+std::chrono::microseconds MsvCallbackWatchdog::GetBudget() const
+{
+	return std::chrono::microseconds(m_budget.load(std::memory_order_relaxed));
+}
+
+bool MsvCallbackWatchdog::Record(const void* pCallback, std::chrono::nanoseconds duration)
+{
+	std::chrono::microseconds budget = GetBudget();
+	bool slow = budget.count() > 0 && duration > budget;
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	std::map<const void*, MsvCallbackReport>::iterator it = m_reports.find(pCallback);
+	if (it == m_reports.end())
+	{
+		it = m_reports.emplace(pCallback, MsvCallbackReport{ pCallback, 0, 0, std::chrono::nanoseconds(0), std::chrono::nanoseconds(0), false }).first;
+	}
+
+	MsvCallbackReport& report = it->second;
+	++report.m_callCount;
+	report.m_totalTime += duration;
+	report.m_maxTime = (std::max)(report.m_maxTime, duration);
+
+	if (slow)
+	{
+		++report.m_slowCallCount;
+	}
+
+	return slow;
+}
+
+void MsvCallbackWatchdog::Quarantine(const void* pCallback)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	MsvCallbackReport& report = m_reports.emplace(pCallback, MsvCallbackReport{ pCallback, 0, 0, std::chrono::nanoseconds(0), std::chrono::nanoseconds(0), false }).first->second;
+	if (!report.m_quarantined)
+	{
+		report.m_quarantined = true;
+		m_quarantinedCount.fetch_add(1, std::memory_order_release);
+	}
+}
+
+bool MsvCallbackWatchdog::Quarantined(const void* pCallback) const
+{
+	//nothing is quarantined in healthy system -> no lock
+	if (m_quarantinedCount.load(std::memory_order_acquire) == 0)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	std::map<const void*, MsvCallbackReport>::const_iterator it = m_reports.find(pCallback);
+
+	return it != m_reports.end() && it->second.m_quarantined;
+}
+
+void MsvCallbackWatchdog::Remove(const void* pCallback)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	std::map<const void*, MsvCallbackReport>::iterator it = m_reports.find(pCallback);
+	if (it == m_reports.end())
+	{
+		return;
+	}
+
+	if (it->second.m_quarantined)
+	{
+		m_quarantinedCount.fetch_sub(1, std::memory_order_release);
+	}
+
+	m_reports.erase(it);
+}
+
+void MsvCallbackWatchdog::GetReport(std::vector<MsvCallbackReport>& report) const
+{
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		report.clear();
+		report.reserve(m_reports.size());
+		for (std::map<const void*, MsvCallbackReport>::const_iterator it = m_reports.begin(); it != m_reports.end(); ++it)
+		{
+			report.push_back(it->second);
+		}
+	}
+
+	std::sort(report.begin(), report.end(), [](const MsvCallbackReport& first, const MsvCallbackReport& second) { return first.m_totalTime > second.m_totalTime; });
+}
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,191 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Callback Watchdog
+* @details		Measures time spent in callbacks and attributes it to subscribers.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_CALLBACKWATCHDOG_H
+#define MARSTECH_CALLBACKWATCHDOG_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Callback Report.
+* @details	Time spent in one subscriber (callback) since it has been registered.
+******************************************************************************************************/
+struct MsvCallbackReport
+{
+	/**************************************************************************************************//**
+	* @brief		Callback.
+	* @details	Address of callback (identification only, it might not be valid anymore).
+	******************************************************************************************************/
+	const void* m_pCallback;
+
+	/**************************************************************************************************//**
+	* @brief		Call count.
+	* @details	Count of measured calls.
+	******************************************************************************************************/
+	uint64_t m_callCount;
+
+	/**************************************************************************************************//**
+	* @brief		Slow call count.
+	* @details	Count of calls which have exceeded budget.
+	******************************************************************************************************/
+	uint64_t m_slowCallCount;
+
+	/**************************************************************************************************//**
+	* @brief		Total time.
+	* @details	Time spent in all measured calls.
+	******************************************************************************************************/
+	std::chrono::nanoseconds m_totalTime;
+
+	/**************************************************************************************************//**
+	* @brief		Maximal time.
+	* @details	Time of the slowest call.
+	******************************************************************************************************/
+	std::chrono::nanoseconds m_maxTime;
+
+	/**************************************************************************************************//**
+	* @brief		Quarantined flag.
+	* @details	Flag if callback has been quarantined (it is called asynchronously) or not.
+	******************************************************************************************************/
+	bool m_quarantined;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Callback Watchdog.
+* @details	Collects duration of callback calls per callback and checks them against budget. Owner measures
+*				calls, reports slow ones and decides about quarantine (watchdog only keeps the flag).
+* @note		It is thread safe.
+******************************************************************************************************/
+class MsvCallbackWatchdog
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	******************************************************************************************************/
+	MsvCallbackWatchdog();
+
+	/**************************************************************************************************//**
+	* @brief			Set budget.
+	* @param[in]	budget		Maximal expected duration of one call (0 -> no budget, only statistics are collected).
+	******************************************************************************************************/
+	void SetBudget(std::chrono::microseconds budget);
+
+	/**************************************************************************************************//**
+	* @brief			Get budget.
+	* @returns		Maximal expected duration of one call (0 -> no budget).
+	******************************************************************************************************/
+	std::chrono::microseconds GetBudget() const;
+
+	/**************************************************************************************************//**
+	* @brief			Record call.
+	* @details		Adds duration of call to statistics of callback.
+	* @param[in]	pCallback		Called callback.
+	* @param[in]	duration			Duration of call.
+	* @retval		true		When call has exceeded budget.
+	* @retval		false		Otherwise.
+	******************************************************************************************************/
+	bool Record(const void* pCallback, std::chrono::nanoseconds duration);
+
+	/**************************************************************************************************//**
+	* @brief			Quarantine callback.
+	* @details		Marks callback as quarantined.
+	* @param[in]	pCallback		Callback to quarantine.
+	******************************************************************************************************/
+	void Quarantine(const void* pCallback);
+
+	/**************************************************************************************************//**
+	* @brief			Quarantined check.
+	* @details		It does not lock when no callback is quarantined.
+	* @param[in]	pCallback		Callback to check.
+	* @retval		true		When callback is quarantined.
+	* @retval		false		Otherwise.
+	******************************************************************************************************/
+	bool Quarantined(const void* pCallback) const;
+
+	/**************************************************************************************************//**
+	* @brief			Remove callback.
+	* @details		Removes statistics and quarantine of callback (it is called when callback is unregistered).
+	* @param[in]	pCallback		Callback to remove.
+	******************************************************************************************************/
+	void Remove(const void* pCallback);
+
+	/**************************************************************************************************//**
+	* @brief			Get report.
+	* @param[out]	report		Statistics of all measured callbacks (sorted by total time, the slowest first).
+	******************************************************************************************************/
+	void GetReport(std::vector<MsvCallbackReport>& report) const;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Watchdog mutex.
+	* @details	Locks statistics.
+	******************************************************************************************************/
+	mutable std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Budget.
+	* @details	Maximal expected duration of one call in microseconds (0 -> no budget).
+	******************************************************************************************************/
+	std::atomic<int64_t> m_budget;
+
+	/**************************************************************************************************//**
+	* @brief		Quarantined count.
+	* @details	Count of quarantined callbacks (quarantine check does not lock when it is zero).
+	******************************************************************************************************/
+	std::atomic<size_t> m_quarantinedCount;
+
+	/**************************************************************************************************//**
+	* @brief		Reports.
+	* @details	Statistics of callbacks.
+	******************************************************************************************************/
+	std::map<const void*, MsvCallbackReport> m_reports;
+};
+
+
+#endif // !MARSTECH_CALLBACKWATCHDOG_H
+
+/** @} */	//End of group MCONFIG.
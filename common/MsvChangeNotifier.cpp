@@ -0,0 +1,186 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Change Notifier
+* @details		Pollable handle (eventfd) signaling pending config changes.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "MsvChangeNotifier.h"
+
+#include "merror/MsvErrorCodes.h"
+
+#ifdef __linux__
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+MSV_ENABLE_WARNINGS
+
+#endif
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvChangeNotifier::MsvChangeNotifier():
+	m_opened(false),
+	m_eventFd(-1)
+{
+
+}
+
+MsvChangeNotifier::~MsvChangeNotifier()
+{
+#ifdef __linux__
+	if (m_eventFd != -1)
+	{
+		close(m_eventFd);
+	}
+#endif
+}
+
+
+/********************************************************************************************************************************
+*															MsvChangeNotifier public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvChangeNotifier::GetHandle(int& handle)
+{
+#ifdef __linux__
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	if (m_eventFd == -1)
+	{
+		//non blocking -> drain never waits (handle is reset by read)
+		m_eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (m_eventFd == -1)
+		{
+			return MSV_OPEN_ERROR;
+		}
+
+		m_opened.store(true, std::memory_order_release);
+	}
+
+	handle = m_eventFd;
+
+	return MSV_SUCCESS;
+#else
+	(void)handle;
+	return MSV_NOT_FOUND_ERROR;
+#endif
+}
+
+void MsvChangeNotifier::Notify(int32_t cfgId)
+{
+	//nobody polls -> nothing to collect (writers do not lock)
+	if (!m_opened.load(std::memory_order_acquire))
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	bool signal = m_pending.empty();
+	m_pending.insert(cfgId);
+
+	if (signal)
+	{
+		SignalHandle();
+	}
+}
+
+void MsvChangeNotifier::Notify(const std::vector<int32_t>& cfgIds)
+{
+	if (cfgIds.empty() || !m_opened.load(std::memory_order_acquire))
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	bool signal = m_pending.empty();
+	m_pending.insert(cfgIds.begin(), cfgIds.end());
+
+	if (signal)
+	{
+		SignalHandle();
+	}
+}
+
+void MsvChangeNotifier::Drain(std::vector<int32_t>& cfgIds)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	cfgIds.assign(m_pending.begin(), m_pending.end());
+
+	if (!m_pending.empty())
+	{
+		ResetHandle();
+		m_pending.clear();
+	}
+}
+
+
+/********************************************************************************************************************************
+*															MsvChangeNotifier protected methods
+********************************************************************************************************************************/
+
+
+void MsvChangeNotifier::SignalHandle()
+{
+#ifdef __linux__
+	//eventfd write of non zero counter never blocks here (counter is reset by each drain)
+	uint64_t counter = 1;
+	if (write(m_eventFd, &counter, sizeof(counter)) != static_cast<ssize_t>(sizeof(counter)))
+	{
+		//handle is not signaled, changes stay pending until next drain
+		return;
+	}
+#endif
+}
+
+void MsvChangeNotifier::ResetHandle()
+{
+#ifdef __linux__
+	//handle is signaled only while changes are pending -> read does not fail with EAGAIN
+	uint64_t counter = 0;
+	if (read(m_eventFd, &counter, sizeof(counter)) != static_cast<ssize_t>(sizeof(counter)))
+	{
+		return;
+	}
+#endif
+}
+
+/** @} */	//End of group MCONFIG.
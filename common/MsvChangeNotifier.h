@@ -0,0 +1,148 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Change Notifier
+* @details		Pollable handle (eventfd) signaling pending config changes.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_CHANGENOTIFIER_H
+#define MARSTECH_CHANGENOTIFIER_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Change Notifier.
+* @details	Collects changed config IDs and signals them by pollable handle (eventfd), so event loops
+*				(epoll, io_uring, etc.) might handle config changes on their own thread. Handle is readable while
+*				some changes are pending, drain returns them and resets handle. Changes are collected only after
+*				handle has been opened (nothing is done when nobody polls).
+* @note		Handle is available only on Linux (eventfd), other systems do not support it.
+******************************************************************************************************/
+class MsvChangeNotifier
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	******************************************************************************************************/
+	MsvChangeNotifier();
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	* @details	Closes handle.
+	******************************************************************************************************/
+	virtual ~MsvChangeNotifier();
+
+	/**************************************************************************************************//**
+	* @brief			Get handle.
+	* @details		Returns pollable handle (it is opened by first call). It is readable (POLLIN) while some
+	*					changes are pending. It is owned by notifier (do not read or close it).
+	* @param[out]	handle		Pollable file descriptor.
+	* @retval		MSV_NOT_FOUND_ERROR		When pollable handle is not supported (not Linux).
+	* @retval		MSV_OPEN_ERROR				When handle could not be opened.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	MsvErrorCode GetHandle(int& handle);
+
+	/**************************************************************************************************//**
+	* @brief			Notify change.
+	* @details		Adds config ID to pending changes and signals handle (when nothing has been pending).
+	* @param[in]	cfgId		Changed config ID.
+	******************************************************************************************************/
+	void Notify(int32_t cfgId);
+
+	/**************************************************************************************************//**
+	* @brief			Notify changes.
+	* @details		Adds config IDs to pending changes and signals handle (when nothing has been pending).
+	* @param[in]	cfgIds		Changed config IDs.
+	******************************************************************************************************/
+	void Notify(const std::vector<int32_t>& cfgIds);
+
+	/**************************************************************************************************//**
+	* @brief			Drain changes.
+	* @details		Returns pending changes and resets handle. It never blocks.
+	* @param[out]	cfgIds		Config IDs changed since last drain (sorted, each only once, empty when nothing).
+	******************************************************************************************************/
+	void Drain(std::vector<int32_t>& cfgIds);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Signal handle.
+	* @details		Makes handle readable (notifier lock must be locked).
+	******************************************************************************************************/
+	void SignalHandle();
+
+	/**************************************************************************************************//**
+	* @brief			Reset handle.
+	* @details		Makes handle not readable (notifier lock must be locked).
+	******************************************************************************************************/
+	void ResetHandle();
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Notifier mutex.
+	* @details	Locks pending changes and handle (handle is signaled exactly when changes are pending).
+	******************************************************************************************************/
+	std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Opened flag.
+	* @details	Flag if handle has been opened (changes are collected) or not.
+	******************************************************************************************************/
+	std::atomic<bool> m_opened;
+
+	/**************************************************************************************************//**
+	* @brief		Handle.
+	* @details	Eventfd file descriptor (-1 when it has not been opened).
+	******************************************************************************************************/
+	int m_eventFd;
+
+	/**************************************************************************************************//**
+	* @brief		Pending changes.
+	* @details	Config IDs changed since last drain.
+	******************************************************************************************************/
+	std::set<int32_t> m_pending;
+};
+
+
+#endif // !MARSTECH_CHANGENOTIFIER_H
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,117 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Checksum
+* @details		Contains @ref MsvChecksum helper for checksum computation.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_CHECKSUM_H
+#define MARSTECH_CHECKSUM_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Checksum.
+* @details	Helper for checksum computation (64-bit FNV-1a). It is not cryptographic hash, it is used
+*				for change detection and data integrity checks of config files.
+******************************************************************************************************/
+class MsvChecksum
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Initial checksum value (FNV-1a 64-bit offset basis).
+	******************************************************************************************************/
+	static const uint64_t INITIAL_VALUE = 0xcbf29ce484222325ull;
+
+	/**************************************************************************************************//**
+	* @brief			Compute checksum.
+	* @details		Computes (or continues computing) checksum of data.
+	* @param[in]	pData		Pointer to data.
+	* @param[in]	size		Size of data (in bytes).
+	* @param[in]	checksum	Checksum of previous data (when computed in more steps).
+	* @returns		Computed checksum.
+	******************************************************************************************************/
+	static uint64_t Compute(const void* pData, size_t size, uint64_t checksum = INITIAL_VALUE)
+	{
+		const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			checksum ^= pBytes[i];
+			checksum *= 0x100000001b3ull;
+		}
+
+		return checksum;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Compute file checksum.
+	* @details		Computes checksum of whole file content.
+	* @param[in]	filePath	Path to file.
+	* @param[out]	checksum	Computed checksum.
+	* @param[out]	size		Size of file content (in bytes).
+	* @returns		True when file has been read, false when it could not be opened.
+	******************************************************************************************************/
+	static bool ComputeFile(const char* filePath, uint64_t& checksum, uint64_t& size)
+	{
+		checksum = INITIAL_VALUE;
+		size = 0;
+
+		std::ifstream file(filePath, std::ifstream::in | std::ifstream::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		char buffer[4096];
+		while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0)
+		{
+			checksum = Compute(buffer, static_cast<size_t>(file.gcount()), checksum);
+			size += static_cast<uint64_t>(file.gcount());
+		}
+
+		return true;
+	}
+};
+
+
+#endif // !MARSTECH_CHECKSUM_H
+
+/** @} */	//End of group MCONFIG.
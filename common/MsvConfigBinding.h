@@ -0,0 +1,529 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Config Binding
+* @details		Contains @ref MsvConfigBinding which mirrors config values into fields of user-defined struct
+*					and @ref MsvConfigBindingBase which attaches it to config.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_CONFIGBINDING_H
+#define MARSTECH_CONFIGBINDING_H
+
+
+#include "MsvConfigOverrides.h"
+#include "MsvConfigValue.h"
+#include "MsvCopyOnWrite.h"
+
+#include "mlogging/mlogging.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+template<class T> class MsvConfigBindingLink;
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Config Binding.
+* @details	Binds fields of user-defined struct (member pointers) to config IDs and keeps fully populated
+*				immutable instance of the struct. Each change creates new instance with all changed fields
+*				and swaps it atomically -> readers see all fields of one change together, they read plain
+*				fields through one pointer without any lookup or error check.
+* @note		Struct must be default constructible and copyable. Fields must be bound before first load,
+*				bound fields are not changed later (they are read without lock, Bind is not thread safe).
+* @see		MsvConfigBindingBase
+* @see		MsvActiveConfigBinding
+* @see		MsvPassiveConfigBinding
+******************************************************************************************************/
+template<class T>
+class MsvConfigBinding
+{
+	friend class MsvConfigBindingLink<T>;
+
+public:
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	******************************************************************************************************/
+	MsvConfigBinding():
+		m_loaded(false)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvConfigBinding()
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Bind field.
+	* @details		Binds struct field to config ID (more fields might be bound to one config ID).
+	* @param[in]	cfgId		Config ID.
+	* @param[in]	pField	Member pointer to field (bool, double, int64_t, std::string or uint64_t).
+	* @retval		MSV_ALREADY_INITIALIZED_INFO	When values have been already loaded (field is not bound).
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	template<class V> MsvErrorCode Bind(int32_t cfgId, V T::* pField)
+	{
+		static_assert(std::is_same<V, bool>::value || std::is_same<V, double>::value || std::is_same<V, int64_t>::value
+			|| std::is_same<V, std::string>::value || std::is_same<V, uint64_t>::value, "Bound field must have type of config value.");
+
+		if (m_loaded)
+		{
+			return MSV_ALREADY_INITIALIZED_INFO;
+		}
+
+		//value of field type is stored -> load knows which GetValue it has to call
+		MsvBoundField field;
+		field.m_type = V();
+		field.m_set = [pField](const MsvConfigValue& value, T& object)
+		{
+			const V* pValue = std::get_if<V>(&value);
+			if (!pValue)
+			{
+				return MSV_INVALID_DATA_ERROR;
+			}
+
+			object.*pField = *pValue;
+			return MSV_SUCCESS;
+		};
+
+		m_fields[cfgId].push_back(field);
+
+		return MSV_SUCCESS;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get values.
+	* @details		Returns current instance of struct. It stays valid (and unchanged) while returned pointer
+	*					is held.
+	* @returns		Current struct (default constructed struct when values have not been loaded yet).
+	******************************************************************************************************/
+	std::shared_ptr<const T> Get() const
+	{
+		return m_value.Load();
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Bound field.
+	* @details	Field bound to config ID.
+	******************************************************************************************************/
+	struct MsvBoundField
+	{
+		MsvConfigValue m_type;																				//!< Default value of field type (selects GetValue overload).
+		std::function<MsvErrorCode(const MsvConfigValue& value, T& object)> m_set;		//!< Sets value to field of struct.
+	};
+
+	/**************************************************************************************************//**
+	* @brief			Load values.
+	* @details		Reads all bound fields from config and publishes them as new instance.
+	* @param[in]	config		Config to read values from (it must have GetValue for all config value types).
+	* @retval		other_error_code	Error code returned by config (instance is not changed).
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	template<class C> MsvErrorCode LoadValues(const C& config)
+	{
+		m_loaded = true;
+
+		//bound instance is shared by all threads -> overrides of loading thread must not leak into it
+		MsvConfigOverridesSuspension suspension;
+
+		//values are read while writers are serialized -> concurrent change is applied before or after this load
+		return m_value.Update([this, &config](T& object) -> MsvErrorCode
+		{
+			for (typename std::map<int32_t, std::vector<MsvBoundField>>::const_iterator it = m_fields.begin(); it != m_fields.end(); ++it)
+			{
+				for (typename std::vector<MsvBoundField>::const_iterator fieldIt = it->second.begin(); fieldIt != it->second.end(); ++fieldIt)
+				{
+					MsvConfigValue value = fieldIt->m_type;
+					MSV_RETURN_FAILED(ReadValue(config, it->first, value));
+					MSV_RETURN_FAILED(fieldIt->m_set(value, object));
+				}
+			}
+
+			return MSV_SUCCESS;
+		});
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Apply changes.
+	* @details		Sets all changed bound fields to one new instance and publishes it (nothing is published
+	*					when no bound field has been changed).
+	* @param[in]	changes		Changed values (items with m_cfgId and m_newValue).
+	* @retval		MSV_INVALID_DATA_ERROR	When changed value has different type than bound field.
+	* @retval		other_error_code			When failed (instance is not changed).
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	template<class U> MsvErrorCode ApplyChanges(const std::vector<U>& changes)
+	{
+		bool bound = false;
+		for (typename std::vector<U>::const_iterator it = changes.begin(); it != changes.end() && !bound; ++it)
+		{
+			bound = m_fields.find(it->m_cfgId) != m_fields.end();
+		}
+
+		if (!bound)
+		{
+			return MSV_SUCCESS;
+		}
+
+		return m_value.Update([this, &changes](T& object) -> MsvErrorCode
+		{
+			for (typename std::vector<U>::const_iterator it = changes.begin(); it != changes.end(); ++it)
+			{
+				typename std::map<int32_t, std::vector<MsvBoundField>>::const_iterator fieldsIt = m_fields.find(it->m_cfgId);
+				if (fieldsIt == m_fields.end())
+				{
+					continue;
+				}
+
+				for (typename std::vector<MsvBoundField>::const_iterator fieldIt = fieldsIt->second.begin(); fieldIt != fieldsIt->second.end(); ++fieldIt)
+				{
+					MSV_RETURN_FAILED(fieldIt->m_set(it->m_newValue, object));
+				}
+			}
+
+			return MSV_SUCCESS;
+		});
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Read value.
+	* @details		Reads value of type held by value from config.
+	* @param[in]	config		Config to read value from.
+	* @param[in]	cfgId			Config ID.
+	* @param[in,out]	value	Value with type to read (read value is returned).
+	* @retval		other_error_code	Error code returned by config.
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	template<class C> static MsvErrorCode ReadValue(const C& config, int32_t cfgId, MsvConfigValue& value)
+	{
+		if (bool* pValue = std::get_if<bool>(&value))
+		{
+			return config.GetValue(cfgId, *pValue);
+		}
+		else if (double* pValue = std::get_if<double>(&value))
+		{
+			return config.GetValue(cfgId, *pValue);
+		}
+		else if (int64_t* pValue = std::get_if<int64_t>(&value))
+		{
+			return config.GetValue(cfgId, *pValue);
+		}
+		else if (std::string* pValue = std::get_if<std::string>(&value))
+		{
+			return config.GetValue(cfgId, *pValue);
+		}
+		else if (uint64_t* pValue = std::get_if<uint64_t>(&value))
+		{
+			return config.GetValue(cfgId, *pValue);
+		}
+
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Bound fields.
+	* @details	Fields bound to config IDs (they are not changed after first load).
+	******************************************************************************************************/
+	std::map<int32_t, std::vector<MsvBoundField>> m_fields;
+
+	/**************************************************************************************************//**
+	* @brief		Loaded flag.
+	* @details	Flag if values have been loaded (fields can not be bound anymore).
+	******************************************************************************************************/
+	std::atomic<bool> m_loaded;
+
+	/**************************************************************************************************//**
+	* @brief		Current values.
+	* @details	Immutable instance of struct (copy on write).
+	******************************************************************************************************/
+	MsvCopyOnWrite<T> m_value;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Config Binding Link.
+* @details	Link from callback registered to config to its binding. Callback holds the link (not binding),
+*				binding unlinks it when it is detached -> notification which is delivered later (queued in
+*				dispatcher or called from callbacks snapshot) is dropped and never touches destroyed binding.
+* @note		Unlink waits for running notification, binding must not be detached from its own notification.
+* @see		MsvConfigBinding
+******************************************************************************************************/
+template<class T>
+class MsvConfigBindingLink
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	pBinding		Pointer to linked binding.
+	* @param[in]	spLogger		Shared pointer to logger for logging.
+	******************************************************************************************************/
+	MsvConfigBindingLink(MsvConfigBinding<T>* pBinding, std::shared_ptr<MsvLogger> spLogger = nullptr):
+		m_pBinding(pBinding),
+		m_spLogger(spLogger)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Values have been changed.
+	* @details		Applies changed values to linked binding (nothing is done when binding has been unlinked).
+	* @param[in]	changes		Changed values (items with m_cfgId and m_newValue).
+	******************************************************************************************************/
+	template<class U> void OnValuesChanged(const std::vector<U>& changes)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		if (!m_pBinding)
+		{
+			return;
+		}
+
+		MsvErrorCode errorCode = m_pBinding->ApplyChanges(changes);
+		if (MSV_FAILED(errorCode))
+		{
+			MSV_LOG_ERROR(m_spLogger, "Apply changes to config binding failed with error: {0:x}", errorCode);
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Unlink binding.
+	* @details	Waits for running notification and drops all later ones.
+	******************************************************************************************************/
+	void Unlink()
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		m_pBinding = nullptr;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Link mutex.
+	* @details	Locks notification and unlink.
+	******************************************************************************************************/
+	std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Linked binding.
+	* @details	Pointer to binding (nullptr -> binding has been unlinked).
+	******************************************************************************************************/
+	MsvConfigBinding<T>* m_pBinding;
+
+	/**************************************************************************************************//**
+	* @brief		Logger.
+	* @details	Shared pointer to logger for logging.
+	******************************************************************************************************/
+	std::shared_ptr<MsvLogger> m_spLogger;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Config Binding Base.
+* @details	Attaches binding to config: registers callback adapter, loads all bound fields and unregisters
+*				callback when binding is detached or destroyed.
+* @note		Callback adapter CB is constructed from link to binding (@ref MsvConfigBindingLink) and it
+*				provides static Register and Unregister methods which register it to config C.
+* @see		MsvActiveConfigBinding
+* @see		MsvPassiveConfigBinding
+******************************************************************************************************/
+template<class T, class C, class CB>
+class MsvConfigBindingBase:
+	public MsvConfigBinding<T>
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	spLogger			Shared pointer to logger for logging.
+	******************************************************************************************************/
+	MsvConfigBindingBase(std::shared_ptr<MsvLogger> spLogger = nullptr):
+		m_spLogger(spLogger)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	* @details	Detaches binding.
+	******************************************************************************************************/
+	virtual ~MsvConfigBindingBase()
+	{
+		Detach();
+
+		//callback might stay registered when detach failed -> it must not reach destroyed binding
+		if (m_spLink)
+		{
+			m_spLink->Unlink();
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Attach binding.
+	* @details		Registers callback to config and loads all bound fields (fields must be bound before).
+	* @param[in]	spConfig		Initialized config.
+	* @retval		MSV_ALREADY_INITIALIZED_INFO	When binding has been already attached.
+	* @retval		MSV_INVALID_DATA_ERROR			When config is nullptr.
+	* @retval		MSV_ALLOCATION_ERROR				When callback allocation failed.
+	* @retval		other_error_code					When register callback or load failed.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Attach(std::shared_ptr<C> spConfig)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		if (m_spConfig)
+		{
+			return MSV_ALREADY_INITIALIZED_INFO;
+		}
+
+		if (!spConfig)
+		{
+			return MSV_INVALID_DATA_ERROR;
+		}
+
+		std::shared_ptr<MsvConfigBindingLink<T>> spLink(new (std::nothrow) MsvConfigBindingLink<T>(this, m_spLogger));
+		if (!spLink)
+		{
+			MSV_LOG_ERROR(m_spLogger, "Create config binding link failed with error: {0:x}", MSV_ALLOCATION_ERROR);
+			return MSV_ALLOCATION_ERROR;
+		}
+
+		std::shared_ptr<CB> spCallback(new (std::nothrow) CB(spLink));
+		if (!spCallback)
+		{
+			MSV_LOG_ERROR(m_spLogger, "Create config binding callback failed with error: {0:x}", MSV_ALLOCATION_ERROR);
+			return MSV_ALLOCATION_ERROR;
+		}
+
+		//callback is registered first -> change made during load is not lost
+		MsvErrorCode errorCode = CB::Register(*spConfig, spCallback);
+		if (MSV_FAILED(errorCode))
+		{
+			MSV_LOG_ERROR(m_spLogger, "Register config binding callback failed with error: {0:x}", errorCode);
+			return errorCode;
+		}
+
+		if (MSV_FAILED(errorCode = this->LoadValues(*spConfig)))
+		{
+			MSV_LOG_ERROR(m_spLogger, "Load config binding values failed with error: {0:x}", errorCode);
+			CB::Unregister(*spConfig, spCallback);
+			spLink->Unlink();
+			return errorCode;
+		}
+
+		m_spConfig = spConfig;
+		m_spCallback = spCallback;
+		m_spLink = spLink;
+
+		return MSV_SUCCESS;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Detach binding.
+	* @details		Unregisters callback (struct keeps last values).
+	* @retval		MSV_NOT_INITIALIZED_INFO	When binding has not been attached.
+	* @retval		other_error_code				When unregister callback failed.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Detach()
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		if (!m_spConfig)
+		{
+			return MSV_NOT_INITIALIZED_INFO;
+		}
+
+		MsvErrorCode errorCode = CB::Unregister(*m_spConfig, m_spCallback);
+		if (MSV_FAILED(errorCode))
+		{
+			MSV_LOG_ERROR(m_spLogger, "Unregister config binding callback failed with error: {0:x}", errorCode);
+			return errorCode;
+		}
+
+		//notification queued in dispatcher or called from callbacks snapshot might still come -> drop it
+		m_spLink->Unlink();
+
+		m_spConfig.reset();
+		m_spCallback.reset();
+		m_spLink.reset();
+
+		return MSV_SUCCESS;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Binding mutex.
+	* @details	Locks attach and detach (notifications lock binding link only).
+	******************************************************************************************************/
+	std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Logger.
+	* @details	Shared pointer to logger for logging.
+	******************************************************************************************************/
+	std::shared_ptr<MsvLogger> m_spLogger;
+
+	/**************************************************************************************************//**
+	* @brief		Attached config.
+	* @details	Config with registered callback (nullptr -> binding is not attached).
+	******************************************************************************************************/
+	std::shared_ptr<C> m_spConfig;
+
+	/**************************************************************************************************//**
+	* @brief		Binding callback.
+	* @details	Callback adapter registered to attached config.
+	******************************************************************************************************/
+	std::shared_ptr<CB> m_spCallback;
+
+	/**************************************************************************************************//**
+	* @brief		Binding link.
+	* @details	Link held by binding callback (it is unlinked when binding is detached).
+	******************************************************************************************************/
+	std::shared_ptr<MsvConfigBindingLink<T>> m_spLink;
+};
+
+
+#endif // !MARSTECH_CONFIGBINDING_H
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,302 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Config Overrides
+* @details		Per thread overrides of config values (they are never stored).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_CONFIGOVERRIDES_H
+#define MARSTECH_CONFIGOVERRIDES_H
+
+
+#include "MsvConfigValue.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <map>
+#include <memory>
+#include <new>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Config Overrides.
+* @details	Stack of override frames of calling thread. Each frame belongs to one config (owner) and it
+*				overrides some of its values. Reads check one thread local pointer when thread has no
+*				overrides. Overrides are never visible to other threads and they are never stored.
+* @warning	Frames must be popped by the thread which has pushed them (before owner is destroyed).
+* @see		MsvConfigOverrideScope
+******************************************************************************************************/
+class MsvConfigOverrides
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Push frame.
+	* @details		Validates values against key map and pushes them as new frame of owner.
+	* @param[in]	pOwner		Config which owns frame.
+	* @param[in]	keyMap		Config key map of owner (types of config IDs).
+	* @param[in]	values		Overridden values (later value of the same config ID wins).
+	* @retval		MSV_NOT_FOUND_ERROR			When some config ID is not in key map.
+	* @retval		MSV_INVALID_DATA_ERROR		When some value has other type than its key.
+	* @retval		MSV_ALLOCATION_ERROR		When frame allocation failed.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	template<class K> static MsvErrorCode Push(const void* pOwner, const std::map<int32_t, std::shared_ptr<K>>& keyMap, const std::vector<MsvConfigValueUpdate>& values)
+	{
+		for (std::vector<MsvConfigValueUpdate>::const_iterator it = values.begin(); it != values.end(); ++it)
+		{
+			typename std::map<int32_t, std::shared_ptr<K>>::const_iterator keyIt = keyMap.find(it->m_cfgId);
+			if (keyIt == keyMap.end())
+			{
+				return MSV_NOT_FOUND_ERROR;
+			}
+
+			bool validType = (std::holds_alternative<bool>(it->m_newValue) && keyIt->second->IsBool())
+				|| (std::holds_alternative<double>(it->m_newValue) && keyIt->second->IsDouble())
+				|| (std::holds_alternative<int64_t>(it->m_newValue) && keyIt->second->IsInteger())
+				|| (std::holds_alternative<std::string>(it->m_newValue) && keyIt->second->IsString())
+				|| (std::holds_alternative<uint64_t>(it->m_newValue) && keyIt->second->IsUnsigned());
+			if (!validType)
+			{
+				return MSV_INVALID_DATA_ERROR;
+			}
+		}
+
+		MsvConfigOverrideFrame* pFrame = new (std::nothrow) MsvConfigOverrideFrame();
+		if (!pFrame)
+		{
+			return MSV_ALLOCATION_ERROR;
+		}
+
+		for (std::vector<MsvConfigValueUpdate>::const_iterator it = values.begin(); it != values.end(); ++it)
+		{
+			pFrame->m_values[it->m_cfgId] = it->m_newValue;
+		}
+
+		MsvConfigOverrideFrame*& pTop = GetTop();
+		pFrame->m_pOwner = pOwner;
+		pFrame->m_pPrevious = pTop;
+		pTop = pFrame;
+
+		return MSV_SUCCESS;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Pop frame.
+	* @details		Removes the most recent frame of owner (frames of other configs pushed later are kept).
+	* @param[in]	pOwner		Config which owns frame.
+	* @retval		MSV_NOT_FOUND_ERROR			When owner has no frame in calling thread.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	static MsvErrorCode Pop(const void* pOwner)
+	{
+		MsvConfigOverrideFrame** ppFrame = &GetTop();
+		while (*ppFrame && (*ppFrame)->m_pOwner != pOwner)
+		{
+			ppFrame = &(*ppFrame)->m_pPrevious;
+		}
+
+		MsvConfigOverrideFrame* pFrame = *ppFrame;
+		if (!pFrame)
+		{
+			return MSV_NOT_FOUND_ERROR;
+		}
+
+		*ppFrame = pFrame->m_pPrevious;
+		delete pFrame;
+
+		return MSV_SUCCESS;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Find value.
+	* @details		Finds overridden value of owner in frames of calling thread (the most recent frame wins).
+	* @param[in]	pOwner		Config which owns frames.
+	* @param[in]	cfgId			Config ID.
+	* @returns		Overridden value (valid until its frame is popped) or nullptr when value is not overridden
+	*					(only thread local pointer is checked when thread has no overrides).
+	******************************************************************************************************/
+	template<class T> static const T* Find(const void* pOwner, int32_t cfgId)
+	{
+		for (const MsvConfigOverrideFrame* pFrame = GetTop(); pFrame; pFrame = pFrame->m_pPrevious)
+		{
+			if (pFrame->m_pOwner != pOwner)
+			{
+				continue;
+			}
+
+			std::map<int32_t, MsvConfigValue>::const_iterator it = pFrame->m_values.find(cfgId);
+			if (it != pFrame->m_values.end())
+			{
+				return std::get_if<T>(&it->second);
+			}
+		}
+
+		return nullptr;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get value.
+	* @details		Copies overridden value of owner (see @ref Find).
+	* @param[in]	pOwner		Config which owns frames.
+	* @param[in]	cfgId			Config ID.
+	* @param[out]	value			Overridden value.
+	* @returns		True when value is overridden, false otherwise.
+	******************************************************************************************************/
+	template<class T> static bool GetValue(const void* pOwner, int32_t cfgId, T& value)
+	{
+		const T* pValue = Find<T>(pOwner, cfgId);
+		if (!pValue)
+		{
+			return false;
+		}
+
+		value = *pValue;
+		return true;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Override frame.
+	* @details	Overridden values of one config pushed by one push.
+	******************************************************************************************************/
+	struct MsvConfigOverrideFrame
+	{
+		const void* m_pOwner;										//!< Config which owns frame.
+		std::map<int32_t, MsvConfigValue> m_values;			//!< Overridden values.
+		MsvConfigOverrideFrame* m_pPrevious;					//!< Frame pushed before this one.
+	};
+
+	/**************************************************************************************************//**
+	* @brief			Get top.
+	* @returns		Top frame of calling thread (nullptr -> thread has no overrides).
+	******************************************************************************************************/
+	static MsvConfigOverrideFrame*& GetTop()
+	{
+		//constant initialized -> no guard, access is one thread local load
+		static thread_local MsvConfigOverrideFrame* pTop = nullptr;
+		return pTop;
+	}
+
+	friend class MsvConfigOverridesSuspension;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Config Overrides Suspension.
+* @details	Hides overrides of calling thread while it exists. It is used when values are read for shared
+*				state (derived values, bindings), which must not see overrides of one thread.
+******************************************************************************************************/
+class MsvConfigOverridesSuspension
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	* @details	Hides overrides of calling thread.
+	******************************************************************************************************/
+	MsvConfigOverridesSuspension():
+		m_pTop(MsvConfigOverrides::GetTop())
+	{
+		MsvConfigOverrides::GetTop() = nullptr;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Destructor.
+	* @details	Restores overrides of calling thread.
+	******************************************************************************************************/
+	~MsvConfigOverridesSuspension()
+	{
+		MsvConfigOverrides::GetTop() = m_pTop;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Top frame.
+	* @details	Hidden top frame of calling thread.
+	******************************************************************************************************/
+	MsvConfigOverrides::MsvConfigOverrideFrame* m_pTop;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Config Override Scope.
+* @details	Pushes overrides to config (active or passive) and pops them when scope ends.
+******************************************************************************************************/
+template<class C>
+class MsvConfigOverrideScope
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Pushes overrides (result is returned by @ref GetErrorCode).
+	* @param[in]	config		Config (it must outlive scope).
+	* @param[in]	values		Overridden values.
+	******************************************************************************************************/
+	MsvConfigOverrideScope(C& config, const std::vector<MsvConfigValueUpdate>& values):
+		m_config(config),
+		m_errorCode(config.PushOverrides(values))
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Destructor.
+	* @details	Pops overrides (when they have been pushed).
+	******************************************************************************************************/
+	~MsvConfigOverrideScope()
+	{
+		if (MSV_SUCCEEDED(m_errorCode))
+		{
+			m_config.PopOverrides();
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get error code.
+	* @returns		Result of push.
+	******************************************************************************************************/
+	MsvErrorCode GetErrorCode() const
+	{
+		return m_errorCode;
+	}
+
+protected:
+	C& m_config;						//!< Config with pushed overrides.
+	MsvErrorCode m_errorCode;		//!< Result of push.
+};
+
+
+#endif // !MARSTECH_CONFIGOVERRIDES_H
+
+/** @} */	//End of group MCONFIG.
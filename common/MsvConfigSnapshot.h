@@ -0,0 +1,227 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Config Snapshot
+* @details		Contains @ref MsvConfigSnapshot immutable view of configuration values.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_CONFIGSNAPSHOT_H
+#define MARSTECH_CONFIGSNAPSHOT_H
+
+
+#include "MsvConfigValues.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <memory>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Config Snapshot.
+* @details	Immutable view of all configuration values at one moment. It is never changed after it has been
+*				created, so any number of values might be read from it without locks and they are consistent
+*				(changes made later are not visible). It is shared by reference counting.
+* @see		MsvConfigSnapshotCache
+******************************************************************************************************/
+class MsvConfigSnapshot
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	values		Snapshot values (they are moved).
+	******************************************************************************************************/
+	explicit MsvConfigSnapshot(MsvConfigValues&& values):
+		m_values(std::move(values))
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get bool value.
+	* @param[in]	cfgId		Config ID to get its value.
+	* @param[out]	value		Found and returned value.
+	* @retval		MSV_NOT_FOUND_ERROR			When config ID (cfgId) does not exist.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	MsvErrorCode GetValue(int32_t cfgId, bool& value) const
+	{
+		return GetValue(cfgId, m_values.m_boolValues, value);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get double value.
+	* @param[in]	cfgId		Config ID to get its value.
+	* @param[out]	value		Found and returned value.
+	* @retval		MSV_NOT_FOUND_ERROR			When config ID (cfgId) does not exist.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	MsvErrorCode GetValue(int32_t cfgId, double& value) const
+	{
+		return GetValue(cfgId, m_values.m_doubleValues, value);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get int64_t value.
+	* @param[in]	cfgId		Config ID to get its value.
+	* @param[out]	value		Found and returned value.
+	* @retval		MSV_NOT_FOUND_ERROR			When config ID (cfgId) does not exist.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	MsvErrorCode GetValue(int32_t cfgId, int64_t& value) const
+	{
+		return GetValue(cfgId, m_values.m_integerValues, value);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get string value.
+	* @param[in]	cfgId		Config ID to get its value.
+	* @param[out]	value		Found and returned value.
+	* @retval		MSV_NOT_FOUND_ERROR			When config ID (cfgId) does not exist.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	MsvErrorCode GetValue(int32_t cfgId, std::string& value) const
+	{
+		return GetValue(cfgId, m_values.m_stringValues, value);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get uint64_t value.
+	* @param[in]	cfgId		Config ID to get its value.
+	* @param[out]	value		Found and returned value.
+	* @retval		MSV_NOT_FOUND_ERROR			When config ID (cfgId) does not exist.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	MsvErrorCode GetValue(int32_t cfgId, uint64_t& value) const
+	{
+		return GetValue(cfgId, m_values.m_unsignedValues, value);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get values.
+	* @returns		All snapshot values (valid while snapshot is held).
+	******************************************************************************************************/
+	const MsvConfigValues& GetValues() const
+	{
+		return m_values;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Get value.
+	* @details		Template method used in Get methods.
+	* @param[in]	cfgId		Config ID to get its value.
+	* @param[in]	values	Storage of values with requested type.
+	* @param[out]	value		Found and returned value.
+	* @retval		MSV_NOT_FOUND_ERROR			When config ID (cfgId) does not exist.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	template<class T> static MsvErrorCode GetValue(int32_t cfgId, const std::map<int32_t, T>& values, T& value)
+	{
+		typename std::map<int32_t, T>::const_iterator it = values.find(cfgId);
+		if (it == values.end())
+		{
+			return MSV_NOT_FOUND_ERROR;
+		}
+
+		value = it->second;
+		return MSV_SUCCESS;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Values.
+	* @details	Immutable snapshot values.
+	******************************************************************************************************/
+	const MsvConfigValues m_values;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Config Snapshot Cache.
+* @details	Holds snapshot of current values. Taking cached snapshot is one atomic shared pointer load (no
+*				copy of values). Writers only invalidate it (they do not copy values), snapshot is rebuilt by
+*				next reader. Owner must publish and invalidate snapshot under the same lock which protects its
+*				values (shared lock for publish, exclusive lock for invalidate), so stale snapshot is never published.
+******************************************************************************************************/
+class MsvConfigSnapshotCache
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Load snapshot.
+	* @returns		Cached snapshot, nullptr when it has been invalidated (or it has not been published yet).
+	******************************************************************************************************/
+	std::shared_ptr<const MsvConfigSnapshot> Load() const
+	{
+		return std::atomic_load(&m_spSnapshot);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Publish snapshot.
+	* @details		Creates snapshot from values and caches it.
+	* @param[in]	values		Current values (they are moved).
+	* @returns		Published snapshot, nullptr when allocation failed.
+	******************************************************************************************************/
+	std::shared_ptr<const MsvConfigSnapshot> Publish(MsvConfigValues&& values)
+	{
+		std::shared_ptr<const MsvConfigSnapshot> spSnapshot(new (std::nothrow) MsvConfigSnapshot(std::move(values)));
+		if (spSnapshot)
+		{
+			std::atomic_store(&m_spSnapshot, spSnapshot);
+		}
+
+		return spSnapshot;
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Invalidate snapshot.
+	* @details	Releases cached snapshot (holders keep their snapshots). It must be called when values are changed.
+	******************************************************************************************************/
+	void Invalidate()
+	{
+		std::atomic_store(&m_spSnapshot, std::shared_ptr<const MsvConfigSnapshot>());
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Snapshot.
+	* @details	Cached snapshot (accessed only by atomic shared pointer operations).
+	******************************************************************************************************/
+	std::shared_ptr<const MsvConfigSnapshot> m_spSnapshot;
+};
+
+
+#endif // !MARSTECH_CONFIGSNAPSHOT_H
+
+/** @} */	//End of group MCONFIG.
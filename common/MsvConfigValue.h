@@ -0,0 +1,130 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Config Value
+* @details		Contains @ref MsvConfigValue (value of any supported type) and @ref MsvConfigValueChange.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_CONFIGVALUE_H
+#define MARSTECH_CONFIGVALUE_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <string>
+#include <variant>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Config Value.
+* @details	Config value of any supported type. std::monostate means no value (value does not exist).
+******************************************************************************************************/
+typedef std::variant<std::monostate, bool, double, int64_t, std::string, uint64_t> MsvConfigValue;
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Config Value Change.
+* @details	Describes one changed config value (its old and new value).
+******************************************************************************************************/
+struct MsvConfigValueChange
+{
+	/**************************************************************************************************//**
+	* @brief		Config ID.
+	* @details	Config ID of changed value.
+	******************************************************************************************************/
+	int32_t m_cfgId;
+
+	/**************************************************************************************************//**
+	* @brief		Old value.
+	* @details	Value before change (std::monostate when value has not existed).
+	******************************************************************************************************/
+	MsvConfigValue m_oldValue;
+
+	/**************************************************************************************************//**
+	* @brief		New value.
+	* @details	Value after change (std::monostate when value does not exist anymore).
+	******************************************************************************************************/
+	MsvConfigValue m_newValue;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Config Value Update.
+* @details	Describes one new config value (config ID and its new value).
+******************************************************************************************************/
+struct MsvConfigValueUpdate
+{
+	/**************************************************************************************************//**
+	* @brief		Config ID.
+	* @details	Config ID of new value.
+	******************************************************************************************************/
+	int32_t m_cfgId;
+
+	/**************************************************************************************************//**
+	* @brief		New value.
+	* @details	New value of config ID.
+	******************************************************************************************************/
+	MsvConfigValue m_newValue;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Config Value Journal Entry.
+* @details	Describes one journaled change (its sequence number, config ID and new value).
+******************************************************************************************************/
+struct MsvConfigValueJournalEntry
+{
+	/**************************************************************************************************//**
+	* @brief		Sequence.
+	* @details	Sequence number of change (it is incremented by each change).
+	******************************************************************************************************/
+	uint64_t m_sequence;
+
+	/**************************************************************************************************//**
+	* @brief		Config ID.
+	* @details	Config ID of changed value.
+	******************************************************************************************************/
+	int32_t m_cfgId;
+
+	/**************************************************************************************************//**
+	* @brief		New value.
+	* @details	Value after change.
+	******************************************************************************************************/
+	MsvConfigValue m_newValue;
+};
+
+
+#endif // !MARSTECH_CONFIGVALUE_H
+
+/** @} */	//End of group MCONFIG.
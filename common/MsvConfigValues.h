@@ -0,0 +1,186 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Config Values
+* @details		Contains @ref MsvConfigValues storage of loaded configuration values.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_CONFIGVALUES_H
+#define MARSTECH_CONFIGVALUES_H
+
+
+#include "MsvConfigValue.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Config Values.
+* @details	Storage of loaded configuration values (one map per supported value type).
+******************************************************************************************************/
+struct MsvConfigValues
+{
+	/**************************************************************************************************//**
+	* @brief		Bool values.
+	* @details	Storage (map) of bool values.
+	******************************************************************************************************/
+	std::map<int32_t, bool> m_boolValues;
+
+	/**************************************************************************************************//**
+	* @brief		Double values.
+	* @details	Storage (map) of double values.
+	******************************************************************************************************/
+	std::map<int32_t, double> m_doubleValues;
+
+	/**************************************************************************************************//**
+	* @brief		Integer values.
+	* @details	Storage (map) of int64_t values.
+	******************************************************************************************************/
+	std::map<int32_t, int64_t> m_integerValues;
+
+	/**************************************************************************************************//**
+	* @brief		String values.
+	* @details	Storage (map) of string values.
+	******************************************************************************************************/
+	std::map<int32_t, std::string> m_stringValues;
+
+	/**************************************************************************************************//**
+	* @brief		Unsigned integer values.
+	* @details	Storage (map) of uint64_t values.
+	******************************************************************************************************/
+	std::map<int32_t, uint64_t> m_unsignedValues;
+
+	/**************************************************************************************************//**
+	* @brief			Clear values.
+	* @details		Removes all values from all storages.
+	******************************************************************************************************/
+	void Clear()
+	{
+		m_boolValues.clear();
+		m_doubleValues.clear();
+		m_integerValues.clear();
+		m_stringValues.clear();
+		m_unsignedValues.clear();
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Apply new values.
+	* @details		Moves new values to this storage. Only values which differ (or which are new or missing)
+	*					are touched, unchanged values are kept as they are.
+	* @param[in]	newValues		New values (they are moved, its content is undefined after this call).
+	* @param[out]	changedCfgIds	Config IDs of changed values (appended, sorted when all storages are applied).
+	* @param[out]	pChanges			Changed values with old and new values (appended and sorted as well), it is
+	*										not filled when nullptr.
+	******************************************************************************************************/
+	void Apply(MsvConfigValues& newValues, std::vector<int32_t>& changedCfgIds, std::vector<MsvConfigValueChange>* pChanges = nullptr)
+	{
+		Apply(m_boolValues, newValues.m_boolValues, changedCfgIds, pChanges);
+		Apply(m_doubleValues, newValues.m_doubleValues, changedCfgIds, pChanges);
+		Apply(m_integerValues, newValues.m_integerValues, changedCfgIds, pChanges);
+		Apply(m_stringValues, newValues.m_stringValues, changedCfgIds, pChanges);
+		Apply(m_unsignedValues, newValues.m_unsignedValues, changedCfgIds, pChanges);
+
+		std::sort(changedCfgIds.begin(), changedCfgIds.end());
+
+		if (pChanges)
+		{
+			std::sort(pChanges->begin(), pChanges->end(), [](const MsvConfigValueChange& change1, const MsvConfigValueChange& change2) { return change1.m_cfgId < change2.m_cfgId; });
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Apply new values.
+	* @details		Template method used for each value storage by @ref Apply(MsvConfigValues& newValues, std::vector<int32_t>& changedCfgIds).
+	* @param[in]	values			Current values (updated).
+	* @param[in]	newValues		New values (they are moved).
+	* @param[out]	changedCfgIds	Config IDs of changed values (appended).
+	* @param[out]	pChanges			Changed values with old and new values (appended), it is not filled when nullptr.
+	******************************************************************************************************/
+	template<class T> static void Apply(std::map<int32_t, T>& values, std::map<int32_t, T>& newValues, std::vector<int32_t>& changedCfgIds, std::vector<MsvConfigValueChange>* pChanges)
+	{
+		typename std::map<int32_t, T>::iterator it = values.begin();
+		typename std::map<int32_t, T>::iterator newIt = newValues.begin();
+
+		//both maps are sorted by config ID -> walk them together
+		while (it != values.end() || newIt != newValues.end())
+		{
+			if (newIt == newValues.end() || (it != values.end() && it->first < newIt->first))
+			{
+				//value does not exist anymore
+				changedCfgIds.push_back(it->first);
+				if (pChanges)
+				{
+					pChanges->push_back(MsvConfigValueChange{ it->first, MsvConfigValue(it->second), MsvConfigValue() });
+				}
+				it = values.erase(it);
+			}
+			else if (it == values.end() || newIt->first < it->first)
+			{
+				//new value
+				changedCfgIds.push_back(newIt->first);
+				if (pChanges)
+				{
+					pChanges->push_back(MsvConfigValueChange{ newIt->first, MsvConfigValue(), MsvConfigValue(newIt->second) });
+				}
+				it = std::next(values.emplace_hint(it, newIt->first, std::move(newIt->second)));
+				++newIt;
+			}
+			else
+			{
+				if (!(it->second == newIt->second))
+				{
+					//changed value
+					changedCfgIds.push_back(it->first);
+					if (pChanges)
+					{
+						pChanges->push_back(MsvConfigValueChange{ it->first, MsvConfigValue(it->second), MsvConfigValue(newIt->second) });
+					}
+					it->second = std::move(newIt->second);
+				}
+
+				++it;
+				++newIt;
+			}
+		}
+	}
+};
+
+
+#endif // !MARSTECH_CONFIGVALUES_H
+
+/** @} */	//End of group MCONFIG.
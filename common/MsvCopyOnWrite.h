@@ -0,0 +1,189 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Copy On Write
+* @details		Contains @ref MsvCopyOnWrite (immutable atomically swapped value) and @ref MsvCallbackList.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_COPYONWRITE_H
+#define MARSTECH_COPYONWRITE_H
+
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Copy On Write.
+* @details	Holds immutable value which is swapped atomically. Readers load current value (one atomic
+*				shared pointer load) and use it without any lock, value never changes under them. Writers
+*				copy current value, modify the copy and publish it (writers are serialized).
+******************************************************************************************************/
+template<class T>
+class MsvCopyOnWrite
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	* @details	Creates default (empty) value.
+	******************************************************************************************************/
+	MsvCopyOnWrite():
+		m_spValue(new (std::nothrow) T())
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Load value.
+	* @details		Returns current value. It stays valid (and unchanged) while returned pointer is held.
+	* @returns		Current value.
+	******************************************************************************************************/
+	std::shared_ptr<const T> Load() const
+	{
+		return std::atomic_load(&m_spValue);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Update value.
+	* @details		Copies current value, calls update on the copy and publishes it when update returns
+	*					MSV_SUCCESS (otherwise value is not changed).
+	* @param[in]	update		Update function (MsvErrorCode(T& value)), it must not call Update.
+	* @retval		MSV_ALLOCATION_ERROR		When copy allocation failed.
+	* @retval		other_error_code			Error code returned by update (value is not published).
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	template<class F> MsvErrorCode Update(F update)
+	{
+		std::lock_guard<std::mutex> lock(m_writeLock);
+
+		std::shared_ptr<const T> spValue = std::atomic_load(&m_spValue);
+		std::shared_ptr<T> spNewValue(spValue ? new (std::nothrow) T(*spValue) : new (std::nothrow) T());
+		if (!spNewValue)
+		{
+			return MSV_ALLOCATION_ERROR;
+		}
+
+		MsvErrorCode errorCode = update(*spNewValue);
+		if (errorCode == MSV_SUCCESS)
+		{
+			std::atomic_store(&m_spValue, std::shared_ptr<const T>(spNewValue));
+		}
+
+		return errorCode;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Value.
+	* @details	Current immutable value (accessed only by atomic shared pointer operations).
+	******************************************************************************************************/
+	std::shared_ptr<const T> m_spValue;
+
+	/**************************************************************************************************//**
+	* @brief		Write mutex.
+	* @details	Serializes writers (readers never lock).
+	******************************************************************************************************/
+	std::mutex m_writeLock;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Callback List.
+* @details	Copy on write array of registered callbacks. Dispatch iterates over loaded array without
+*				lock (and without reference counting of each callback). Callback can register or unregister
+*				callbacks (itself too) while it is called, change is visible in next dispatch.
+******************************************************************************************************/
+template<class T>
+class MsvCallbackList:
+	public MsvCopyOnWrite<std::vector<std::shared_ptr<T>>>
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Register callback.
+	* @details		Publishes new array with the callback.
+	* @param[in]	spCallback		Callback to register.
+	* @retval		MSV_ALREADY_REGISTERED_INFO	When callback has been already registered (this is info, not error).
+	* @retval		MSV_ALLOCATION_ERROR				When allocation failed.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	MsvErrorCode Register(std::shared_ptr<T> spCallback)
+	{
+		return this->Update([&spCallback](std::vector<std::shared_ptr<T>>& callbacks)
+		{
+			if (std::find(callbacks.begin(), callbacks.end(), spCallback) != callbacks.end())
+			{
+				//callback is already registered
+				return MSV_ALREADY_REGISTERED_INFO;
+			}
+
+			callbacks.push_back(spCallback);
+			return MSV_SUCCESS;
+		});
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Unregister callback.
+	* @details		Publishes new array without the callback.
+	* @param[in]	spCallback		Callback to unregister.
+	* @retval		MSV_ALLOCATION_ERROR				When allocation failed.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	MsvErrorCode Unregister(std::shared_ptr<T> spCallback)
+	{
+		MsvErrorCode errorCode = this->Update([&spCallback](std::vector<std::shared_ptr<T>>& callbacks)
+		{
+			typename std::vector<std::shared_ptr<T>>::iterator it = std::remove(callbacks.begin(), callbacks.end(), spCallback);
+			if (it == callbacks.end())
+			{
+				//callback is not registered -> nothing to publish
+				return MSV_NOT_FOUND_ERROR;
+			}
+
+			callbacks.erase(it, callbacks.end());
+			return MSV_SUCCESS;
+		});
+
+		return (errorCode == MSV_NOT_FOUND_ERROR) ? MSV_SUCCESS : errorCode;
+	}
+};
+
+
+#endif // !MARSTECH_COPYONWRITE_H
+
+/** @} */	//End of group MCONFIG.
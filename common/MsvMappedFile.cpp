@@ -0,0 +1,181 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Mapped File Implementation
+* @details		Contains implementation of @ref MsvMappedFile.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "MsvMappedFile.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvMappedFile::MsvMappedFile():
+	m_pData(nullptr),
+	m_size(0),
+	m_hMapping(nullptr)
+{
+
+}
+
+MsvMappedFile::~MsvMappedFile()
+{
+	Unmap();
+}
+
+
+/********************************************************************************************************************************
+*															MsvMappedFile public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvMappedFile::Map(const char* filePath)
+{
+	Unmap();
+
+#ifdef _WIN32
+	HANDLE hFile = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE)
+	{
+		return MSV_OPEN_ERROR;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart <= 0)
+	{
+		CloseHandle(hFile);
+		return MSV_OPEN_ERROR;
+	}
+
+	//mapping keeps file opened -> file handle is not needed anymore
+	HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(hFile);
+	if (!hMapping)
+	{
+		return MSV_OPEN_ERROR;
+	}
+
+	void* pData = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+	if (!pData)
+	{
+		CloseHandle(hMapping);
+		return MSV_OPEN_ERROR;
+	}
+
+	m_hMapping = hMapping;
+	size_t size = static_cast<size_t>(fileSize.QuadPart);
+#else
+	int fd = open(filePath, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+	{
+		return MSV_OPEN_ERROR;
+	}
+
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+	{
+		close(fd);
+		return MSV_OPEN_ERROR;
+	}
+
+	//mapping keeps file referenced -> file descriptor is not needed anymore
+	void* pData = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (pData == MAP_FAILED)
+	{
+		return MSV_OPEN_ERROR;
+	}
+
+	size_t size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+	m_pData = static_cast<const uint8_t*>(pData);
+	m_size = size;
+
+	return MSV_SUCCESS;
+}
+
+void MsvMappedFile::Unmap()
+{
+	if (!m_pData)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	UnmapViewOfFile(m_pData);
+	CloseHandle(static_cast<HANDLE>(m_hMapping));
+#else
+	munmap(const_cast<uint8_t*>(m_pData), m_size);
+#endif
+
+	m_pData = nullptr;
+	m_size = 0;
+	m_hMapping = nullptr;
+}
+
+const uint8_t* MsvMappedFile::GetData() const
+{
+	return m_pData;
+}
+
+size_t MsvMappedFile::GetSize() const
+{
+	return m_size;
+}
+
+void MsvMappedFile::Swap(MsvMappedFile& other)
+{
+	std::swap(m_pData, other.m_pData);
+	std::swap(m_size, other.m_size);
+	std::swap(m_hMapping, other.m_hMapping);
+}
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,126 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Mapped File
+* @details		Contains declaration of @ref MsvMappedFile (read only memory mapped file).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_MAPPEDFILE_H
+#define MARSTECH_MAPPEDFILE_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstddef>
+#include <cstdint>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Mapped File.
+* @details	Read only memory mapped file (mmap on POSIX systems, file mapping on Windows). Mapped pages
+*				are shared by all processes which map the same file.
+* @note		It is not thread safe, owner is responsible for synchronization.
+******************************************************************************************************/
+class MsvMappedFile
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	******************************************************************************************************/
+	MsvMappedFile();
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	* @details	Unmaps file (when mapped).
+	******************************************************************************************************/
+	virtual ~MsvMappedFile();
+
+	/**************************************************************************************************//**
+	* @brief			Map file.
+	* @details		Maps whole file to memory (read only). Previously mapped file is unmapped.
+	* @param[in]	filePath		Path to file.
+	* @retval		MSV_OPEN_ERROR		When file could not be opened or mapped (or it is empty).
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Map(const char* filePath);
+
+	/**************************************************************************************************//**
+	* @brief			Unmap file.
+	* @details		Unmaps file (when mapped). All pointers returned by @ref GetData are invalid after this call.
+	******************************************************************************************************/
+	virtual void Unmap();
+
+	/**************************************************************************************************//**
+	* @brief			Get mapped data.
+	* @returns		Pointer to mapped data or nullptr (when file is not mapped).
+	******************************************************************************************************/
+	virtual const uint8_t* GetData() const;
+
+	/**************************************************************************************************//**
+	* @brief			Get mapped size.
+	* @returns		Size of mapped data (in bytes), 0 when file is not mapped.
+	******************************************************************************************************/
+	virtual size_t GetSize() const;
+
+	/**************************************************************************************************//**
+	* @brief			Swap mapped files.
+	* @details		Swaps mapped files of this and other object.
+	* @param[in]	other		Other mapped file.
+	******************************************************************************************************/
+	virtual void Swap(MsvMappedFile& other);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Mapped data.
+	* @details	Pointer to mapped file content.
+	******************************************************************************************************/
+	const uint8_t* m_pData;
+
+	/**************************************************************************************************//**
+	* @brief		Mapped size.
+	* @details	Size of mapped file content (in bytes).
+	******************************************************************************************************/
+	size_t m_size;
+
+	/**************************************************************************************************//**
+	* @brief		Mapping handle.
+	* @details	File mapping handle (used only on Windows).
+	******************************************************************************************************/
+	void* m_hMapping;
+};
+
+
+#endif // !MARSTECH_MAPPEDFILE_H
+
+/** @} */	//End of group MCONFIG.
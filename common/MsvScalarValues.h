@@ -0,0 +1,289 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Scalar Values
+* @details		Contains @ref MsvScalarValues (seqlock protected storage of scalar config values).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_SCALARVALUES_H
+#define MARSTECH_SCALARVALUES_H
+
+
+#include "MsvConfigValues.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Scalar Values.
+* @details	Storage of scalar config values (bool, double, int64_t and uint64_t) for lock free reads.
+*				Config IDs (slots) are fixed at construction, values are protected by sequence lock
+*				(seqlock). Writer makes sequence odd, updates slots and makes sequence even again. Reader
+*				copies value and retries when sequence has changed (or it was odd) meanwhile. Readers never
+*				take lock and never write shared memory (cache line).
+* @note		Writers must be serialized by owner (only one writer at a time).
+******************************************************************************************************/
+class MsvScalarValues
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Scalar type.
+	* @details	Type of value stored in slot (MSV_SCALAR_NONE when slot has no value).
+	******************************************************************************************************/
+	enum class MsvScalarType: uint32_t
+	{
+		MSV_SCALAR_NONE = 0,
+		MSV_SCALAR_BOOL,
+		MSV_SCALAR_DOUBLE,
+		MSV_SCALAR_INTEGER,
+		MSV_SCALAR_UNSIGNED
+	};
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Slots are allocated without throwing, allocation failure is reported by @ref IsValid.
+	* @param[in]	cfgIds		All config IDs which might have scalar value.
+	******************************************************************************************************/
+	MsvScalarValues(std::vector<int32_t> cfgIds):
+		m_sequence(0)
+	{
+		//sort own copy before it is moved to member (move assignment does not allocate)
+		std::sort(cfgIds.begin(), cfgIds.end());
+		m_cfgIds = std::move(cfgIds);
+
+		m_slots.reset(new (std::nothrow) MsvScalarSlot[m_cfgIds.size()]);
+		if (!m_slots)
+		{
+			//no slots -> no config IDs (lookups fail instead of reading invalid memory)
+			m_cfgIds.clear();
+			return;
+		}
+
+		for (size_t i = 0; i < m_cfgIds.size(); ++i)
+		{
+			m_slots[i].m_type.store(static_cast<uint32_t>(MsvScalarType::MSV_SCALAR_NONE), std::memory_order_relaxed);
+			m_slots[i].m_value.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	/**************************************************************************************************//**
+	* @brief		Check validity.
+	* @details	Checks if slots have been allocated by constructor.
+	* @returns	True when slots have been allocated, false otherwise.
+	******************************************************************************************************/
+	bool IsValid() const
+	{
+		return m_slots != nullptr;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Update values.
+	* @details		Updates all slots from config values (slots without value are cleared).
+	* @param[in]	values		Config values.
+	******************************************************************************************************/
+	void Update(const MsvConfigValues& values)
+	{
+		BeginWrite();
+
+		for (size_t i = 0; i < m_cfgIds.size(); ++i)
+		{
+			uint32_t type = static_cast<uint32_t>(MsvScalarType::MSV_SCALAR_NONE);
+			uint64_t value = 0;
+
+			if (!Find(values.m_boolValues, m_cfgIds[i], MsvScalarType::MSV_SCALAR_BOOL, type, value)
+				&& !Find(values.m_doubleValues, m_cfgIds[i], MsvScalarType::MSV_SCALAR_DOUBLE, type, value)
+				&& !Find(values.m_integerValues, m_cfgIds[i], MsvScalarType::MSV_SCALAR_INTEGER, type, value))
+			{
+				Find(values.m_unsignedValues, m_cfgIds[i], MsvScalarType::MSV_SCALAR_UNSIGNED, type, value);
+			}
+
+			m_slots[i].m_type.store(type, std::memory_order_relaxed);
+			m_slots[i].m_value.store(value, std::memory_order_relaxed);
+		}
+
+		EndWrite();
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Get value.
+	* @details		Lock free read of scalar value (bool, double, int64_t or uint64_t).
+	* @param[in]	cfgId		Config ID to get its value.
+	* @param[out]	value		Found and returned value.
+	* @retval		MSV_NOT_FOUND_ERROR			When config ID (cfgId) with requested type does not exist.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	template<class T> MsvErrorCode GetValue(int32_t cfgId, T& value) const
+	{
+		//config IDs are immutable -> no synchronization needed
+		std::vector<int32_t>::const_iterator it = std::lower_bound(m_cfgIds.begin(), m_cfgIds.end(), cfgId);
+		if (it == m_cfgIds.end() || *it != cfgId)
+		{
+			return MSV_NOT_FOUND_ERROR;
+		}
+
+		const MsvScalarSlot& slot = m_slots[it - m_cfgIds.begin()];
+		uint32_t type;
+		uint64_t bits;
+
+		for (;;)
+		{
+			uint64_t sequence = m_sequence.load(std::memory_order_acquire);
+			if (sequence & 1)
+			{
+				//writer is updating values -> wait
+				std::this_thread::yield();
+				continue;
+			}
+
+			type = slot.m_type.load(std::memory_order_relaxed);
+			bits = slot.m_value.load(std::memory_order_relaxed);
+
+			//slot loads must not be reordered after sequence check
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (m_sequence.load(std::memory_order_relaxed) == sequence)
+			{
+				break;
+			}
+		}
+
+		if (type != static_cast<uint32_t>(GetType(value)))
+		{
+			return MSV_NOT_FOUND_ERROR;
+		}
+
+		FromBits(bits, value);
+		return MSV_SUCCESS;
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Scalar slot.
+	* @details	One scalar value (atomic members -> torn reads are detected by sequence, not undefined).
+	******************************************************************************************************/
+	struct MsvScalarSlot
+	{
+		std::atomic<uint32_t> m_type;			//!< Value type (@ref MsvScalarType).
+		std::atomic<uint64_t> m_value;		//!< Value (bit copy).
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Begin write.
+	* @details	Makes sequence odd (readers retry until @ref EndWrite).
+	******************************************************************************************************/
+	void BeginWrite()
+	{
+		m_sequence.store(m_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+		//slot stores must not be reordered before sequence store
+		std::atomic_thread_fence(std::memory_order_release);
+	}
+
+	/**************************************************************************************************//**
+	* @brief		End write.
+	* @details	Makes sequence even (publishes written values).
+	******************************************************************************************************/
+	void EndWrite()
+	{
+		m_sequence.store(m_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Find value.
+	* @details		Finds value in config values storage and converts it to slot data.
+	* @param[in]	values		Config values storage.
+	* @param[in]	cfgId			Config ID.
+	* @param[in]	valueType	Type of values in storage.
+	* @param[out]	type			Slot type (set only when value has been found).
+	* @param[out]	bits			Slot value (set only when value has been found).
+	* @returns		True when value has been found, false otherwise.
+	******************************************************************************************************/
+	template<class T> static bool Find(const std::map<int32_t, T>& values, int32_t cfgId, MsvScalarType valueType, uint32_t& type, uint64_t& bits)
+	{
+		typename std::map<int32_t, T>::const_iterator it = values.find(cfgId);
+		if (it == values.end())
+		{
+			return false;
+		}
+
+		type = static_cast<uint32_t>(valueType);
+		bits = ToBits(it->second);
+		return true;
+	}
+
+	static MsvScalarType GetType(const bool&) { return MsvScalarType::MSV_SCALAR_BOOL; }					//!< Gets scalar type of bool.
+	static MsvScalarType GetType(const double&) { return MsvScalarType::MSV_SCALAR_DOUBLE; }				//!< Gets scalar type of double.
+	static MsvScalarType GetType(const int64_t&) { return MsvScalarType::MSV_SCALAR_INTEGER; }			//!< Gets scalar type of int64_t.
+	static MsvScalarType GetType(const uint64_t&) { return MsvScalarType::MSV_SCALAR_UNSIGNED; }		//!< Gets scalar type of uint64_t.
+
+	static uint64_t ToBits(bool value) { return value ? 1 : 0; }													//!< Converts bool to bits.
+	static uint64_t ToBits(double value) { uint64_t bits; memcpy(&bits, &value, sizeof(bits)); return bits; }		//!< Converts double to bits.
+	static uint64_t ToBits(int64_t value) { return static_cast<uint64_t>(value); }							//!< Converts int64_t to bits.
+	static uint64_t ToBits(uint64_t value) { return value; }														//!< Converts uint64_t to bits.
+
+	static void FromBits(uint64_t bits, bool& value) { value = bits != 0; }									//!< Converts bits to bool.
+	static void FromBits(uint64_t bits, double& value) { memcpy(&value, &bits, sizeof(value)); }		//!< Converts bits to double.
+	static void FromBits(uint64_t bits, int64_t& value) { value = static_cast<int64_t>(bits); }		//!< Converts bits to int64_t.
+	static void FromBits(uint64_t bits, uint64_t& value) { value = bits; }									//!< Converts bits to uint64_t.
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Sequence.
+	* @details	Odd while writer updates values (own cache line -> it is not shared with other data).
+	******************************************************************************************************/
+	alignas(64) std::atomic<uint64_t> m_sequence;
+
+	/**************************************************************************************************//**
+	* @brief		Config IDs.
+	* @details	Sorted config IDs (index to slots), immutable after construction.
+	******************************************************************************************************/
+	alignas(64) std::vector<int32_t> m_cfgIds;
+
+	/**************************************************************************************************//**
+	* @brief		Slots.
+	* @details	Scalar values (one slot per config ID).
+	******************************************************************************************************/
+	std::unique_ptr<MsvScalarSlot[]> m_slots;
+};
+
+
+#endif // !MARSTECH_SCALARVALUES_H
+
+/** @} */	//End of group MCONFIG.
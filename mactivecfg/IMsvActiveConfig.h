@@ -35,19 +35,33 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 #define MARSTECH_IACTIVECONFIG_H
 
 
+#include "IMsvActiveConfigBatchCallback.h"
 #include "IMsvActiveConfigCallback.h"
 #include "mconfig/common/IMsvConfigKeyMap.h"
 #include "mconfig/common/IMsvDefaultValue.h"
+#include "mconfig/common/MsvConfigOverrides.h"
+#include "mconfig/common/MsvConfigSnapshot.h"
+#include "mconfig/common/MsvConfigValue.h"
 
 #include "merror/MsvError.h"
 
 MSV_DISABLE_ALL_WARNINGS
 
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 MSV_ENABLE_WARNINGS
 
 
+/**************************************************************************************************//**
+* @brief		Infinite wait.
+* @details	Timeout of @ref IMsvActiveConfig::WaitForChange which waits until some config ID is changed.
+******************************************************************************************************/
+#define MSV_ACTIVECONFIG_WAIT_INFINITE UINT32_MAX
+
+
 /**************************************************************************************************//**
 * @brief		MarsTech Active Config Interface.
 * @details	Interface for active configuration.
@@ -84,6 +98,23 @@ public:
 	* @retval		MSV_SUCCESS							On success.
 	******************************************************************************************************/
 	virtual MsvErrorCode Uninitialize() = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Retarget active configuration.
+	* @details		Switches initialized config to other database or group without interruption. New database is
+	*					opened and all its values are loaded while readers and writers still use current database,
+	*					then readers are switched at once. Callbacks (and notification handle) of this config are
+	*					notified only about values which differ in new database. Versions and journal belong to
+	*					database (change waiters are woken with MSV_BUSY_ERROR, they and journal consumers should
+	*					resync after retarget).
+	* @param[in]	configPath			Path to new active config database.
+	* @param[in]	groupName			New active config group name.
+	* @retval		MSV_NOT_INITIALIZED_ERROR		When config has not been initialized.
+	* @retval		MSV_BUSY_ERROR						When config has been uninitialized (or retargeted) meanwhile.
+	* @retval		other_error_code					When new database could not be opened (current one is still used).
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Retarget(const char* configPath, const char* groupName = "MsvConfig") = 0;
 	
 	/**************************************************************************************************//**
 	* @brief			Initialize check.
@@ -196,6 +227,33 @@ public:
 	******************************************************************************************************/
 	virtual MsvErrorCode SetValue(int32_t cfgId, const std::string& value) = 0;
 
+	/**************************************************************************************************//**
+	* @brief			Set string value (moved value).
+	* @details		Sets string value to active configuration. Value is moved to cache, it is shared with
+	*					storage and callbacks (it is not copied).
+	* @param[in]	cfgId		Config ID to set its value.
+	* @param[in]	value		New value of config ID.
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_NOT_FOUND_ERROR			When config ID (cfgId) does not exist.
+	* @retval		other_error_code				When failed.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode SetValue(int32_t cfgId, std::string&& value) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Set string value (shared value).
+	* @details		Sets string value to active configuration. Shared value is kept by cache, bound to storage
+	*					and passed to callbacks (it is not copied).
+	* @param[in]	cfgId		Config ID to set its value.
+	* @param[in]	spValue	New value of config ID (immutable, must not be null).
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_NOT_FOUND_ERROR			When config ID (cfgId) does not exist.
+	* @retval		MSV_INVALID_DATA_ERROR		When value is null.
+	* @retval		other_error_code				When failed.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode SetValue(int32_t cfgId, const std::shared_ptr<const std::string>& spValue) = 0;
+
 	/**************************************************************************************************//**
 	* @brief			Set unsigned integer value.
 	* @details		Sets uint64_t value to active configuration.
@@ -208,6 +266,19 @@ public:
 	******************************************************************************************************/
 	virtual MsvErrorCode SetValue(int32_t cfgId, uint64_t value) = 0;
 
+	/**************************************************************************************************//**
+	* @brief			Set values.
+	* @details		Sets more values to active configuration at once (multi-key write). Batch callbacks are
+	*					notified once for all changed values.
+	* @param[in]	values		New values of config IDs (type of value must match type of config ID).
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_NOT_FOUND_ERROR			When any config ID does not exist (nothing is set).
+	* @retval		MSV_INVALID_DATA_ERROR		When any value has different type than config ID (nothing is set).
+	* @retval		other_error_code				When failed (values before failed one are set).
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode SetValues(const std::vector<MsvConfigValueUpdate>& values) = 0;
+
 	/**************************************************************************************************//**
 	* @brief			Register active config callback.
 	* @details		Registers active config callback which is called when active configuration has been changed.
@@ -218,15 +289,199 @@ public:
 	******************************************************************************************************/
 	virtual MsvErrorCode RegisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback) = 0;
 
+	/**************************************************************************************************//**
+	* @brief			Register active config callback for config ID.
+	* @details		Registers active config callback which is called only when value of config ID has been changed.
+	* @param[in]	spCallback		Callback to register.
+	* @param[in]	cfgId				Config ID which changes are notified.
+	* @retval		MSV_ALREADY_REGISTERED_INFO	When callback has been already registered for config ID (this is info, not error).
+	* @retval		MSV_SUCCESS							On success.
+	* @see			IMsvActiveConfigCallback
+	******************************************************************************************************/
+	virtual MsvErrorCode RegisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback, int32_t cfgId) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Register active config callback for config ID range.
+	* @details		Registers active config callback which is called only when value of config ID in range
+	*					(including first and last config ID) has been changed.
+	* @param[in]	spCallback		Callback to register.
+	* @param[in]	firstCfgId		First config ID of range.
+	* @param[in]	lastCfgId		Last config ID of range.
+	* @retval		MSV_ALREADY_REGISTERED_INFO	When callback has been already registered for the range (this is info, not error).
+	* @retval		MSV_INVALID_DATA_ERROR			When first config ID is greater than last config ID.
+	* @retval		MSV_SUCCESS							On success.
+	* @see			IMsvActiveConfigCallback
+	******************************************************************************************************/
+	virtual MsvErrorCode RegisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback, int32_t firstCfgId, int32_t lastCfgId) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Register active config callback for config ID group.
+	* @details		Registers active config callback which is called only when value of any config ID from group
+	*					has been changed.
+	* @param[in]	spCallback		Callback to register.
+	* @param[in]	cfgIds			Config IDs (group) which changes are notified.
+	* @retval		MSV_ALREADY_REGISTERED_INFO	When callback has been already registered for all config IDs (this is info, not error).
+	* @retval		MSV_SUCCESS							On success.
+	* @see			IMsvActiveConfigCallback
+	******************************************************************************************************/
+	virtual MsvErrorCode RegisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback, const std::vector<int32_t>& cfgIds) = 0;
+
 	/**************************************************************************************************//**
 	* @brief			Unregister active config callback.
 	* @details		Unregisters active config callback which is called when active configuration has been changed.
+	*					All registrations of the callback (all config IDs, ranges and groups) are removed.
 	* @param[in]	spCallback		Callback to unregister.
 	* @retval		MSV_SUCCESS		On success.
 	* @see			IMsvActiveConfigCallback
 	******************************************************************************************************/
 	virtual MsvErrorCode UnregisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback) = 0;
 
+	/**************************************************************************************************//**
+	* @brief			Register active config batch callback.
+	* @details		Registers active config batch callback which is called once per batch of changed values.
+	* @param[in]	spCallback		Callback to register.
+	* @retval		MSV_ALREADY_REGISTERED_INFO	When callback has been already registered (this is info, not error).
+	* @retval		MSV_SUCCESS							On success.
+	* @see			IMsvActiveConfigBatchCallback
+	******************************************************************************************************/
+	virtual MsvErrorCode RegisterBatchCallback(std::shared_ptr<IMsvActiveConfigBatchCallback> spCallback) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Unregister active config batch callback.
+	* @details		Unregisters active config batch callback.
+	* @param[in]	spCallback		Callback to unregister.
+	* @retval		MSV_SUCCESS		On success.
+	* @see			IMsvActiveConfigBatchCallback
+	******************************************************************************************************/
+	virtual MsvErrorCode UnregisterBatchCallback(std::shared_ptr<IMsvActiveConfigBatchCallback> spCallback) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Get version.
+	* @details		Returns current version of active configuration (it is incremented by each change of value).
+	*					Get version before values are read and use it as since version of @ref WaitForChange, so
+	*					no change made after values have been read is missed.
+	* @param[out]	version		Current version (zero when nothing has been changed yet).
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode GetVersion(uint64_t& version) const = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Wait for change.
+	* @details		Blocks until config ID is changed after since version or until timeout elapses. It returns
+	*					immediately when config ID has been already changed.
+	* @param[in]	cfgId				Config ID to wait for.
+	* @param[in]	sinceVersion	Version which has been already seen (see @ref GetVersion).
+	* @param[in]	timeoutMs		Timeout in milliseconds (zero does not wait, @ref MSV_ACTIVECONFIG_WAIT_INFINITE waits
+	*										without timeout).
+	* @param[out]	version			Version of last change of config ID (it is greater than since version) or since
+	*										version when timeout has elapsed.
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_NOT_FOUND_ERROR			When config ID (cfgId) does not exist.
+	* @retval		MSV_BUSY_ERROR					When config has been retargeted or uninitialized while waiting (version
+	*													is since version, waiter has to resync).
+	* @retval		MSV_SUCCESS						On success (change or timeout).
+	******************************************************************************************************/
+	virtual MsvErrorCode WaitForChange(int32_t cfgId, uint64_t sinceVersion, uint32_t timeoutMs, uint64_t& version) const = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Wait for change.
+	* @details		Blocks until some of config IDs is changed after since version or until timeout elapses. It
+	*					returns immediately when some of config IDs has been already changed.
+	* @param[in]	cfgIds			Config IDs to wait for.
+	* @param[in]	sinceVersion	Version which has been already seen (see @ref GetVersion).
+	* @param[in]	timeoutMs		Timeout in milliseconds (zero does not wait, @ref MSV_ACTIVECONFIG_WAIT_INFINITE waits
+	*										without timeout).
+	* @param[out]	version			Version of last change of config IDs (it is greater than since version) or since
+	*										version when timeout has elapsed.
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_NOT_FOUND_ERROR			When some config ID (cfgIds) does not exist.
+	* @retval		MSV_BUSY_ERROR					When config has been retargeted or uninitialized while waiting (version
+	*													is since version, waiter has to resync).
+	* @retval		MSV_SUCCESS						On success (change or timeout).
+	******************************************************************************************************/
+	virtual MsvErrorCode WaitForChange(const std::vector<int32_t>& cfgIds, uint64_t sinceVersion, uint32_t timeoutMs, uint64_t& version) const = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Poll changes.
+	* @details		Returns changes made after last sequence from in-memory journal (sequence is version of
+	*					change, see @ref GetVersion). It does not block writers for longer than copy of changes.
+	*					When consumer is too far behind (its changes have been overwritten), it must resync: read
+	*					all values it needs and continue polling from returned sequence.
+	* @param[in]	lastSequence	Sequence number of last change seen by consumer (0 -> nothing has been seen).
+	* @param[out]	changes			Changes made after last sequence in sequence order (they are appended).
+	* @param[out]	sequence			Sequence number of last change (last sequence of next poll).
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_NOT_FOUND_ERROR			When changes after last sequence are not in journal anymore (overrun,
+	*													consumer must resync).
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode PollChanges(uint64_t lastSequence, std::vector<MsvConfigValueJournalEntry>& changes, uint64_t& sequence) const = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Get notification handle.
+	* @details		Returns pollable handle (eventfd) which is readable (POLLIN) while some changes are pending,
+	*					so config changes might be handled by event loop (epoll, io_uring, etc.) without callbacks
+	*					and extra threads. Changes are collected after first call. Use @ref DrainChanges to get
+	*					pending changes and to reset handle. Handle is owned by config (do not read or close it).
+	* @param[out]	handle		Pollable file descriptor.
+	* @retval		MSV_NOT_FOUND_ERROR		When pollable handle is not supported (eventfd is available only on Linux).
+	* @retval		MSV_OPEN_ERROR				When handle could not be opened.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode GetNotificationHandle(int& handle) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Drain changes.
+	* @details		Returns config IDs changed since last drain and resets notification handle. It never blocks,
+	*					current values are read by GetValue.
+	* @param[out]	changedCfgIds		Changed config IDs (sorted, each only once, empty when nothing is pending).
+	* @retval		MSV_SUCCESS		On success.
+	* @see			GetNotificationHandle
+	******************************************************************************************************/
+	virtual MsvErrorCode DrainChanges(std::vector<int32_t>& changedCfgIds) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Get snapshot.
+	* @details		Returns immutable view of all values of active config database. Values are read from it
+	*					without locks and they are consistent (changes made later are not visible). Snapshot is cached
+	*					until next change, so taking it is cheap (shared pointer copy) and it might be held as long as
+	*					needed. In lazy mode all values are loaded by first call.
+	* @param[out]	spSnapshot		Current snapshot.
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_ALLOCATION_ERROR			When snapshot allocation failed.
+	* @retval		other_error_code				When loading of values (lazy mode) failed.
+	* @retval		MSV_SUCCESS						On success.
+	* @see			MsvConfigSnapshot
+	******************************************************************************************************/
+	virtual MsvErrorCode GetSnapshot(std::shared_ptr<const MsvConfigSnapshot>& spSnapshot) const = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Push overrides.
+	* @details		Overrides values for calling thread only (other threads still read stored values). Overrides
+	*					are not written to storage and they are not notified. The most recently pushed value wins.
+	*					When calling thread has no overrides, reads check only one thread local pointer.
+	* @param[in]	values		Overridden values.
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_NOT_FOUND_ERROR			When some config ID does not exist.
+	* @retval		MSV_INVALID_DATA_ERROR		When some value has other type.
+	* @retval		MSV_ALLOCATION_ERROR		When allocation failed.
+	* @retval		MSV_SUCCESS						On success.
+	* @note		Snapshots and derived values do not contain overrides.
+	* @warning		Pushed overrides must be popped by the same thread (@ref MsvConfigOverrideScope).
+	* @see			PopOverrides
+	******************************************************************************************************/
+	virtual MsvErrorCode PushOverrides(const std::vector<MsvConfigValueUpdate>& values) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Pop overrides.
+	* @details		Removes overrides pushed last by calling thread.
+	* @retval		MSV_NOT_FOUND_ERROR			When calling thread has no overrides.
+	* @retval		MSV_SUCCESS						On success.
+	* @see			PushOverrides
+	******************************************************************************************************/
+	virtual MsvErrorCode PopOverrides() = 0;
+
 	/*-----------------------------------------------------------------------------------------------------
 	**										IMsvDefaultValue inline public methods
 	**---------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,75 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Active Config Batch Callback Interface
+* @details		Contains interface of MarsTech Active Config Batch Callback.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_IACTIVECONFIG_BATCHCALLBACK_H
+#define MARSTECH_IACTIVECONFIG_BATCHCALLBACK_H
+
+
+#include "mconfig/common/MsvConfigValue.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Batch Callback Interface.
+* @details	Interface for active configuration callback which notifies about data changes in batches.
+*				One notification is delivered per multi-key write (@ref IMsvActiveConfig::SetValues) or per
+*				coalescing window of single writes, so subscriber rebuilds its state once per batch.
+* @warning	This callback works only with one instance of active config and it is not cross process.
+******************************************************************************************************/
+class IMsvActiveConfigBatchCallback
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~IMsvActiveConfigBatchCallback() {}
+
+	/**************************************************************************************************//**
+	* @brief			Values have been changed.
+	* @details		This method is called once per batch of changed values (callback must be registered before).
+	* @param[in]	values		Changed config IDs with its new values (sorted by config ID, each config ID
+	*									is there only once with its last value).
+	******************************************************************************************************/
+	virtual void OnValuesChanged(const std::vector<MsvConfigValueUpdate>& values) = 0;
+};
+
+
+#endif // !MARSTECH_IACTIVECONFIG_BATCHCALLBACK_H
+
+/** @} */	//End of group MCONFIG.
@@ -37,6 +37,13 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 
 #include "merror/MsvError.h"
 
+MSV_DISABLE_ALL_WARNINGS
+
+#include <memory>
+#include <string>
+
+MSV_ENABLE_WARNINGS
+
 
 /**************************************************************************************************//**
 * @brief		MarsTech Active Config Callback Interface.
@@ -86,6 +93,19 @@ public:
 	******************************************************************************************************/
 	virtual void OnValueChanged(int32_t cfgId, const char* newValue) = 0;
 
+	/**************************************************************************************************//**
+	* @brief			String value has been changed (shared value).
+	* @details		This method is called when string value has been changed (callback must be registered before).
+	*					Shared value might be kept by callback without copy. Default implementation calls
+	*					@ref OnValueChanged(int32_t cfgId, const char* newValue).
+	* @param[in]	cfgId			Config ID of changed value.
+	* @param[in]	spNewValue	New value, current value (immutable, it is shared with active config cache).
+	******************************************************************************************************/
+	virtual void OnValueChanged(int32_t cfgId, const std::shared_ptr<const std::string>& spNewValue)
+	{
+		OnValueChanged(cfgId, spNewValue->c_str());
+	}
+
 	/**************************************************************************************************//**
 	* @brief			Unsigned integer value has been changed.
 	* @details		This method is called when uint64_t value has been changed (callback must be registered before).
@@ -38,10 +38,13 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 #include "IMsvActiveConfigStorageCallback.h"
 #include "mconfig/common/IMsvConfigKeyMap.h"
 #include "mconfig/common/IMsvDefaultValue.h"
+#include "mconfig/common/MsvCallbackWatchdog.h"
 
 MSV_DISABLE_ALL_WARNINGS
 
+#include <memory>
 #include <string>
+#include <vector>
 
 MSV_ENABLE_WARNINGS
 
@@ -200,6 +203,32 @@ public:
 	******************************************************************************************************/
 	virtual MsvErrorCode StoreValue(int32_t cfgId, const std::string& value) = 0;
 
+	/**************************************************************************************************//**
+	* @brief			Store string value (moved value).
+	* @details		Stores string value to active configuration. Value is moved to shared value which is passed
+	*					to callbacks (it is not copied).
+	* @param[in]	cfgId		Config ID to store its value.
+	* @param[in]	value		New value of config ID.
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_NOT_FOUND_ERROR			When config ID (cfgId) does not exist.
+	* @retval		other_error_code				When failed.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode StoreValue(int32_t cfgId, std::string&& value) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Store string value (shared value).
+	* @details		Stores string value to active configuration. Shared value is bound to storage query and
+	*					passed to callbacks (it is not copied).
+	* @param[in]	cfgId		Config ID to store its value.
+	* @param[in]	spValue	New value of config ID (must not be null).
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_NOT_FOUND_ERROR			When config ID (cfgId) does not exist.
+	* @retval		other_error_code				When failed.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode StoreValue(int32_t cfgId, const std::shared_ptr<const std::string>& spValue) = 0;
+
 	/**************************************************************************************************//**
 	* @brief			Store unsigned integer value.
 	* @details		Stores uint64_t value to active configuration.
@@ -230,6 +259,21 @@ public:
 	* @see			IMsvActiveConfigStorageCallback
 	******************************************************************************************************/
 	virtual MsvErrorCode UnregisterCallback(std::shared_ptr<IMsvActiveConfigStorageCallback> spCallback) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Set callback budget.
+	* @details		Sets maximal expected duration of one storage callback call. Each call is measured, calls
+	*					exceeding budget are reported (logged with the callback).
+	* @param[in]	budgetUs		Budget in microseconds (0 -> no budget, only statistics are collected).
+	******************************************************************************************************/
+	virtual void SetCallbackBudget(uint32_t budgetUs) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Get callback report.
+	* @details		Returns time spent in each registered storage callback.
+	* @param[out]	report		Statistics of storage callbacks (the slowest first).
+	******************************************************************************************************/
+	virtual void GetCallbackReport(std::vector<MsvCallbackReport>& report) const = 0;
 };
 
 
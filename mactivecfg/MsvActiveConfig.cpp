@@ -33,11 +33,17 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 
 #include "MsvActiveConfig.h"
 #include "MsvActiveConfig_Factory.h"
+#include "MsvActiveConfigShardedStorage.h"
+#include "MsvActiveConfigSnapshot.h"
 
 #include "merror/MsvErrorCodes.h"
 
 MSV_DISABLE_ALL_WARNINGS
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <variant>
 #include <vector>
 #include <sstream>
 
@@ -87,6 +93,14 @@ void MsvActiveConfig::MsvActiveConfigStorageCallback::OnValueChanged(int32_t cfg
 	}
 }
 
+void MsvActiveConfig::MsvActiveConfigStorageCallback::OnValueChanged(int32_t cfgId, const std::shared_ptr<const std::string>& spNewValue)
+{
+	if (m_pConfig)
+	{
+		m_pConfig->OnValueChanged<std::shared_ptr<const std::string>>(cfgId, spNewValue);
+	}
+}
+
 void MsvActiveConfig::MsvActiveConfigStorageCallback::OnValueChanged(int32_t cfgId, uint64_t newValue)
 {
 	if (m_pConfig)
@@ -102,8 +116,19 @@ void MsvActiveConfig::MsvActiveConfigStorageCallback::OnValueChanged(int32_t cfg
 
 MsvActiveConfig::MsvActiveConfig(std::shared_ptr<MsvActiveConfig_Factory> spFactory, std::shared_ptr<MsvLogger> spLogger):
 	m_initialized(false),
+	m_lazyLoading(false),
+	m_journalSize(MSV_ACTIVECONFIG_JOURNAL_SIZE),
+	m_writeShards(1),
 	m_spFactory(spFactory ? spFactory : MsvActiveConfig_Factory::Get()),
-	m_spLogger(spLogger)
+	m_spLogger(spLogger),
+	m_databaseEpoch(0),
+	m_spNotifier(new (std::nothrow) MsvChangeNotifier()),
+	m_spDerived(new (std::nothrow) MsvActiveConfigDerived(*this, [this](int32_t cfgId, const MsvConfigValue& newValue) { OnDerivedValueChanged(cfgId, newValue); }, spLogger)),
+	m_quarantine(false),
+	m_batchDepth(0),
+	m_coalescingWindow(0),
+	m_flushScheduled(false),
+	m_stopFlush(false)
 {
 
 }
@@ -117,6 +142,7 @@ MsvActiveConfig::MsvActiveConfig(std::shared_ptr<MsvLogger> spLogger):
 MsvActiveConfig::~MsvActiveConfig()
 {
 	Uninitialize();
+	StopFlushThread();
 }
 
 
@@ -137,125 +163,51 @@ MsvErrorCode MsvActiveConfig::Initialize(std::shared_ptr<IMsvConfigKeyMap<IMsvDe
 		return MSV_ALREADY_INITIALIZED_INFO;
 	}
 
-	std::shared_ptr<IMsvActiveConfigStorage> spStorage = m_spFactory->GetIMsvActiveConfigStorage(m_spLogger);
-	if (!spStorage)
+	//instances on the same database and group share storage, connection and value cache
+	std::shared_ptr<MsvActiveConfigDatabase> spDatabase;
+	MsvErrorCode errorCode = MsvActiveConfigRegistry::Get().GetDatabase(configPath, groupName, [this, spConfigKeyMap, configPath, groupName](MsvActiveConfigDatabase& database)
 	{
-		//allocation failed
-		MSV_LOG_ERROR(m_spLogger, "Get active configuration storage failed with error: {0:x}", MSV_ALLOCATION_ERROR);
-		return MSV_ALLOCATION_ERROR;
-	}
+		return OpenDatabase(spConfigKeyMap, configPath, groupName, database, true);
+	}, spDatabase);
 
-	MsvErrorCode errorCode = spStorage->Initialize(spConfigKeyMap, configPath, groupName);
 	if (MSV_FAILED(errorCode))
 	{
-		//initialize config storage failed
-		MSV_LOG_ERROR(m_spLogger, "Initialize active configuration storage failed with error: {0:x}", errorCode);
+		MSV_LOG_ERROR(m_spLogger, "Open active configuration database failed with error: {0:x}", errorCode);
 		return errorCode;
 	}
-
-	std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>::const_iterator endIt = spConfigKeyMap->GetMap().end();
-	for (std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>::const_iterator it = spConfigKeyMap->GetMap().begin(); it != endIt; ++it)
+	else if (errorCode == MSV_ALREADY_EXISTS_INFO)
 	{
-		int32_t cfgId = it->first;
-
-		if (it->second->IsBool())
-		{
-			bool value = false;
-			if (MSV_FAILED(errorCode = spStorage->GetValue(it->first, value)))
-			{
-				MSV_LOG_ERROR(m_spLogger, "Get bool value {} from configuration storage failed with error: {0:x}", it->first, errorCode);
-				break;
-			}
-
-			m_boolValues[cfgId] = value;
-		}
-		else if (it->second->IsDouble())
-		{
-			double value = 0.0;
-			if (MSV_FAILED(errorCode = spStorage->GetValue(it->first, value)))
-			{
-				MSV_LOG_ERROR(m_spLogger, "Get double value {} from configuration storage failed with error: {0:x}", it->first, errorCode);
-				break;
-			}
-
-			m_doubleValues[cfgId] = value;
-		}
-		else if (it->second->IsInteger())
-		{
-			int64_t value = 0;
-			if (MSV_FAILED(errorCode = spStorage->GetValue(it->first, value)))
-			{
-				MSV_LOG_ERROR(m_spLogger, "Get int64_t value {} from configuration storage failed with error: {0:x}", it->first, errorCode);
-				break;
-			}
-
-			m_integerValues[cfgId] = value;
-		}
-		else if (it->second->IsString())
-		{
-			std::string value;
-			if (MSV_FAILED(errorCode = spStorage->GetValue(it->first, value)))
-			{
-				MSV_LOG_ERROR(m_spLogger, "Get string value {} from configuration storage failed with error: {0:x}", it->first, errorCode);
-				break;
-			}
-
-			m_stringValues[cfgId] = value;
-		}
-		else if (it->second->IsUnsigned())
-		{
-			uint64_t value;
-			if (MSV_FAILED(errorCode = spStorage->GetValue(it->first, value)))
-			{
-				MSV_LOG_ERROR(m_spLogger, "Get uint64_t value {} from configuration storage failed with error: {0:x}", it->first, errorCode);
-				break;
-			}
-
-			m_unsignedValues[cfgId] = value;
-		}
-		else
-		{
-			errorCode = MSV_INVALID_DATA_ERROR;
-			MSV_LOG_ERROR(m_spLogger, "Unknown type of configuration value - error: {0:x}", errorCode);
-			break;
-		}
+		MSV_LOG_INFO(m_spLogger, "Active configuration database has been already opened by other instance - sharing it.");
 	}
 
 	//create storage callback before (it is shared pointer and it would be released when it was defined in if)
 	std::shared_ptr<IMsvActiveConfigStorageCallback> spStorageCallback(new (std::nothrow) MsvActiveConfigStorageCallback(this));
-	if (MSV_SUCCEEDED(errorCode))
+	if (!spStorageCallback)
 	{
-		//read configuration values from configuration storage succeeded -> register callback if it was successfully created
-		if (!spStorageCallback)
-		{
-			MSV_LOG_ERROR(m_spLogger, "Create active config storage callback failed with error: {0:x}", MSV_ALLOCATION_ERROR);
-			errorCode = MSV_ALLOCATION_ERROR;
-		}
-
-		if (MSV_FAILED(errorCode = spStorage->RegisterCallback(spStorageCallback)))
-		{
-			//just log (next error code check will handle errors)
-			MSV_LOG_ERROR(m_spLogger, "Register active configuration storage callback failed with error: {0:x}", errorCode);
-		}
+		MSV_LOG_ERROR(m_spLogger, "Create active config storage callback failed with error: {0:x}", MSV_ALLOCATION_ERROR);
+		return MSV_ALLOCATION_ERROR;
 	}
 
-	if (MSV_FAILED(errorCode))
+	if (MSV_FAILED(errorCode = AttachDatabase(spDatabase, spStorageCallback)))
 	{
-		//read configuration values from configuration storage failed or register callback failed -> clear all values
-		m_boolValues.clear();
-		m_doubleValues.clear();
-		m_integerValues.clear();
-		m_stringValues.clear();
-		m_unsignedValues.clear();
-
+		//database is released with spDatabase when it is not used by other instance
 		return errorCode;
 	}
-	
-	//set member values (storage, storage callback and initialize flag)
-	m_spStorage = spStorage;
+
+	//set member values (database, storage callback and initialize flag)
+	{
+		std::unique_lock<std::shared_mutex> databaseLock(m_databaseLock);
+		m_spDatabase = spDatabase;
+	}
 	m_spStorageCallback = spStorageCallback;
 	m_initialized = true;
 
+	//derived values registered before (config has been reinitialized) are computed from values of current database
+	if (m_spDerived)
+	{
+		m_spDerived->RecomputeAll(false);
+	}
+
 	MSV_LOG_INFO(m_spLogger, "Active configuration has been successfully initialized.");
 
 	return MSV_SUCCESS;
@@ -263,6 +215,21 @@ MsvErrorCode MsvActiveConfig::Initialize(std::shared_ptr<IMsvConfigKeyMap<IMsvDe
 
 MsvErrorCode MsvActiveConfig::Uninitialize()
 {
+	//writes of other instances notify this one under database write lock -> lock it before config lock
+	std::shared_ptr<MsvActiveConfigDatabase> spDatabase = GetDatabase();
+	std::unique_lock<MsvActiveConfigWriteLock> writeLock;
+	if (spDatabase)
+	{
+		if (spDatabase->m_writeLock.HoldsKey())
+		{
+			//called by callback of sharded write -> whole database can not be locked by this thread
+			MSV_LOG_ERROR(m_spLogger, "Active configuration can not be uninitialized during sharded write - error: {0:x}", MSV_BUSY_ERROR);
+			return MSV_BUSY_ERROR;
+		}
+
+		writeLock = std::unique_lock<MsvActiveConfigWriteLock>(spDatabase->m_writeLock);
+	}
+
 	std::lock_guard<std::recursive_mutex> lock(m_lock);
 
 	MSV_LOG_INFO(m_spLogger, "Uninitializing active configuration.");
@@ -273,28 +240,43 @@ MsvErrorCode MsvActiveConfig::Uninitialize()
 		return MSV_NOT_INITIALIZED_INFO;
 	}
 
-	MsvErrorCode errorCode = m_spStorage->UnregisterCallback(m_spStorageCallback);
-	if (MSV_FAILED(errorCode))
+	//deliver collected changes before values are released
+	DeliverChanges();
+
+	//save snapshot for next start (only verified complete cache, running verification is not waited for)
+	bool verified = false;
 	{
-		//just log error
-		MSV_LOG_ERROR(m_spLogger, "Unregister active configuration storage callback failed with error: {0:x}", errorCode);
+		std::lock_guard<std::mutex> verifyLock(m_spDatabase->m_verifyLock);
+		verified = !m_spDatabase->m_verifying;
 	}
 
-	m_spStorageCallback.reset();
+	if (!m_snapshotPath.empty() && !m_spDatabase->m_lazy && verified && m_spDatabase->m_spStorage->Initialized())
+	{
+		MsvErrorCode saveErrorCode = MsvActiveConfigSnapshot::Save(m_snapshotPath.c_str(), *m_spDatabase);
+		if (MSV_FAILED(saveErrorCode))
+		{
+			MSV_LOG_ERROR(m_spLogger, "Save active configuration snapshot failed with error: {0:x}", saveErrorCode);
+		}
+	}
 
-	if (MSV_FAILED(errorCode = m_spStorage->Uninitialize()))
+	MsvErrorCode errorCode = DetachDatabase(*m_spDatabase, m_spStorageCallback);
+	if (MSV_FAILED(errorCode))
 	{
-		MSV_LOG_ERROR(m_spLogger, "Uninitialize active configuration storage failed with error: {0:x}", errorCode);
 		return errorCode;
 	}
 
-	m_spStorage.reset();
+	m_spStorageCallback.reset();
+
+	//storage is uninitialized when the last instance releases database (readers might still hold it)
+	std::shared_ptr<MsvActiveConfigDatabase> spOldDatabase = m_spDatabase;
+	{
+		std::unique_lock<std::shared_mutex> databaseLock(m_databaseLock);
+		m_spDatabase.reset();
+		++m_databaseEpoch;
+	}
 
-	m_boolValues.clear();
-	m_doubleValues.clear();
-	m_integerValues.clear();
-	m_stringValues.clear();
-	m_unsignedValues.clear();
+	//change waiters of released database stop waiting
+	spOldDatabase->WakeWaiters();
 
 	m_initialized = false;
 
@@ -303,178 +285,1899 @@ MsvErrorCode MsvActiveConfig::Uninitialize()
 	return errorCode;
 }
 
-bool MsvActiveConfig::Initialized() const
+MsvErrorCode MsvActiveConfig::Retarget(const char* configPath, const char* groupName)
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
+	MSV_LOG_INFO(m_spLogger, "Retargeting active configuration (configPath: \"{}\", groupName: \"{}\").", configPath, groupName);
+
+	std::shared_ptr<MsvActiveConfigDatabase> spOldDatabase = GetDatabase();
+	std::shared_ptr<IMsvActiveConfigStorageCallback> spStorageCallback;
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+		spStorageCallback = m_spStorageCallback;
+	}
+
+	if (!spOldDatabase || !spStorageCallback)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration is not initialized - error:", MSV_NOT_INITIALIZED_ERROR);
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	//slow part (open and bulk load of new database) runs without locks, readers and writers still use current database
+	std::shared_ptr<MsvActiveConfigDatabase> spDatabase;
+	std::shared_ptr<IMsvConfigKeyMap<IMsvDefaultValue>> spConfigKeyMap = spOldDatabase->m_spConfigKeyMap;
+	MsvErrorCode errorCode = MsvActiveConfigRegistry::Get().GetDatabase(configPath, groupName, [this, spConfigKeyMap, configPath, groupName](MsvActiveConfigDatabase& database)
+	{
+		//snapshot belongs to initial database -> new database is always loaded from its storage
+		return OpenDatabase(spConfigKeyMap, configPath, groupName, database, false);
+	}, spDatabase);
+
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Open active configuration database failed with error: {0:x}", errorCode);
+		return errorCode;
+	}
+	else if (spDatabase == spOldDatabase)
+	{
+		MSV_LOG_INFO(m_spLogger, "Active configuration already uses requested database.");
+		return MSV_SUCCESS;
+	}
+	else if (spOldDatabase->m_writeLock.HoldsKey() || spDatabase->m_writeLock.HoldsKey())
+	{
+		//called by callback of sharded write -> whole database can not be locked by this thread
+		MSV_LOG_ERROR(m_spLogger, "Active configuration can not be retargeted during sharded write - error: {0:x}", MSV_BUSY_ERROR);
+		return MSV_BUSY_ERROR;
+	}
+
+	//values of both databases are loaded now (lazy mode) -> diff does not wait for storage under locks
+	std::shared_ptr<const MsvConfigSnapshot> spOldSnapshot;
+	std::shared_ptr<const MsvConfigSnapshot> spSnapshot;
+	if (MSV_FAILED(errorCode = GetSnapshot(*spOldDatabase, spOldSnapshot)) || MSV_FAILED(errorCode = GetSnapshot(*spDatabase, spSnapshot)))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Load active configuration values for retarget failed with error: {0:x}", errorCode);
+		return errorCode;
+	}
+
+	//changes of new database made from now are notified by it
+	if (MSV_FAILED(errorCode = AttachDatabase(spDatabase, spStorageCallback)))
+	{
+		return errorCode;
+	}
+
+	{
+		//writes of other instances notify this one under database write lock -> lock it before config lock
+		std::lock_guard<MsvActiveConfigWriteLock> writeLock(spOldDatabase->m_writeLock);
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+		if (m_spDatabase != spOldDatabase)
+		{
+			//config has been uninitialized (or retargeted) meanwhile
+			MSV_LOG_ERROR(m_spLogger, "Active configuration has been changed during retarget - error: {0:x}", MSV_BUSY_ERROR);
+			DetachDatabase(*spDatabase, spStorageCallback);
+			return MSV_BUSY_ERROR;
+		}
+
+		//deliver collected changes of current database before it is switched
+		DeliverChanges();
+
+		//current database is not changed while its write lock is held -> its values are final
+		if (MSV_FAILED(errorCode = GetSnapshot(*spOldDatabase, spOldSnapshot)))
+		{
+			MSV_LOG_ERROR(m_spLogger, "Load active configuration values for retarget failed with error: {0:x}", errorCode);
+			DetachDatabase(*spDatabase, spStorageCallback);
+			return errorCode;
+		}
+
+		//readers are switched at once (they never see uninitialized config)
+		{
+			std::unique_lock<std::shared_mutex> databaseLock(m_databaseLock);
+			m_spDatabase = spDatabase;
+
+			//versions continue when database is the same one -> its change waiters keep waiting
+			if (spDatabase != spOldDatabase)
+			{
+				++m_databaseEpoch;
+			}
+		}
+
+		//change waiters of current database stop waiting (its versions are not used anymore)
+		spOldDatabase->WakeWaiters();
+
+		//current database is released when it is not used by other instance (or reader)
+		DetachDatabase(*spOldDatabase, spStorageCallback);
+	}
 
+	//differences are notified as one write of new database (its later changes are notified after them)
+	std::lock_guard<MsvActiveConfigWriteLock> writeLock(spDatabase->m_writeLock);
+
+	if (MSV_FAILED(errorCode = GetSnapshot(*spDatabase, spSnapshot)))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Load active configuration values for retarget failed with error: {0:x}", errorCode);
+		return errorCode;
+	}
+
+	const MsvConfigValues& oldValues = spOldSnapshot->GetValues();
+	const MsvConfigValues& newValues = spSnapshot->GetValues();
+	MsvConfigValues changedValues;
+	std::vector<int32_t> changedCfgIds;
+	DiffValues<bool>(oldValues.m_boolValues, newValues.m_boolValues, changedValues.m_boolValues, changedCfgIds);
+	DiffValues<double>(oldValues.m_doubleValues, newValues.m_doubleValues, changedValues.m_doubleValues, changedCfgIds);
+	DiffValues<int64_t>(oldValues.m_integerValues, newValues.m_integerValues, changedValues.m_integerValues, changedCfgIds);
+	DiffValues<std::string>(oldValues.m_stringValues, newValues.m_stringValues, changedValues.m_stringValues, changedCfgIds);
+	DiffValues<uint64_t>(oldValues.m_unsignedValues, newValues.m_unsignedValues, changedValues.m_unsignedValues, changedCfgIds);
+
+	MSV_LOG_INFO(m_spLogger, "Active configuration has been successfully retargeted ({} values changed).", changedCfgIds.size());
+
+	std::vector<std::shared_ptr<IMsvActiveConfigStorageCallback>> callbacks({ spStorageCallback });
+	NotifyVerifiedValues<bool>(callbacks, changedValues.m_boolValues);
+	NotifyVerifiedValues<double>(callbacks, changedValues.m_doubleValues);
+	NotifyVerifiedValues<int64_t>(callbacks, changedValues.m_integerValues);
+	NotifyVerifiedValues<std::string>(callbacks, changedValues.m_stringValues);
+	NotifyVerifiedValues<uint64_t>(callbacks, changedValues.m_unsignedValues);
+
+	if (m_spNotifier && !changedCfgIds.empty())
+	{
+		m_spNotifier->Notify(changedCfgIds);
+	}
+
+	//derived values follow values of new database (changed ones are notified after stored ones)
+	if (m_spDerived)
+	{
+		m_spDerived->RecomputeAll(true);
+	}
+
+	return MSV_SUCCESS;
+}
+
+bool MsvActiveConfig::Initialized() const
+{
 	return m_initialized;
 }
 
 MsvErrorCode MsvActiveConfig::GetValue(int32_t cfgId, bool& value) const
 {
-	return GetValue<bool>(cfgId, m_boolValues, value);
+	return GetValue<bool>(cfgId, &MsvActiveConfigDatabase::m_boolValues, value);
 }
 
 MsvErrorCode MsvActiveConfig::GetValue(int32_t cfgId, double& value) const
 {
-	return GetValue<double>(cfgId, m_doubleValues, value);
+	return GetValue<double>(cfgId, &MsvActiveConfigDatabase::m_doubleValues, value);
 }
 
 MsvErrorCode MsvActiveConfig::GetValue(int32_t cfgId, int64_t& value) const
 {
-	return GetValue<int64_t>(cfgId, m_integerValues, value);
+	return GetValue<int64_t>(cfgId, &MsvActiveConfigDatabase::m_integerValues, value);
 }
 
 MsvErrorCode MsvActiveConfig::GetValue(int32_t cfgId, std::string& value) const
 {
-	return GetValue<std::string>(cfgId, m_stringValues, value);
+	return GetValue<std::string>(cfgId, &MsvActiveConfigDatabase::m_stringValues, value);
 }
 
 MsvErrorCode MsvActiveConfig::GetValue(int32_t cfgId, uint64_t& value) const
 {
-	return GetValue<uint64_t>(cfgId, m_unsignedValues, value);
+	return GetValue<uint64_t>(cfgId, &MsvActiveConfigDatabase::m_unsignedValues, value);
 }
 
 MsvErrorCode MsvActiveConfig::SetValue(int32_t cfgId, bool value)
 {
-	return SetValue<bool>(cfgId, m_boolValues, value);
+	return SetValue<bool>(cfgId, &MsvActiveConfigDatabase::m_boolValues, value);
 }
 
 MsvErrorCode MsvActiveConfig::SetValue(int32_t cfgId, double value)
 {
-	return SetValue<double>(cfgId, m_doubleValues, value);
+	return SetValue<double>(cfgId, &MsvActiveConfigDatabase::m_doubleValues, value);
 }
 
 MsvErrorCode MsvActiveConfig::SetValue(int32_t cfgId, int64_t value)
 {
-	return SetValue<int64_t>(cfgId, m_integerValues, value);
+	return SetValue<int64_t>(cfgId, &MsvActiveConfigDatabase::m_integerValues, value);
 }
 
 MsvErrorCode MsvActiveConfig::SetValue(int32_t cfgId, const std::string& value)
 {
-	return SetValue<std::string>(cfgId, m_stringValues, value);
+	return SetValue(cfgId, std::make_shared<const std::string>(value));
 }
 
-MsvErrorCode MsvActiveConfig::SetValue(int32_t cfgId, uint64_t value)
+MsvErrorCode MsvActiveConfig::SetValue(int32_t cfgId, std::string&& value)
 {
-	return SetValue<uint64_t>(cfgId, m_unsignedValues, value);
+	//value is moved -> it is allocated only once (by caller)
+	return SetValue(cfgId, std::make_shared<const std::string>(std::move(value)));
 }
 
-MsvErrorCode MsvActiveConfig::RegisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback)
+MsvErrorCode MsvActiveConfig::SetValue(int32_t cfgId, const std::shared_ptr<const std::string>& spValue)
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
+	if (!spValue)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration value {} is null - error:", cfgId, MSV_INVALID_DATA_ERROR);
+		return MSV_INVALID_DATA_ERROR;
+	}
 
-	//there is no check if is initilized or not (it is possible to register callback before initialized - weard, but OK)
+	//cache, storage and callbacks share value
+	return SetValue<std::shared_ptr<const std::string>>(cfgId, &MsvActiveConfigDatabase::m_stringValues, spValue);
+}
 
-	MSV_LOG_INFO(m_spLogger, "Registering Config callback.");
+MsvErrorCode MsvActiveConfig::SetValue(int32_t cfgId, uint64_t value)
+{
+	return SetValue<uint64_t>(cfgId, &MsvActiveConfigDatabase::m_unsignedValues, value);
+}
 
-	std::forward_list<std::shared_ptr<IMsvActiveConfigCallback>>::iterator endIt = m_callbacks.end();
-	for (std::forward_list<std::shared_ptr<IMsvActiveConfigCallback>>::iterator it = m_callbacks.begin(); it != endIt; ++it)
+MsvErrorCode MsvActiveConfig::SetValues(const std::vector<MsvConfigValueUpdate>& values)
+{
+	std::shared_ptr<MsvActiveConfigDatabase> spDatabase = GetDatabase();
+	if (!spDatabase)
 	{
-		if (*it == spCallback)
-		{
-			//callback is already registered
-			MSV_LOG_INFO(m_spLogger, "Config callback has been already registered.");
-			return MSV_ALREADY_REGISTERED_INFO;
-		}
+		MSV_LOG_ERROR(m_spLogger, "Active configuration is not initialized - error:", MSV_NOT_INITIALIZED_ERROR);
+		return MSV_NOT_INITIALIZED_ERROR;
 	}
 
-	//register callback
-	m_callbacks.push_front(spCallback);
-
-	MSV_LOG_INFO(m_spLogger, "Config callback has been successfully registered.");
+	//storage is opened by snapshot verification -> wait for it (failed storage open is retried in background)
+	MsvErrorCode openErrorCode = spDatabase->WaitForVerification();
+	if (MSV_FAILED(openErrorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration storage has not been opened - error: {0:x}", openErrorCode);
+		return openErrorCode;
+	}
 
-	return MSV_SUCCESS;
-}
+	if (spDatabase->m_writeLock.HoldsKey())
+	{
+		//called by callback of sharded write -> whole database can not be locked by this thread
+		MSV_LOG_ERROR(m_spLogger, "Active configuration batch can not be written during sharded write - error: {0:x}", MSV_BUSY_ERROR);
+		return MSV_BUSY_ERROR;
+	}
 
-MsvErrorCode MsvActiveConfig::UnregisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback)
-{
+	//whole batch is one write (database write lock must be locked before config lock)
+	std::lock_guard<MsvActiveConfigWriteLock> writeLock(spDatabase->m_writeLock);
 	std::lock_guard<std::recursive_mutex> lock(m_lock);
 
-	MSV_LOG_INFO(m_spLogger, "Unregistering Config callback.");
+	//check all values first (nothing is set when any value is not valid), key map is used -> cache might not
+	//contain all values in lazy mode
+	const std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>& keyMap = spDatabase->m_spConfigKeyMap->GetMap();
+	for (std::vector<MsvConfigValueUpdate>::const_iterator it = values.begin(); it != values.end(); ++it)
+	{
+		std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>::const_iterator keyIt = keyMap.find(it->m_cfgId);
+		if (keyIt == keyMap.end())
+		{
+			MSV_LOG_ERROR(m_spLogger, "Active configuration value {} has not been found - error:", it->m_cfgId, MSV_NOT_FOUND_ERROR);
+			return MSV_NOT_FOUND_ERROR;
+		}
 
-	m_callbacks.remove(spCallback);
+		bool validType = (std::holds_alternative<bool>(it->m_newValue) && keyIt->second->IsBool())
+			|| (std::holds_alternative<double>(it->m_newValue) && keyIt->second->IsDouble())
+			|| (std::holds_alternative<int64_t>(it->m_newValue) && keyIt->second->IsInteger())
+			|| (std::holds_alternative<std::string>(it->m_newValue) && keyIt->second->IsString())
+			|| (std::holds_alternative<uint64_t>(it->m_newValue) && keyIt->second->IsUnsigned());
+		if (!validType)
+		{
+			MSV_LOG_ERROR(m_spLogger, "Active configuration value {} has different type - error:", it->m_cfgId, MSV_INVALID_DATA_ERROR);
+			return MSV_INVALID_DATA_ERROR;
+		}
+	}
 
-	MSV_LOG_INFO(m_spLogger, "Config callback has been successfully unregistered.");
+	//changes are only collected while batch is running
+	++m_batchDepth;
 
-	return MSV_SUCCESS;
-}
+	MsvErrorCode errorCode = MSV_SUCCESS;
+	for (std::vector<MsvConfigValueUpdate>::const_iterator it = values.begin(); it != values.end() && MSV_SUCCEEDED(errorCode); ++it)
+	{
+		if (const bool* pValue = std::get_if<bool>(&it->m_newValue))
+		{
+			errorCode = SetValue<bool>(it->m_cfgId, &MsvActiveConfigDatabase::m_boolValues, *pValue);
+		}
+		else if (const double* pValue = std::get_if<double>(&it->m_newValue))
+		{
+			errorCode = SetValue<double>(it->m_cfgId, &MsvActiveConfigDatabase::m_doubleValues, *pValue);
+		}
+		else if (const int64_t* pValue = std::get_if<int64_t>(&it->m_newValue))
+		{
+			errorCode = SetValue<int64_t>(it->m_cfgId, &MsvActiveConfigDatabase::m_integerValues, *pValue);
+		}
+		else if (const std::string* pValue = std::get_if<std::string>(&it->m_newValue))
+		{
+			errorCode = SetValue(it->m_cfgId, *pValue);
+		}
+		else if (const uint64_t* pValue = std::get_if<uint64_t>(&it->m_newValue))
+		{
+			errorCode = SetValue<uint64_t>(it->m_cfgId, &MsvActiveConfigDatabase::m_unsignedValues, *pValue);
+		}
+	}
 
+	--m_batchDepth;
 
-/********************************************************************************************************************************
-*															MsvActiveConfig protected methods
-********************************************************************************************************************************/
+	//notify all changes of this batch at once (even when failed - stored values have been changed)
+	DeliverChanges();
 
+	return errorCode;
+}
 
-template<class T> void MsvActiveConfig::OnValueChanged(int32_t cfgId, T newValue)
+MsvErrorCode MsvActiveConfig::RegisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback)
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
+	//there is no check if is initilized or not (it is possible to register callback before initialized - weard, but OK)
 
-	MSV_LOG_DEBUG(m_spLogger, "Config data changed (cfgId: {}, newValue: {}).", cfgId, newValue);
-	  
-	std::forward_list<std::shared_ptr<IMsvActiveConfigCallback>>::iterator endIt = m_callbacks.end();
-	for (std::forward_list<std::shared_ptr<IMsvActiveConfigCallback>>::iterator it = m_callbacks.begin(); it != endIt; ++it)
+	MSV_LOG_INFO(m_spLogger, "Registering Config callback.");
+
+	MsvErrorCode errorCode = m_subscriptions.Update([&spCallback](MsvSubscriptions& subscriptions)
 	{
-		//config ID is everywhere defined as int32_t -> we can static_cast without worries
-		(*it)->OnValueChanged(static_cast<int32_t>(cfgId), newValue);
-	}
-}
+		if (std::find(subscriptions.m_callbacks.begin(), subscriptions.m_callbacks.end(), spCallback) != subscriptions.m_callbacks.end())
+		{
+			//callback is already registered
+			return MSV_ALREADY_REGISTERED_INFO;
+		}
 
-template<class T> MsvErrorCode MsvActiveConfig::GetValue(int32_t cfgId, const std::map<int32_t, T>& values, T& value) const
-{
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
+		//register callback
+		subscriptions.m_callbacks.push_back(spCallback);
+		return MSV_SUCCESS;
+	});
 
-	if (!Initialized())
+	if (errorCode == MSV_ALREADY_REGISTERED_INFO)
 	{
-		MSV_LOG_ERROR(m_spLogger, "Active configuration is not initialized - error:", MSV_NOT_INITIALIZED_ERROR);
-		return MSV_NOT_INITIALIZED_ERROR;
+		MSV_LOG_INFO(m_spLogger, "Config callback has been already registered.");
+		return errorCode;
 	}
-
-	typename std::map<int32_t, T>::const_iterator it = values.find(cfgId);
-
-	if (it != values.end())
+	else if (MSV_FAILED(errorCode))
 	{
-		value = it->second;
-		return MSV_SUCCESS;
+		MSV_LOG_ERROR(m_spLogger, "Register Config callback failed with error: {0:x}", errorCode);
+		return errorCode;
 	}
 
-	MSV_LOG_ERROR(m_spLogger, "Active configuration value {} has not been found - error:", cfgId, MSV_NOT_FOUND_ERROR);
+	MSV_LOG_INFO(m_spLogger, "Config callback has been successfully registered.");
 
-	return MSV_NOT_FOUND_ERROR;
+	return MSV_SUCCESS;
 }
 
-template<class T> MsvErrorCode MsvActiveConfig::SetValue(int32_t cfgId, std::map<int32_t, T>& values, const T& value)
+MsvErrorCode MsvActiveConfig::RegisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback, int32_t cfgId)
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
+	return RegisterCallback(spCallback, std::vector<int32_t>(1, cfgId));
+}
 
-	if (!Initialized())
+MsvErrorCode MsvActiveConfig::RegisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback, int32_t firstCfgId, int32_t lastCfgId)
+{
+	MSV_LOG_INFO(m_spLogger, "Registering Config callback for range (firstCfgId: {}, lastCfgId: {}).", firstCfgId, lastCfgId);
+
+	if (firstCfgId > lastCfgId)
 	{
-		MSV_LOG_ERROR(m_spLogger, "Active configuration is not initialized - error:", MSV_NOT_INITIALIZED_ERROR);
-		return MSV_NOT_INITIALIZED_ERROR;
+		MSV_LOG_ERROR(m_spLogger, "Invalid config ID range - error: {0:x}", MSV_INVALID_DATA_ERROR);
+		return MSV_INVALID_DATA_ERROR;
 	}
 
-	typename std::map<int32_t, T>::iterator it = values.find(cfgId);
-
-	if (it != values.end())
+	MsvErrorCode errorCode = m_subscriptions.Update([&spCallback, firstCfgId, lastCfgId](MsvSubscriptions& subscriptions)
 	{
-		//update database first
-		MsvErrorCode errorCode = m_spStorage->StoreValue(cfgId, value);
-		if (MSV_FAILED(errorCode))
+		std::pair<std::multimap<int32_t, MsvRangeCallback>::iterator, std::multimap<int32_t, MsvRangeCallback>::iterator> range = subscriptions.m_rangeCallbacks.equal_range(firstCfgId);
+		for (std::multimap<int32_t, MsvRangeCallback>::iterator it = range.first; it != range.second; ++it)
+		{
+			if (it->second.m_lastCfgId == lastCfgId && it->second.m_spCallback == spCallback)
+			{
+				//callback is already registered
+				return MSV_ALREADY_REGISTERED_INFO;
+			}
+		}
+
+		//register callback
+		subscriptions.m_rangeCallbacks.insert(std::make_pair(firstCfgId, MsvRangeCallback{ firstCfgId, lastCfgId, spCallback }));
+		return MSV_SUCCESS;
+	});
+
+	if (errorCode == MSV_ALREADY_REGISTERED_INFO)
+	{
+		MSV_LOG_INFO(m_spLogger, "Config callback has been already registered for range.");
+		return errorCode;
+	}
+	else if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Register Config callback for range failed with error: {0:x}", errorCode);
+		return errorCode;
+	}
+
+	MSV_LOG_INFO(m_spLogger, "Config callback has been successfully registered for range.");
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfig::RegisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback, const std::vector<int32_t>& cfgIds)
+{
+	MSV_LOG_INFO(m_spLogger, "Registering Config callback for {} config IDs.", cfgIds.size());
+
+	MsvErrorCode errorCode = m_subscriptions.Update([&spCallback, &cfgIds](MsvSubscriptions& subscriptions)
+	{
+		MsvErrorCode result = MSV_ALREADY_REGISTERED_INFO;
+
+		for (std::vector<int32_t>::const_iterator cfgIdIt = cfgIds.begin(); cfgIdIt != cfgIds.end(); ++cfgIdIt)
+		{
+			std::vector<std::shared_ptr<IMsvActiveConfigCallback>>& callbacks = subscriptions.m_cfgIdCallbacks[*cfgIdIt];
+			if (std::find(callbacks.begin(), callbacks.end(), spCallback) != callbacks.end())
+			{
+				//callback is already registered for config ID
+				continue;
+			}
+
+			//register callback
+			callbacks.push_back(spCallback);
+			result = MSV_SUCCESS;
+		}
+
+		return result;
+	});
+
+	if (errorCode == MSV_ALREADY_REGISTERED_INFO)
+	{
+		MSV_LOG_INFO(m_spLogger, "Config callback has been already registered for all config IDs.");
+		return errorCode;
+	}
+	else if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Register Config callback for config IDs failed with error: {0:x}", errorCode);
+		return errorCode;
+	}
+
+	MSV_LOG_INFO(m_spLogger, "Config callback has been successfully registered for config IDs.");
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfig::UnregisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback)
+{
+	MSV_LOG_INFO(m_spLogger, "Unregistering Config callback.");
+
+	//running notifications use old snapshot -> callback can unregister itself while it is called
+	MsvErrorCode errorCode = m_subscriptions.Update([&spCallback](MsvSubscriptions& subscriptions)
+	{
+		subscriptions.m_callbacks.erase(std::remove(subscriptions.m_callbacks.begin(), subscriptions.m_callbacks.end(), spCallback), subscriptions.m_callbacks.end());
+
+		//remove config ID registrations (and empty index entries)
+		for (std::map<int32_t, std::vector<std::shared_ptr<IMsvActiveConfigCallback>>>::iterator it = subscriptions.m_cfgIdCallbacks.begin(); it != subscriptions.m_cfgIdCallbacks.end();)
+		{
+			it->second.erase(std::remove(it->second.begin(), it->second.end(), spCallback), it->second.end());
+			it = it->second.empty() ? subscriptions.m_cfgIdCallbacks.erase(it) : std::next(it);
+		}
+
+		//remove range registrations
+		for (std::multimap<int32_t, MsvRangeCallback>::iterator it = subscriptions.m_rangeCallbacks.begin(); it != subscriptions.m_rangeCallbacks.end();)
+		{
+			it = (it->second.m_spCallback == spCallback) ? subscriptions.m_rangeCallbacks.erase(it) : std::next(it);
+		}
+
+		return MSV_SUCCESS;
+	});
+
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Unregister Config callback failed with error: {0:x}", errorCode);
+		return errorCode;
+	}
+
+	m_watchdog.Remove(spCallback.get());
+
+	MSV_LOG_INFO(m_spLogger, "Config callback has been successfully unregistered.");
+
+	return MSV_SUCCESS;
+}
+
+
+MsvErrorCode MsvActiveConfig::RegisterBatchCallback(std::shared_ptr<IMsvActiveConfigBatchCallback> spCallback)
+{
+	MSV_LOG_INFO(m_spLogger, "Registering Config batch callback.");
+
+	MsvErrorCode errorCode = m_batchCallbacks.Register(spCallback);
+	if (errorCode == MSV_ALREADY_REGISTERED_INFO)
+	{
+		MSV_LOG_INFO(m_spLogger, "Config batch callback has been already registered.");
+		return errorCode;
+	}
+	else if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Register Config batch callback failed with error: {0:x}", errorCode);
+		return errorCode;
+	}
+
+	MSV_LOG_INFO(m_spLogger, "Config batch callback has been successfully registered.");
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfig::UnregisterBatchCallback(std::shared_ptr<IMsvActiveConfigBatchCallback> spCallback)
+{
+	MSV_LOG_INFO(m_spLogger, "Unregistering Config batch callback.");
+
+	MsvErrorCode errorCode = m_batchCallbacks.Unregister(spCallback);
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Unregister Config batch callback failed with error: {0:x}", errorCode);
+		return errorCode;
+	}
+
+	MSV_LOG_INFO(m_spLogger, "Config batch callback has been successfully unregistered.");
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfig::GetVersion(uint64_t& version) const
+{
+	std::shared_ptr<MsvActiveConfigDatabase> spDatabase = GetDatabase();
+	if (!spDatabase)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration is not initialized - error:", MSV_NOT_INITIALIZED_ERROR);
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	version = spDatabase->GetVersion();
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfig::WaitForChange(int32_t cfgId, uint64_t sinceVersion, uint32_t timeoutMs, uint64_t& version) const
+{
+	return WaitForChange(std::vector<int32_t>(1, cfgId), sinceVersion, timeoutMs, version);
+}
+
+MsvErrorCode MsvActiveConfig::WaitForChange(const std::vector<int32_t>& cfgIds, uint64_t sinceVersion, uint32_t timeoutMs, uint64_t& version) const
+{
+	//database is held by waiter -> it is valid even when config is uninitialized (or retargeted) while waiting
+	std::shared_ptr<MsvActiveConfigDatabase> spDatabase;
+	uint64_t databaseEpoch = 0;
+	{
+		std::shared_lock<std::shared_mutex> databaseLock(m_databaseLock);
+		spDatabase = m_spDatabase;
+		databaseEpoch = m_databaseEpoch;
+	}
+
+	if (!spDatabase)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration is not initialized - error:", MSV_NOT_INITIALIZED_ERROR);
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	//key map is immutable -> no lock
+	const std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>& keyMap = spDatabase->m_spConfigKeyMap->GetMap();
+	std::vector<int32_t>::const_iterator endIt = cfgIds.end();
+	for (std::vector<int32_t>::const_iterator it = cfgIds.begin(); it != endIt; ++it)
+	{
+		if (keyMap.find(*it) == keyMap.end())
+		{
+			MSV_LOG_ERROR(m_spLogger, "Active configuration value {} has not been found - error:", *it, MSV_NOT_FOUND_ERROR);
+			return MSV_NOT_FOUND_ERROR;
+		}
+	}
+
+	version = spDatabase->WaitForChange(cfgIds, sinceVersion, timeoutMs, [this, databaseEpoch]() { return m_databaseEpoch != databaseEpoch; });
+
+	if (m_databaseEpoch != databaseEpoch)
+	{
+		//versions of released database do not continue in current one -> waiter has to resync
+		MSV_LOG_ERROR(m_spLogger, "Active configuration database has been switched while waiting for change - error: {0:x}", MSV_BUSY_ERROR);
+		version = sinceVersion;
+		return MSV_BUSY_ERROR;
+	}
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfig::GetNotificationHandle(int& handle)
+{
+	if (!m_spNotifier)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration change notifier has not been created - error: {0:x}", MSV_ALLOCATION_ERROR);
+		return MSV_ALLOCATION_ERROR;
+	}
+
+	MsvErrorCode errorCode = m_spNotifier->GetHandle(handle);
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Open active configuration notification handle failed with error: {0:x}", errorCode);
+		return errorCode;
+	}
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfig::DrainChanges(std::vector<int32_t>& changedCfgIds)
+{
+	changedCfgIds.clear();
+
+	if (m_spNotifier)
+	{
+		m_spNotifier->Drain(changedCfgIds);
+	}
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfig::GetSnapshot(std::shared_ptr<const MsvConfigSnapshot>& spSnapshot) const
+{
+	std::shared_ptr<MsvActiveConfigDatabase> spDatabase = GetDatabase();
+	if (!spDatabase)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration is not initialized - error:", MSV_NOT_INITIALIZED_ERROR);
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	return GetSnapshot(*spDatabase, spSnapshot);
+}
+
+MsvErrorCode MsvActiveConfig::PushOverrides(const std::vector<MsvConfigValueUpdate>& values)
+{
+	std::shared_ptr<MsvActiveConfigDatabase> spDatabase = GetDatabase();
+	if (!spDatabase)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration is not initialized - error:", MSV_NOT_INITIALIZED_ERROR);
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	//key map is immutable after database initialization -> no lock
+	MsvErrorCode errorCode = MsvConfigOverrides::Push(this, spDatabase->m_spConfigKeyMap->GetMap(), values);
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Push overrides failed - error:", errorCode);
+		return errorCode;
+	}
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfig::PopOverrides()
+{
+	MsvErrorCode errorCode = MsvConfigOverrides::Pop(this);
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Pop overrides failed - error:", errorCode);
+		return errorCode;
+	}
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfig::PollChanges(uint64_t lastSequence, std::vector<MsvConfigValueJournalEntry>& changes, uint64_t& sequence) const
+{
+	std::shared_ptr<MsvActiveConfigDatabase> spDatabase = GetDatabase();
+	if (!spDatabase)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration is not initialized - error:", MSV_NOT_INITIALIZED_ERROR);
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	MsvErrorCode errorCode = spDatabase->PollChanges(lastSequence, changes, sequence);
+	if (MSV_FAILED(errorCode))
+	{
+		//expected for slow consumers -> not an error of config
+		MSV_LOG_INFO(m_spLogger, "Active configuration changes after sequence {} are not in journal (last sequence {}) - consumer must resync.", lastSequence, sequence);
+		return errorCode;
+	}
+
+	return MSV_SUCCESS;
+}
+
+
+/********************************************************************************************************************************
+*															MsvActiveConfig public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvActiveConfig::SetDispatcher(std::shared_ptr<MsvActiveConfigDispatcher> spDispatcher)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	if (spDispatcher && !spDispatcher->Initialized())
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration dispatcher is not initialized - error: {0:x}", MSV_NOT_INITIALIZED_ERROR);
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	m_spDispatcher = spDispatcher;
+
+	return MSV_SUCCESS;
+}
+
+
+MsvErrorCode MsvActiveConfig::SetCallbackBudget(uint32_t budgetUs, bool quarantine)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	MSV_LOG_INFO(m_spLogger, "Setting callback budget to {} us (quarantine: {}).", budgetUs, quarantine);
+
+	m_watchdog.SetBudget(std::chrono::microseconds(budgetUs));
+	m_quarantine = quarantine;
+
+	//storage notifies instances (its callbacks) -> their time is measured too
+	std::shared_ptr<MsvActiveConfigDatabase> spDatabase = GetDatabase();
+	if (spDatabase)
+	{
+		spDatabase->m_spStorage->SetCallbackBudget(budgetUs);
+	}
+
+	return MSV_SUCCESS;
+}
+
+void MsvActiveConfig::GetCallbackReport(std::vector<MsvCallbackReport>& report) const
+{
+	m_watchdog.GetReport(report);
+}
+
+MsvErrorCode MsvActiveConfig::SetCoalescingWindow(uint32_t windowMs)
+{
+	std::unique_lock<std::recursive_mutex> lock(m_lock);
+
+	MSV_LOG_INFO(m_spLogger, "Setting coalescing window to {} ms.", windowMs);
+
+	m_coalescingWindow = std::chrono::milliseconds(windowMs);
+
+	if (windowMs == 0)
+	{
+		//no coalescing -> flush thread is not needed (collected changes are flushed), unlock -> thread needs lock to stop
+		lock.unlock();
+		StopFlushThread();
+		return MSV_SUCCESS;
+	}
+
+	if (m_flushThread.joinable())
+	{
+		return MSV_SUCCESS;
+	}
+
+	try
+	{
+		m_flushThread = std::thread(&MsvActiveConfig::FlushThread, this);
+	}
+	catch (...)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Create flush thread failed with error: {0:x}", MSV_ALLOCATION_ERROR);
+		m_coalescingWindow = std::chrono::milliseconds(0);
+		return MSV_ALLOCATION_ERROR;
+	}
+
+	return MSV_SUCCESS;
+}
+
+void MsvActiveConfig::FlushChanges()
+{
+	//writers notify this instance under database write lock and then lock config lock -> lock them in the same order
+	std::shared_ptr<MsvActiveConfigDatabase> spDatabase = GetDatabase();
+	std::unique_lock<MsvActiveConfigWriteLock> writeLock;
+	if (spDatabase && !spDatabase->m_writeLock.HoldsKey())
+	{
+		writeLock = std::unique_lock<MsvActiveConfigWriteLock>(spDatabase->m_writeLock);
+	}
+
+	DeliverChanges();
+}
+
+void MsvActiveConfig::DeliverChanges()
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	m_flushScheduled = false;
+
+	if (m_pendingChanges.empty())
+	{
+		return;
+	}
+
+	std::shared_ptr<std::vector<MsvConfigValueUpdate>> spValues(new (std::nothrow) std::vector<MsvConfigValueUpdate>());
+	if (!spValues)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Allocate batch of changes failed with error: {0:x}", MSV_ALLOCATION_ERROR);
+		return;
+	}
+
+	spValues->reserve(m_pendingChanges.size());
+	for (std::map<int32_t, MsvConfigValue>::iterator it = m_pendingChanges.begin(); it != m_pendingChanges.end(); ++it)
+	{
+		spValues->push_back(MsvConfigValueUpdate{ it->first, std::move(it->second) });
+	}
+	m_pendingChanges.clear();
+
+	MSV_LOG_DEBUG(m_spLogger, "Config data changed (batch of {} values).", spValues->size());
+
+	//callbacks snapshot -> callback can unregister itself while it is called
+	std::shared_ptr<const std::vector<std::shared_ptr<IMsvActiveConfigBatchCallback>>> spBatchCallbacks = m_batchCallbacks.Load();
+
+	std::vector<std::shared_ptr<IMsvActiveConfigBatchCallback>>::const_iterator endIt = spBatchCallbacks->end();
+	for (std::vector<std::shared_ptr<IMsvActiveConfigBatchCallback>>::const_iterator it = spBatchCallbacks->begin(); it != endIt; ++it)
+	{
+		if (m_spDispatcher)
+		{
+			//asynchronous notification -> batch is shared by all notifications (it is not copied)
+			std::shared_ptr<IMsvActiveConfigBatchCallback> spCallback = *it;
+			MsvErrorCode errorCode = m_spDispatcher->Dispatch(spCallback.get(), [spCallback, spValues]() { spCallback->OnValuesChanged(*spValues); });
+			if (MSV_FAILED(errorCode))
+			{
+				MSV_LOG_ERROR(m_spLogger, "Dispatch batch of config data changes failed with error: {0:x}", errorCode);
+			}
+			continue;
+		}
+
+		(*it)->OnValuesChanged(*spValues);
+	}
+}
+
+
+MsvErrorCode MsvActiveConfig::SetLazyLoading(bool lazy)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	if (Initialized())
+	{
+		MSV_LOG_INFO(m_spLogger, "Active configuration has been already initialized - loading mode is not changed.");
+		return MSV_ALREADY_INITIALIZED_INFO;
+	}
+
+	m_lazyLoading = lazy;
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfig::SetJournalSize(size_t journalSize)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	if (Initialized())
+	{
+		MSV_LOG_INFO(m_spLogger, "Active configuration has been already initialized - journal size is not changed.");
+		return MSV_ALREADY_INITIALIZED_INFO;
+	}
+
+	m_journalSize = journalSize;
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfig::SetWriteShards(size_t shardCount)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	if (Initialized())
+	{
+		MSV_LOG_INFO(m_spLogger, "Active configuration has been already initialized - write shards are not changed.");
+		return MSV_ALREADY_INITIALIZED_INFO;
+	}
+
+	m_writeShards = shardCount > 1 ? shardCount : 1;
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfig::Prefetch(const std::vector<int32_t>& cfgIds)
+{
+	std::shared_ptr<MsvActiveConfigDatabase> spDatabase = GetDatabase();
+	if (!spDatabase)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration is not initialized - error:", MSV_NOT_INITIALIZED_ERROR);
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	MSV_LOG_DEBUG(m_spLogger, "Prefetching {} active configuration values.", cfgIds.size());
+
+	return PrefetchValues(*spDatabase, cfgIds);
+}
+
+MsvErrorCode MsvActiveConfig::SetSnapshotPath(const char* snapshotPath)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	if (Initialized())
+	{
+		MSV_LOG_INFO(m_spLogger, "Active configuration has been already initialized - snapshot path is not changed.");
+		return MSV_ALREADY_INITIALIZED_INFO;
+	}
+
+	m_snapshotPath = snapshotPath ? snapshotPath : "";
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfig::SaveSnapshot()
+{
+	std::shared_ptr<MsvActiveConfigDatabase> spDatabase = GetDatabase();
+	if (!spDatabase)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration is not initialized - error:", MSV_NOT_INITIALIZED_ERROR);
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	if (m_snapshotPath.empty())
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration snapshot path has not been set - error: {0:x}", MSV_INVALID_DATA_ERROR);
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	//cache must be verified (snapshot is tagged by current storage revision) (failed storage open is retried in background)
+	MsvErrorCode openErrorCode = spDatabase->WaitForVerification();
+	if (MSV_FAILED(openErrorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration storage has not been opened - error: {0:x}", openErrorCode);
+		return openErrorCode;
+	}
+
+	if (spDatabase->m_writeLock.HoldsKey())
+	{
+		//called by callback of sharded write -> whole database can not be locked by this thread
+		MSV_LOG_ERROR(m_spLogger, "Active configuration snapshot can not be saved during sharded write - error: {0:x}", MSV_BUSY_ERROR);
+		return MSV_BUSY_ERROR;
+	}
+
+	//no write can run while cache and revision are saved
+	std::lock_guard<MsvActiveConfigWriteLock> writeLock(spDatabase->m_writeLock);
+
+	if (!spDatabase->m_spStorage->Initialized())
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration storage is not opened - error: {0:x}", MSV_NOT_INITIALIZED_ERROR);
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	MsvErrorCode errorCode = MsvActiveConfigSnapshot::Save(m_snapshotPath.c_str(), *spDatabase);
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Save active configuration snapshot failed with error: {0:x}", errorCode);
+		return errorCode;
+	}
+
+	MSV_LOG_INFO(m_spLogger, "Active configuration snapshot has been successfully saved.");
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfig::RegisterDerivedValue(int32_t cfgId, const std::vector<int32_t>& dependencies, MsvActiveConfigDerivedFunction function)
+{
+	std::shared_ptr<MsvActiveConfigDatabase> spDatabase = GetDatabase();
+	if (!spDatabase)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration is not initialized - error:", MSV_NOT_INITIALIZED_ERROR);
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	if (!m_spDerived)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration derived values have not been created - error: {0:x}", MSV_ALLOCATION_ERROR);
+		return MSV_ALLOCATION_ERROR;
+	}
+
+	//derived value is computed now (concurrent writes recompute it after registration)
+	MsvErrorCode errorCode = m_spDerived->Register(cfgId, dependencies, function, spDatabase->m_spConfigKeyMap->GetMap());
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Register active configuration derived value {} failed with error: {:x}", cfgId, errorCode);
+		return errorCode;
+	}
+
+	MSV_LOG_INFO(m_spLogger, "Active configuration derived value {} has been successfully registered.", cfgId);
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfig::UnregisterDerivedValue(int32_t cfgId)
+{
+	if (!m_spDerived)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration derived values have not been created - error: {0:x}", MSV_ALLOCATION_ERROR);
+		return MSV_ALLOCATION_ERROR;
+	}
+
+	return m_spDerived->Unregister(cfgId);
+}
+
+
+/********************************************************************************************************************************
+*															MsvActiveConfig protected methods
+********************************************************************************************************************************/
+
+
+template<class T> void MsvActiveConfig::OnValueChanged(int32_t cfgId, T newValue)
+{
+	//nothing is registered -> concurrent writes of different shards do not wait for config lock
+	std::shared_ptr<const MsvSubscriptions> spRegistered = m_subscriptions.Load();
+	if (spRegistered->m_callbacks.empty() && spRegistered->m_cfgIdCallbacks.empty() && spRegistered->m_rangeCallbacks.empty() && m_batchCallbacks.Load()->empty())
+	{
+		return;
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	MSV_LOG_DEBUG(m_spLogger, "Config data changed (cfgId: {}, newValue: {}).", cfgId, FromCachedValue(newValue));
+	  
+	//only interested callbacks are notified (index lookup, not all registered callbacks), snapshot is held while
+	//callbacks are called -> callback can unregister itself (or others) without invalidating this iteration
+	std::shared_ptr<const MsvSubscriptions> spSubscriptions = m_subscriptions.Load();
+	std::vector<const std::shared_ptr<IMsvActiveConfigCallback>*> callbacks;
+	GetInterestedCallbacks(*spSubscriptions, cfgId, callbacks);
+
+	for (std::vector<const std::shared_ptr<IMsvActiveConfigCallback>*>::iterator it = callbacks.begin(); it != callbacks.end(); ++it)
+	{
+		if (m_spDispatcher)
+		{
+			//asynchronous notification -> slow callback does not block this thread
+			DispatchValueChanged(*m_spDispatcher, **it, cfgId, newValue);
+			continue;
+		}
+
+		if (m_spQuarantineDispatcher && m_watchdog.Quarantined((**it).get()))
+		{
+			//callback has exceeded budget -> it is notified asynchronously since then
+			DispatchValueChanged(*m_spQuarantineDispatcher, **it, cfgId, newValue);
+			continue;
+		}
+
+		//config ID is everywhere defined as int32_t -> we can static_cast without worries
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		(**it)->OnValueChanged(static_cast<int32_t>(cfgId), newValue);
+		OnCallbackCalled(**it, cfgId, std::chrono::steady_clock::now() - start);
+	}
+
+	if (!m_batchCallbacks.Load()->empty())
+	{
+		AddPendingChange(cfgId, ToConfigValue(newValue));
+	}
+}
+
+void MsvActiveConfig::OnDerivedValueChanged(int32_t cfgId, const MsvConfigValue& newValue)
+{
+	if (const bool* pValue = std::get_if<bool>(&newValue))
+	{
+		OnValueChanged<bool>(cfgId, *pValue);
+	}
+	else if (const double* pValue = std::get_if<double>(&newValue))
+	{
+		OnValueChanged<double>(cfgId, *pValue);
+	}
+	else if (const int64_t* pValue = std::get_if<int64_t>(&newValue))
+	{
+		OnValueChanged<int64_t>(cfgId, *pValue);
+	}
+	else if (const std::string* pValue = std::get_if<std::string>(&newValue))
+	{
+		OnValueChanged<const char*>(cfgId, pValue->c_str());
+	}
+	else if (const uint64_t* pValue = std::get_if<uint64_t>(&newValue))
+	{
+		OnValueChanged<uint64_t>(cfgId, *pValue);
+	}
+
+	//derived values are not in database -> database does not signal them
+	if (m_spNotifier)
+	{
+		m_spNotifier->Notify(cfgId);
+	}
+}
+
+void MsvActiveConfig::GetInterestedCallbacks(const MsvSubscriptions& subscriptions, int32_t cfgId, std::vector<const std::shared_ptr<IMsvActiveConfigCallback>*>& callbacks) const
+{
+	//callback might be registered more times (all changes, config ID, range) -> add it only once
+	std::function<void(const std::shared_ptr<IMsvActiveConfigCallback>&)> addCallback = [&callbacks](const std::shared_ptr<IMsvActiveConfigCallback>& spCallback)
+	{
+		for (std::vector<const std::shared_ptr<IMsvActiveConfigCallback>*>::const_iterator it = callbacks.begin(); it != callbacks.end(); ++it)
+		{
+			if (**it == spCallback)
+			{
+				return;
+			}
+		}
+
+		callbacks.push_back(&spCallback);
+	};
+
+	std::vector<std::shared_ptr<IMsvActiveConfigCallback>>::const_iterator endIt = subscriptions.m_callbacks.end();
+	for (std::vector<std::shared_ptr<IMsvActiveConfigCallback>>::const_iterator it = subscriptions.m_callbacks.begin(); it != endIt; ++it)
+	{
+		addCallback(*it);
+	}
+
+	std::map<int32_t, std::vector<std::shared_ptr<IMsvActiveConfigCallback>>>::const_iterator cfgIdIt = subscriptions.m_cfgIdCallbacks.find(cfgId);
+	if (cfgIdIt != subscriptions.m_cfgIdCallbacks.end())
+	{
+		for (std::vector<std::shared_ptr<IMsvActiveConfigCallback>>::const_iterator it = cfgIdIt->second.begin(); it != cfgIdIt->second.end(); ++it)
+		{
+			addCallback(*it);
+		}
+	}
+
+	//ranges are sorted by first config ID -> stop at first range starting after config ID
+	std::multimap<int32_t, MsvRangeCallback>::const_iterator rangeEndIt = subscriptions.m_rangeCallbacks.upper_bound(cfgId);
+	for (std::multimap<int32_t, MsvRangeCallback>::const_iterator it = subscriptions.m_rangeCallbacks.begin(); it != rangeEndIt; ++it)
+	{
+		if (cfgId <= it->second.m_lastCfgId)
+		{
+			addCallback(it->second.m_spCallback);
+		}
+	}
+}
+
+template<class T> void MsvActiveConfig::DispatchValueChanged(MsvActiveConfigDispatcher& dispatcher, std::shared_ptr<IMsvActiveConfigCallback> spCallback, int32_t cfgId, T newValue)
+{
+	MsvErrorCode errorCode = dispatcher.Dispatch(spCallback.get(), [spCallback, cfgId, newValue]() { spCallback->OnValueChanged(cfgId, newValue); });
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Dispatch config data change (cfgId: {}) failed with error: {:x}", cfgId, errorCode);
+	}
+}
+
+void MsvActiveConfig::DispatchValueChanged(MsvActiveConfigDispatcher& dispatcher, std::shared_ptr<IMsvActiveConfigCallback> spCallback, int32_t cfgId, const char* newValue)
+{
+	std::string value(newValue);
+	MsvErrorCode errorCode = dispatcher.Dispatch(spCallback.get(), [spCallback, cfgId, value]() { spCallback->OnValueChanged(cfgId, value.c_str()); });
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Dispatch config data change (cfgId: {}) failed with error: {:x}", cfgId, errorCode);
+	}
+}
+
+void MsvActiveConfig::OnCallbackCalled(const std::shared_ptr<IMsvActiveConfigCallback>& spCallback, int32_t cfgId, std::chrono::nanoseconds duration)
+{
+	if (!m_watchdog.Record(spCallback.get(), duration))
+	{
+		return;
+	}
+
+	MSV_LOG_ERROR(m_spLogger, "Config callback {} exceeded budget {} us (cfgId: {}, duration: {} us).", static_cast<const void*>(spCallback.get()), m_watchdog.GetBudget().count(),
+		cfgId, std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+
+	if (!m_quarantine)
+	{
+		return;
+	}
+
+	if (!m_spQuarantineDispatcher)
+	{
+		//one worker -> quarantined callbacks are notified in order (slow callback delays only other quarantined ones)
+		std::shared_ptr<MsvActiveConfigDispatcher> spDispatcher(new (std::nothrow) MsvActiveConfigDispatcher(1024, 1, m_spLogger));
+		if (!spDispatcher)
+		{
+			MSV_LOG_ERROR(m_spLogger, "Create quarantine dispatcher failed with error: {0:x}", MSV_ALLOCATION_ERROR);
+			return;
+		}
+
+		MsvErrorCode errorCode = spDispatcher->Initialize();
+		if (MSV_FAILED(errorCode))
+		{
+			MSV_LOG_ERROR(m_spLogger, "Initialize quarantine dispatcher failed with error: {0:x}", errorCode);
+			return;
+		}
+
+		m_spQuarantineDispatcher = spDispatcher;
+	}
+
+	m_watchdog.Quarantine(spCallback.get());
+
+	MSV_LOG_INFO(m_spLogger, "Config callback {} has been quarantined (it is notified asynchronously).", static_cast<const void*>(spCallback.get()));
+}
+
+template<class T, class C> MsvErrorCode MsvActiveConfig::GetValue(int32_t cfgId, std::map<int32_t, C> MsvActiveConfigDatabase::* pValues, T& value) const
+{
+	//overrides of calling thread (one thread local load when thread has none)
+	if (MsvConfigOverrides::GetValue(this, cfgId, value))
+	{
+		return MSV_SUCCESS;
+	}
+
+	//readers share locks (config lock is not locked -> readers do not wait for notifications)
+	std::shared_lock<std::shared_mutex> databaseLock(m_databaseLock);
+
+	if (!m_spDatabase)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration is not initialized - error:", MSV_NOT_INITIALIZED_ERROR);
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	std::shared_lock<std::shared_mutex> valuesLock(m_spDatabase->m_valuesLock);
+
+	const std::map<int32_t, C>& values = (*m_spDatabase).*pValues;
+	typename std::map<int32_t, C>::const_iterator it = values.find(cfgId);
+
+	if (it != values.end())
+	{
+		value = FromCachedValue(it->second);
+		return MSV_SUCCESS;
+	}
+
+	valuesLock.unlock();
+
+	//derived values are memoized by this instance (they are not in database)
+	if (m_spDerived && MSV_SUCCEEDED(m_spDerived->GetValue<T>(cfgId, value)))
+	{
+		return MSV_SUCCESS;
+	}
+
+	if (m_spDatabase->m_lazy)
+	{
+		//value has not been accessed yet -> load it from storage
+		return LoadValue<T>(*m_spDatabase, cfgId, pValues, value);
+	}
+
+	MSV_LOG_ERROR(m_spLogger, "Active configuration value {} has not been found - error:", cfgId, MSV_NOT_FOUND_ERROR);
+
+	return MSV_NOT_FOUND_ERROR;
+}
+
+template<class T> MsvErrorCode MsvActiveConfig::SetValue(int32_t cfgId, std::map<int32_t, T> MsvActiveConfigDatabase::* pValues, const T& value)
+{
+	std::shared_ptr<MsvActiveConfigDatabase> spDatabase = GetDatabase();
+	if (!spDatabase)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration is not initialized - error:", MSV_NOT_INITIALIZED_ERROR);
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	//storage is opened by snapshot verification -> wait for it (failed storage open is retried in background)
+	MsvErrorCode openErrorCode = spDatabase->WaitForVerification();
+	if (MSV_FAILED(openErrorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration storage has not been opened - error: {0:x}", openErrorCode);
+		return openErrorCode;
+	}
+
+	//storage notifies all instances sharing database -> writes of one key shard are serialized (config lock is not
+	//held, other instance might wait for database write lock while it holds its config lock)
+	MsvActiveConfigKeyWriteGuard writeGuard(spDatabase->m_writeLock, cfgId);
+	if (MSV_FAILED(writeGuard.GetErrorCode()))
+	{
+		//callback of sharded write writes key of other shard (it would deadlock with other such callback)
+		MSV_LOG_ERROR(m_spLogger, "Active configuration value {} can not be written during write of other shard - error: {:x}", cfgId, writeGuard.GetErrorCode());
+		return writeGuard.GetErrorCode();
+	}
+
+	//key map is checked -> value does not have to be cached in lazy mode
+	if (HasValue<T>(*spDatabase, cfgId))
+	{
+		//update database first
+		MsvErrorCode errorCode = spDatabase->m_spStorage->StoreValue(cfgId, value);
+		if (MSV_FAILED(errorCode))
 		{
 			MSV_LOG_ERROR(m_spLogger, "Store active configuration value {} to storage failed with error: {0:x}", cfgId, errorCode);
 			return errorCode;
 		}
 
-		//set new value to cache
-		it->second = value;
+		//set new value to shared cache
+		{
+			std::unique_lock<std::shared_mutex> valuesLock(spDatabase->m_valuesLock);
+			((*spDatabase).*pValues)[cfgId] = value;
+			spDatabase->m_snapshot.Invalidate();
+		}
+
+		//waiters read new value when they are woken
+		spDatabase->RecordChange(cfgId, ToConfigValue(value));
+
+		return MSV_SUCCESS;
+	}
+
+	MSV_LOG_ERROR(m_spLogger, "Active configuration value {} has not been found - error:", cfgId, MSV_NOT_FOUND_ERROR);
+
+	return MSV_NOT_FOUND_ERROR;
+}
+
+template<class T, class C> MsvErrorCode MsvActiveConfig::LoadValue(MsvActiveConfigDatabase& database, int32_t cfgId, std::map<int32_t, C> MsvActiveConfigDatabase::* pValues, T& value) const
+{
+	//concurrent first accesses wait here (storage connection is serialized anyway, so one load lock is enough)
+	std::lock_guard<std::mutex> loadLock(database.m_loadLock);
+
+	{
+		//value might have been loaded by concurrent first access (or set) meanwhile
+		std::shared_lock<std::shared_mutex> valuesLock(database.m_valuesLock);
+		typename std::map<int32_t, C>::const_iterator it = (database.*pValues).find(cfgId);
+		if (it != (database.*pValues).end())
+		{
+			value = FromCachedValue(it->second);
+			return MSV_SUCCESS;
+		}
+	}
+
+	if (!HasValue<T>(database, cfgId))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration value {} has not been found - error:", cfgId, MSV_NOT_FOUND_ERROR);
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	T loadedValue = T();
+	MsvErrorCode errorCode = database.m_spStorage->GetValue(cfgId, loadedValue);
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Load active configuration value {} from storage failed with error: {:x}", cfgId, errorCode);
+		return errorCode;
+	}
+
+	//value set while it was loaded is newer -> it is not overwritten
+	std::unique_lock<std::shared_mutex> valuesLock(database.m_valuesLock);
+	value = FromCachedValue((database.*pValues).emplace(cfgId, ToCachedValue(std::move(loadedValue))).first->second);
+	database.m_snapshot.Invalidate();
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfig::PrefetchValues(MsvActiveConfigDatabase& database, const std::vector<int32_t>& cfgIds) const
+{
+	const std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>& keyMap = database.m_spConfigKeyMap->GetMap();
+	for (std::vector<int32_t>::const_iterator it = cfgIds.begin(); it != cfgIds.end(); ++it)
+	{
+		std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>::const_iterator keyIt = keyMap.find(*it);
+		if (keyIt == keyMap.end())
+		{
+			MSV_LOG_ERROR(m_spLogger, "Active configuration value {} has not been found - error:", *it, MSV_NOT_FOUND_ERROR);
+			return MSV_NOT_FOUND_ERROR;
+		}
+
+		//value is loaded to cache only when it has not been loaded yet
+		MsvErrorCode errorCode = MSV_SUCCESS;
+		if (keyIt->second->IsBool())
+		{
+			bool value = false;
+			errorCode = LoadValue<bool>(database, *it, &MsvActiveConfigDatabase::m_boolValues, value);
+		}
+		else if (keyIt->second->IsDouble())
+		{
+			double value = 0.0;
+			errorCode = LoadValue<double>(database, *it, &MsvActiveConfigDatabase::m_doubleValues, value);
+		}
+		else if (keyIt->second->IsInteger())
+		{
+			int64_t value = 0;
+			errorCode = LoadValue<int64_t>(database, *it, &MsvActiveConfigDatabase::m_integerValues, value);
+		}
+		else if (keyIt->second->IsString())
+		{
+			std::string value;
+			errorCode = LoadValue<std::string>(database, *it, &MsvActiveConfigDatabase::m_stringValues, value);
+		}
+		else if (keyIt->second->IsUnsigned())
+		{
+			uint64_t value = 0;
+			errorCode = LoadValue<uint64_t>(database, *it, &MsvActiveConfigDatabase::m_unsignedValues, value);
+		}
+
+		if (MSV_FAILED(errorCode))
+		{
+			MSV_LOG_ERROR(m_spLogger, "Prefetch active configuration value {} failed with error: {:x}", *it, errorCode);
+			return errorCode;
+		}
+	}
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfig::GetSnapshot(MsvActiveConfigDatabase& database, std::shared_ptr<const MsvConfigSnapshot>& spSnapshot) const
+{
+	//snapshot is cached until next change -> no lock and no copy
+	spSnapshot = database.m_snapshot.Load();
+	if (spSnapshot)
+	{
+		return MSV_SUCCESS;
+	}
+
+	if (database.m_lazy)
+	{
+		//snapshot contains all values -> load values which have not been accessed yet
+		std::vector<int32_t> cfgIds;
+		const std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>& keyMap = database.m_spConfigKeyMap->GetMap();
+		for (std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>::const_iterator it = keyMap.begin(); it != keyMap.end(); ++it)
+		{
+			cfgIds.push_back(it->first);
+		}
+
+		MsvErrorCode errorCode = PrefetchValues(database, cfgIds);
+		if (MSV_FAILED(errorCode))
+		{
+			return errorCode;
+		}
+	}
+
+	//snapshot is published under shared lock -> writers (they invalidate it under exclusive lock) can not make it stale
+	std::shared_lock<std::shared_mutex> valuesLock(database.m_valuesLock);
+
+	MsvConfigValues values;
+	values.m_boolValues = database.m_boolValues;
+	values.m_doubleValues = database.m_doubleValues;
+	values.m_integerValues = database.m_integerValues;
+	for (std::map<int32_t, std::shared_ptr<const std::string>>::const_iterator it = database.m_stringValues.begin(); it != database.m_stringValues.end(); ++it)
+	{
+		values.m_stringValues.emplace_hint(values.m_stringValues.end(), it->first, *it->second);
+	}
+	values.m_unsignedValues = database.m_unsignedValues;
+
+	spSnapshot = database.m_snapshot.Publish(std::move(values));
+	if (!spSnapshot)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Create active configuration snapshot failed with error: {0:x}", MSV_ALLOCATION_ERROR);
+		return MSV_ALLOCATION_ERROR;
+	}
+
+	return MSV_SUCCESS;
+}
+
+template<class T> bool MsvActiveConfig::HasValue(const MsvActiveConfigDatabase& database, int32_t cfgId)
+{
+	//key map is immutable -> no lock
+	std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>::const_iterator it = database.m_spConfigKeyMap->GetMap().find(cfgId);
+
+	return (it != database.m_spConfigKeyMap->GetMap().end()) && IsValueType(*it->second, static_cast<const T*>(nullptr));
+}
+
+MsvErrorCode MsvActiveConfig::OpenDatabase(std::shared_ptr<IMsvConfigKeyMap<IMsvDefaultValue>> spConfigKeyMap, const char* configPath, const char* groupName, MsvActiveConfigDatabase& database, bool useSnapshot)
+{
+	std::shared_ptr<IMsvActiveConfigStorage> spStorage;
+	if (m_writeShards > 1)
+	{
+		//each shard has its own storage (SQLite file and connection) -> shards do not wait for each other
+		std::vector<std::shared_ptr<IMsvActiveConfigStorage>> partitions;
+		for (size_t i = 0; i < m_writeShards; ++i)
+		{
+			std::shared_ptr<IMsvActiveConfigStorage> spPartition = m_spFactory->GetIMsvActiveConfigStorage(m_spLogger);
+			if (!spPartition)
+			{
+				break;
+			}
+
+			partitions.push_back(spPartition);
+		}
+
+		if (partitions.size() == m_writeShards)
+		{
+			spStorage.reset(new (std::nothrow) MsvActiveConfigShardedStorage(partitions, m_spLogger));
+		}
+	}
+	else
+	{
+		spStorage = m_spFactory->GetIMsvActiveConfigStorage(m_spLogger);
+	}
+
+	if (!spStorage)
+	{
+		//allocation failed
+		MSV_LOG_ERROR(m_spLogger, "Get active configuration storage failed with error: {0:x}", MSV_ALLOCATION_ERROR);
+		return MSV_ALLOCATION_ERROR;
+	}
+
+	database.m_spConfigKeyMap = spConfigKeyMap;
+	database.m_configPath = configPath;
+	database.m_groupName = groupName;
+	database.m_lazy = m_lazyLoading;
+	database.m_journal.SetCapacity(m_journalSize);
+	database.m_writeLock.SetShardCount(m_writeShards);
+
+	if (useSnapshot && !database.m_lazy && !m_snapshotPath.empty())
+	{
+		//valid snapshot -> reads are served from it, storage is opened later by verification (it might be slow)
+		MsvErrorCode errorCode = MsvActiveConfigSnapshot::Load(m_snapshotPath.c_str(), database, database.m_snapshotRevision);
+		if (MSV_SUCCEEDED(errorCode))
+		{
+			MSV_LOG_INFO(m_spLogger, "Active configuration values have been loaded from snapshot - storage will be verified in background.");
+			database.m_spStorage = spStorage;
+			database.m_verifyPending = true;
+			database.m_verifying = true;
+			return MSV_SUCCESS;
+		}
+
+		MSV_LOG_INFO(m_spLogger, "Active configuration snapshot has not been loaded ({0:x}) - loading values from storage.", errorCode);
+	}
+
+	MsvErrorCode errorCode = spStorage->Initialize(spConfigKeyMap, configPath, groupName);
+	if (MSV_FAILED(errorCode))
+	{
+		//initialize config storage failed
+		MSV_LOG_ERROR(m_spLogger, "Initialize active configuration storage failed with error: {0:x}", errorCode);
+		return errorCode;
+	}
 
+	if (database.m_lazy)
+	{
+		//values are loaded on first access
+		MSV_LOG_INFO(m_spLogger, "Active configuration values will be loaded lazily (on first access).");
+		database.m_spStorage = spStorage;
 		return MSV_SUCCESS;
 	}
 
-	MSV_LOG_ERROR(m_spLogger, "Active configuration value {} has not been found - error:", cfgId, MSV_NOT_FOUND_ERROR);
+	//database is not shared yet -> cache does not have to be locked
+	if (MSV_FAILED(errorCode = LoadValues(*spStorage, database, m_spLogger)))
+	{
+		//read configuration values from configuration storage failed -> close storage (database is not used)
+		spStorage->Uninitialize();
+		return errorCode;
+	}
 
-	return MSV_NOT_FOUND_ERROR;
+	database.m_spStorage = spStorage;
+
+	return MSV_SUCCESS;
+}
+
+std::shared_ptr<MsvActiveConfigDatabase> MsvActiveConfig::GetDatabase() const
+{
+	std::shared_lock<std::shared_mutex> databaseLock(m_databaseLock);
+
+	return m_spDatabase;
+}
+
+MsvErrorCode MsvActiveConfig::AttachDatabase(std::shared_ptr<MsvActiveConfigDatabase> spDatabase, std::shared_ptr<IMsvActiveConfigStorageCallback> spStorageCallback)
+{
+	MsvErrorCode errorCode = MSV_SUCCESS;
+
+	if (MSV_FAILED(errorCode = spDatabase->m_spStorage->RegisterCallback(spStorageCallback)))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Register active configuration storage callback failed with error: {0:x}", errorCode);
+		return errorCode;
+	}
+
+	//snapshot verification notifies differences to all instances using database
+	if (MSV_FAILED(errorCode = spDatabase->m_callbacks.Register(spStorageCallback)))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Register active configuration database callback failed with error: {0:x}", errorCode);
+		spDatabase->m_spStorage->UnregisterCallback(spStorageCallback);
+		return errorCode;
+	}
+
+	//pollable handle is signaled by database (after cache update), it might be opened before initialize
+	if (m_spNotifier && MSV_FAILED(errorCode = spDatabase->m_notifiers.Register(m_spNotifier)))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Register active configuration change notifier failed with error: {0:x}", errorCode);
+		spDatabase->m_callbacks.Unregister(spStorageCallback);
+		spDatabase->m_spStorage->UnregisterCallback(spStorageCallback);
+		return errorCode;
+	}
+
+	//derived values are recomputed by database (after cache update) when their dependency has been changed
+	if (m_spDerived && MSV_FAILED(errorCode = spDatabase->m_derivedValues.Register(m_spDerived)))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Register active configuration derived values failed with error: {0:x}", errorCode);
+		if (m_spNotifier)
+		{
+			spDatabase->m_notifiers.Unregister(m_spNotifier);
+		}
+		spDatabase->m_callbacks.Unregister(spStorageCallback);
+		spDatabase->m_spStorage->UnregisterCallback(spStorageCallback);
+		return errorCode;
+	}
+
+	//instance callbacks are measured by storage too (budget might be set before initialize)
+	if (m_watchdog.GetBudget().count() > 0)
+	{
+		spDatabase->m_spStorage->SetCallbackBudget(static_cast<uint32_t>(m_watchdog.GetBudget().count()));
+	}
+
+	//cache has been loaded from snapshot -> verify it in background (callback is registered, differences will be notified)
+	bool verifyNow = false;
+	{
+		std::lock_guard<std::mutex> verifyLock(spDatabase->m_verifyLock);
+		if (spDatabase->m_verifyPending)
+		{
+			spDatabase->m_verifyPending = false;
+
+			try
+			{
+				spDatabase->m_verifyThread = std::thread(&MsvActiveConfig::VerifySnapshot, spDatabase.get(), m_spLogger);
+			}
+			catch (...)
+			{
+				MSV_LOG_ERROR(m_spLogger, "Create snapshot verification thread failed with error: {0:x} - verifying snapshot now.", MSV_ALLOCATION_ERROR);
+				verifyNow = true;
+			}
+		}
+	}
+
+	if (verifyNow)
+	{
+		VerifySnapshot(spDatabase.get(), m_spLogger);
+	}
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfig::DetachDatabase(MsvActiveConfigDatabase& database, std::shared_ptr<IMsvActiveConfigStorageCallback> spStorageCallback)
+{
+	database.m_callbacks.Unregister(spStorageCallback);
+	if (m_spNotifier)
+	{
+		database.m_notifiers.Unregister(m_spNotifier);
+	}
+	if (m_spDerived)
+	{
+		database.m_derivedValues.Unregister(m_spDerived);
+	}
+
+	MsvErrorCode errorCode = database.m_spStorage->UnregisterCallback(spStorageCallback);
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Unregister active configuration storage callback failed with error: {0:x}", errorCode);
+	}
+
+	return errorCode;
+}
+
+MsvErrorCode MsvActiveConfig::LoadValues(IMsvActiveConfigStorage& storage, MsvActiveConfigDatabase& database, std::shared_ptr<MsvLogger> spLogger)
+{
+	MsvErrorCode errorCode = MSV_SUCCESS;
+
+	std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>::const_iterator endIt = database.m_spConfigKeyMap->GetMap().end();
+	for (std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>::const_iterator it = database.m_spConfigKeyMap->GetMap().begin(); it != endIt; ++it)
+	{
+		int32_t cfgId = it->first;
+
+		if (it->second->IsBool())
+		{
+			bool value = false;
+			if (MSV_FAILED(errorCode = storage.GetValue(it->first, value)))
+			{
+				MSV_LOG_ERROR(spLogger, "Get bool value {} from configuration storage failed with error: {:x}", it->first, errorCode);
+				break;
+			}
+
+			database.m_boolValues[cfgId] = value;
+		}
+		else if (it->second->IsDouble())
+		{
+			double value = 0.0;
+			if (MSV_FAILED(errorCode = storage.GetValue(it->first, value)))
+			{
+				MSV_LOG_ERROR(spLogger, "Get double value {} from configuration storage failed with error: {:x}", it->first, errorCode);
+				break;
+			}
+
+			database.m_doubleValues[cfgId] = value;
+		}
+		else if (it->second->IsInteger())
+		{
+			int64_t value = 0;
+			if (MSV_FAILED(errorCode = storage.GetValue(it->first, value)))
+			{
+				MSV_LOG_ERROR(spLogger, "Get int64_t value {} from configuration storage failed with error: {:x}", it->first, errorCode);
+				break;
+			}
+
+			database.m_integerValues[cfgId] = value;
+		}
+		else if (it->second->IsString())
+		{
+			std::string value;
+			if (MSV_FAILED(errorCode = storage.GetValue(it->first, value)))
+			{
+				MSV_LOG_ERROR(spLogger, "Get string value {} from configuration storage failed with error: {:x}", it->first, errorCode);
+				break;
+			}
+
+			database.m_stringValues[cfgId] = ToCachedValue(std::move(value));
+		}
+		else if (it->second->IsUnsigned())
+		{
+			uint64_t value;
+			if (MSV_FAILED(errorCode = storage.GetValue(it->first, value)))
+			{
+				MSV_LOG_ERROR(spLogger, "Get uint64_t value {} from configuration storage failed with error: {:x}", it->first, errorCode);
+				break;
+			}
+
+			database.m_unsignedValues[cfgId] = value;
+		}
+		else
+		{
+			errorCode = MSV_INVALID_DATA_ERROR;
+			MSV_LOG_ERROR(spLogger, "Unknown type of configuration value - error: {0:x}", errorCode);
+			break;
+		}
+	}
+
+	return errorCode;
+}
+
+void MsvActiveConfig::VerifySnapshot(MsvActiveConfigDatabase* pDatabase, std::shared_ptr<MsvLogger> spLogger)
+{
+	MsvActiveConfigDatabase& database = *pDatabase;
+
+	MSV_LOG_INFO(spLogger, "Verifying active configuration snapshot.");
+
+	//slow part (open and read storage) runs without locks, cache is still served from snapshot
+	MsvActiveConfigDatabase verified;
+	verified.m_spConfigKeyMap = database.m_spConfigKeyMap;
+	bool applyValues = false;
+
+	//retried open is made under database write lock -> no write is stored between open and verification
+	std::unique_lock<MsvActiveConfigWriteLock> retryLock(database.m_writeLock, std::defer_lock);
+	std::chrono::milliseconds retryDelay(MSV_ACTIVECONFIG_STORAGE_RETRY_MS);
+
+	MsvErrorCode errorCode = database.m_spStorage->Initialize(database.m_spConfigKeyMap, database.m_configPath.c_str(), database.m_groupName.c_str());
+	while (MSV_FAILED(errorCode))
+	{
+		if (retryLock.owns_lock())
+		{
+			retryLock.unlock();
+		}
+
+		MSV_LOG_ERROR(spLogger, "Initialize active configuration storage failed with error: {:x} - retrying in {} ms.", errorCode, retryDelay.count());
+
+		//reads keep snapshot values, writes fail with open error until storage is opened
+		{
+			std::unique_lock<std::mutex> verifyLock(database.m_verifyLock);
+			database.m_storageError = errorCode;
+			database.m_verifying = false;
+			database.m_verifyCondition.notify_all();
+
+			if (database.m_verifyCondition.wait_for(verifyLock, retryDelay, [&database]() { return database.m_stopVerify; }))
+			{
+				//database is being destroyed
+				return;
+			}
+		}
+
+		retryDelay = std::min(retryDelay * 2, std::chrono::milliseconds(MSV_ACTIVECONFIG_STORAGE_RETRY_MAX_MS));
+
+		retryLock.lock();
+		errorCode = database.m_spStorage->Initialize(database.m_spConfigKeyMap, database.m_configPath.c_str(), database.m_groupName.c_str());
+	}
+
+	//storage has not been changed since snapshot has been saved -> values do not have to be read
+	uint64_t revision = 0;
+	if (database.m_snapshotRevision != 0 && MSV_SUCCEEDED(MsvActiveConfigSnapshot::GetStorageRevision(database, revision)) && revision == database.m_snapshotRevision)
+	{
+		MSV_LOG_INFO(spLogger, "Active configuration snapshot is up to date.");
+	}
+	else if (MSV_FAILED(errorCode = LoadValues(*database.m_spStorage, verified, spLogger)))
+	{
+		MSV_LOG_ERROR(spLogger, "Load active configuration values for snapshot verification failed with error: {0:x}", errorCode);
+	}
+	else
+	{
+		applyValues = true;
+	}
+
+	//differences are set and notified as one write (writes of instances wait for it)
+	std::lock_guard<MsvActiveConfigWriteLock> writeLock(database.m_writeLock);
+
+	if (applyValues)
+	{
+		{
+			std::unique_lock<std::shared_mutex> valuesLock(database.m_valuesLock);
+			ApplyVerifiedValues<bool>(database, &MsvActiveConfigDatabase::m_boolValues, verified.m_boolValues);
+			ApplyVerifiedValues<double>(database, &MsvActiveConfigDatabase::m_doubleValues, verified.m_doubleValues);
+			ApplyVerifiedValues<int64_t>(database, &MsvActiveConfigDatabase::m_integerValues, verified.m_integerValues);
+			ApplyVerifiedValues<std::shared_ptr<const std::string>>(database, &MsvActiveConfigDatabase::m_stringValues, verified.m_stringValues);
+			ApplyVerifiedValues<uint64_t>(database, &MsvActiveConfigDatabase::m_unsignedValues, verified.m_unsignedValues);
+			database.m_snapshot.Invalidate();
+		}
+
+		RecordVerifiedValues<bool>(database, verified.m_boolValues);
+		RecordVerifiedValues<double>(database, verified.m_doubleValues);
+		RecordVerifiedValues<int64_t>(database, verified.m_integerValues);
+		RecordVerifiedValues<std::shared_ptr<const std::string>>(database, verified.m_stringValues);
+		RecordVerifiedValues<uint64_t>(database, verified.m_unsignedValues);
+	}
+
+	//callbacks might write (write lock is recursive, verification must not be waited for)
+	{
+		std::lock_guard<std::mutex> verifyLock(database.m_verifyLock);
+		database.m_storageError = MSV_SUCCESS;
+		database.m_verifying = false;
+	}
+	database.m_verifyCondition.notify_all();
+
+	if (applyValues)
+	{
+		MSV_LOG_INFO(spLogger, "Active configuration snapshot has been verified ({} values changed).", verified.m_boolValues.size() + verified.m_doubleValues.size()
+			+ verified.m_integerValues.size() + verified.m_stringValues.size() + verified.m_unsignedValues.size());
+
+		std::shared_ptr<const std::vector<std::shared_ptr<IMsvActiveConfigStorageCallback>>> spCallbacks = database.m_callbacks.Load();
+		NotifyVerifiedValues<bool>(*spCallbacks, verified.m_boolValues);
+		NotifyVerifiedValues<double>(*spCallbacks, verified.m_doubleValues);
+		NotifyVerifiedValues<int64_t>(*spCallbacks, verified.m_integerValues);
+		NotifyVerifiedValues<std::shared_ptr<const std::string>>(*spCallbacks, verified.m_stringValues);
+		NotifyVerifiedValues<uint64_t>(*spCallbacks, verified.m_unsignedValues);
+	}
+}
+
+template<class T> void MsvActiveConfig::ApplyVerifiedValues(MsvActiveConfigDatabase& database, std::map<int32_t, T> MsvActiveConfigDatabase::* pValues, std::map<int32_t, T>& values)
+{
+	std::map<int32_t, T>& cachedValues = database.*pValues;
+
+	for (typename std::map<int32_t, T>::iterator it = values.begin(); it != values.end();)
+	{
+		typename std::map<int32_t, T>::iterator cachedIt = cachedValues.find(it->first);
+		if (cachedIt != cachedValues.end() && FromCachedValue(cachedIt->second) == FromCachedValue(it->second))
+		{
+			//snapshot value is valid -> nothing to notify
+			it = values.erase(it);
+			continue;
+		}
+
+		cachedValues[it->first] = it->second;
+		++it;
+	}
+}
+
+template<class T> void MsvActiveConfig::RecordVerifiedValues(MsvActiveConfigDatabase& database, const std::map<int32_t, T>& values)
+{
+	for (typename std::map<int32_t, T>::const_iterator it = values.begin(); it != values.end(); ++it)
+	{
+		database.RecordChange(it->first, ToConfigValue(it->second));
+	}
+}
+
+template<class T> void MsvActiveConfig::NotifyVerifiedValues(const std::vector<std::shared_ptr<IMsvActiveConfigStorageCallback>>& callbacks, const std::map<int32_t, T>& values)
+{
+	for (typename std::map<int32_t, T>::const_iterator it = values.begin(); it != values.end(); ++it)
+	{
+		std::vector<std::shared_ptr<IMsvActiveConfigStorageCallback>>::const_iterator endCallbackIt = callbacks.end();
+		for (std::vector<std::shared_ptr<IMsvActiveConfigStorageCallback>>::const_iterator callbackIt = callbacks.begin(); callbackIt != endCallbackIt; ++callbackIt)
+		{
+			(*callbackIt)->OnValueChanged(it->first, ToCallbackValue(it->second));
+		}
+	}
+}
+
+template<class T> void MsvActiveConfig::DiffValues(const std::map<int32_t, T>& oldValues, const std::map<int32_t, T>& newValues, std::map<int32_t, T>& changedValues, std::vector<int32_t>& changedCfgIds)
+{
+	for (typename std::map<int32_t, T>::const_iterator it = newValues.begin(); it != newValues.end(); ++it)
+	{
+		typename std::map<int32_t, T>::const_iterator oldIt = oldValues.find(it->first);
+		if (oldIt == oldValues.end() || !(oldIt->second == it->second))
+		{
+			changedValues.emplace_hint(changedValues.end(), it->first, it->second);
+			changedCfgIds.push_back(it->first);
+		}
+	}
+}
+
+void MsvActiveConfig::AddPendingChange(int32_t cfgId, MsvConfigValue&& newValue)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	//only last value is kept (subscriber needs current state, not history)
+	m_pendingChanges[cfgId] = std::move(newValue);
+
+	if (m_batchDepth)
+	{
+		//multi-key write is running -> it flushes all changes at its end
+		return;
+	}
+
+	if (m_coalescingWindow.count() == 0)
+	{
+		DeliverChanges();
+		return;
+	}
+
+	if (!m_flushScheduled)
+	{
+		//first change in window -> start window
+		m_flushScheduled = true;
+		m_flushDeadline = std::chrono::steady_clock::now() + m_coalescingWindow;
+		m_flushCondition.notify_all();
+	}
+}
+
+void MsvActiveConfig::StopFlushThread()
+{
+	std::unique_lock<std::recursive_mutex> lock(m_lock);
+
+	if (m_flushThread.joinable())
+	{
+		m_stopFlush = true;
+		m_flushCondition.notify_all();
+
+		lock.unlock();
+		m_flushThread.join();
+		lock.lock();
+
+		m_stopFlush = false;
+	}
+
+	//database write lock is locked before config lock
+	lock.unlock();
+	FlushChanges();
 }
 
+void MsvActiveConfig::FlushThread()
+{
+	std::unique_lock<std::recursive_mutex> lock(m_lock);
+
+	for (;;)
+	{
+		m_flushCondition.wait(lock, [this]() { return m_stopFlush || m_flushScheduled; });
+
+		if (m_stopFlush)
+		{
+			return;
+		}
+
+		if (std::chrono::steady_clock::now() < m_flushDeadline)
+		{
+			//wait for the end of window (or stop request), then check again (flush might be done meanwhile)
+			m_flushCondition.wait_until(lock, m_flushDeadline);
+			continue;
+		}
+
+		//database write lock is locked before config lock (batch callback might write config)
+		lock.unlock();
+		FlushChanges();
+		lock.lock();
+	}
+}
 
 /** @} */	//End of group MCONFIG.
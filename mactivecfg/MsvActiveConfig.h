@@ -37,13 +37,24 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 
 #include "IMsvActiveConfig.h"
 #include "IMsvActiveConfigStorage.h"
+#include "MsvActiveConfigDispatcher.h"
+#include "MsvActiveConfigRegistry.h"
 
 #include "mlogging/mlogging.h"
+#include "mconfig/common/MsvCallbackWatchdog.h"
+#include "mconfig/common/MsvCopyOnWrite.h"
 
 MSV_DISABLE_ALL_WARNINGS
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
-#include <forward_list>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 MSV_ENABLE_WARNINGS
 
@@ -98,6 +109,11 @@ protected:
 		******************************************************************************************************/
 		virtual void OnValueChanged(int32_t cfgId, const char* newValue) override;
 
+		/**************************************************************************************************//**
+		* @copydoc IMsvActiveConfigStorageCallback::OnValueChanged(int32_t cfgId, const std::shared_ptr<const std::string>& spNewValue)
+		******************************************************************************************************/
+		virtual void OnValueChanged(int32_t cfgId, const std::shared_ptr<const std::string>& spNewValue) override;
+
 		/**************************************************************************************************//**
 		* @copydoc IMsvActiveConfigStorageCallback::OnValueChanged(int32_t cfgId, uint64_t value)
 		******************************************************************************************************/
@@ -111,6 +127,28 @@ protected:
 		MsvActiveConfig* m_pConfig;
 	};
 
+	/**************************************************************************************************//**
+	* @brief		Range callback.
+	* @details	Callback registered for config ID range.
+	******************************************************************************************************/
+	struct MsvRangeCallback
+	{
+		int32_t m_firstCfgId;												//!< First config ID of range.
+		int32_t m_lastCfgId;													//!< Last config ID of range.
+		std::shared_ptr<IMsvActiveConfigCallback> m_spCallback;		//!< Registered callback.
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Subscriptions.
+	* @details	All callback registrations (immutable snapshot, it is copied and swapped on change).
+	******************************************************************************************************/
+	struct MsvSubscriptions
+	{
+		std::vector<std::shared_ptr<IMsvActiveConfigCallback>> m_callbacks;										//!< Callbacks registered for all changes.
+		std::map<int32_t, std::vector<std::shared_ptr<IMsvActiveConfigCallback>>> m_cfgIdCallbacks;		//!< Index from config ID to callbacks registered for the config ID (and for groups with it).
+		std::multimap<int32_t, MsvRangeCallback> m_rangeCallbacks;													//!< Callbacks registered for config ID ranges sorted by first config ID.
+	};
+
 public:
 	/**************************************************************************************************//**
 	* @brief			Constructor.
@@ -145,6 +183,11 @@ public:
 	******************************************************************************************************/
 	virtual MsvErrorCode Uninitialize() override;
 
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfig::Retarget(const char* configPath, const char* groupName)
+	******************************************************************************************************/
+	virtual MsvErrorCode Retarget(const char* configPath, const char* groupName = "MsvConfig") override;
+
 	/**************************************************************************************************//**
 	* @copydoc IMsvActiveConfig::Initialized() const
 	******************************************************************************************************/
@@ -195,21 +238,268 @@ public:
 	******************************************************************************************************/
 	virtual MsvErrorCode SetValue(int32_t cfgId, const std::string& value) override;
 
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfig::SetValue(int32_t cfgId, std::string&& value)
+	******************************************************************************************************/
+	virtual MsvErrorCode SetValue(int32_t cfgId, std::string&& value) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfig::SetValue(int32_t cfgId, const std::shared_ptr<const std::string>& spValue)
+	******************************************************************************************************/
+	virtual MsvErrorCode SetValue(int32_t cfgId, const std::shared_ptr<const std::string>& spValue) override;
+
 	/**************************************************************************************************//**
 	* @copydoc IMsvActiveConfig::SetValue(int32_t cfgId, uint64_t value)
 	******************************************************************************************************/
 	virtual MsvErrorCode SetValue(int32_t cfgId, uint64_t value) override;
 
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfig::SetValues(const std::vector<MsvConfigValueUpdate>& values)
+	******************************************************************************************************/
+	virtual MsvErrorCode SetValues(const std::vector<MsvConfigValueUpdate>& values) override;
+
 	/**************************************************************************************************//**
 	* @copydoc IMsvActiveConfig::RegisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback)
 	******************************************************************************************************/
 	virtual MsvErrorCode RegisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback) override;
 
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfig::RegisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback, int32_t cfgId)
+	******************************************************************************************************/
+	virtual MsvErrorCode RegisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback, int32_t cfgId) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfig::RegisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback, int32_t firstCfgId, int32_t lastCfgId)
+	******************************************************************************************************/
+	virtual MsvErrorCode RegisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback, int32_t firstCfgId, int32_t lastCfgId) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfig::RegisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback, const std::vector<int32_t>& cfgIds)
+	******************************************************************************************************/
+	virtual MsvErrorCode RegisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback, const std::vector<int32_t>& cfgIds) override;
+
 	/**************************************************************************************************//**
 	* @copydoc IMsvActiveConfig::UnregisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback)
 	******************************************************************************************************/
 	virtual MsvErrorCode UnregisterCallback(std::shared_ptr<IMsvActiveConfigCallback> spCallback) override;
 
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfig::RegisterBatchCallback(std::shared_ptr<IMsvActiveConfigBatchCallback> spCallback)
+	******************************************************************************************************/
+	virtual MsvErrorCode RegisterBatchCallback(std::shared_ptr<IMsvActiveConfigBatchCallback> spCallback) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfig::UnregisterBatchCallback(std::shared_ptr<IMsvActiveConfigBatchCallback> spCallback)
+	******************************************************************************************************/
+	virtual MsvErrorCode UnregisterBatchCallback(std::shared_ptr<IMsvActiveConfigBatchCallback> spCallback) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfig::GetVersion(uint64_t& version) const
+	******************************************************************************************************/
+	virtual MsvErrorCode GetVersion(uint64_t& version) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfig::WaitForChange(int32_t cfgId, uint64_t sinceVersion, uint32_t timeoutMs, uint64_t& version) const
+	******************************************************************************************************/
+	virtual MsvErrorCode WaitForChange(int32_t cfgId, uint64_t sinceVersion, uint32_t timeoutMs, uint64_t& version) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfig::WaitForChange(const std::vector<int32_t>& cfgIds, uint64_t sinceVersion, uint32_t timeoutMs, uint64_t& version) const
+	******************************************************************************************************/
+	virtual MsvErrorCode WaitForChange(const std::vector<int32_t>& cfgIds, uint64_t sinceVersion, uint32_t timeoutMs, uint64_t& version) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfig::PollChanges(uint64_t lastSequence, std::vector<MsvConfigValueJournalEntry>& changes, uint64_t& sequence) const
+	******************************************************************************************************/
+	virtual MsvErrorCode PollChanges(uint64_t lastSequence, std::vector<MsvConfigValueJournalEntry>& changes, uint64_t& sequence) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfig::GetNotificationHandle(int& handle)
+	******************************************************************************************************/
+	virtual MsvErrorCode GetNotificationHandle(int& handle) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfig::DrainChanges(std::vector<int32_t>& changedCfgIds)
+	******************************************************************************************************/
+	virtual MsvErrorCode DrainChanges(std::vector<int32_t>& changedCfgIds) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfig::GetSnapshot(std::shared_ptr<const MsvConfigSnapshot>& spSnapshot) const
+	******************************************************************************************************/
+	virtual MsvErrorCode GetSnapshot(std::shared_ptr<const MsvConfigSnapshot>& spSnapshot) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfig::PushOverrides(const std::vector<MsvConfigValueUpdate>& values)
+	******************************************************************************************************/
+	virtual MsvErrorCode PushOverrides(const std::vector<MsvConfigValueUpdate>& values) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfig::PopOverrides()
+	******************************************************************************************************/
+	virtual MsvErrorCode PopOverrides() override;
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											MsvActiveConfig public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @brief			Set dispatcher.
+	* @details		Sets dispatcher for asynchronous delivery of notifications to registered callbacks. Changing
+	*					thread (SetValue) only enqueues notifications, it does not wait for slow callbacks.
+	* @param[in]	spDispatcher	Initialized dispatcher (nullptr -> callbacks are notified synchronously).
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When dispatcher is not initialized.
+	* @retval		MSV_SUCCESS						On success.
+	* @note		Notifications rejected by dispatcher (full queue) are logged and they are not delivered.
+	******************************************************************************************************/
+	virtual MsvErrorCode SetDispatcher(std::shared_ptr<MsvActiveConfigDispatcher> spDispatcher);
+
+	/**************************************************************************************************//**
+	* @brief			Set coalescing window.
+	* @details		Sets coalescing window for batch callbacks. Changes made by single writes (SetValue) are
+	*					collected and batch callbacks are notified once per window (window starts by first change).
+	*					Multi-key writes (SetValues) are notified immediately (with already collected changes).
+	* @param[in]	windowMs		Coalescing window in milliseconds (0 -> each single write is notified immediately).
+	* @retval		MSV_ALLOCATION_ERROR		When flush thread creation failed.
+	* @retval		MSV_SUCCESS					On success.
+	* @warning		Do not call it from callbacks (it might wait for flush thread).
+	******************************************************************************************************/
+	virtual MsvErrorCode SetCoalescingWindow(uint32_t windowMs);
+
+	/**************************************************************************************************//**
+	* @brief			Set callback budget.
+	* @details		Each synchronous callback call is measured and its time is attributed to the callback. Calls
+	*					exceeding budget are reported (logged with the callback and config ID). With quarantine,
+	*					callback which has exceeded budget is moved to asynchronous delivery (it is notified by
+	*					own dispatcher with one worker, so it does not block writers anymore). Budget is set to
+	*					storage of database too (its callbacks are config instances using database).
+	* @param[in]	budgetUs			Budget in microseconds (0 -> no budget, only statistics are collected).
+	* @param[in]	quarantine		Quarantine flag (true -> slow callbacks are moved to asynchronous delivery).
+	* @retval		MSV_SUCCESS		On success.
+	* @see			GetCallbackReport
+	******************************************************************************************************/
+	virtual MsvErrorCode SetCallbackBudget(uint32_t budgetUs, bool quarantine = false);
+
+	/**************************************************************************************************//**
+	* @brief			Get callback report.
+	* @details		Returns time spent in each registered callback (synchronous calls only).
+	* @param[out]	report		Statistics of callbacks (the slowest first).
+	******************************************************************************************************/
+	virtual void GetCallbackReport(std::vector<MsvCallbackReport>& report) const;
+
+	/**************************************************************************************************//**
+	* @brief			Flush changes.
+	* @details		Notifies batch callbacks about all collected changes immediately (does not wait for end of
+	*					coalescing window). Database write lock is locked before changes are delivered, so batch
+	*					callbacks might write config.
+	* @warning		It must not be called while config lock is held (use @ref DeliverChanges).
+	******************************************************************************************************/
+	virtual void FlushChanges();
+
+	/**************************************************************************************************//**
+	* @brief			Set lazy loading.
+	* @details		In lazy mode Initialize only opens storage and each value is loaded from storage on its first
+	*					access (and cached). It must be set before Initialize. Database already opened by other
+	*					instance keeps its mode.
+	* @param[in]	lazy		Lazy loading flag (true -> lazy, false -> all values are loaded in Initialize).
+	* @retval		MSV_ALREADY_INITIALIZED_INFO	When config has been already initialized (mode is not changed).
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode SetLazyLoading(bool lazy);
+
+	/**************************************************************************************************//**
+	* @brief			Set journal size.
+	* @details		Sets count of last changes kept for @ref PollChanges. It must be set before Initialize.
+	*					Database already opened by other instance keeps its journal size.
+	* @param[in]	journalSize		Count of kept changes (0 -> changes are not kept, each poll resyncs).
+	* @retval		MSV_ALREADY_INITIALIZED_INFO	When config has been already initialized (size is not changed).
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode SetJournalSize(size_t journalSize);
+
+	/**************************************************************************************************//**
+	* @brief			Set write shards.
+	* @details		Spreads writes across key shards. Writes of keys from different shards run concurrently (they
+	*					do not wait for each other) and each shard is stored in its own SQLite file (partition), so
+	*					write throughput scales with count of writing threads. Batches, retarget and snapshot save
+	*					still lock all shards. It must be set before Initialize. Database already opened by other
+	*					instance keeps its shard count.
+	* @param[in]	shardCount		Count of shards (0 or 1 -> one shard, all writes are serialized in one file).
+	* @retval		MSV_ALREADY_INITIALIZED_INFO	When config has been already initialized (count is not changed).
+	* @retval		MSV_SUCCESS							On success.
+	* @warning		Count of shards must not be changed for existing database (see @ref MsvActiveConfigShardedStorage).
+	*					Synchronous callback of sharded write might write only keys of the same shard (other writes
+	*					return @ref MSV_BUSY_ERROR), callbacks which write other keys must be dispatched asynchronously.
+	******************************************************************************************************/
+	virtual MsvErrorCode SetWriteShards(size_t shardCount);
+
+	/**************************************************************************************************//**
+	* @brief			Prefetch values.
+	* @details		Loads selected values to cache (warming of lazy mode, loaded values are not loaded again).
+	* @param[in]	cfgIds		Config IDs to load.
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_NOT_FOUND_ERROR			When some config ID does not exist.
+	* @retval		other_error_code				When load from storage failed.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Prefetch(const std::vector<int32_t>& cfgIds);
+
+	/**************************************************************************************************//**
+	* @brief			Set snapshot path.
+	* @details		Sets path to binary snapshot of value cache. When valid snapshot exists, Initialize loads
+	*					cache from it and returns immediately (reads are served from snapshot). Storage is opened
+	*					and snapshot is verified in background, differences are set to cache and notified to
+	*					callbacks (writes wait for verification). When storage can not be opened, reads keep
+	*					snapshot values, open is retried in background and writes return open error until it
+	*					succeeds. Snapshot is saved by Uninitialize. It must be set before Initialize and it is not
+	*					used in lazy mode.
+	* @param[in]	snapshotPath	Path to snapshot (nullptr or empty -> snapshot is not used).
+	* @retval		MSV_ALREADY_INITIALIZED_INFO	When config has been already initialized (path is not changed).
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode SetSnapshotPath(const char* snapshotPath);
+
+	/**************************************************************************************************//**
+	* @brief			Save snapshot.
+	* @details		Saves value cache to snapshot (it waits for snapshot verification).
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized or storage is not opened.
+	* @retval		MSV_INVALID_DATA_ERROR		When snapshot path has not been set.
+	* @retval		MSV_NOT_FOUND_ERROR			When some value is not cached (lazy mode).
+	* @retval		other_error_code				When storage open (it is retried) or write failed.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode SaveSnapshot();
+
+	/**************************************************************************************************//**
+	* @brief			Register derived value.
+	* @details		Registers (or replaces) value computed by function from other config values (stored or
+	*					derived). Derived value is memoized by this instance and it is read by GetValue like stored
+	*					one. It is recomputed only when some of its dependencies has been changed (by any instance
+	*					using database), its changes are notified to registered callbacks. Its registration is not
+	*					notified.
+	* @param[in]	cfgId				Config ID of derived value (it must not be in config key map).
+	* @param[in]	dependencies	Config IDs of stored or already registered derived values used by function.
+	* @param[in]	function			Function which computes derived value (it must not write to config).
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_ALREADY_EXISTS_ERROR	When config ID is in config key map.
+	* @retval		MSV_NOT_FOUND_ERROR			When some dependency does not exist.
+	* @retval		MSV_INVALID_DATA_ERROR		When function is empty or dependencies create cycle.
+	* @retval		MSV_ALLOCATION_ERROR		When derived values have not been created.
+	* @retval		other_error_code				When function failed (derived value is not registered).
+	* @retval		MSV_SUCCESS						On success.
+	* @see			MsvActiveConfigDerived
+	******************************************************************************************************/
+	virtual MsvErrorCode RegisterDerivedValue(int32_t cfgId, const std::vector<int32_t>& dependencies, MsvActiveConfigDerivedFunction function);
+
+	/**************************************************************************************************//**
+	* @brief			Unregister derived value.
+	* @param[in]	cfgId				Config ID of derived value.
+	* @retval		MSV_NOT_FOUND_ERROR			When derived value has not been registered.
+	* @retval		MSV_BUSY_ERROR					When other derived value depends on it.
+	* @retval		MSV_ALLOCATION_ERROR		When derived values have not been created.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode UnregisterDerivedValue(int32_t cfgId);
+
 	/*-----------------------------------------------------------------------------------------------------
 	**											MsvActiveConfig protected methods
 	**---------------------------------------------------------------------------------------------------*/
@@ -224,29 +514,343 @@ protected:
 	******************************************************************************************************/
 	template<class T> void OnValueChanged(int32_t cfgId, T newValue);
 
+	/**************************************************************************************************//**
+	* @brief			Derived value has been changed.
+	* @details		This method is called by @ref m_spDerived when derived value has been recomputed. It notifies
+	*					all registered callbacks and change notifier.
+	* @param[in]	cfgId			Config ID of changed derived value.
+	* @param[in]	newValue		New derived value.
+	******************************************************************************************************/
+	void OnDerivedValueChanged(int32_t cfgId, const MsvConfigValue& newValue);
+
+	/**************************************************************************************************//**
+	* @brief			Get interested callbacks.
+	* @details		Finds all callbacks interested in config ID (registered for all changes, for config ID or for
+	*					range with config ID). Each callback is returned only once.
+	* @param[in]	subscriptions		Subscriptions snapshot.
+	* @param[in]	cfgId					Config ID of changed value.
+	* @param[out]	callbacks			Interested callbacks (pointers to snapshot callbacks, valid while snapshot is held).
+	******************************************************************************************************/
+	void GetInterestedCallbacks(const MsvSubscriptions& subscriptions, int32_t cfgId, std::vector<const std::shared_ptr<IMsvActiveConfigCallback>*>& callbacks) const;
+
+	/**************************************************************************************************//**
+	* @brief			Add pending change.
+	* @details		Collects changed value for batch callbacks and schedules flush (immediately or at the end
+	*					of coalescing window). Only last value of config ID is kept.
+	* @param[in]	cfgId			Config ID of changed value.
+	* @param[in]	newValue		New value, current value.
+	******************************************************************************************************/
+	void AddPendingChange(int32_t cfgId, MsvConfigValue&& newValue);
+
+	/**************************************************************************************************//**
+	* @brief			Deliver changes.
+	* @details		Notifies batch callbacks about all collected changes under config lock. Caller must hold
+	*					database write lock (or key of its shard) when config is initialized.
+	******************************************************************************************************/
+	void DeliverChanges();
+
+	/**************************************************************************************************//**
+	* @brief			Stop flush thread.
+	* @details		Stops flush thread (if it is running) and flushes collected changes.
+	******************************************************************************************************/
+	void StopFlushThread();
+
+	/**************************************************************************************************//**
+	* @brief			Flush thread.
+	* @details		Waits for the end of coalescing window and flushes collected changes.
+	******************************************************************************************************/
+	void FlushThread();
+
+	/**************************************************************************************************//**
+	* @brief			Convert value.
+	* @details		Converts changed value to config value (string is copied).
+	* @param[in]	value		Changed value.
+	* @returns		Config value.
+	******************************************************************************************************/
+	template<class T> static MsvConfigValue ToConfigValue(T value) { return MsvConfigValue(value); }
+
+	/**************************************************************************************************//**
+	* @copydoc ToConfigValue(T value)
+	******************************************************************************************************/
+	static MsvConfigValue ToConfigValue(const char* value) { return MsvConfigValue(std::string(value)); }
+
+	/**************************************************************************************************//**
+	* @copydoc ToConfigValue(T value)
+	******************************************************************************************************/
+	static MsvConfigValue ToConfigValue(const std::shared_ptr<const std::string>& spValue) { return MsvConfigValue(*spValue); }
+
+	/**************************************************************************************************//**
+	* @brief			Dispatch value changed.
+	* @details		Enqueues notification of registered callback to dispatcher.
+	* @param[in]	spCallback	Callback to notify.
+	* @param[in]	cfgId			Config ID of changed value.
+	* @param[in]	newValue		New value, current value.
+	******************************************************************************************************/
+	template<class T> void DispatchValueChanged(MsvActiveConfigDispatcher& dispatcher, std::shared_ptr<IMsvActiveConfigCallback> spCallback, int32_t cfgId, T newValue);
+
+	/**************************************************************************************************//**
+	* @brief			Dispatch value changed.
+	* @details		Enqueues notification of registered callback to dispatcher (string is copied, pointer would
+	*					not be valid when notification is delivered).
+	* @param[in]	spCallback	Callback to notify.
+	* @param[in]	cfgId			Config ID of changed value.
+	* @param[in]	newValue		New value, current value.
+	******************************************************************************************************/
+	void DispatchValueChanged(MsvActiveConfigDispatcher& dispatcher, std::shared_ptr<IMsvActiveConfigCallback> spCallback, int32_t cfgId, const char* newValue);
+
+	/**************************************************************************************************//**
+	* @brief			Callback has been called.
+	* @details		Attributes duration of synchronous call to callback. Slow call is reported and callback is
+	*					quarantined (when quarantine is enabled). Config lock must be locked.
+	* @param[in]	spCallback	Called callback.
+	* @param[in]	cfgId			Config ID of changed value.
+	* @param[in]	duration		Duration of call.
+	******************************************************************************************************/
+	void OnCallbackCalled(const std::shared_ptr<IMsvActiveConfigCallback>& spCallback, int32_t cfgId, std::chrono::nanoseconds duration);
+
 	/**************************************************************************************************//**
 	* @brief			Get value.
-	* @details		Template method used in virtual Get methods.
+	* @details		Template method used in virtual Get methods. Readers proceed in parallel (shared locks only).
 	* @param[in]	cfgId		Config ID to get its value.
-	* @param[in]	values	Config key storage with loaded values.
+	* @param[in]	pValues	Database cache (map) with loaded values (cached type might differ, see @ref ToCachedValue).
 	* @param[out]	value		Found and returned value.
 	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
 	* @retval		MSV_NOT_FOUND_ERROR			When config ID (cfgId) does not exist.
 	* @retval		MSV_SUCCESS						On success.
 	******************************************************************************************************/
-	template<class T> MsvErrorCode GetValue(int32_t cfgId, const std::map<int32_t, T>& values, T& value) const;
+	template<class T, class C> MsvErrorCode GetValue(int32_t cfgId, std::map<int32_t, C> MsvActiveConfigDatabase::* pValues, T& value) const;
 
 	/**************************************************************************************************//**
 	* @brief			Set value.
-	* @details		Template method used in virtual Set methods.
+	* @details		Template method used in virtual Set methods. Writes of all instances sharing database are
+	*					serialized.
 	* @param[in]	cfgId		Config ID to set its value.
-	* @param[in]	values	Config key storage with loaded values.
+	* @param[in]	pValues	Database cache (map) with loaded values.
 	* @param[in]	value		New value of config ID.
 	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
 	* @retval		MSV_NOT_FOUND_ERROR			When config ID (cfgId) does not exist.
 	* @retval		MSV_SUCCESS						On success.
 	******************************************************************************************************/
-	template<class T> MsvErrorCode SetValue(int32_t cfgId, std::map<int32_t, T>& values, const T& value);
+	template<class T> MsvErrorCode SetValue(int32_t cfgId, std::map<int32_t, T> MsvActiveConfigDatabase::* pValues, const T& value);
+
+	/**************************************************************************************************//**
+	* @brief			Load value.
+	* @details		Loads value from storage to cache (lazy mode). Concurrent first accesses of one value are
+	*					single-flighted (one loads it, others wait and take cached value).
+	* @param[in]	database		Database to load value from.
+	* @param[in]	cfgId			Config ID to load its value.
+	* @param[in]	pValues		Database cache (map) for loaded value (cached type might differ, see @ref ToCachedValue).
+	* @param[out]	value			Loaded (or already cached) value.
+	* @retval		MSV_NOT_FOUND_ERROR			When config ID (cfgId) does not exist or it has different type.
+	* @retval		other_error_code				When load from storage failed.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	template<class T, class C> MsvErrorCode LoadValue(MsvActiveConfigDatabase& database, int32_t cfgId, std::map<int32_t, C> MsvActiveConfigDatabase::* pValues, T& value) const;
+
+	/**************************************************************************************************//**
+	* @brief			Prefetch values.
+	* @details		Loads values to cache (values which have been already loaded are not loaded again).
+	* @param[in]	database		Database to load values to.
+	* @param[in]	cfgIds		Config IDs to load.
+	* @retval		MSV_NOT_FOUND_ERROR			When some config ID does not exist.
+	* @retval		other_error_code				When load from storage failed.
+	* @retval		MSV_SUCCESS						On success.
+	* @see			Prefetch
+	******************************************************************************************************/
+	MsvErrorCode PrefetchValues(MsvActiveConfigDatabase& database, const std::vector<int32_t>& cfgIds) const;
+
+	/**************************************************************************************************//**
+	* @brief			Get snapshot.
+	* @details		Returns cached snapshot of database or creates it (all values are loaded first in lazy mode).
+	* @param[in]	database		Database to get its snapshot.
+	* @param[out]	spSnapshot	Current snapshot of database.
+	* @retval		MSV_ALLOCATION_ERROR			When snapshot allocation failed.
+	* @retval		other_error_code				When load from storage failed.
+	* @retval		MSV_SUCCESS						On success.
+	* @see			GetSnapshot(std::shared_ptr<const MsvConfigSnapshot>& spSnapshot) const
+	******************************************************************************************************/
+	MsvErrorCode GetSnapshot(MsvActiveConfigDatabase& database, std::shared_ptr<const MsvConfigSnapshot>& spSnapshot) const;
+
+	/**************************************************************************************************//**
+	* @brief			Diff values.
+	* @details		Finds values which are new or which differ from old values.
+	* @param[in]	oldValues		Old values.
+	* @param[in]	newValues		New values.
+	* @param[out]	changedValues	Changed values (new ones).
+	* @param[out]	changedCfgIds	Config IDs of changed values (appended).
+	******************************************************************************************************/
+	template<class T> static void DiffValues(const std::map<int32_t, T>& oldValues, const std::map<int32_t, T>& newValues, std::map<int32_t, T>& changedValues, std::vector<int32_t>& changedCfgIds);
+
+	/**************************************************************************************************//**
+	* @brief			Has value.
+	* @details		Checks config key map if config ID exists and has requested type (cache might not contain
+	*					value in lazy mode).
+	* @param[in]	database		Database with config key map.
+	* @param[in]	cfgId			Config ID to check.
+	* @retval		true		When config ID exists with requested type.
+	* @retval		false		Otherwise.
+	******************************************************************************************************/
+	template<class T> static bool HasValue(const MsvActiveConfigDatabase& database, int32_t cfgId);
+
+	/**************************************************************************************************//**
+	* @brief			Value type check.
+	* @details		Checks if default value has type of pointer (pointer is used only for overload selection).
+	* @param[in]	defaultValue		Default value of config ID.
+	* @returns		True when default value has type of pointer.
+	******************************************************************************************************/
+	static bool IsValueType(const IMsvDefaultValue& defaultValue, const bool*) { return defaultValue.IsBool(); }
+
+	/**************************************************************************************************//**
+	* @copydoc IsValueType(const IMsvDefaultValue& defaultValue, const bool*)
+	******************************************************************************************************/
+	static bool IsValueType(const IMsvDefaultValue& defaultValue, const double*) { return defaultValue.IsDouble(); }
+
+	/**************************************************************************************************//**
+	* @copydoc IsValueType(const IMsvDefaultValue& defaultValue, const bool*)
+	******************************************************************************************************/
+	static bool IsValueType(const IMsvDefaultValue& defaultValue, const int64_t*) { return defaultValue.IsInteger(); }
+
+	/**************************************************************************************************//**
+	* @copydoc IsValueType(const IMsvDefaultValue& defaultValue, const bool*)
+	******************************************************************************************************/
+	static bool IsValueType(const IMsvDefaultValue& defaultValue, const std::string*) { return defaultValue.IsString(); }
+
+	/**************************************************************************************************//**
+	* @copydoc IsValueType(const IMsvDefaultValue& defaultValue, const bool*)
+	******************************************************************************************************/
+	static bool IsValueType(const IMsvDefaultValue& defaultValue, const std::shared_ptr<const std::string>*) { return defaultValue.IsString(); }
+
+	/**************************************************************************************************//**
+	* @copydoc IsValueType(const IMsvDefaultValue& defaultValue, const bool*)
+	******************************************************************************************************/
+	static bool IsValueType(const IMsvDefaultValue& defaultValue, const uint64_t*) { return defaultValue.IsUnsigned(); }
+
+	/**************************************************************************************************//**
+	* @brief			Open database.
+	* @details		Creates and initializes storage of new shared database and loads all values to its cache
+	*					(it is called by @ref MsvActiveConfigRegistry only for first instance).
+	* @param[in]	spConfigKeyMap		Config key map with config IDs and its default values.
+	* @param[in]	configPath			Path to active config database.
+	* @param[in]	groupName			Active config group name.
+	* @param[out]	database				Database to open.
+	* @param[in]	useSnapshot			Values might be loaded from snapshot (true) or always from storage (false).
+	* @retval		other_error_code	When failed.
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	MsvErrorCode OpenDatabase(std::shared_ptr<IMsvConfigKeyMap<IMsvDefaultValue>> spConfigKeyMap, const char* configPath, const char* groupName, MsvActiveConfigDatabase& database, bool useSnapshot);
+
+	/**************************************************************************************************//**
+	* @brief			Get database.
+	* @returns		Shared database (nullptr when config is not initialized).
+	******************************************************************************************************/
+	std::shared_ptr<MsvActiveConfigDatabase> GetDatabase() const;
+
+	/**************************************************************************************************//**
+	* @brief			Attach database.
+	* @details		Registers storage callback and change notifier of this instance to database, sets callback budget
+	*					to its storage and starts snapshot verification when it is pending.
+	* @param[in]	spDatabase				Database to attach.
+	* @param[in]	spStorageCallback		Storage callback of this instance.
+	* @retval		other_error_code	When failed (nothing is registered).
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	MsvErrorCode AttachDatabase(std::shared_ptr<MsvActiveConfigDatabase> spDatabase, std::shared_ptr<IMsvActiveConfigStorageCallback> spStorageCallback);
+
+	/**************************************************************************************************//**
+	* @brief			Detach database.
+	* @details		Unregisters storage callback and change notifier of this instance from database.
+	* @param[in]	database					Database to detach.
+	* @param[in]	spStorageCallback		Storage callback of this instance.
+	* @retval		other_error_code	When unregister of storage callback failed.
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	MsvErrorCode DetachDatabase(MsvActiveConfigDatabase& database, std::shared_ptr<IMsvActiveConfigStorageCallback> spStorageCallback);
+
+	/**************************************************************************************************//**
+	* @brief			Load values.
+	* @details		Loads all values of config key map from storage to database cache.
+	* @param[in]	storage			Initialized storage.
+	* @param[out]	database			Database with config key map to load its cache.
+	* @param[in]	spLogger			Shared pointer to logger for logging.
+	* @retval		other_error_code	When failed.
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	static MsvErrorCode LoadValues(IMsvActiveConfigStorage& storage, MsvActiveConfigDatabase& database, std::shared_ptr<MsvLogger> spLogger);
+
+	/**************************************************************************************************//**
+	* @brief			Verify snapshot.
+	* @details		Verification thread of database loaded from snapshot. Opens storage, loads values (only when
+	*					storage revision has changed), sets differences to cache and notifies them to all instances
+	*					using database. It does not use any instance (database might outlive this one).
+	* @param[in]	pDatabase		Database loaded from snapshot (it joins this thread before it is released).
+	* @param[in]	spLogger			Shared pointer to logger for logging.
+	******************************************************************************************************/
+	static void VerifySnapshot(MsvActiveConfigDatabase* pDatabase, std::shared_ptr<MsvLogger> spLogger);
+
+	/**************************************************************************************************//**
+	* @brief			Apply verified values.
+	* @details		Sets verified values which differ from cache to cache (database values lock must be locked).
+	* @param[in]	database		Database with cache.
+	* @param[in]	pValues		Database cache (map) of value type.
+	* @param[in,out]	values	Verified values, only differences are kept.
+	******************************************************************************************************/
+	template<class T> static void ApplyVerifiedValues(MsvActiveConfigDatabase& database, std::map<int32_t, T> MsvActiveConfigDatabase::* pValues, std::map<int32_t, T>& values);
+
+	/**************************************************************************************************//**
+	* @brief			Record verified values.
+	* @details		Records changes of verified values (differences) and wakes change waiters.
+	* @param[in]	database		Database with versions.
+	* @param[in]	values		Verified values which differ from snapshot.
+	******************************************************************************************************/
+	template<class T> static void RecordVerifiedValues(MsvActiveConfigDatabase& database, const std::map<int32_t, T>& values);
+
+	/**************************************************************************************************//**
+	* @brief			Notify verified values.
+	* @details		Notifies storage callbacks of all instances using database about differences.
+	* @param[in]	callbacks	Storage callbacks of instances.
+	* @param[in]	values		Changed values.
+	******************************************************************************************************/
+	template<class T> static void NotifyVerifiedValues(const std::vector<std::shared_ptr<IMsvActiveConfigStorageCallback>>& callbacks, const std::map<int32_t, T>& values);
+
+	/**************************************************************************************************//**
+	* @brief			Convert value.
+	* @details		Converts cached value to value passed to storage callback.
+	* @param[in]	value		Cached value.
+	* @returns		Callback value.
+	******************************************************************************************************/
+	template<class T> static T ToCallbackValue(const T& value) { return value; }
+
+	/**************************************************************************************************//**
+	* @copydoc ToCallbackValue(const T& value)
+	******************************************************************************************************/
+	static const char* ToCallbackValue(const std::string& value) { return value.c_str(); }
+
+	/**************************************************************************************************//**
+	* @brief			Convert value.
+	* @details		Converts value to cached value (string is cached as shared immutable value, it is shared
+	*					with storage and callbacks).
+	* @param[in]	value		Value to cache.
+	* @returns		Cached value.
+	******************************************************************************************************/
+	template<class T> static const T& ToCachedValue(const T& value) { return value; }
+
+	/**************************************************************************************************//**
+	* @copydoc ToCachedValue(const T& value)
+	******************************************************************************************************/
+	static std::shared_ptr<const std::string> ToCachedValue(std::string value) { return std::make_shared<const std::string>(std::move(value)); }
+
+	/**************************************************************************************************//**
+	* @brief			Convert value.
+	* @details		Converts cached value to value returned by Get methods.
+	* @param[in]	value		Cached value.
+	* @returns		Returned value.
+	******************************************************************************************************/
+	template<class T> static const T& FromCachedValue(const T& value) { return value; }
+
+	/**************************************************************************************************//**
+	* @copydoc FromCachedValue(const T& value)
+	******************************************************************************************************/
+	static const std::string& FromCachedValue(const std::shared_ptr<const std::string>& spValue) { return *spValue; }
 
 protected:
 	/**************************************************************************************************//**
@@ -256,21 +860,50 @@ protected:
 	mutable std::recursive_mutex m_lock;
 
 	/**************************************************************************************************//**
-	* @brief		Registered callbacks.
-	* @details	Contains all registered callbacks which will be notified about data changes.
+	* @brief		Subscriptions.
+	* @details	All registered callbacks which will be notified about data changes (copy on write,
+	*				notification does not lock).
 	* @see		RegisterCallback
 	* @see		UnregisterCallback
 	******************************************************************************************************/
-	std::forward_list<std::shared_ptr<IMsvActiveConfigCallback>> m_callbacks;
+	MsvCopyOnWrite<MsvSubscriptions> m_subscriptions;
 
 	/**************************************************************************************************//**
 	* @brief		Initialize flag.
-	* @details	Flag if config is initialized (true) or not (false).
+	* @details	Flag if config is initialized (true) or not (false). It is atomic, check does not lock.
 	* @see		Initialize
 	* @see		Uninitialize
 	* @see		Initialized
 	******************************************************************************************************/
-	bool m_initialized;
+	std::atomic<bool> m_initialized;
+
+	/**************************************************************************************************//**
+	* @brief		Lazy loading flag.
+	* @details	Flag if values are loaded on first access (true) or in Initialize (false).
+	* @see		SetLazyLoading
+	******************************************************************************************************/
+	bool m_lazyLoading;
+
+	/**************************************************************************************************//**
+	* @brief		Snapshot path.
+	* @details	Path to binary snapshot of value cache (empty -> snapshot is not used).
+	* @see		SetSnapshotPath
+	******************************************************************************************************/
+	std::string m_snapshotPath;
+
+	/**************************************************************************************************//**
+	* @brief		Journal size.
+	* @details	Count of changes kept by journal of database opened by this instance.
+	* @see		SetJournalSize
+	******************************************************************************************************/
+	size_t m_journalSize;
+
+	/**************************************************************************************************//**
+	* @brief		Write shards.
+	* @details	Count of write shards (and storage partitions) of database opened by this instance.
+	* @see		SetWriteShards
+	******************************************************************************************************/
+	size_t m_writeShards;
 
 	/**************************************************************************************************//**
 	* @brief		Dependency injection factory.
@@ -286,10 +919,26 @@ protected:
 	std::shared_ptr<MsvLogger> m_spLogger;
 
 	/**************************************************************************************************//**
-	* @brief		Active config storage.
-	* @details	Real configuration storage. Implements metods for real storage manimupalation a notifications.
+	* @brief		Active config database.
+	* @details	Database shared by all instances opened on the same config path and group (real configuration
+	*				storage and value cache).
+	* @see		MsvActiveConfigRegistry
+	******************************************************************************************************/
+	std::shared_ptr<MsvActiveConfigDatabase> m_spDatabase;
+
+	/**************************************************************************************************//**
+	* @brief		Database mutex.
+	* @details	Reader/writer lock of @ref m_spDatabase (readers share it and do not lock @ref m_lock). It is
+	*				locked exclusively only when database is set or released.
+	******************************************************************************************************/
+	mutable std::shared_mutex m_databaseLock;
+
+	/**************************************************************************************************//**
+	* @brief		Database epoch.
+	* @details	Incremented (under exclusive @ref m_databaseLock) whenever database is switched or released.
+	*				Change waiters which have started in older epoch stop waiting (their database is not used).
 	******************************************************************************************************/
-	std::shared_ptr<IMsvActiveConfigStorage> m_spStorage;
+	std::atomic<uint64_t> m_databaseEpoch;
 
 	/**************************************************************************************************//**
 	* @brief		Active config storage callback.
@@ -297,49 +946,108 @@ protected:
 	******************************************************************************************************/
 	std::shared_ptr<IMsvActiveConfigStorageCallback> m_spStorageCallback;
 
-	/*-----------------------------------------------------------------------------------------------------
-	**										MsvActiveConfig value storages (maps)
-	**---------------------------------------------------------------------------------------------------*/
+	/**************************************************************************************************//**
+	* @brief		Change notifier.
+	* @details	Collects config IDs changed on database (by any instance) and signals them by pollable handle.
+	*				It is registered to database, which notifies it after value cache has been updated.
+	* @see		GetNotificationHandle
+	* @see		DrainChanges
+	******************************************************************************************************/
+	std::shared_ptr<MsvChangeNotifier> m_spNotifier;
 
 	/**************************************************************************************************//**
-	* @brief		Bool values.
-	* @details	Storage (map) of bool values.
-	* @see		Initialize
-	* @see		GetValue(int32_t cfgId, bool& value)
+	* @brief		Derived values.
+	* @details	Values computed from other config values and memoized by this instance. It is registered to
+	*				database, which notifies it after value cache has been updated.
+	* @see		RegisterDerivedValue
 	******************************************************************************************************/
-	std::map<int32_t, bool> m_boolValues;
+	std::shared_ptr<MsvActiveConfigDerived> m_spDerived;
 
 	/**************************************************************************************************//**
-	* @brief		Double values.
-	* @details	Storage (map) of double values.
-	* @see		Initialize
-	* @see		GetValue(int32_t cfgId, double& value)
+	* @brief		Dispatcher.
+	* @details	Dispatcher for asynchronous notifications (nullptr -> synchronous notifications).
+	* @see		SetDispatcher
 	******************************************************************************************************/
-	std::map<int32_t, double> m_doubleValues;
+	std::shared_ptr<MsvActiveConfigDispatcher> m_spDispatcher;
 
 	/**************************************************************************************************//**
-	* @brief		Integer values.
-	* @details	Storage (map) of int64_t values.
-	* @see		Initialize
-	* @see		GetValue(int32_t cfgId, int64_t& value)
+	* @brief		Callback watchdog.
+	* @details	Time spent in registered callbacks.
+	* @see		SetCallbackBudget
+	* @see		GetCallbackReport
 	******************************************************************************************************/
-	std::map<int32_t, int64_t> m_integerValues;
+	MsvCallbackWatchdog m_watchdog;
 
 	/**************************************************************************************************//**
-	* @brief		String values.
-	* @details	Storage (map) of string values.
-	* @see		Initialize
-	* @see		GetValue(int32_t cfgId, std::string& value)
+	* @brief		Quarantine flag.
+	* @details	Flag if callbacks exceeding budget are moved to asynchronous delivery (true) or not (false).
+	* @see		SetCallbackBudget
 	******************************************************************************************************/
-	std::map<int32_t, std::string> m_stringValues;
+	bool m_quarantine;
 
 	/**************************************************************************************************//**
-	* @brief		Unsigned integer values.
-	* @details	Storage (map) of uint64_t values.
-	* @see		Initialize
-	* @see		GetValue(int32_t cfgId, uint64_t& value)
+	* @brief		Quarantine dispatcher.
+	* @details	Dispatcher of quarantined callbacks (it is created by first quarantine).
+	******************************************************************************************************/
+	std::shared_ptr<MsvActiveConfigDispatcher> m_spQuarantineDispatcher;
+
+	/**************************************************************************************************//**
+	* @brief		Registered batch callbacks.
+	* @details	Contains all registered batch callbacks which will be notified about batches of data changes
+	*				(copy on write, notification does not lock).
+	* @see		RegisterBatchCallback
+	* @see		UnregisterBatchCallback
+	******************************************************************************************************/
+	MsvCallbackList<IMsvActiveConfigBatchCallback> m_batchCallbacks;
+
+	/**************************************************************************************************//**
+	* @brief		Pending changes.
+	* @details	Changes collected for batch callbacks (last value of each config ID).
+	******************************************************************************************************/
+	std::map<int32_t, MsvConfigValue> m_pendingChanges;
+
+	/**************************************************************************************************//**
+	* @brief		Batch depth.
+	* @details	Count of running multi-key writes (changes are only collected while it is not zero).
+	******************************************************************************************************/
+	uint32_t m_batchDepth;
+
+	/**************************************************************************************************//**
+	* @brief		Coalescing window.
+	* @details	Coalescing window of single writes (0 -> no coalescing).
+	* @see		SetCoalescingWindow
+	******************************************************************************************************/
+	std::chrono::milliseconds m_coalescingWindow;
+
+	/**************************************************************************************************//**
+	* @brief		Flush scheduled flag.
+	* @details	Flag if flush has been scheduled by flush thread (true) or not (false).
+	******************************************************************************************************/
+	bool m_flushScheduled;
+
+	/**************************************************************************************************//**
+	* @brief		Flush deadline.
+	* @details	End of current coalescing window.
+	******************************************************************************************************/
+	std::chrono::steady_clock::time_point m_flushDeadline;
+
+	/**************************************************************************************************//**
+	* @brief		Stop flush flag.
+	* @details	Flag if flush thread should stop (true) or not (false).
+	******************************************************************************************************/
+	bool m_stopFlush;
+
+	/**************************************************************************************************//**
+	* @brief		Flush condition.
+	* @details	Signals scheduled flush and stop request to flush thread.
+	******************************************************************************************************/
+	std::condition_variable_any m_flushCondition;
+
+	/**************************************************************************************************//**
+	* @brief		Flush thread.
+	* @details	Flushes collected changes at the end of coalescing window (runs only when window is set).
 	******************************************************************************************************/
-	std::map<int32_t, uint64_t> m_unsignedValues;
+	std::thread m_flushThread;
 };
 
 
@@ -0,0 +1,132 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Active Config Binding
+* @details		Contains @ref MsvActiveConfigBinding which mirrors active config values into user-defined struct.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_ACTIVECONFIGBINDING_H
+#define MARSTECH_ACTIVECONFIGBINDING_H
+
+
+#include "IMsvActiveConfig.h"
+#include "IMsvActiveConfigBatchCallback.h"
+
+#include "mconfig/common/MsvConfigBinding.h"
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Binding Callback.
+* @details	Batch callback registered to active config, it applies changes to parent binding.
+* @see		IMsvActiveConfigBatchCallback
+******************************************************************************************************/
+template<class T>
+class MsvActiveConfigBindingCallback:
+	public IMsvActiveConfigBatchCallback
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	spLink		Shared pointer to link to parent (@ref MsvActiveConfigBinding).
+	******************************************************************************************************/
+	MsvActiveConfigBindingCallback(std::shared_ptr<MsvConfigBindingLink<T>> spLink):
+		m_spLink(spLink)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigBatchCallback::OnValuesChanged(const std::vector<MsvConfigValueUpdate>& values)
+	******************************************************************************************************/
+	virtual void OnValuesChanged(const std::vector<MsvConfigValueUpdate>& values) override
+	{
+		m_spLink->OnValuesChanged(values);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Register callback.
+	* @param[in]	config		Active config.
+	* @param[in]	spCallback	Callback to register.
+	* @retval		other_error_code	When register failed.
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	static MsvErrorCode Register(IMsvActiveConfig& config, std::shared_ptr<MsvActiveConfigBindingCallback<T>> spCallback)
+	{
+		return config.RegisterBatchCallback(spCallback);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Unregister callback.
+	* @param[in]	config		Active config.
+	* @param[in]	spCallback	Callback to unregister.
+	* @retval		other_error_code	When unregister failed.
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	static MsvErrorCode Unregister(IMsvActiveConfig& config, std::shared_ptr<MsvActiveConfigBindingCallback<T>> spCallback)
+	{
+		return config.UnregisterBatchCallback(spCallback);
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Link to parent.
+	* @details	Link to object which creates this one (it is unlinked when parent is detached).
+	******************************************************************************************************/
+	std::shared_ptr<MsvConfigBindingLink<T>> m_spLink;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Binding.
+* @details	Mirrors active config values into fields of user-defined struct. Bound fields are loaded when
+*				binding is attached and updated by batch notifications (all values of one multi-key write
+*				are updated together).
+* @see		MsvConfigBindingBase
+******************************************************************************************************/
+template<class T>
+class MsvActiveConfigBinding:
+	public MsvConfigBindingBase<T, IMsvActiveConfig, MsvActiveConfigBindingCallback<T>>
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	spLogger			Shared pointer to logger for logging.
+	******************************************************************************************************/
+	MsvActiveConfigBinding(std::shared_ptr<MsvLogger> spLogger = nullptr):
+		MsvConfigBindingBase<T, IMsvActiveConfig, MsvActiveConfigBindingCallback<T>>(spLogger)
+	{
+
+	}
+};
+
+
+#endif // !MARSTECH_ACTIVECONFIGBINDING_H
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,391 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Active Config Derived Values Implementation
+* @details		Contains implementation of @ref MsvActiveConfigDerived.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "MsvActiveConfigDerived.h"
+
+#include "IMsvActiveConfig.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <utility>
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvActiveConfigDerived::MsvActiveConfigDerived(const IMsvActiveConfig& config, MsvActiveConfigDerivedHandler handler, std::shared_ptr<MsvLogger> spLogger):
+	m_config(config),
+	m_handler(handler),
+	m_spLogger(spLogger)
+{
+
+}
+
+
+/********************************************************************************************************************************
+*															MsvActiveConfigDerived public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvActiveConfigDerived::Register(int32_t cfgId, const std::vector<int32_t>& dependencies, MsvActiveConfigDerivedFunction function, const std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>& keyMap)
+{
+	std::lock_guard<std::mutex> lock(m_computeLock);
+
+	if (!function)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Derived value {} has no function - error: {:x}", cfgId, MSV_INVALID_DATA_ERROR);
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	if (keyMap.find(cfgId) != keyMap.end())
+	{
+		MSV_LOG_ERROR(m_spLogger, "Derived value {} is stored value - error: {:x}", cfgId, MSV_ALREADY_EXISTS_ERROR);
+		return MSV_ALREADY_EXISTS_ERROR;
+	}
+
+	for (std::vector<int32_t>::const_iterator it = dependencies.begin(); it != dependencies.end(); ++it)
+	{
+		if (*it == cfgId)
+		{
+			MSV_LOG_ERROR(m_spLogger, "Derived value {} depends on itself - error: {:x}", cfgId, MSV_INVALID_DATA_ERROR);
+			return MSV_INVALID_DATA_ERROR;
+		}
+
+		if (keyMap.find(*it) == keyMap.end() && m_definitions.find(*it) == m_definitions.end())
+		{
+			MSV_LOG_ERROR(m_spLogger, "Dependency {} of derived value {} does not exist - error: {:x}", *it, cfgId, MSV_NOT_FOUND_ERROR);
+			return MSV_NOT_FOUND_ERROR;
+		}
+	}
+
+	//new graph is checked before it is used (replaced definition might close cycle)
+	std::map<int32_t, MsvActiveConfigDerivedDefinition> definitions(m_definitions);
+	MsvActiveConfigDerivedDefinition& definition = definitions[cfgId];
+	definition.m_dependencies = dependencies;
+	definition.m_function = function;
+
+	std::vector<int32_t> order;
+	MsvErrorCode errorCode = SortDefinitions(definitions, order);
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Dependencies of derived value {} create cycle - error: {:x}", cfgId, errorCode);
+		return errorCode;
+	}
+
+	std::multimap<int32_t, int32_t> dependents;
+	for (std::map<int32_t, MsvActiveConfigDerivedDefinition>::const_iterator it = definitions.begin(); it != definitions.end(); ++it)
+	{
+		for (std::vector<int32_t>::const_iterator depIt = it->second.m_dependencies.begin(); depIt != it->second.m_dependencies.end(); ++depIt)
+		{
+			dependents.emplace(*depIt, it->first);
+		}
+	}
+
+	bool registered = m_definitions.find(cfgId) != m_definitions.end();
+	std::swap(m_definitions, definitions);
+	std::swap(m_dependents, dependents);
+	std::swap(m_order, order);
+
+	//derived value and its dependents (replaced definition might change them)
+	std::set<int32_t> cfgIds({ cfgId });
+	CollectDependents(cfgId, cfgIds);
+
+	std::set<int32_t> dirtyCfgIds({ cfgId });
+	std::vector<std::pair<int32_t, MsvConfigValue>> changes;
+	if (MSV_FAILED(errorCode = Recompute(cfgIds, dirtyCfgIds, changes)))
+	{
+		//previous definitions are restored (with their values)
+		std::swap(m_definitions, definitions);
+		std::swap(m_dependents, dependents);
+		std::swap(m_order, order);
+
+		if (registered)
+		{
+			dirtyCfgIds = std::set<int32_t>({ cfgId });
+			changes.clear();
+			Recompute(cfgIds, dirtyCfgIds, changes);
+		}
+		else
+		{
+			std::unique_lock<std::shared_mutex> valuesLock(m_valuesLock);
+			m_values.erase(cfgId);
+		}
+
+		return errorCode;
+	}
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfigDerived::Unregister(int32_t cfgId)
+{
+	std::lock_guard<std::mutex> lock(m_computeLock);
+
+	std::map<int32_t, MsvActiveConfigDerivedDefinition>::iterator it = m_definitions.find(cfgId);
+	if (it == m_definitions.end())
+	{
+		MSV_LOG_ERROR(m_spLogger, "Derived value {} has not been registered - error: {:x}", cfgId, MSV_NOT_FOUND_ERROR);
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	if (m_dependents.find(cfgId) != m_dependents.end())
+	{
+		MSV_LOG_ERROR(m_spLogger, "Other derived value depends on derived value {} - error: {:x}", cfgId, MSV_BUSY_ERROR);
+		return MSV_BUSY_ERROR;
+	}
+
+	for (std::vector<int32_t>::const_iterator depIt = it->second.m_dependencies.begin(); depIt != it->second.m_dependencies.end(); ++depIt)
+	{
+		std::pair<std::multimap<int32_t, int32_t>::iterator, std::multimap<int32_t, int32_t>::iterator> range = m_dependents.equal_range(*depIt);
+		for (std::multimap<int32_t, int32_t>::iterator dependentIt = range.first; dependentIt != range.second;)
+		{
+			dependentIt = (dependentIt->second == cfgId) ? m_dependents.erase(dependentIt) : std::next(dependentIt);
+		}
+	}
+
+	m_definitions.erase(it);
+
+	for (std::vector<int32_t>::iterator orderIt = m_order.begin(); orderIt != m_order.end(); ++orderIt)
+	{
+		if (*orderIt == cfgId)
+		{
+			m_order.erase(orderIt);
+			break;
+		}
+	}
+
+	std::unique_lock<std::shared_mutex> valuesLock(m_valuesLock);
+	m_values.erase(cfgId);
+
+	return MSV_SUCCESS;
+}
+
+void MsvActiveConfigDerived::OnValueChanged(int32_t cfgId)
+{
+	std::vector<std::pair<int32_t, MsvConfigValue>> changes;
+
+	{
+		std::lock_guard<std::mutex> lock(m_computeLock);
+
+		//the most of changed values have no derived values
+		if (m_dependents.find(cfgId) == m_dependents.end())
+		{
+			return;
+		}
+
+		std::set<int32_t> cfgIds;
+		CollectDependents(cfgId, cfgIds);
+		std::set<int32_t> dirtyCfgIds({ cfgId });
+		Recompute(cfgIds, dirtyCfgIds, changes);
+	}
+
+	NotifyChanges(changes);
+}
+
+void MsvActiveConfigDerived::RecomputeAll(bool notify)
+{
+	std::vector<std::pair<int32_t, MsvConfigValue>> changes;
+
+	{
+		std::lock_guard<std::mutex> lock(m_computeLock);
+
+		if (m_order.empty())
+		{
+			return;
+		}
+
+		std::set<int32_t> cfgIds(m_order.begin(), m_order.end());
+		std::set<int32_t> dirtyCfgIds(cfgIds);
+		Recompute(cfgIds, dirtyCfgIds, changes);
+	}
+
+	if (notify)
+	{
+		NotifyChanges(changes);
+	}
+}
+
+
+/********************************************************************************************************************************
+*															MsvActiveConfigDerived protected methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvActiveConfigDerived::SortDefinitions(const std::map<int32_t, MsvActiveConfigDerivedDefinition>& definitions, std::vector<int32_t>& order)
+{
+	//count of derived dependencies of each derived value (stored dependencies do not constrain order)
+	std::map<int32_t, size_t> inDegrees;
+	std::multimap<int32_t, int32_t> dependents;
+	for (std::map<int32_t, MsvActiveConfigDerivedDefinition>::const_iterator it = definitions.begin(); it != definitions.end(); ++it)
+	{
+		size_t& inDegree = inDegrees[it->first];
+		for (std::vector<int32_t>::const_iterator depIt = it->second.m_dependencies.begin(); depIt != it->second.m_dependencies.end(); ++depIt)
+		{
+			if (definitions.find(*depIt) != definitions.end())
+			{
+				++inDegree;
+				dependents.emplace(*depIt, it->first);
+			}
+		}
+	}
+
+	std::vector<int32_t> ready;
+	for (std::map<int32_t, size_t>::const_iterator it = inDegrees.begin(); it != inDegrees.end(); ++it)
+	{
+		if (it->second == 0)
+		{
+			ready.push_back(it->first);
+		}
+	}
+
+	order.clear();
+	order.reserve(definitions.size());
+	while (!ready.empty())
+	{
+		int32_t cfgId = ready.back();
+		ready.pop_back();
+		order.push_back(cfgId);
+
+		std::pair<std::multimap<int32_t, int32_t>::const_iterator, std::multimap<int32_t, int32_t>::const_iterator> range = dependents.equal_range(cfgId);
+		for (std::multimap<int32_t, int32_t>::const_iterator it = range.first; it != range.second; ++it)
+		{
+			if (--inDegrees[it->second] == 0)
+			{
+				ready.push_back(it->second);
+			}
+		}
+	}
+
+	//derived values in cycle never get ready
+	return (order.size() == definitions.size()) ? MSV_SUCCESS : MSV_INVALID_DATA_ERROR;
+}
+
+void MsvActiveConfigDerived::CollectDependents(int32_t cfgId, std::set<int32_t>& dependents) const
+{
+	std::vector<int32_t> pending({ cfgId });
+	while (!pending.empty())
+	{
+		int32_t dependency = pending.back();
+		pending.pop_back();
+
+		std::pair<std::multimap<int32_t, int32_t>::const_iterator, std::multimap<int32_t, int32_t>::const_iterator> range = m_dependents.equal_range(dependency);
+		for (std::multimap<int32_t, int32_t>::const_iterator it = range.first; it != range.second; ++it)
+		{
+			if (dependents.insert(it->second).second)
+			{
+				pending.push_back(it->second);
+			}
+		}
+	}
+}
+
+MsvErrorCode MsvActiveConfigDerived::Recompute(const std::set<int32_t>& cfgIds, std::set<int32_t>& dirtyCfgIds, std::vector<std::pair<int32_t, MsvConfigValue>>& changes)
+{
+	MsvErrorCode result = MSV_SUCCESS;
+
+	//derived values are shared by all threads -> overrides of writing thread must not leak into them
+	MsvConfigOverridesSuspension suspension;
+
+	//each derived value is computed after its dependencies -> functions read already recomputed values
+	for (std::vector<int32_t>::const_iterator it = m_order.begin(); it != m_order.end(); ++it)
+	{
+		if (cfgIds.find(*it) == cfgIds.end())
+		{
+			continue;
+		}
+
+		//derived value is recomputed only when some of its dependencies has been changed
+		const MsvActiveConfigDerivedDefinition& definition = m_definitions.find(*it)->second;
+		bool dirty = dirtyCfgIds.find(*it) != dirtyCfgIds.end();
+		for (std::vector<int32_t>::const_iterator depIt = definition.m_dependencies.begin(); depIt != definition.m_dependencies.end() && !dirty; ++depIt)
+		{
+			dirty = dirtyCfgIds.find(*depIt) != dirtyCfgIds.end();
+		}
+
+		if (!dirty)
+		{
+			continue;
+		}
+
+		MsvConfigValue value;
+		MsvErrorCode errorCode = definition.m_function(m_config, value);
+		if (MSV_SUCCEEDED(errorCode) && std::holds_alternative<std::monostate>(value))
+		{
+			errorCode = MSV_INVALID_DATA_ERROR;
+		}
+
+		if (MSV_FAILED(errorCode))
+		{
+			MSV_LOG_ERROR(m_spLogger, "Compute derived value {} failed with error: {:x}", *it, errorCode);
+			result = MSV_SUCCEEDED(result) ? errorCode : result;
+			continue;
+		}
+
+		{
+			//values lock is not held while function is called (it reads other derived values)
+			std::unique_lock<std::shared_mutex> valuesLock(m_valuesLock);
+			MsvConfigValue& memoizedValue = m_values[*it];
+			if (memoizedValue == value)
+			{
+				continue;
+			}
+
+			memoizedValue = value;
+		}
+
+		dirtyCfgIds.insert(*it);
+		changes.emplace_back(*it, std::move(value));
+	}
+
+	return result;
+}
+
+void MsvActiveConfigDerived::NotifyChanges(const std::vector<std::pair<int32_t, MsvConfigValue>>& changes)
+{
+	if (!m_handler)
+	{
+		return;
+	}
+
+	for (std::vector<std::pair<int32_t, MsvConfigValue>>::const_iterator it = changes.begin(); it != changes.end(); ++it)
+	{
+		m_handler(it->first, it->second);
+	}
+}
+
+/** @} */	//End of group MCONFIG.
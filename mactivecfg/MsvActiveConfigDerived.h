@@ -0,0 +1,273 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Active Config Derived Values
+* @details		Derived values memoized by active config (computed from other config values).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_ACTIVECONFIGDERIVED_H
+#define MARSTECH_ACTIVECONFIGDERIVED_H
+
+
+#include "mconfig/common/IMsvDefaultValue.h"
+#include "mconfig/common/MsvConfigValue.h"
+
+#include "merror/MsvErrorCodes.h"
+#include "mlogging/mlogging.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+//forward declaration of MarsTech Active Config Interface
+class IMsvActiveConfig;
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Derived Function.
+* @details	Computes derived value from other config values (it reads them from passed config). It must not
+*				write to config or register derived values.
+******************************************************************************************************/
+typedef std::function<MsvErrorCode(const IMsvActiveConfig& config, MsvConfigValue& value)> MsvActiveConfigDerivedFunction;
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Derived Handler.
+* @details	Receives derived values which have been changed by recomputation.
+******************************************************************************************************/
+typedef std::function<void(int32_t cfgId, const MsvConfigValue& newValue)> MsvActiveConfigDerivedHandler;
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Derived Values.
+* @details	Derived values of one active config instance. Each derived value is computed by its function from
+*				its dependencies (stored or other derived values) and memoized. It is recomputed only when some
+*				of its dependencies has been changed, derived values are recomputed in topological order (each
+*				one after its dependencies). Cycles are rejected by registration.
+* @note		It is registered to database, which notifies it after value cache has been updated.
+* @see		MsvActiveConfigDatabase
+******************************************************************************************************/
+class MsvActiveConfigDerived
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	config		Config which is passed to derived functions (their dependencies are read from it).
+	* @param[in]	handler		Handler of changed derived values (it is called after recomputation, without locks).
+	* @param[in]	spLogger		Shared pointer to logger for logging.
+	******************************************************************************************************/
+	MsvActiveConfigDerived(const IMsvActiveConfig& config, MsvActiveConfigDerivedHandler handler, std::shared_ptr<MsvLogger> spLogger = nullptr);
+
+	/**************************************************************************************************//**
+	* @brief			Register derived value.
+	* @details		Registers (or replaces) derived value and computes it (registration is not notified).
+	* @param[in]	cfgId				Config ID of derived value (it must not be config ID of stored value).
+	* @param[in]	dependencies	Config IDs of stored or already registered derived values used by function.
+	* @param[in]	function			Function which computes derived value.
+	* @param[in]	keyMap			Config key map (config IDs of stored values).
+	* @retval		MSV_ALREADY_EXISTS_ERROR	When config ID is config ID of stored value.
+	* @retval		MSV_NOT_FOUND_ERROR			When some dependency does not exist.
+	* @retval		MSV_INVALID_DATA_ERROR		When function is empty or dependencies create cycle.
+	* @retval		other_error_code				When function failed (derived value is not registered).
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	MsvErrorCode Register(int32_t cfgId, const std::vector<int32_t>& dependencies, MsvActiveConfigDerivedFunction function, const std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>& keyMap);
+
+	/**************************************************************************************************//**
+	* @brief			Unregister derived value.
+	* @param[in]	cfgId				Config ID of derived value.
+	* @retval		MSV_NOT_FOUND_ERROR			When derived value has not been registered.
+	* @retval		MSV_BUSY_ERROR					When other derived value depends on it.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	MsvErrorCode Unregister(int32_t cfgId);
+
+	/**************************************************************************************************//**
+	* @brief			Get value.
+	* @details		Returns memoized derived value (it does not compute it).
+	* @param[in]	cfgId				Config ID of derived value.
+	* @param[out]	value				Derived value.
+	* @retval		MSV_NOT_FOUND_ERROR			When derived value does not exist (or it has other type).
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	template<class T> MsvErrorCode GetValue(int32_t cfgId, T& value) const
+	{
+		std::shared_lock<std::shared_mutex> valuesLock(m_valuesLock);
+
+		std::map<int32_t, MsvConfigValue>::const_iterator it = m_values.find(cfgId);
+		if (it == m_values.end())
+		{
+			return MSV_NOT_FOUND_ERROR;
+		}
+
+		const T* pValue = std::get_if<T>(&it->second);
+		if (!pValue)
+		{
+			return MSV_NOT_FOUND_ERROR;
+		}
+
+		value = *pValue;
+		return MSV_SUCCESS;
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Value has been changed.
+	* @details		Recomputes derived values which depend (directly or transitively) on changed config ID and
+	*					passes changed ones to handler.
+	* @param[in]	cfgId				Changed config ID.
+	******************************************************************************************************/
+	void OnValueChanged(int32_t cfgId);
+
+	/**************************************************************************************************//**
+	* @brief			Recompute all.
+	* @details		Recomputes all derived values (all values might have been changed, e.g. database has been switched).
+	* @param[in]	notify			Changed derived values are passed to handler (true) or not (false).
+	******************************************************************************************************/
+	void RecomputeAll(bool notify);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		MarsTech Active Config Derived Definition.
+	* @details	Dependencies and function of one derived value.
+	******************************************************************************************************/
+	struct MsvActiveConfigDerivedDefinition
+	{
+		std::vector<int32_t> m_dependencies;							//!< Config IDs used by function.
+		MsvActiveConfigDerivedFunction m_function;					//!< Function which computes derived value.
+	};
+
+	/**************************************************************************************************//**
+	* @brief			Sort definitions.
+	* @details		Sorts derived values topologically (each one follows its derived dependencies).
+	* @param[in]	definitions		Definitions of derived values.
+	* @param[out]	order				Config IDs of derived values in topological order.
+	* @retval		MSV_INVALID_DATA_ERROR		When dependencies create cycle.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	static MsvErrorCode SortDefinitions(const std::map<int32_t, MsvActiveConfigDerivedDefinition>& definitions, std::vector<int32_t>& order);
+
+	/**************************************************************************************************//**
+	* @brief			Collect dependents.
+	* @details		Adds all derived values which depend (directly or transitively) on config ID.
+	* @param[in]	cfgId				Config ID.
+	* @param[out]	dependents		Config IDs of dependent derived values.
+	******************************************************************************************************/
+	void CollectDependents(int32_t cfgId, std::set<int32_t>& dependents) const;
+
+	/**************************************************************************************************//**
+	* @brief			Recompute.
+	* @details		Recomputes selected derived values in topological order and stores changed ones. Derived value
+	*					is recomputed only when it is dirty or some of its dependencies is dirty (unchanged result
+	*					stops propagation). Value whose function has failed keeps its last value.
+	* @param[in]		cfgIds			Config IDs of derived values which might be recomputed.
+	* @param[in,out]	dirtyCfgIds		Changed config IDs (changed derived values are added).
+	* @param[out]		changes			Changed derived values (in topological order).
+	* @retval		other_error_code				When some function failed (the first error is returned).
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	MsvErrorCode Recompute(const std::set<int32_t>& cfgIds, std::set<int32_t>& dirtyCfgIds, std::vector<std::pair<int32_t, MsvConfigValue>>& changes);
+
+	/**************************************************************************************************//**
+	* @brief			Notify changes.
+	* @details		Passes changed derived values to handler.
+	* @param[in]	changes			Changed derived values.
+	******************************************************************************************************/
+	void NotifyChanges(const std::vector<std::pair<int32_t, MsvConfigValue>>& changes);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Config.
+	* @details	Config which is passed to derived functions.
+	******************************************************************************************************/
+	const IMsvActiveConfig& m_config;
+
+	/**************************************************************************************************//**
+	* @brief		Handler.
+	* @details	Handler of changed derived values.
+	******************************************************************************************************/
+	MsvActiveConfigDerivedHandler m_handler;
+
+	/**************************************************************************************************//**
+	* @brief		Logger.
+	* @details	Shared pointer to logger for logging.
+	******************************************************************************************************/
+	std::shared_ptr<MsvLogger> m_spLogger;
+
+	/**************************************************************************************************//**
+	* @brief		Compute mutex.
+	* @details	Serializes registrations and recomputations (it locks definitions, dependents and order). It is
+	*				not held while handler is called.
+	******************************************************************************************************/
+	std::mutex m_computeLock;
+
+	/**************************************************************************************************//**
+	* @brief		Definitions.
+	* @details	Definitions of registered derived values.
+	******************************************************************************************************/
+	std::map<int32_t, MsvActiveConfigDerivedDefinition> m_definitions;
+
+	/**************************************************************************************************//**
+	* @brief		Dependents.
+	* @details	Derived values of each dependency (dependency config ID -> derived config ID).
+	******************************************************************************************************/
+	std::multimap<int32_t, int32_t> m_dependents;
+
+	/**************************************************************************************************//**
+	* @brief		Order.
+	* @details	Config IDs of derived values in topological order.
+	******************************************************************************************************/
+	std::vector<int32_t> m_order;
+
+	/**************************************************************************************************//**
+	* @brief		Values mutex.
+	* @details	Reader/writer lock of memoized values (readers do not wait for recomputation).
+	******************************************************************************************************/
+	mutable std::shared_mutex m_valuesLock;
+
+	/**************************************************************************************************//**
+	* @brief		Values.
+	* @details	Memoized derived values.
+	******************************************************************************************************/
+	std::map<int32_t, MsvConfigValue> m_values;
+};
+
+
+#endif // !MARSTECH_ACTIVECONFIGDERIVED_H
+
+/** @} */	//End of group MCONFIG.
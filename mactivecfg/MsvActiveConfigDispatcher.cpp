@@ -0,0 +1,305 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Active Config Dispatcher Implementation
+* @details		Contains implementation of @ref MsvActiveConfigDispatcher.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "MsvActiveConfigDispatcher.h"
+
+#include "merror/MsvErrorCodes.h"
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvActiveConfigDispatcher::MsvActiveConfigDispatcher(size_t queueSize, uint32_t workerCount, std::shared_ptr<MsvLogger> spLogger):
+	m_initialized(false),
+	m_stop(false),
+	m_queueSize(queueSize),
+	m_queuedCount(0),
+	m_rejectedCount(0),
+	m_workerCount(workerCount ? workerCount : 1),
+	m_spLogger(spLogger)
+{
+
+}
+
+MsvActiveConfigDispatcher::MsvActiveConfigDispatcher(MsvActiveConfigExecutor executor, size_t queueSize, std::shared_ptr<MsvLogger> spLogger):
+	m_initialized(false),
+	m_stop(false),
+	m_queueSize(queueSize),
+	m_queuedCount(0),
+	m_rejectedCount(0),
+	m_workerCount(0),
+	m_executor(executor),
+	m_spLogger(spLogger)
+{
+
+}
+
+MsvActiveConfigDispatcher::~MsvActiveConfigDispatcher()
+{
+	Uninitialize();
+}
+
+
+/********************************************************************************************************************************
+*															MsvActiveConfigDispatcher public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvActiveConfigDispatcher::Initialize()
+{
+	std::unique_lock<std::recursive_mutex> lock(m_lock);
+
+	MSV_LOG_INFO(m_spLogger, "Initializing active configuration dispatcher (queueSize: {}, workerCount: {}).", m_queueSize, m_workerCount);
+
+	if (Initialized())
+	{
+		MSV_LOG_INFO(m_spLogger, "Active configuration dispatcher has been already initialized.");
+		return MSV_ALREADY_INITIALIZED_INFO;
+	}
+
+	m_stop = false;
+
+	for (uint32_t i = 0; i < m_workerCount; ++i)
+	{
+		try
+		{
+			m_workers.emplace_back(&MsvActiveConfigDispatcher::WorkerThread, this);
+		}
+		catch (...)
+		{
+			MSV_LOG_ERROR(m_spLogger, "Create dispatcher worker thread failed with error: {0:x}", MSV_ALLOCATION_ERROR);
+
+			//stop already created workers (they are waiting for lock -> they will see stop flag)
+			m_stop = true;
+			m_condition.notify_all();
+			break;
+		}
+	}
+
+	if (m_stop)
+	{
+		lock.unlock();
+		for (std::thread& worker : m_workers)
+		{
+			worker.join();
+		}
+		lock.lock();
+
+		m_workers.clear();
+		m_stop = false;
+
+		return MSV_ALLOCATION_ERROR;
+	}
+
+	m_initialized = true;
+
+	MSV_LOG_INFO(m_spLogger, "Active configuration dispatcher has been successfully initialized.");
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfigDispatcher::Uninitialize()
+{
+	std::unique_lock<std::recursive_mutex> lock(m_lock);
+
+	MSV_LOG_INFO(m_spLogger, "Uninitializing active configuration dispatcher.");
+
+	if (!Initialized())
+	{
+		MSV_LOG_INFO(m_spLogger, "Active configuration dispatcher has not been initialized.");
+		return MSV_NOT_INITIALIZED_INFO;
+	}
+
+	//reject new notifications and deliver queued ones
+	m_initialized = false;
+	m_condition.wait(lock, [this]() { return m_queuedCount == 0; });
+
+	//stop workers
+	m_stop = true;
+	m_condition.notify_all();
+
+	lock.unlock();
+	for (std::thread& worker : m_workers)
+	{
+		worker.join();
+	}
+	lock.lock();
+
+	m_workers.clear();
+	m_stop = false;
+
+	MSV_LOG_INFO(m_spLogger, "Active configuration dispatcher has been successfully uninitialized.");
+
+	return MSV_SUCCESS;
+}
+
+bool MsvActiveConfigDispatcher::Initialized() const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	return m_initialized;
+}
+
+MsvErrorCode MsvActiveConfigDispatcher::Dispatch(const void* pSubscriber, std::function<void()> notification)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	if (!Initialized())
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration dispatcher is not initialized - error: {0:x}", MSV_NOT_INITIALIZED_ERROR);
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	if (m_queuedCount >= m_queueSize)
+	{
+		//queue is full -> reject notification (notifier must not wait for slow subscribers)
+		++m_rejectedCount;
+		MSV_LOG_ERROR(m_spLogger, "Active configuration dispatcher queue is full (rejected: {}) - error: {:x}", m_rejectedCount, MSV_BUSY_ERROR);
+		return MSV_BUSY_ERROR;
+	}
+
+	std::deque<std::function<void()>>& subscriberQueue = m_subscriberQueues[pSubscriber];
+	bool idle = subscriberQueue.empty();
+
+	subscriberQueue.push_back(std::move(notification));
+	++m_queuedCount;
+
+	//subscriber with queued notifications is already scheduled (its notifications must not run concurrently)
+	if (idle)
+	{
+		Schedule(pSubscriber);
+	}
+
+	return MSV_SUCCESS;
+}
+
+void MsvActiveConfigDispatcher::Drain()
+{
+	std::unique_lock<std::recursive_mutex> lock(m_lock);
+
+	m_condition.wait(lock, [this]() { return m_queuedCount == 0; });
+}
+
+size_t MsvActiveConfigDispatcher::GetQueuedCount() const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	return m_queuedCount;
+}
+
+uint64_t MsvActiveConfigDispatcher::GetRejectedCount() const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	return m_rejectedCount;
+}
+
+
+/********************************************************************************************************************************
+*															MsvActiveConfigDispatcher protected methods
+********************************************************************************************************************************/
+
+
+void MsvActiveConfigDispatcher::Schedule(const void* pSubscriber)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	if (m_executor)
+	{
+		m_executor([this, pSubscriber]() { RunSubscriber(pSubscriber); });
+		return;
+	}
+
+	m_scheduled.push_back(pSubscriber);
+
+	//notify all (drain might be waiting on the same condition)
+	m_condition.notify_all();
+}
+
+void MsvActiveConfigDispatcher::RunSubscriber(const void* pSubscriber)
+{
+	for (;;)
+	{
+		std::function<void()> notification;
+
+		{
+			std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+			//notification stays in queue until it is finished (subscriber is not scheduled again meanwhile)
+			notification = std::move(m_subscriberQueues[pSubscriber].front());
+		}
+
+		notification();
+
+		std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+		std::map<const void*, std::deque<std::function<void()>>>::iterator it = m_subscriberQueues.find(pSubscriber);
+		it->second.pop_front();
+		--m_queuedCount;
+		m_condition.notify_all();
+
+		if (it->second.empty())
+		{
+			m_subscriberQueues.erase(it);
+			return;
+		}
+	}
+}
+
+void MsvActiveConfigDispatcher::WorkerThread()
+{
+	std::unique_lock<std::recursive_mutex> lock(m_lock);
+
+	for (;;)
+	{
+		m_condition.wait(lock, [this]() { return m_stop || !m_scheduled.empty(); });
+
+		if (m_scheduled.empty())
+		{
+			//stop requested and nothing to do
+			return;
+		}
+
+		const void* pSubscriber = m_scheduled.front();
+		m_scheduled.pop_front();
+
+		lock.unlock();
+		RunSubscriber(pSubscriber);
+		lock.lock();
+	}
+}
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,263 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Active Config Dispatcher
+* @details		Contains @ref MsvActiveConfigDispatcher (asynchronous delivery of config change notifications).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_ACTIVECONFIGDISPATCHER_H
+#define MARSTECH_ACTIVECONFIGDISPATCHER_H
+
+
+#include "merror/MsvError.h"
+
+#include "mlogging/mlogging.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Executor.
+* @details	User supplied executor. It must run passed task (later, in any thread) exactly once.
+******************************************************************************************************/
+typedef std::function<void(std::function<void()>)> MsvActiveConfigExecutor;
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Dispatcher.
+* @details	Delivers config change notifications asynchronously (notifying thread only enqueues them).
+*				Notifications are run by own worker pool or by user supplied executor. Notifications of
+*				one subscriber are delivered in order and never concurrently (subscriber has its own queue),
+*				notifications of different subscribers run in parallel.
+* @note		Queue is bounded. When it is full, new notification is rejected (MSV_BUSY_ERROR) and it is
+*				counted in rejected notifications (backpressure is reported to the notifier, it never waits).
+* @see		MsvActiveConfig::SetDispatcher
+******************************************************************************************************/
+class MsvActiveConfigDispatcher
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Notifications are run by own worker pool.
+	* @param[in]	queueSize		Maximal count of queued (not finished) notifications.
+	* @param[in]	workerCount		Count of worker threads.
+	* @param[in]	spLogger			Shared pointer to logger for logging.
+	******************************************************************************************************/
+	MsvActiveConfigDispatcher(size_t queueSize = 1024, uint32_t workerCount = 1, std::shared_ptr<MsvLogger> spLogger = nullptr);
+
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Notifications are run by user supplied executor.
+	* @param[in]	executor			User supplied executor.
+	* @param[in]	queueSize		Maximal count of queued (not finished) notifications.
+	* @param[in]	spLogger			Shared pointer to logger for logging.
+	******************************************************************************************************/
+	MsvActiveConfigDispatcher(MsvActiveConfigExecutor executor, size_t queueSize = 1024, std::shared_ptr<MsvLogger> spLogger = nullptr);
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvActiveConfigDispatcher();
+
+	/**************************************************************************************************//**
+	* @brief			Initialize dispatcher.
+	* @details		Starts worker threads (when executor is not used).
+	* @retval		MSV_ALREADY_INITIALIZED_INFO	When dispatcher has been already initialized (this is info, not error).
+	* @retval		MSV_ALLOCATION_ERROR				When worker thread creation failed.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Initialize();
+
+	/**************************************************************************************************//**
+	* @brief			Uninitialize dispatcher.
+	* @details		Delivers all queued notifications and stops worker threads.
+	* @retval		MSV_NOT_INITIALIZED_INFO		When dispatcher has not been initialized (this is info, not error).
+	* @retval		MSV_SUCCESS							On success.
+	* @warning		Do not call it from notification (it waits for all notifications).
+	******************************************************************************************************/
+	virtual MsvErrorCode Uninitialize();
+
+	/**************************************************************************************************//**
+	* @brief			Initialize check.
+	* @details		Returns flag if dispatcher is initialized (true) or not (false).
+	* @retval		true		When initialized.
+	* @retval		false		When not initialized.
+	******************************************************************************************************/
+	virtual bool Initialized() const;
+
+	/**************************************************************************************************//**
+	* @brief			Dispatch notification.
+	* @details		Enqueues notification of subscriber. It does not wait for delivery.
+	* @param[in]	pSubscriber		Subscriber identification (notifications of one subscriber are ordered).
+	* @param[in]	notification	Notification to run.
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When dispatcher is not initialized.
+	* @retval		MSV_BUSY_ERROR					When queue is full (notification is rejected).
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Dispatch(const void* pSubscriber, std::function<void()> notification);
+
+	/**************************************************************************************************//**
+	* @brief			Drain dispatcher.
+	* @details		Waits until all queued notifications are delivered (useful for tests).
+	* @warning		Do not call it from notification (it would wait for itself).
+	******************************************************************************************************/
+	virtual void Drain();
+
+	/**************************************************************************************************//**
+	* @brief			Get queued count.
+	* @details		Returns count of queued (not finished) notifications.
+	* @returns		Count of queued notifications.
+	******************************************************************************************************/
+	virtual size_t GetQueuedCount() const;
+
+	/**************************************************************************************************//**
+	* @brief			Get rejected count.
+	* @details		Returns count of notifications rejected because of full queue (backpressure).
+	* @returns		Count of rejected notifications.
+	******************************************************************************************************/
+	virtual uint64_t GetRejectedCount() const;
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											MsvActiveConfigDispatcher protected methods
+	**---------------------------------------------------------------------------------------------------*/
+protected:
+	/**************************************************************************************************//**
+	* @brief			Schedule subscriber.
+	* @details		Passes subscriber with queued notifications to executor or to worker threads.
+	* @param[in]	pSubscriber		Subscriber identification.
+	******************************************************************************************************/
+	void Schedule(const void* pSubscriber);
+
+	/**************************************************************************************************//**
+	* @brief			Run subscriber.
+	* @details		Runs queued notifications of subscriber one by one (until its queue is empty).
+	* @param[in]	pSubscriber		Subscriber identification.
+	******************************************************************************************************/
+	void RunSubscriber(const void* pSubscriber);
+
+	/**************************************************************************************************//**
+	* @brief			Worker thread.
+	* @details		Waits for scheduled subscribers and runs their notifications.
+	******************************************************************************************************/
+	void WorkerThread();
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Dispatcher mutex.
+	* @details	Locks this object for thread safety access.
+	******************************************************************************************************/
+	mutable std::recursive_mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Dispatcher condition.
+	* @details	Signals scheduled subscribers (workers), finished notifications (drain) and stop request.
+	******************************************************************************************************/
+	std::condition_variable_any m_condition;
+
+	/**************************************************************************************************//**
+	* @brief		Initialize flag.
+	* @details	Flag if dispatcher is initialized (true) or not (false).
+	******************************************************************************************************/
+	bool m_initialized;
+
+	/**************************************************************************************************//**
+	* @brief		Stop flag.
+	* @details	Flag if worker threads should stop (true) or not (false).
+	******************************************************************************************************/
+	bool m_stop;
+
+	/**************************************************************************************************//**
+	* @brief		Maximal queue size.
+	* @details	Maximal count of queued (not finished) notifications.
+	******************************************************************************************************/
+	size_t m_queueSize;
+
+	/**************************************************************************************************//**
+	* @brief		Queued count.
+	* @details	Count of queued (not finished) notifications.
+	******************************************************************************************************/
+	size_t m_queuedCount;
+
+	/**************************************************************************************************//**
+	* @brief		Rejected count.
+	* @details	Count of notifications rejected because of full queue.
+	******************************************************************************************************/
+	uint64_t m_rejectedCount;
+
+	/**************************************************************************************************//**
+	* @brief		Worker count.
+	* @details	Count of worker threads (0 when executor is used).
+	******************************************************************************************************/
+	uint32_t m_workerCount;
+
+	/**************************************************************************************************//**
+	* @brief		User supplied executor.
+	* @details	Runs notifications instead of worker threads (might be empty).
+	******************************************************************************************************/
+	MsvActiveConfigExecutor m_executor;
+
+	/**************************************************************************************************//**
+	* @brief		Subscriber queues.
+	* @details	Queued notifications of each subscriber (subscriber is removed when its queue is empty).
+	******************************************************************************************************/
+	std::map<const void*, std::deque<std::function<void()>>> m_subscriberQueues;
+
+	/**************************************************************************************************//**
+	* @brief		Scheduled subscribers.
+	* @details	Subscribers waiting for worker thread (each subscriber is there at most once).
+	******************************************************************************************************/
+	std::deque<const void*> m_scheduled;
+
+	/**************************************************************************************************//**
+	* @brief		Worker threads.
+	******************************************************************************************************/
+	std::vector<std::thread> m_workers;
+
+	/**************************************************************************************************//**
+	* @brief		Logger.
+	* @details	Shared pointer to logger for logging.
+	******************************************************************************************************/
+	std::shared_ptr<MsvLogger> m_spLogger;
+};
+
+
+#endif // !MARSTECH_ACTIVECONFIGDISPATCHER_H
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,531 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Active Config Feature Flags Implementation
+* @details		Contains implementation of @ref MsvActiveConfigFlags.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "MsvActiveConfigFlags.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															MsvActiveConfigFlagsCallback implementation
+********************************************************************************************************************************/
+
+
+MsvActiveConfigFlags::MsvActiveConfigFlagsCallback::MsvActiveConfigFlagsCallback(MsvActiveConfigFlags* pFlags):
+	m_pFlags(pFlags)
+{
+
+}
+
+void MsvActiveConfigFlags::MsvActiveConfigFlagsCallback::OnValuesChanged(const std::vector<MsvConfigValueUpdate>& values)
+{
+	if (m_pFlags)
+	{
+		m_pFlags->OnValuesChanged(values);
+	}
+}
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvActiveConfigFlags::MsvActiveConfigFlags(const std::vector<MsvActiveConfigFlag>& flags, size_t listCapacity, std::shared_ptr<MsvLogger> spLogger):
+	m_sequence(0),
+	m_flags(flags),
+	m_listCapacity(listCapacity),
+	m_slots(new MsvActiveConfigFlagSlot[flags.size()]),
+	m_hashes(new std::atomic<uint64_t>[flags.size() * 2 * listCapacity]),
+	m_spLogger(spLogger),
+	m_rules(flags.size(), MsvActiveConfigFlagRules({ true, 100.0, std::string(), std::string() }))
+{
+	for (size_t flagId = 0; flagId < m_flags.size(); ++flagId)
+	{
+		//flags are disabled until they are compiled
+		m_slots[flagId].m_enabled.store(0, std::memory_order_relaxed);
+		m_slots[flagId].m_allowCount.store(0, std::memory_order_relaxed);
+		m_slots[flagId].m_denyCount.store(0, std::memory_order_relaxed);
+		m_slots[flagId].m_threshold.store(0, std::memory_order_relaxed);
+
+		const int32_t cfgIds[] = { m_flags[flagId].m_enabledCfgId, m_flags[flagId].m_percentageCfgId, m_flags[flagId].m_allowCfgId, m_flags[flagId].m_denyCfgId };
+		for (size_t i = 0; i < sizeof(cfgIds) / sizeof(cfgIds[0]); ++i)
+		{
+			if (cfgIds[i] != MSV_ACTIVECONFIGFLAGS_NO_CFGID)
+			{
+				m_flagIds.emplace(cfgIds[i], flagId);
+			}
+		}
+	}
+
+	for (size_t i = 0; i < m_flags.size() * 2 * m_listCapacity; ++i)
+	{
+		m_hashes[i].store(0, std::memory_order_relaxed);
+	}
+}
+
+MsvActiveConfigFlags::~MsvActiveConfigFlags()
+{
+	Detach();
+}
+
+
+/********************************************************************************************************************************
+*															MsvActiveConfigFlags public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvActiveConfigFlags::Attach(std::shared_ptr<IMsvActiveConfig> spConfig)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	if (m_spConfig)
+	{
+		return MSV_ALREADY_INITIALIZED_INFO;
+	}
+
+	if (!spConfig)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	std::shared_ptr<IMsvActiveConfigBatchCallback> spCallback(new (std::nothrow) MsvActiveConfigFlagsCallback(this));
+	if (!spCallback)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Create active config flags callback failed with error: {0:x}", MSV_ALLOCATION_ERROR);
+		return MSV_ALLOCATION_ERROR;
+	}
+
+	//callback is registered first -> change made during load is not lost
+	MsvErrorCode errorCode = spConfig->RegisterBatchCallback(spCallback);
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Register active config flags callback failed with error: {0:x}", errorCode);
+		return errorCode;
+	}
+
+	{
+		std::lock_guard<std::mutex> compileLock(m_compileLock);
+
+		if (MSV_FAILED(errorCode = LoadRules(*spConfig)))
+		{
+			MSV_LOG_ERROR(m_spLogger, "Load active config flags rules failed with error: {0:x}", errorCode);
+			spConfig->UnregisterBatchCallback(spCallback);
+			return errorCode;
+		}
+
+		std::set<size_t> flagIds;
+		for (size_t flagId = 0; flagId < m_flags.size(); ++flagId)
+		{
+			flagIds.insert(flagIds.end(), flagId);
+		}
+		Compile(flagIds);
+	}
+
+	m_spConfig = spConfig;
+	m_spCallback = spCallback;
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfigFlags::Detach()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	if (!m_spConfig)
+	{
+		return MSV_NOT_INITIALIZED_INFO;
+	}
+
+	MsvErrorCode errorCode = m_spConfig->UnregisterBatchCallback(m_spCallback);
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Unregister active config flags callback failed with error: {0:x}", errorCode);
+		return errorCode;
+	}
+
+	m_spConfig.reset();
+	m_spCallback.reset();
+
+	return MSV_SUCCESS;
+}
+
+bool MsvActiveConfigFlags::IsEnabled(size_t flagId, uint64_t subjectHash) const
+{
+	if (flagId >= m_flags.size())
+	{
+		return false;
+	}
+
+	//bucket does not depend on rules -> it is computed outside of sequence lock (each flag has own buckets)
+	uint64_t bucket = MixHash(subjectHash ^ MixHash(static_cast<uint64_t>(flagId) + 1)) >> 32;
+	const MsvActiveConfigFlagSlot& slot = m_slots[flagId];
+	const std::atomic<uint64_t>* pAllowHashes = &m_hashes[flagId * 2 * m_listCapacity];
+	const std::atomic<uint64_t>* pDenyHashes = pAllowHashes + m_listCapacity;
+	bool enabled;
+
+	for (;;)
+	{
+		uint64_t sequence = m_sequence.load(std::memory_order_acquire);
+		if (sequence & 1)
+		{
+			//flags are being compiled -> wait
+			std::this_thread::yield();
+			continue;
+		}
+
+		//counts never exceed capacity -> torn read only gives wrong result, which is retried
+		enabled = slot.m_enabled.load(std::memory_order_relaxed) != 0
+			&& !FindHash(pDenyHashes, slot.m_denyCount.load(std::memory_order_relaxed), subjectHash)
+			&& (FindHash(pAllowHashes, slot.m_allowCount.load(std::memory_order_relaxed), subjectHash) || bucket < slot.m_threshold.load(std::memory_order_relaxed));
+
+		//slot loads must not be reordered after sequence check
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (m_sequence.load(std::memory_order_relaxed) == sequence)
+		{
+			return enabled;
+		}
+	}
+}
+
+bool MsvActiveConfigFlags::IsEnabled(size_t flagId, const char* subject) const
+{
+	return IsEnabled(flagId, HashSubject(subject));
+}
+
+uint64_t MsvActiveConfigFlags::HashSubject(const char* subject, size_t length)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (size_t i = 0; i < length; ++i)
+	{
+		hash ^= static_cast<unsigned char>(subject[i]);
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+uint64_t MsvActiveConfigFlags::HashSubject(const char* subject)
+{
+	return subject ? HashSubject(subject, strlen(subject)) : HashSubject("", 0);
+}
+
+
+/********************************************************************************************************************************
+*															MsvActiveConfigFlags protected methods
+********************************************************************************************************************************/
+
+
+void MsvActiveConfigFlags::OnValuesChanged(const std::vector<MsvConfigValueUpdate>& values)
+{
+	std::lock_guard<std::mutex> compileLock(m_compileLock);
+
+	//whole batch is compiled at once (flag using more changed config IDs is compiled only once)
+	std::set<size_t> flagIds;
+	for (std::vector<MsvConfigValueUpdate>::const_iterator it = values.begin(); it != values.end(); ++it)
+	{
+		MsvErrorCode errorCode = SetRule(it->m_cfgId, it->m_newValue, flagIds);
+		if (MSV_FAILED(errorCode))
+		{
+			MSV_LOG_ERROR(m_spLogger, "Active config flag rule {} has not been set - error: {:x}", it->m_cfgId, errorCode);
+		}
+	}
+
+	if (!flagIds.empty())
+	{
+		Compile(flagIds);
+	}
+}
+
+MsvErrorCode MsvActiveConfigFlags::LoadRules(const IMsvActiveConfig& config)
+{
+	//all rules are read from one snapshot (types are not known, missing type is not logged as error)
+	std::shared_ptr<const MsvConfigSnapshot> spSnapshot;
+	MsvErrorCode errorCode = config.GetSnapshot(spSnapshot);
+	if (MSV_FAILED(errorCode))
+	{
+		return errorCode;
+	}
+
+	std::set<size_t> flagIds;
+	for (std::multimap<int32_t, size_t>::const_iterator it = m_flagIds.begin(); it != m_flagIds.end(); it = m_flagIds.upper_bound(it->first))
+	{
+		bool boolValue = false;
+		double doubleValue = 0.0;
+		int64_t integerValue = 0;
+		std::string stringValue;
+		uint64_t unsignedValue = 0;
+		MsvConfigValue value;
+
+		if (MSV_SUCCEEDED(spSnapshot->GetValue(it->first, boolValue)))
+		{
+			value = boolValue;
+		}
+		else if (MSV_SUCCEEDED(spSnapshot->GetValue(it->first, doubleValue)))
+		{
+			value = doubleValue;
+		}
+		else if (MSV_SUCCEEDED(spSnapshot->GetValue(it->first, integerValue)))
+		{
+			value = integerValue;
+		}
+		else if (MSV_SUCCEEDED(spSnapshot->GetValue(it->first, stringValue)))
+		{
+			value = std::move(stringValue);
+		}
+		else if (MSV_SUCCEEDED(spSnapshot->GetValue(it->first, unsignedValue)))
+		{
+			value = unsignedValue;
+		}
+		else
+		{
+			MSV_LOG_ERROR(m_spLogger, "Active config flag rule {} has not been found - error: {:x}", it->first, MSV_NOT_FOUND_ERROR);
+			return MSV_NOT_FOUND_ERROR;
+		}
+
+		if (MSV_FAILED(errorCode = SetRule(it->first, value, flagIds)))
+		{
+			MSV_LOG_ERROR(m_spLogger, "Active config flag rule {} has other type - error: {:x}", it->first, errorCode);
+			return errorCode;
+		}
+	}
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfigFlags::SetRule(int32_t cfgId, const MsvConfigValue& value, std::set<size_t>& flagIds)
+{
+	std::pair<std::multimap<int32_t, size_t>::const_iterator, std::multimap<int32_t, size_t>::const_iterator> range = m_flagIds.equal_range(cfgId);
+	for (std::multimap<int32_t, size_t>::const_iterator it = range.first; it != range.second; ++it)
+	{
+		const MsvActiveConfigFlag& flag = m_flags[it->second];
+		MsvActiveConfigFlagRules& rules = m_rules[it->second];
+
+		if (flag.m_enabledCfgId == cfgId)
+		{
+			const bool* pValue = std::get_if<bool>(&value);
+			if (!pValue)
+			{
+				return MSV_INVALID_DATA_ERROR;
+			}
+			rules.m_enabled = *pValue;
+		}
+
+		if (flag.m_percentageCfgId == cfgId)
+		{
+			if (const double* pValue = std::get_if<double>(&value))
+			{
+				rules.m_percentage = *pValue;
+			}
+			else if (const int64_t* pValue = std::get_if<int64_t>(&value))
+			{
+				rules.m_percentage = static_cast<double>(*pValue);
+			}
+			else if (const uint64_t* pValue = std::get_if<uint64_t>(&value))
+			{
+				rules.m_percentage = static_cast<double>(*pValue);
+			}
+			else
+			{
+				return MSV_INVALID_DATA_ERROR;
+			}
+		}
+
+		if (flag.m_allowCfgId == cfgId || flag.m_denyCfgId == cfgId)
+		{
+			const std::string* pValue = std::get_if<std::string>(&value);
+			if (!pValue)
+			{
+				return MSV_INVALID_DATA_ERROR;
+			}
+
+			if (flag.m_allowCfgId == cfgId)
+			{
+				rules.m_allowList = *pValue;
+			}
+
+			if (flag.m_denyCfgId == cfgId)
+			{
+				rules.m_denyList = *pValue;
+			}
+		}
+
+		flagIds.insert(it->second);
+	}
+
+	return MSV_SUCCESS;
+}
+
+void MsvActiveConfigFlags::Compile(const std::set<size_t>& flagIds)
+{
+	//lists are hashed and sorted before write -> evaluation retries only while slots are stored
+	std::vector<std::vector<uint64_t>> allowHashes(flagIds.size());
+	std::vector<std::vector<uint64_t>> denyHashes(flagIds.size());
+	std::vector<uint64_t> thresholds(flagIds.size());
+	std::vector<bool> enabled(flagIds.size());
+
+	size_t index = 0;
+	for (std::set<size_t>::const_iterator it = flagIds.begin(); it != flagIds.end(); ++it, ++index)
+	{
+		const MsvActiveConfigFlagRules& rules = m_rules[*it];
+		CompileList(rules.m_allowList, allowHashes[index]);
+		CompileList(rules.m_denyList, denyHashes[index]);
+
+		//percentage is mapped to 32 bit bucket space (NaN -> nobody)
+		double percentage = rules.m_percentage;
+		thresholds[index] = !(percentage > 0.0) ? 0 : (percentage >= 100.0) ? (uint64_t(1) << 32) : static_cast<uint64_t>(percentage / 100.0 * 4294967296.0);
+		enabled[index] = rules.m_enabled;
+
+		if (allowHashes[index].size() > m_listCapacity || denyHashes[index].size() > m_listCapacity)
+		{
+			//incomplete deny list would let denied subjects in -> flag is disabled
+			MSV_LOG_ERROR(m_spLogger, "Active config flag {} list exceeds capacity {} - flag is disabled, error: {:x}", *it, m_listCapacity, MSV_INVALID_DATA_ERROR);
+			allowHashes[index].clear();
+			denyHashes[index].clear();
+			enabled[index] = false;
+		}
+	}
+
+	//make sequence odd (slot stores must not be reordered before sequence store)
+	m_sequence.store(m_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	index = 0;
+	for (std::set<size_t>::const_iterator it = flagIds.begin(); it != flagIds.end(); ++it, ++index)
+	{
+		MsvActiveConfigFlagSlot& slot = m_slots[*it];
+		std::atomic<uint64_t>* pAllowHashes = &m_hashes[*it * 2 * m_listCapacity];
+		std::atomic<uint64_t>* pDenyHashes = pAllowHashes + m_listCapacity;
+
+		for (size_t i = 0; i < allowHashes[index].size(); ++i)
+		{
+			pAllowHashes[i].store(allowHashes[index][i], std::memory_order_relaxed);
+		}
+
+		for (size_t i = 0; i < denyHashes[index].size(); ++i)
+		{
+			pDenyHashes[i].store(denyHashes[index][i], std::memory_order_relaxed);
+		}
+
+		slot.m_enabled.store(enabled[index] ? 1 : 0, std::memory_order_relaxed);
+		slot.m_allowCount.store(static_cast<uint32_t>(allowHashes[index].size()), std::memory_order_relaxed);
+		slot.m_denyCount.store(static_cast<uint32_t>(denyHashes[index].size()), std::memory_order_relaxed);
+		slot.m_threshold.store(thresholds[index], std::memory_order_relaxed);
+	}
+
+	//make sequence even (publishes compiled flags)
+	m_sequence.store(m_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void MsvActiveConfigFlags::CompileList(const std::string& list, std::vector<uint64_t>& hashes)
+{
+	hashes.clear();
+
+	size_t begin = 0;
+	while (begin <= list.size())
+	{
+		size_t end = list.find(',', begin);
+		if (end == std::string::npos)
+		{
+			end = list.size();
+		}
+
+		size_t first = begin;
+		size_t last = end;
+		while (first < last && (list[first] == ' ' || list[first] == '\t'))
+		{
+			++first;
+		}
+		while (last > first && (list[last - 1] == ' ' || list[last - 1] == '\t'))
+		{
+			--last;
+		}
+
+		//empty subjects are ignored (e.g. trailing comma)
+		if (last > first)
+		{
+			hashes.push_back(HashSubject(list.data() + first, last - first));
+		}
+
+		begin = end + 1;
+	}
+
+	std::sort(hashes.begin(), hashes.end());
+	hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+}
+
+bool MsvActiveConfigFlags::FindHash(const std::atomic<uint64_t>* pHashes, uint32_t count, uint64_t hash)
+{
+	uint32_t first = 0;
+	while (first < count)
+	{
+		uint32_t middle = first + (count - first) / 2;
+		uint64_t middleHash = pHashes[middle].load(std::memory_order_relaxed);
+		if (middleHash == hash)
+		{
+			return true;
+		}
+		else if (middleHash < hash)
+		{
+			first = middle + 1;
+		}
+		else
+		{
+			count = middle;
+		}
+	}
+
+	return false;
+}
+
+uint64_t MsvActiveConfigFlags::MixHash(uint64_t hash)
+{
+	hash ^= hash >> 30;
+	hash *= 0xbf58476d1ce4e5b9ull;
+	hash ^= hash >> 27;
+	hash *= 0x94d049bb133111ebull;
+	hash ^= hash >> 31;
+
+	return hash;
+}
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,361 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Active Config Feature Flags
+* @details		Feature flags compiled from active config values (lock free evaluation).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_ACTIVECONFIGFLAGS_H
+#define MARSTECH_ACTIVECONFIGFLAGS_H
+
+
+#include "IMsvActiveConfig.h"
+#include "IMsvActiveConfigBatchCallback.h"
+
+#include "mlogging/mlogging.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		No config ID.
+* @details	Config ID of flag rule which is not configured (rule uses its default).
+******************************************************************************************************/
+#define MSV_ACTIVECONFIGFLAGS_NO_CFGID INT32_MIN
+
+/**************************************************************************************************//**
+* @brief		Default list capacity.
+* @details	Default maximal count of subjects in allow (or deny) list of one flag.
+******************************************************************************************************/
+#define MSV_ACTIVECONFIGFLAGS_LIST_CAPACITY 64
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Flag.
+* @details	Config IDs of rules of one feature flag (@ref MSV_ACTIVECONFIGFLAGS_NO_CFGID -> rule is not used).
+******************************************************************************************************/
+struct MsvActiveConfigFlag
+{
+	int32_t m_enabledCfgId;				//!< Bool switch of flag (not used -> flag is switched on).
+	int32_t m_percentageCfgId;			//!< Rollout percentage 0-100 (double, int64_t or uint64_t; not used -> 100 %).
+	int32_t m_allowCfgId;				//!< Comma separated subjects which always get flag (string; not used -> nobody).
+	int32_t m_denyCfgId;					//!< Comma separated subjects which never get flag (string; not used -> nobody).
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Flags.
+* @details	Evaluates feature flags for subjects (users, tenants, requests...). Rules of each flag are read from
+*				active config and compiled once per change to compact slots: switch, percentage threshold and
+*				sorted hashes of allow and deny lists. Evaluation does not lock and does not allocate, it is
+*				one bucket comparison and two binary searches. Slots are protected by sequence lock (evaluation
+*				retries while flags are being compiled).
+* @note		Switched off flag is disabled for everybody. Deny list has precedence over allow list, allow list
+*				has precedence over rollout percentage. Flag whose list exceeds capacity is disabled.
+* @see		MsvScalarValues
+******************************************************************************************************/
+class MsvActiveConfigFlags
+{
+protected:
+	/**************************************************************************************************//**
+	* @brief		MarsTech Active Config Flags Callback.
+	* @details	Batch callback registered to active config, it passes changes to parent flags.
+	* @see		IMsvActiveConfigBatchCallback
+	******************************************************************************************************/
+	class MsvActiveConfigFlagsCallback:
+		public IMsvActiveConfigBatchCallback
+	{
+	public:
+		/**************************************************************************************************//**
+		* @brief			Constructor.
+		* @param[in]	pFlags		Pointer to parent (@ref MsvActiveConfigFlags).
+		******************************************************************************************************/
+		MsvActiveConfigFlagsCallback(MsvActiveConfigFlags* pFlags);
+
+		/**************************************************************************************************//**
+		* @copydoc IMsvActiveConfigBatchCallback::OnValuesChanged(const std::vector<MsvConfigValueUpdate>& values)
+		******************************************************************************************************/
+		virtual void OnValuesChanged(const std::vector<MsvConfigValueUpdate>& values) override;
+
+	protected:
+		/**************************************************************************************************//**
+		* @brief		Pointer to parent.
+		* @details	Pointer to object which creates this one.
+		******************************************************************************************************/
+		MsvActiveConfigFlags* m_pFlags;
+	};
+
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Flags are disabled until they are attached to config.
+	* @param[in]	flags				Rules of flags (flag ID is index of flag).
+	* @param[in]	listCapacity	Maximal count of subjects in allow (or deny) list of one flag.
+	* @param[in]	spLogger			Shared pointer to logger for logging.
+	******************************************************************************************************/
+	MsvActiveConfigFlags(const std::vector<MsvActiveConfigFlag>& flags, size_t listCapacity = MSV_ACTIVECONFIGFLAGS_LIST_CAPACITY, std::shared_ptr<MsvLogger> spLogger = nullptr);
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	* @details	Detaches flags.
+	******************************************************************************************************/
+	virtual ~MsvActiveConfigFlags();
+
+	/**************************************************************************************************//**
+	* @brief			Attach flags.
+	* @details		Registers batch callback to active config and compiles all flags.
+	* @param[in]	spConfig		Initialized active config.
+	* @retval		MSV_ALREADY_INITIALIZED_INFO	When flags have been already attached.
+	* @retval		MSV_INVALID_DATA_ERROR			When config is nullptr or some rule has other type.
+	* @retval		MSV_ALLOCATION_ERROR				When callback allocation failed.
+	* @retval		other_error_code					When register callback or load failed.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Attach(std::shared_ptr<IMsvActiveConfig> spConfig);
+
+	/**************************************************************************************************//**
+	* @brief			Detach flags.
+	* @details		Unregisters batch callback (flags keep last compiled rules).
+	* @retval		MSV_NOT_INITIALIZED_INFO	When flags have not been attached.
+	* @retval		other_error_code				When unregister callback failed.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Detach();
+
+	/**************************************************************************************************//**
+	* @brief			Is enabled.
+	* @details		Evaluates flag for subject (lock free, no allocation).
+	* @param[in]	flagId			Flag ID (index of flag passed to constructor).
+	* @param[in]	subjectHash		Hash of subject (@ref HashSubject, it might be computed once per request).
+	* @returns		True when flag is enabled for subject, false otherwise (or when flag does not exist).
+	******************************************************************************************************/
+	bool IsEnabled(size_t flagId, uint64_t subjectHash) const;
+
+	/**************************************************************************************************//**
+	* @brief			Is enabled.
+	* @details		Evaluates flag for subject (lock free, no allocation).
+	* @param[in]	flagId			Flag ID (index of flag passed to constructor).
+	* @param[in]	subject			Subject (e.g. user ID).
+	* @returns		True when flag is enabled for subject, false otherwise (or when flag does not exist).
+	******************************************************************************************************/
+	bool IsEnabled(size_t flagId, const char* subject) const;
+
+	/**************************************************************************************************//**
+	* @brief			Hash subject.
+	* @details		Computes hash of subject (64 bit FNV-1a), the same hash is used for allow and deny lists.
+	* @param[in]	subject			Subject (e.g. user ID).
+	* @param[in]	length			Length of subject.
+	* @returns		Hash of subject.
+	******************************************************************************************************/
+	static uint64_t HashSubject(const char* subject, size_t length);
+
+	/**************************************************************************************************//**
+	* @brief			Hash subject.
+	* @param[in]	subject			Null terminated subject (e.g. user ID).
+	* @returns		Hash of subject.
+	* @see			HashSubject(const char*, size_t)
+	******************************************************************************************************/
+	static uint64_t HashSubject(const char* subject);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Flag rules.
+	* @details	Current values of rules of one flag (input of compilation).
+	******************************************************************************************************/
+	struct MsvActiveConfigFlagRules
+	{
+		bool m_enabled;							//!< Flag is switched on.
+		double m_percentage;						//!< Rollout percentage.
+		std::string m_allowList;				//!< Comma separated subjects which always get flag.
+		std::string m_denyList;					//!< Comma separated subjects which never get flag.
+	};
+
+	/**************************************************************************************************//**
+	* @brief		Flag slot.
+	* @details	Compiled flag (atomic members -> torn reads are detected by sequence, not undefined).
+	******************************************************************************************************/
+	struct MsvActiveConfigFlagSlot
+	{
+		std::atomic<uint32_t> m_enabled;		//!< Flag is switched on (1) or not (0).
+		std::atomic<uint32_t> m_allowCount;	//!< Count of hashes in allow list.
+		std::atomic<uint32_t> m_denyCount;	//!< Count of hashes in deny list.
+		std::atomic<uint64_t> m_threshold;	//!< Subjects whose bucket is lower get flag (0 -> nobody, 2^32 -> everybody).
+	};
+
+	/**************************************************************************************************//**
+	* @brief			Values have been changed.
+	* @details		Updates rules of changed config IDs and compiles affected flags.
+	* @param[in]	values		Changed values.
+	******************************************************************************************************/
+	void OnValuesChanged(const std::vector<MsvConfigValueUpdate>& values);
+
+	/**************************************************************************************************//**
+	* @brief			Load rules.
+	* @details		Reads rules of all flags from config.
+	* @param[in]	config		Active config.
+	* @retval		other_error_code				When some rule has not been read.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	MsvErrorCode LoadRules(const IMsvActiveConfig& config);
+
+	/**************************************************************************************************//**
+	* @brief			Set rule.
+	* @details		Sets changed value to all rules which use config ID.
+	* @param[in]	cfgId			Changed config ID.
+	* @param[in]	value			New value.
+	* @param[out]	flagIds		Flags whose rules have been changed.
+	* @retval		MSV_INVALID_DATA_ERROR		When value has other type than rule.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	MsvErrorCode SetRule(int32_t cfgId, const MsvConfigValue& value, std::set<size_t>& flagIds);
+
+	/**************************************************************************************************//**
+	* @brief			Compile flags.
+	* @details		Compiles rules of flags and publishes them to slots (in one sequence lock write).
+	* @param[in]	flagIds		Flags to compile.
+	******************************************************************************************************/
+	void Compile(const std::set<size_t>& flagIds);
+
+	/**************************************************************************************************//**
+	* @brief			Compile list.
+	* @details		Hashes subjects of comma separated list (surrounding white spaces are ignored).
+	* @param[in]	list			Comma separated subjects.
+	* @param[out]	hashes		Sorted unique hashes of subjects.
+	******************************************************************************************************/
+	static void CompileList(const std::string& list, std::vector<uint64_t>& hashes);
+
+	/**************************************************************************************************//**
+	* @brief			Find hash.
+	* @details		Binary search of hash in compiled list.
+	* @param[in]	pHashes		Sorted hashes.
+	* @param[in]	count			Count of hashes.
+	* @param[in]	hash			Searched hash.
+	* @returns		True when hash is in list, false otherwise.
+	******************************************************************************************************/
+	static bool FindHash(const std::atomic<uint64_t>* pHashes, uint32_t count, uint64_t hash);
+
+	/**************************************************************************************************//**
+	* @brief			Mix hash.
+	* @details		Spreads bits of hash (splitmix64 finalizer), bucket of subject differs per flag.
+	* @param[in]	hash			Hash to mix.
+	* @returns		Mixed hash.
+	******************************************************************************************************/
+	static uint64_t MixHash(uint64_t hash);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Sequence.
+	* @details	Odd while flags are being compiled (own cache line -> it is not shared with other data).
+	******************************************************************************************************/
+	alignas(64) std::atomic<uint64_t> m_sequence;
+
+	/**************************************************************************************************//**
+	* @brief		Flags.
+	* @details	Config IDs of rules of flags, immutable after construction.
+	******************************************************************************************************/
+	alignas(64) const std::vector<MsvActiveConfigFlag> m_flags;
+
+	/**************************************************************************************************//**
+	* @brief		List capacity.
+	* @details	Maximal count of subjects in allow (or deny) list of one flag.
+	******************************************************************************************************/
+	const size_t m_listCapacity;
+
+	/**************************************************************************************************//**
+	* @brief		Slots.
+	* @details	Compiled flags (one slot per flag).
+	******************************************************************************************************/
+	std::unique_ptr<MsvActiveConfigFlagSlot[]> m_slots;
+
+	/**************************************************************************************************//**
+	* @brief		Hashes.
+	* @details	Compiled allow and deny lists (each flag has allow list followed by deny list, both of list
+	*				capacity).
+	******************************************************************************************************/
+	std::unique_ptr<std::atomic<uint64_t>[]> m_hashes;
+
+	/**************************************************************************************************//**
+	* @brief		Logger.
+	* @details	Shared pointer to logger for logging.
+	******************************************************************************************************/
+	std::shared_ptr<MsvLogger> m_spLogger;
+
+	/**************************************************************************************************//**
+	* @brief		Flags mutex.
+	* @details	Locks attach and detach (evaluation does not lock it).
+	******************************************************************************************************/
+	std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Compile mutex.
+	* @details	Serializes compilations (only one sequence lock writer at a time), it locks rules.
+	******************************************************************************************************/
+	std::mutex m_compileLock;
+
+	/**************************************************************************************************//**
+	* @brief		Rules.
+	* @details	Current rules of flags (one per flag).
+	******************************************************************************************************/
+	std::vector<MsvActiveConfigFlagRules> m_rules;
+
+	/**************************************************************************************************//**
+	* @brief		Flags by config ID.
+	* @details	Flags which use config ID in their rules (config ID -> flag ID).
+	******************************************************************************************************/
+	std::multimap<int32_t, size_t> m_flagIds;
+
+	/**************************************************************************************************//**
+	* @brief		Attached config.
+	* @details	Active config with registered callback (nullptr -> flags are not attached).
+	******************************************************************************************************/
+	std::shared_ptr<IMsvActiveConfig> m_spConfig;
+
+	/**************************************************************************************************//**
+	* @brief		Flags callback.
+	* @details	Batch callback registered to attached config.
+	******************************************************************************************************/
+	std::shared_ptr<IMsvActiveConfigBatchCallback> m_spCallback;
+};
+
+
+#endif // !MARSTECH_ACTIVECONFIGFLAGS_H
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,100 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Active Config Journal
+* @details		Ring buffer of sequenced changes of active config database.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "MsvActiveConfigJournal.h"
+
+#include "merror/MsvErrorCodes.h"
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvActiveConfigJournal::MsvActiveConfigJournal(size_t capacity):
+	m_entries(capacity),
+	m_lastSequence(0)
+{
+
+}
+
+
+/********************************************************************************************************************************
+*															MsvActiveConfigJournal public methods
+********************************************************************************************************************************/
+
+
+void MsvActiveConfigJournal::SetCapacity(size_t capacity)
+{
+	m_entries.clear();
+	m_entries.resize(capacity);
+}
+
+void MsvActiveConfigJournal::Record(uint64_t sequence, int32_t cfgId, MsvConfigValue&& newValue)
+{
+	m_lastSequence = sequence;
+
+	if (m_entries.empty())
+	{
+		//journal is disabled -> only sequence is tracked (consumers resync)
+		return;
+	}
+
+	//slot is reused (no allocation for scalar values)
+	MsvConfigValueJournalEntry& entry = m_entries[sequence % m_entries.size()];
+	entry.m_sequence = sequence;
+	entry.m_cfgId = cfgId;
+	entry.m_newValue = std::move(newValue);
+}
+
+MsvErrorCode MsvActiveConfigJournal::Poll(uint64_t lastSequence, std::vector<MsvConfigValueJournalEntry>& changes, uint64_t& sequence) const
+{
+	sequence = m_lastSequence;
+
+	if (lastSequence > m_lastSequence || m_lastSequence - lastSequence > m_entries.size())
+	{
+		//sequence from other journal (database has been reopened) or changes have been overwritten
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	changes.reserve(changes.size() + static_cast<size_t>(m_lastSequence - lastSequence));
+	for (uint64_t entrySequence = lastSequence + 1; entrySequence <= m_lastSequence; ++entrySequence)
+	{
+		changes.push_back(m_entries[entrySequence % m_entries.size()]);
+	}
+
+	return MSV_SUCCESS;
+}
+
+/** @} */	//End of group MCONFIG.
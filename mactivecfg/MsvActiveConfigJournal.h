@@ -0,0 +1,120 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Active Config Journal
+* @details		Ring buffer of sequenced changes of active config database.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_ACTIVECONFIGJOURNAL_H
+#define MARSTECH_ACTIVECONFIGJOURNAL_H
+
+
+#include "mconfig/common/MsvConfigValue.h"
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstdint>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Default journal size.
+* @details	Default count of changes kept by active config journal.
+******************************************************************************************************/
+#define MSV_ACTIVECONFIG_JOURNAL_SIZE 1024
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Journal.
+* @details	Keeps last changes (with their sequence numbers) in ring buffer of fixed size, so consumers might
+*				poll changes made after sequence they have already seen. Sequences must be recorded in order
+*				without gaps. Oldest changes are overwritten, consumer which is too far behind is told to resync.
+* @note		It is not thread safe (it is locked by its database).
+* @see		MsvActiveConfigDatabase
+******************************************************************************************************/
+class MsvActiveConfigJournal
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	capacity		Count of kept changes (0 -> journal is disabled, each poll of older sequence resyncs).
+	******************************************************************************************************/
+	MsvActiveConfigJournal(size_t capacity = MSV_ACTIVECONFIG_JOURNAL_SIZE);
+
+	/**************************************************************************************************//**
+	* @brief			Set capacity.
+	* @details		Sets count of kept changes. It must be set before first change is recorded.
+	* @param[in]	capacity		Count of kept changes.
+	******************************************************************************************************/
+	void SetCapacity(size_t capacity);
+
+	/**************************************************************************************************//**
+	* @brief			Record change.
+	* @details		Stores change to journal (it overwrites the oldest one when journal is full).
+	* @param[in]	sequence		Sequence number of change (previous sequence plus one).
+	* @param[in]	cfgId			Changed config ID.
+	* @param[in]	newValue		New value of config ID.
+	******************************************************************************************************/
+	void Record(uint64_t sequence, int32_t cfgId, MsvConfigValue&& newValue);
+
+	/**************************************************************************************************//**
+	* @brief			Poll changes.
+	* @details		Appends all changes made after last sequence to changes (in sequence order).
+	* @param[in]	lastSequence	Sequence number of last change seen by consumer (0 -> nothing has been seen).
+	* @param[out]	changes			Changes made after last sequence.
+	* @param[out]	sequence			Sequence number of last change in journal (consumer continues from it).
+	* @retval		MSV_NOT_FOUND_ERROR		When changes after last sequence are not in journal anymore (they have
+	*												been overwritten or last sequence is unknown), consumer must resync.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	MsvErrorCode Poll(uint64_t lastSequence, std::vector<MsvConfigValueJournalEntry>& changes, uint64_t& sequence) const;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Entries.
+	* @details	Ring buffer of changes (change is stored at its sequence modulo capacity).
+	******************************************************************************************************/
+	std::vector<MsvConfigValueJournalEntry> m_entries;
+
+	/**************************************************************************************************//**
+	* @brief		Last sequence.
+	* @details	Sequence number of last recorded change (0 -> nothing has been recorded).
+	******************************************************************************************************/
+	uint64_t m_lastSequence;
+};
+
+
+#endif // !MARSTECH_ACTIVECONFIGJOURNAL_H
+
+/** @} */	//End of group MCONFIG.
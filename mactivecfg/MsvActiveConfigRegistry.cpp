@@ -0,0 +1,266 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Active Config Registry Implementation
+* @details		Contains implementation of @ref MsvActiveConfigRegistry.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "MsvActiveConfigRegistry.h"
+
+#include "IMsvActiveConfig.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <chrono>
+#include <filesystem>
+#include <system_error>
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															MsvActiveConfigDatabase implementation
+********************************************************************************************************************************/
+
+
+MsvActiveConfigDatabase::MsvActiveConfigDatabase():
+	m_lazy(false),
+	m_snapshotRevision(0),
+	m_verifyPending(false),
+	m_verifying(false),
+	m_storageError(MSV_SUCCESS),
+	m_stopVerify(false),
+	m_version(0)
+{
+
+}
+
+MsvActiveConfigDatabase::~MsvActiveConfigDatabase()
+{
+	//verification uses database (and it opens storage), it might wait for retry of failed open
+	if (m_verifyThread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_verifyLock);
+			m_stopVerify = true;
+		}
+		m_verifyCondition.notify_all();
+
+		m_verifyThread.join();
+	}
+
+	if (m_spStorage)
+	{
+		//last instance has released database -> close it (return code is not important here)
+		m_spStorage->Uninitialize();
+	}
+}
+
+MsvErrorCode MsvActiveConfigDatabase::WaitForVerification()
+{
+	std::unique_lock<std::mutex> lock(m_verifyLock);
+	m_verifyCondition.wait(lock, [this]() { return !m_verifying; });
+
+	return m_storageError;
+}
+
+void MsvActiveConfigDatabase::RecordChange(int32_t cfgId, MsvConfigValue&& newValue)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_changeLock);
+		m_keyVersions[cfgId] = ++m_version;
+		m_journal.Record(m_version, cfgId, std::move(newValue));
+	}
+
+	//waiters check their config IDs (they are woken only when something has been changed, there is no polling)
+	m_changeCondition.notify_all();
+
+	std::shared_ptr<const std::vector<std::shared_ptr<MsvChangeNotifier>>> spNotifiers = m_notifiers.Load();
+	std::vector<std::shared_ptr<MsvChangeNotifier>>::const_iterator endIt = spNotifiers->end();
+	for (std::vector<std::shared_ptr<MsvChangeNotifier>>::const_iterator it = spNotifiers->begin(); it != endIt; ++it)
+	{
+		(*it)->Notify(cfgId);
+	}
+
+	//derived values read new value from cache (their changes are notified by their instances)
+	std::shared_ptr<const std::vector<std::shared_ptr<MsvActiveConfigDerived>>> spDerivedValues = m_derivedValues.Load();
+	std::vector<std::shared_ptr<MsvActiveConfigDerived>>::const_iterator derivedEndIt = spDerivedValues->end();
+	for (std::vector<std::shared_ptr<MsvActiveConfigDerived>>::const_iterator it = spDerivedValues->begin(); it != derivedEndIt; ++it)
+	{
+		(*it)->OnValueChanged(cfgId);
+	}
+}
+
+uint64_t MsvActiveConfigDatabase::GetVersion()
+{
+	std::lock_guard<std::mutex> lock(m_changeLock);
+	return m_version;
+}
+
+uint64_t MsvActiveConfigDatabase::WaitForChange(const std::vector<int32_t>& cfgIds, uint64_t sinceVersion, uint32_t timeoutMs, const std::function<bool()>& released)
+{
+	uint64_t version = sinceVersion;
+
+	std::function<bool()> changed = [this, &cfgIds, sinceVersion, &version, &released]()
+	{
+		if (released())
+		{
+			return true;
+		}
+
+		std::vector<int32_t>::const_iterator endIt = cfgIds.end();
+		for (std::vector<int32_t>::const_iterator it = cfgIds.begin(); it != endIt; ++it)
+		{
+			std::map<int32_t, uint64_t>::const_iterator versionIt = m_keyVersions.find(*it);
+			if (versionIt != m_keyVersions.end() && versionIt->second > version)
+			{
+				version = versionIt->second;
+			}
+		}
+
+		return version != sinceVersion;
+	};
+
+	std::unique_lock<std::mutex> lock(m_changeLock);
+
+	if (timeoutMs == MSV_ACTIVECONFIG_WAIT_INFINITE)
+	{
+		m_changeCondition.wait(lock, changed);
+	}
+	else
+	{
+		m_changeCondition.wait_for(lock, std::chrono::milliseconds(timeoutMs), changed);
+	}
+
+	return version;
+}
+
+void MsvActiveConfigDatabase::WakeWaiters()
+{
+	{
+		//waiter checks release under change lock -> it is either checked after release or waiter is already blocked
+		std::lock_guard<std::mutex> lock(m_changeLock);
+	}
+
+	m_changeCondition.notify_all();
+}
+
+MsvErrorCode MsvActiveConfigDatabase::PollChanges(uint64_t lastSequence, std::vector<MsvConfigValueJournalEntry>& changes, uint64_t& sequence)
+{
+	std::lock_guard<std::mutex> lock(m_changeLock);
+	return m_journal.Poll(lastSequence, changes, sequence);
+}
+
+
+/********************************************************************************************************************************
+*															MsvActiveConfigRegistry public methods
+********************************************************************************************************************************/
+
+
+MsvActiveConfigRegistry& MsvActiveConfigRegistry::Get()
+{
+	static MsvActiveConfigRegistry registry;
+	return registry;
+}
+
+MsvErrorCode MsvActiveConfigRegistry::GetDatabase(const char* configPath, const char* groupName, MsvActiveConfigDatabaseOpen open, std::shared_ptr<MsvActiveConfigDatabase>& spDatabase)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	std::pair<std::string, std::string> key = GetKey(configPath, groupName);
+
+	//remove databases released by all instances
+	for (std::map<std::pair<std::string, std::string>, std::weak_ptr<MsvActiveConfigDatabase>>::iterator it = m_databases.begin(); it != m_databases.end();)
+	{
+		it = it->second.expired() ? m_databases.erase(it) : std::next(it);
+	}
+
+	std::map<std::pair<std::string, std::string>, std::weak_ptr<MsvActiveConfigDatabase>>::iterator it = m_databases.find(key);
+	if (it != m_databases.end())
+	{
+		spDatabase = it->second.lock();
+		if (spDatabase)
+		{
+			return MSV_ALREADY_EXISTS_INFO;
+		}
+	}
+
+	std::shared_ptr<MsvActiveConfigDatabase> spNewDatabase(new (std::nothrow) MsvActiveConfigDatabase());
+	if (!spNewDatabase)
+	{
+		return MSV_ALLOCATION_ERROR;
+	}
+
+	//registry stays locked -> concurrent instances wait for this open and then share the database
+	MSV_RETURN_FAILED(open(*spNewDatabase));
+
+	m_databases[key] = spNewDatabase;
+	spDatabase = spNewDatabase;
+
+	return MSV_SUCCESS;
+}
+
+size_t MsvActiveConfigRegistry::GetDatabaseCount() const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	size_t count = 0;
+	for (std::map<std::pair<std::string, std::string>, std::weak_ptr<MsvActiveConfigDatabase>>::const_iterator it = m_databases.begin(); it != m_databases.end(); ++it)
+	{
+		count += it->second.expired() ? 0 : 1;
+	}
+
+	return count;
+}
+
+
+/********************************************************************************************************************************
+*															MsvActiveConfigRegistry protected methods
+********************************************************************************************************************************/
+
+
+std::pair<std::string, std::string> MsvActiveConfigRegistry::GetKey(const char* configPath, const char* groupName)
+{
+	//the same file might be opened by different paths (relative, absolute, with "..", etc.)
+	//(path is made absolute first, not existing file would keep relative path otherwise)
+	std::error_code errorCode;
+	std::filesystem::path canonicalPath = std::filesystem::absolute(std::filesystem::path(configPath), errorCode);
+	if (!errorCode)
+	{
+		canonicalPath = std::filesystem::weakly_canonical(canonicalPath, errorCode);
+	}
+
+	return std::make_pair(errorCode ? std::string(configPath) : canonicalPath.string(), std::string(groupName));
+}
+
+
+/** @} */	//End of group MCONFIG.
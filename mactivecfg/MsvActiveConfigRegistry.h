@@ -0,0 +1,259 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Active Config Registry
+* @details		Process-wide registry of active config databases shared by @ref MsvActiveConfig instances.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_ACTIVECONFIGREGISTRY_H
+#define MARSTECH_ACTIVECONFIGREGISTRY_H
+
+
+#include "IMsvActiveConfigStorage.h"
+#include "MsvActiveConfigDerived.h"
+#include "MsvActiveConfigJournal.h"
+#include "MsvActiveConfigWriteLock.h"
+#include "mconfig/common/IMsvConfigKeyMap.h"
+#include "mconfig/common/IMsvDefaultValue.h"
+#include "mconfig/common/MsvChangeNotifier.h"
+#include "mconfig/common/MsvConfigSnapshot.h"
+#include "mconfig/common/MsvCopyOnWrite.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Storage open retry delay.
+* @details	First delay (in milliseconds) before snapshot verification retries failed storage open (it is
+*				doubled after each failure up to @ref MSV_ACTIVECONFIG_STORAGE_RETRY_MAX_MS).
+******************************************************************************************************/
+#define MSV_ACTIVECONFIG_STORAGE_RETRY_MS 100
+
+/**************************************************************************************************//**
+* @brief		Storage open max retry delay.
+* @details	Max delay (in milliseconds) between retries of failed storage open.
+******************************************************************************************************/
+#define MSV_ACTIVECONFIG_STORAGE_RETRY_MAX_MS 5000
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Database.
+* @details	State shared by all active config instances opened on the same database and group (one storage,
+*				one connection and one value cache). Storage is uninitialized when the last instance releases it.
+* @see		MsvActiveConfigRegistry
+******************************************************************************************************/
+struct MsvActiveConfigDatabase
+{
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	******************************************************************************************************/
+	MsvActiveConfigDatabase();
+
+	/**************************************************************************************************//**
+	* @brief		Destructor.
+	* @details	Stops retries of storage open, waits for snapshot verification and uninitializes shared storage.
+	******************************************************************************************************/
+	~MsvActiveConfigDatabase();
+
+	/**************************************************************************************************//**
+	* @brief			Wait for verification.
+	* @details		Waits until snapshot verification is done (storage is opened) or until its storage open has
+	*					failed (open is retried in background). It returns immediately when database has not been
+	*					loaded from snapshot.
+	* @retval		other_error_code	Error of last failed storage open (storage is not opened yet).
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	MsvErrorCode WaitForVerification();
+
+	/**************************************************************************************************//**
+	* @brief			Record change.
+	* @details		Increments database version, sets it as version of config ID, stores change to journal and
+	*					wakes change waiters and notifiers. Derived values depending on config ID are recomputed.
+	*					It is called once per changed value (after value cache has been updated).
+	* @param[in]	cfgId			Changed config ID.
+	* @param[in]	newValue		New value of config ID.
+	******************************************************************************************************/
+	void RecordChange(int32_t cfgId, MsvConfigValue&& newValue);
+
+	/**************************************************************************************************//**
+	* @brief			Get version.
+	* @returns		Current database version (version of last change, zero when nothing has been changed).
+	******************************************************************************************************/
+	uint64_t GetVersion();
+
+	/**************************************************************************************************//**
+	* @brief			Wait for change.
+	* @details		Waits until version of some config ID is greater than since version, until waiter has released
+	*					database or until timeout elapses.
+	* @param[in]	cfgIds			Config IDs to wait for.
+	* @param[in]	sinceVersion	Version which has been already seen.
+	* @param[in]	timeoutMs		Timeout in milliseconds (@ref MSV_ACTIVECONFIG_WAIT_INFINITE waits without timeout).
+	* @param[in]	released			Returns true when instance of waiter does not use database anymore (it is checked
+	*										under change lock, instance calls @ref WakeWaiters after it is set).
+	* @returns		The highest version of config IDs when some of them has been changed, since version on timeout
+	*					(or release).
+	******************************************************************************************************/
+	uint64_t WaitForChange(const std::vector<int32_t>& cfgIds, uint64_t sinceVersion, uint32_t timeoutMs, const std::function<bool()>& released);
+
+	/**************************************************************************************************//**
+	* @brief		Wake waiters.
+	* @details	Wakes all change waiters, so they check whether their instance has released database (it is
+	*				called by instance which has been retargeted or uninitialized).
+	******************************************************************************************************/
+	void WakeWaiters();
+
+	/**************************************************************************************************//**
+	* @brief			Poll changes.
+	* @details		Returns journaled changes made after last sequence (sequence is database version).
+	* @param[in]	lastSequence	Sequence number of last change seen by consumer.
+	* @param[out]	changes			Changes made after last sequence.
+	* @param[out]	sequence			Sequence number of last change.
+	* @retval		MSV_NOT_FOUND_ERROR		When changes after last sequence are not in journal anymore (resync).
+	* @retval		MSV_SUCCESS					On success.
+	* @see			MsvActiveConfigJournal::Poll
+	******************************************************************************************************/
+	MsvErrorCode PollChanges(uint64_t lastSequence, std::vector<MsvConfigValueJournalEntry>& changes, uint64_t& sequence);
+
+	std::shared_ptr<IMsvActiveConfigStorage> m_spStorage;		//!< Shared storage (and its database connection).
+	std::shared_ptr<IMsvConfigKeyMap<IMsvDefaultValue>> m_spConfigKeyMap;	//!< Config key map (types of all config IDs).
+	std::string m_configPath;												//!< Path to active config database.
+	std::string m_groupName;												//!< Active config group name.
+	bool m_lazy;																//!< Values are loaded on first access (true) or when database is opened (false).
+	uint64_t m_snapshotRevision;											//!< Storage revision of loaded snapshot.
+	bool m_verifyPending;													//!< Cache has been loaded from snapshot and verification has not been started yet.
+	bool m_verifying;															//!< Cache has been loaded from snapshot and it is not verified yet (storage is not opened).
+	MsvErrorCode m_storageError;											//!< Error of last storage open made by verification (MSV_SUCCESS when storage is opened).
+	bool m_stopVerify;														//!< Database is being destroyed -> verification stops retrying storage open.
+	std::mutex m_verifyLock;												//!< Locks verification flags.
+	std::condition_variable m_verifyCondition;						//!< Signals end of verification.
+	std::thread m_verifyThread;											//!< Verifies snapshot against storage (opens storage in background).
+	MsvCallbackList<IMsvActiveConfigStorageCallback> m_callbacks;	//!< Storage callbacks of instances using database (notified about differences found by verification).
+	std::mutex m_changeLock;												//!< Locks versions and journal.
+	std::condition_variable m_changeCondition;						//!< Signals new change (change waiters check their config IDs).
+	uint64_t m_version;														//!< Database version (incremented by each change).
+	std::map<int32_t, uint64_t> m_keyVersions;						//!< Versions of changed config IDs (version of their last change).
+	MsvActiveConfigJournal m_journal;									//!< Journal of last changes (their sequences are versions).
+	MsvCallbackList<MsvChangeNotifier> m_notifiers;				//!< Change notifiers of instances using database (pollable handles).
+	MsvCallbackList<MsvActiveConfigDerived> m_derivedValues;	//!< Derived values of instances using database (recomputed when their dependency has been changed).
+	std::mutex m_loadLock;													//!< Serializes lazy loads (concurrent first accesses load value only once).
+	MsvActiveConfigWriteLock m_writeLock;							//!< Serializes writes of one key shard (or all writes exclusively) and their notifications of all instances.
+	mutable std::shared_mutex m_valuesLock;						//!< Reader/writer lock of value cache (it is never held while callbacks are called).
+	std::map<int32_t, bool> m_boolValues;							//!< Cache of bool values.
+	std::map<int32_t, double> m_doubleValues;						//!< Cache of double values.
+	std::map<int32_t, int64_t> m_integerValues;					//!< Cache of int64_t values.
+	std::map<int32_t, std::shared_ptr<const std::string>> m_stringValues;	//!< Cache of string values (shared with storage and callbacks, they are never changed).
+	std::map<int32_t, uint64_t> m_unsignedValues;				//!< Cache of uint64_t values.
+	MsvConfigSnapshotCache m_snapshot;									//!< Snapshot of value cache (invalidated under exclusive values lock, published under shared one).
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Database Open Function.
+* @details	Opens storage and loads value cache of new database (it is called only for first instance).
+******************************************************************************************************/
+typedef std::function<MsvErrorCode(MsvActiveConfigDatabase& database)> MsvActiveConfigDatabaseOpen;
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Registry.
+* @details	Process-wide registry of opened databases keyed by canonical path and group. Databases are held
+*				weakly, so they live only while some active config uses them.
+******************************************************************************************************/
+class MsvActiveConfigRegistry
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Get registry.
+	* @returns		Process-wide registry.
+	******************************************************************************************************/
+	static MsvActiveConfigRegistry& Get();
+
+	/**************************************************************************************************//**
+	* @brief			Get database.
+	* @details		Returns database already opened by other instance or opens new one (concurrent first
+	*					access opens it only once).
+	* @param[in]	configPath		Path to active config database.
+	* @param[in]	groupName		Active config group name.
+	* @param[in]	open				Function which opens new database.
+	* @param[out]	spDatabase		Shared database.
+	* @retval		MSV_ALREADY_EXISTS_INFO		When database has been already opened (this is info, not error).
+	* @retval		MSV_ALLOCATION_ERROR			When memory allocation failed.
+	* @retval		other_error_code				Error code returned by open.
+	* @retval		MSV_SUCCESS						On success (new database has been opened).
+	******************************************************************************************************/
+	MsvErrorCode GetDatabase(const char* configPath, const char* groupName, MsvActiveConfigDatabaseOpen open, std::shared_ptr<MsvActiveConfigDatabase>& spDatabase);
+
+	/**************************************************************************************************//**
+	* @brief			Get database count.
+	* @returns		Count of currently opened databases.
+	******************************************************************************************************/
+	size_t GetDatabaseCount() const;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Get key.
+	* @details		Returns canonical path (or path itself when it can not be resolved) and group.
+	* @param[in]	configPath		Path to active config database.
+	* @param[in]	groupName		Active config group name.
+	* @returns		Registry key.
+	******************************************************************************************************/
+	static std::pair<std::string, std::string> GetKey(const char* configPath, const char* groupName);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Registry mutex.
+	* @details	Locks registry (it is held while new database is opened).
+	******************************************************************************************************/
+	mutable std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Databases.
+	* @details	Opened databases (weak pointers, expired entries are removed on next access).
+	******************************************************************************************************/
+	std::map<std::pair<std::string, std::string>, std::weak_ptr<MsvActiveConfigDatabase>> m_databases;
+};
+
+
+#endif // !MARSTECH_ACTIVECONFIGREGISTRY_H
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,385 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Active Config Sharded Storage
+* @details		Active configuration storage spread across more SQLite files.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "MsvActiveConfigShardedStorage.h"
+#include "MsvActiveConfigWriteLock.h"
+
+#include "mconfig/common/MsvConfigKeyMapBase.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvActiveConfigShardedStorage::MsvActiveConfigShardedStorage(const std::vector<std::shared_ptr<IMsvActiveConfigStorage>>& partitions, std::shared_ptr<MsvLogger> spLogger):
+	m_partitions(partitions),
+	m_initialized(false),
+	m_spLogger(spLogger)
+{
+
+}
+
+MsvActiveConfigShardedStorage::~MsvActiveConfigShardedStorage()
+{
+	Uninitialize();
+}
+
+
+/********************************************************************************************************************************
+*															MsvActiveConfigShardedStorage public methods
+********************************************************************************************************************************/
+
+
+std::string MsvActiveConfigShardedStorage::GetPartitionPath(const char* configPath, size_t partition)
+{
+	return partition == 0 ? std::string(configPath) : std::string(configPath) + ".shard" + std::to_string(partition);
+}
+
+
+/********************************************************************************************************************************
+*															IMsvActiveConfigStorage public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvActiveConfigShardedStorage::Initialize(const std::shared_ptr<IMsvConfigKeyMap<IMsvDefaultValue>> spConfigKeyMap, const char* configPath, const char* groupName)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	MSV_LOG_INFO(m_spLogger, "Initializing active configuration sharded storage (configPath: \"{}\", groupName: \"{}\", partitions: {}).", configPath, groupName, m_partitions.size());
+
+	if (Initialized())
+	{
+		MSV_LOG_INFO(m_spLogger, "Active configuration sharded storage has been already initialized.");
+		return MSV_ALREADY_INITIALIZED_INFO;
+	}
+
+	if (m_partitions.empty() || !spConfigKeyMap)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration sharded storage has no partitions or config key map - error: {0:x}", MSV_INVALID_DATA_ERROR);
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	//the first partition keeps all keys (it is database created without partitions)
+	MsvErrorCode errorCode = m_partitions.front()->Initialize(spConfigKeyMap, configPath, groupName);
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Initialize active configuration partition 0 failed with error: {0:x}", errorCode);
+		return errorCode;
+	}
+
+	for (size_t i = 1; i < m_partitions.size() && MSV_SUCCEEDED(errorCode); ++i)
+	{
+		std::shared_ptr<MsvConfigKeyMapBase<IMsvDefaultValue>> spPartitionKeyMap(new (std::nothrow) MsvConfigKeyMapBase<IMsvDefaultValue>());
+		if (!spPartitionKeyMap)
+		{
+			errorCode = MSV_ALLOCATION_ERROR;
+			break;
+		}
+
+		const std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>& keyMap = spConfigKeyMap->GetMap();
+		for (std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>::const_iterator it = keyMap.begin(); it != keyMap.end(); ++it)
+		{
+			if (MsvActiveConfigWriteLock::GetShard(it->first, m_partitions.size()) == i)
+			{
+				spPartitionKeyMap->InsertKeyData(it->first, it->second);
+			}
+		}
+
+		std::string partitionPath = GetPartitionPath(configPath, i);
+		errorCode = m_partitions[i]->Initialize(spPartitionKeyMap, partitionPath.c_str(), groupName);
+		if (errorCode == MSV_SUCCESS)
+		{
+			//table has been created (it has default values) -> move values stored before partitioning
+			errorCode = FillPartition(*m_partitions[i], spPartitionKeyMap->GetMap());
+		}
+
+		if (MSV_FAILED(errorCode))
+		{
+			MSV_LOG_ERROR(m_spLogger, "Initialize active configuration partition {} failed with error: {:x}", i, errorCode);
+		}
+	}
+
+	if (MSV_FAILED(errorCode))
+	{
+		//partial storage is not usable
+		for (std::vector<std::shared_ptr<IMsvActiveConfigStorage>>::iterator it = m_partitions.begin(); it != m_partitions.end(); ++it)
+		{
+			(*it)->Uninitialize();
+		}
+
+		return errorCode;
+	}
+
+	m_initialized = true;
+
+	MSV_LOG_INFO(m_spLogger, "Active configuration sharded storage has been successfully initialized.");
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfigShardedStorage::Uninitialize()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	if (!Initialized())
+	{
+		return MSV_NOT_INITIALIZED_INFO;
+	}
+
+	//all partitions are closed (the first error is returned)
+	MsvErrorCode result = MSV_SUCCESS;
+	for (std::vector<std::shared_ptr<IMsvActiveConfigStorage>>::iterator it = m_partitions.begin(); it != m_partitions.end(); ++it)
+	{
+		MsvErrorCode errorCode = (*it)->Uninitialize();
+		if (MSV_FAILED(errorCode) && MSV_SUCCEEDED(result))
+		{
+			result = errorCode;
+		}
+	}
+
+	m_initialized = false;
+
+	return result;
+}
+
+bool MsvActiveConfigShardedStorage::Initialized() const
+{
+	return m_initialized;
+}
+
+MsvErrorCode MsvActiveConfigShardedStorage::GetValue(int32_t cfgId, bool& value) const
+{
+	return GetPartition(cfgId).GetValue(cfgId, value);
+}
+
+MsvErrorCode MsvActiveConfigShardedStorage::GetValue(int32_t cfgId, double& value) const
+{
+	return GetPartition(cfgId).GetValue(cfgId, value);
+}
+
+MsvErrorCode MsvActiveConfigShardedStorage::GetValue(int32_t cfgId, int64_t& value) const
+{
+	return GetPartition(cfgId).GetValue(cfgId, value);
+}
+
+MsvErrorCode MsvActiveConfigShardedStorage::GetValue(int32_t cfgId, std::string& value) const
+{
+	return GetPartition(cfgId).GetValue(cfgId, value);
+}
+
+MsvErrorCode MsvActiveConfigShardedStorage::GetValue(int32_t cfgId, uint64_t& value) const
+{
+	return GetPartition(cfgId).GetValue(cfgId, value);
+}
+
+MsvErrorCode MsvActiveConfigShardedStorage::StoreValue(int32_t cfgId, bool value)
+{
+	return GetPartition(cfgId).StoreValue(cfgId, value);
+}
+
+MsvErrorCode MsvActiveConfigShardedStorage::StoreValue(int32_t cfgId, double value)
+{
+	return GetPartition(cfgId).StoreValue(cfgId, value);
+}
+
+MsvErrorCode MsvActiveConfigShardedStorage::StoreValue(int32_t cfgId, int64_t value)
+{
+	return GetPartition(cfgId).StoreValue(cfgId, value);
+}
+
+MsvErrorCode MsvActiveConfigShardedStorage::StoreValue(int32_t cfgId, const std::string& value)
+{
+	return GetPartition(cfgId).StoreValue(cfgId, value);
+}
+
+MsvErrorCode MsvActiveConfigShardedStorage::StoreValue(int32_t cfgId, std::string&& value)
+{
+	return GetPartition(cfgId).StoreValue(cfgId, std::move(value));
+}
+
+MsvErrorCode MsvActiveConfigShardedStorage::StoreValue(int32_t cfgId, const std::shared_ptr<const std::string>& spValue)
+{
+	return GetPartition(cfgId).StoreValue(cfgId, spValue);
+}
+
+MsvErrorCode MsvActiveConfigShardedStorage::StoreValue(int32_t cfgId, uint64_t value)
+{
+	return GetPartition(cfgId).StoreValue(cfgId, value);
+}
+
+MsvErrorCode MsvActiveConfigShardedStorage::RegisterCallback(std::shared_ptr<IMsvActiveConfigStorageCallback> spCallback)
+{
+	//partitions notify their changes directly (notification does not pass through this storage)
+	MsvErrorCode result = MSV_SUCCESS;
+	for (std::vector<std::shared_ptr<IMsvActiveConfigStorage>>::iterator it = m_partitions.begin(); it != m_partitions.end(); ++it)
+	{
+		MsvErrorCode errorCode = (*it)->RegisterCallback(spCallback);
+		if (MSV_FAILED(errorCode))
+		{
+			//callback is registered everywhere or nowhere
+			for (std::vector<std::shared_ptr<IMsvActiveConfigStorage>>::iterator registeredIt = m_partitions.begin(); registeredIt != it; ++registeredIt)
+			{
+				(*registeredIt)->UnregisterCallback(spCallback);
+			}
+
+			return errorCode;
+		}
+
+		result = errorCode;
+	}
+
+	return result;
+}
+
+MsvErrorCode MsvActiveConfigShardedStorage::UnregisterCallback(std::shared_ptr<IMsvActiveConfigStorageCallback> spCallback)
+{
+	MsvErrorCode result = MSV_SUCCESS;
+	for (std::vector<std::shared_ptr<IMsvActiveConfigStorage>>::iterator it = m_partitions.begin(); it != m_partitions.end(); ++it)
+	{
+		MsvErrorCode errorCode = (*it)->UnregisterCallback(spCallback);
+		if (MSV_FAILED(errorCode) && MSV_SUCCEEDED(result))
+		{
+			result = errorCode;
+		}
+	}
+
+	return result;
+}
+
+void MsvActiveConfigShardedStorage::SetCallbackBudget(uint32_t budgetUs)
+{
+	for (std::vector<std::shared_ptr<IMsvActiveConfigStorage>>::iterator it = m_partitions.begin(); it != m_partitions.end(); ++it)
+	{
+		(*it)->SetCallbackBudget(budgetUs);
+	}
+}
+
+void MsvActiveConfigShardedStorage::GetCallbackReport(std::vector<MsvCallbackReport>& report) const
+{
+	//each partition measures its own notifications -> reports of the same callback are merged
+	std::map<const void*, MsvCallbackReport> reports;
+	for (std::vector<std::shared_ptr<IMsvActiveConfigStorage>>::const_iterator it = m_partitions.begin(); it != m_partitions.end(); ++it)
+	{
+		std::vector<MsvCallbackReport> partitionReport;
+		(*it)->GetCallbackReport(partitionReport);
+
+		for (std::vector<MsvCallbackReport>::const_iterator reportIt = partitionReport.begin(); reportIt != partitionReport.end(); ++reportIt)
+		{
+			std::map<const void*, MsvCallbackReport>::iterator mergedIt = reports.find(reportIt->m_pCallback);
+			if (mergedIt == reports.end())
+			{
+				reports.emplace(reportIt->m_pCallback, *reportIt);
+				continue;
+			}
+
+			mergedIt->second.m_callCount += reportIt->m_callCount;
+			mergedIt->second.m_slowCallCount += reportIt->m_slowCallCount;
+			mergedIt->second.m_totalTime += reportIt->m_totalTime;
+			mergedIt->second.m_maxTime = std::max(mergedIt->second.m_maxTime, reportIt->m_maxTime);
+			mergedIt->second.m_quarantined = mergedIt->second.m_quarantined || reportIt->m_quarantined;
+		}
+	}
+
+	report.clear();
+	report.reserve(reports.size());
+	for (std::map<const void*, MsvCallbackReport>::const_iterator it = reports.begin(); it != reports.end(); ++it)
+	{
+		report.push_back(it->second);
+	}
+
+	std::sort(report.begin(), report.end(), [](const MsvCallbackReport& first, const MsvCallbackReport& second) { return first.m_totalTime > second.m_totalTime; });
+}
+
+
+/********************************************************************************************************************************
+*															MsvActiveConfigShardedStorage protected methods
+********************************************************************************************************************************/
+
+
+IMsvActiveConfigStorage& MsvActiveConfigShardedStorage::GetPartition(int32_t cfgId) const
+{
+	return *m_partitions[MsvActiveConfigWriteLock::GetShard(cfgId, m_partitions.size())];
+}
+
+MsvErrorCode MsvActiveConfigShardedStorage::FillPartition(IMsvActiveConfigStorage& partition, const std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>& keyMap)
+{
+	for (std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>::const_iterator it = keyMap.begin(); it != keyMap.end(); ++it)
+	{
+		MsvErrorCode errorCode = MSV_SUCCESS;
+		if (it->second->IsBool())
+		{
+			errorCode = CopyValue<bool>(partition, it->first);
+		}
+		else if (it->second->IsDouble())
+		{
+			errorCode = CopyValue<double>(partition, it->first);
+		}
+		else if (it->second->IsInteger())
+		{
+			errorCode = CopyValue<int64_t>(partition, it->first);
+		}
+		else if (it->second->IsString())
+		{
+			errorCode = CopyValue<std::string>(partition, it->first);
+		}
+		else if (it->second->IsUnsigned())
+		{
+			errorCode = CopyValue<uint64_t>(partition, it->first);
+		}
+
+		MSV_RETURN_FAILED(errorCode);
+	}
+
+	return MSV_SUCCESS;
+}
+
+template<class T> MsvErrorCode MsvActiveConfigShardedStorage::CopyValue(IMsvActiveConfigStorage& partition, int32_t cfgId)
+{
+	//the first partition has all keys (missing value is its default value)
+	T value = T();
+	MSV_RETURN_FAILED(m_partitions.front()->GetValue(cfgId, value));
+
+	return partition.StoreValue(cfgId, value);
+}
+
+/** @} */	//End of group MCONFIG.
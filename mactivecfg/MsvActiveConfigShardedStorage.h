@@ -0,0 +1,250 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Active Config Sharded Storage
+* @details		Active configuration storage spread across more SQLite files.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_ACTIVECONFIGSHARDEDSTORAGE_H
+#define MARSTECH_ACTIVECONFIGSHARDEDSTORAGE_H
+
+
+#include "IMsvActiveConfigStorage.h"
+
+#include "mlogging/mlogging.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Sharded Storage.
+* @details	Spreads values across partitions (each partition is own storage with own SQLite file and
+*				connection), so writes of different partitions do not wait for each other. Partition of config
+*				ID is its write shard (@ref MsvActiveConfigWriteLock::GetShard). The first partition uses config
+*				path itself and it keeps all keys (values of database created without partitions stay there), other
+*				partitions use @ref GetPartitionPath. New partition is filled with values from the first one.
+* @warning	Count of partitions must not be changed for existing database (values of moved keys would be read
+*				from other partition).
+* @see		IMsvActiveConfigStorage
+******************************************************************************************************/
+class MsvActiveConfigShardedStorage:
+	public IMsvActiveConfigStorage
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	partitions		Uninitialized partition storages (at least one).
+	* @param[in]	spLogger			Shared pointer to logger for logging.
+	******************************************************************************************************/
+	MsvActiveConfigShardedStorage(const std::vector<std::shared_ptr<IMsvActiveConfigStorage>>& partitions, std::shared_ptr<MsvLogger> spLogger = nullptr);
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvActiveConfigShardedStorage();
+
+	/**************************************************************************************************//**
+	* @brief			Get partition path.
+	* @param[in]	configPath		Path to active config database.
+	* @param[in]	partition		Partition index.
+	* @returns		Path to SQLite file of partition (config path for the first partition).
+	******************************************************************************************************/
+	static std::string GetPartitionPath(const char* configPath, size_t partition);
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvActiveConfigStorage public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::Initialize(const std::shared_ptr<IMsvConfigKeyMap<IMsvDefaultValue>> spConfigKeyMap, const char* configPath, const char* groupName)
+	******************************************************************************************************/
+	virtual MsvErrorCode Initialize(const std::shared_ptr<IMsvConfigKeyMap<IMsvDefaultValue>> spConfigKeyMap, const char* configPath = "config.db", const char* groupName = "MsvConfig") override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::Uninitialize()
+	******************************************************************************************************/
+	virtual MsvErrorCode Uninitialize() override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::Initialized() const
+	******************************************************************************************************/
+	virtual bool Initialized() const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::GetValue(int32_t cfgId, bool& value) const
+	******************************************************************************************************/
+	virtual MsvErrorCode GetValue(int32_t cfgId, bool& value) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::GetValue(int32_t cfgId, double& value) const
+	******************************************************************************************************/
+	virtual MsvErrorCode GetValue(int32_t cfgId, double& value) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::GetValue(int32_t cfgId, int64_t& value) const
+	******************************************************************************************************/
+	virtual MsvErrorCode GetValue(int32_t cfgId, int64_t& value) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::GetValue(int32_t cfgId, std::string& value) const
+	******************************************************************************************************/
+	virtual MsvErrorCode GetValue(int32_t cfgId, std::string& value) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::GetValue(int32_t cfgId, uint64_t& value) const
+	******************************************************************************************************/
+	virtual MsvErrorCode GetValue(int32_t cfgId, uint64_t& value) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::StoreValue(int32_t cfgId, bool value)
+	******************************************************************************************************/
+	virtual MsvErrorCode StoreValue(int32_t cfgId, bool value) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::StoreValue(int32_t cfgId, double value)
+	******************************************************************************************************/
+	virtual MsvErrorCode StoreValue(int32_t cfgId, double value) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::StoreValue(int32_t cfgId, int64_t value)
+	******************************************************************************************************/
+	virtual MsvErrorCode StoreValue(int32_t cfgId, int64_t value) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::StoreValue(int32_t cfgId, const std::string& value)
+	******************************************************************************************************/
+	virtual MsvErrorCode StoreValue(int32_t cfgId, const std::string& value) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::StoreValue(int32_t cfgId, std::string&& value)
+	******************************************************************************************************/
+	virtual MsvErrorCode StoreValue(int32_t cfgId, std::string&& value) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::StoreValue(int32_t cfgId, const std::shared_ptr<const std::string>& spValue)
+	******************************************************************************************************/
+	virtual MsvErrorCode StoreValue(int32_t cfgId, const std::shared_ptr<const std::string>& spValue) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::StoreValue(int32_t cfgId, uint64_t value)
+	******************************************************************************************************/
+	virtual MsvErrorCode StoreValue(int32_t cfgId, uint64_t value) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::RegisterCallback(std::shared_ptr<IMsvActiveConfigStorageCallback> spCallback)
+	******************************************************************************************************/
+	virtual MsvErrorCode RegisterCallback(std::shared_ptr<IMsvActiveConfigStorageCallback> spCallback) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::UnregisterCallback(std::shared_ptr<IMsvActiveConfigStorageCallback> spCallback)
+	******************************************************************************************************/
+	virtual MsvErrorCode UnregisterCallback(std::shared_ptr<IMsvActiveConfigStorageCallback> spCallback) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::SetCallbackBudget(uint32_t budgetUs)
+	******************************************************************************************************/
+	virtual void SetCallbackBudget(uint32_t budgetUs) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::GetCallbackReport(std::vector<MsvCallbackReport>& report) const
+	******************************************************************************************************/
+	virtual void GetCallbackReport(std::vector<MsvCallbackReport>& report) const override;
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											MsvActiveConfigShardedStorage protected methods
+	**---------------------------------------------------------------------------------------------------*/
+protected:
+	/**************************************************************************************************//**
+	* @brief			Get partition.
+	* @param[in]	cfgId		Config ID.
+	* @returns		Partition storage of config ID.
+	******************************************************************************************************/
+	IMsvActiveConfigStorage& GetPartition(int32_t cfgId) const;
+
+	/**************************************************************************************************//**
+	* @brief			Fill partition.
+	* @details		Copies values of partition keys from the first partition (migration of database created
+	*					without partitions).
+	* @param[in]	partition		New partition.
+	* @param[in]	keyMap			Config keys of partition.
+	* @retval		other_error_code	Error code returned by partition.
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	MsvErrorCode FillPartition(IMsvActiveConfigStorage& partition, const std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>& keyMap);
+
+	/**************************************************************************************************//**
+	* @brief			Copy value.
+	* @details		Copies value from the first partition to partition.
+	* @param[in]	partition		Target partition.
+	* @param[in]	cfgId				Config ID.
+	* @retval		other_error_code	Error code returned by partition.
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	template<class T> MsvErrorCode CopyValue(IMsvActiveConfigStorage& partition, int32_t cfgId);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Storage mutex.
+	* @details	Serializes initialization (values are read and stored by partitions, they lock themselves).
+	******************************************************************************************************/
+	std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Partitions.
+	* @details	Partition storages (immutable, partition of config ID is its write shard).
+	******************************************************************************************************/
+	std::vector<std::shared_ptr<IMsvActiveConfigStorage>> m_partitions;
+
+	/**************************************************************************************************//**
+	* @brief		Initialize flag.
+	* @details	Flag if all partitions are initialized (true) or not (false).
+	******************************************************************************************************/
+	std::atomic<bool> m_initialized;
+
+	/**************************************************************************************************//**
+	* @brief		Logger.
+	* @details	Shared pointer to logger for logging.
+	******************************************************************************************************/
+	std::shared_ptr<MsvLogger> m_spLogger;
+};
+
+
+#endif // !MARSTECH_ACTIVECONFIGSHARDEDSTORAGE_H
+
+/** @} */	//End of group MCONFIG.
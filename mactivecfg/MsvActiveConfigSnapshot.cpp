@@ -0,0 +1,422 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Active Config Snapshot
+* @details		Contains definition of @ref MsvActiveConfigSnapshot which saves and loads binary snapshot of active config cache.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "MsvActiveConfigSnapshot.h"
+#include "MsvActiveConfigShardedStorage.h"
+
+#include "mconfig/common/MsvChecksum.h"
+#include "mconfig/common/MsvMappedFile.h"
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															MsvActiveConfigSnapshot public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvActiveConfigSnapshot::Save(const char* snapshotPath, const MsvActiveConfigDatabase& database)
+{
+	if (!snapshotPath || !database.m_spConfigKeyMap)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	MsvActiveConfigSnapshotHeader header;
+	memset(&header, 0, sizeof(header));
+	header.m_magic = MSV_ACTIVECONFIG_SNAPSHOT_MAGIC;
+	header.m_version = MSV_ACTIVECONFIG_SNAPSHOT_VERSION;
+	MSV_RETURN_FAILED(ComputeKeyMapChecksum(database, header.m_keyMapChecksum));
+
+	//unknown revision -> snapshot is always fully verified
+	if (MSV_FAILED(GetStorageRevision(database, header.m_storageRevision)))
+	{
+		header.m_storageRevision = 0;
+	}
+
+	//config key map is sorted by config ID -> entries are sorted as well
+	const std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>& configKeys = database.m_spConfigKeyMap->GetMap();
+	std::vector<MsvActiveConfigSnapshotEntry> entries;
+	std::string stringPool;
+	entries.reserve(configKeys.size());
+
+	{
+		std::shared_lock<std::shared_mutex> valuesLock(database.m_valuesLock);
+
+		for (std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>::const_iterator it = configKeys.begin(); it != configKeys.end(); ++it)
+		{
+			MsvActiveConfigSnapshotEntry entry;
+			memset(&entry, 0, sizeof(entry));
+			entry.m_cfgId = it->first;
+
+			if (it->second->IsBool())
+			{
+				std::map<int32_t, bool>::const_iterator valueIt = database.m_boolValues.find(it->first);
+				if (valueIt == database.m_boolValues.end())
+				{
+					return MSV_NOT_FOUND_ERROR;
+				}
+
+				entry.m_type = static_cast<uint32_t>(MsvActiveConfigSnapshotType::MSV_SNAPSHOT_BOOL);
+				entry.m_value = valueIt->second ? 1 : 0;
+			}
+			else if (it->second->IsDouble())
+			{
+				std::map<int32_t, double>::const_iterator valueIt = database.m_doubleValues.find(it->first);
+				if (valueIt == database.m_doubleValues.end())
+				{
+					return MSV_NOT_FOUND_ERROR;
+				}
+
+				entry.m_type = static_cast<uint32_t>(MsvActiveConfigSnapshotType::MSV_SNAPSHOT_DOUBLE);
+				memcpy(&entry.m_value, &valueIt->second, sizeof(valueIt->second));
+			}
+			else if (it->second->IsInteger())
+			{
+				std::map<int32_t, int64_t>::const_iterator valueIt = database.m_integerValues.find(it->first);
+				if (valueIt == database.m_integerValues.end())
+				{
+					return MSV_NOT_FOUND_ERROR;
+				}
+
+				entry.m_type = static_cast<uint32_t>(MsvActiveConfigSnapshotType::MSV_SNAPSHOT_INTEGER);
+				entry.m_value = static_cast<uint64_t>(valueIt->second);
+			}
+			else if (it->second->IsString())
+			{
+				std::map<int32_t, std::shared_ptr<const std::string>>::const_iterator valueIt = database.m_stringValues.find(it->first);
+				if (valueIt == database.m_stringValues.end())
+				{
+					return MSV_NOT_FOUND_ERROR;
+				}
+
+				entry.m_type = static_cast<uint32_t>(MsvActiveConfigSnapshotType::MSV_SNAPSHOT_STRING);
+				entry.m_value = stringPool.size();
+				entry.m_size = valueIt->second->size();
+				stringPool.append(*valueIt->second);
+				stringPool.push_back('\0');
+			}
+			else if (it->second->IsUnsigned())
+			{
+				std::map<int32_t, uint64_t>::const_iterator valueIt = database.m_unsignedValues.find(it->first);
+				if (valueIt == database.m_unsignedValues.end())
+				{
+					return MSV_NOT_FOUND_ERROR;
+				}
+
+				entry.m_type = static_cast<uint32_t>(MsvActiveConfigSnapshotType::MSV_SNAPSHOT_UNSIGNED);
+				entry.m_value = valueIt->second;
+			}
+			else
+			{
+				return MSV_UNKNOWN_ERROR;
+			}
+
+			entries.push_back(entry);
+		}
+	}
+
+	//layout: header, entries, string pool
+	header.m_entriesOffset = sizeof(MsvActiveConfigSnapshotHeader);
+	header.m_entryCount = entries.size();
+	header.m_stringPoolOffset = header.m_entriesOffset + entries.size() * sizeof(MsvActiveConfigSnapshotEntry);
+	header.m_stringPoolSize = stringPool.size();
+	header.m_snapshotSize = header.m_stringPoolOffset + header.m_stringPoolSize;
+
+	std::vector<uint8_t> snapshot(static_cast<size_t>(header.m_snapshotSize));
+	if (!entries.empty())
+	{
+		memcpy(snapshot.data() + header.m_entriesOffset, entries.data(), entries.size() * sizeof(MsvActiveConfigSnapshotEntry));
+	}
+	if (!stringPool.empty())
+	{
+		memcpy(snapshot.data() + header.m_stringPoolOffset, stringPool.data(), stringPool.size());
+	}
+
+	header.m_checksum = MsvChecksum::Compute(snapshot.data() + sizeof(MsvActiveConfigSnapshotHeader), snapshot.size() - sizeof(MsvActiveConfigSnapshotHeader));
+	memcpy(snapshot.data(), &header, sizeof(header));
+
+	//temporary file is unique per process (more processes might save the same snapshot at the same time)
+#ifdef _WIN32
+	std::string tempPath = std::string(snapshotPath) + "." + std::to_string(GetCurrentProcessId()) + ".tmp";
+#else
+	std::string tempPath = std::string(snapshotPath) + "." + std::to_string(getpid()) + ".tmp";
+#endif
+
+	std::ofstream snapshotFile(tempPath, std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+	if (!snapshotFile.is_open())
+	{
+		return MSV_OPEN_ERROR;
+	}
+
+	snapshotFile.write(reinterpret_cast<const char*>(snapshot.data()), static_cast<std::streamsize>(snapshot.size()));
+	snapshotFile.close();
+	if (snapshotFile.fail())
+	{
+		remove(tempPath.c_str());
+		return MSV_OPEN_ERROR;
+	}
+
+	//rename replaces snapshot atomically (reader never maps half written snapshot)
+#ifdef _WIN32
+	if (!MoveFileExA(tempPath.c_str(), snapshotPath, MOVEFILE_REPLACE_EXISTING))
+#else
+	if (rename(tempPath.c_str(), snapshotPath) != 0)
+#endif
+	{
+		remove(tempPath.c_str());
+		return MSV_OPEN_ERROR;
+	}
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfigSnapshot::Load(const char* snapshotPath, MsvActiveConfigDatabase& database, uint64_t& storageRevision)
+{
+	if (!snapshotPath || !database.m_spConfigKeyMap)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	MsvMappedFile snapshotFile;
+	MSV_RETURN_FAILED(snapshotFile.Map(snapshotPath));
+
+	const uint8_t* pData = snapshotFile.GetData();
+	size_t size = snapshotFile.GetSize();
+	if (size < sizeof(MsvActiveConfigSnapshotHeader))
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	//check header (all offsets must be inside of snapshot)
+	const MsvActiveConfigSnapshotHeader* pHeader = reinterpret_cast<const MsvActiveConfigSnapshotHeader*>(pData);
+	if (pHeader->m_magic != MSV_ACTIVECONFIG_SNAPSHOT_MAGIC || pHeader->m_version != MSV_ACTIVECONFIG_SNAPSHOT_VERSION || pHeader->m_snapshotSize != size
+		|| pHeader->m_entriesOffset != sizeof(MsvActiveConfigSnapshotHeader) || pHeader->m_entryCount > (size - pHeader->m_entriesOffset) / sizeof(MsvActiveConfigSnapshotEntry)
+		|| pHeader->m_stringPoolOffset != pHeader->m_entriesOffset + pHeader->m_entryCount * sizeof(MsvActiveConfigSnapshotEntry)
+		|| pHeader->m_stringPoolOffset + pHeader->m_stringPoolSize != size)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	if (MsvChecksum::Compute(pData + sizeof(MsvActiveConfigSnapshotHeader), size - sizeof(MsvActiveConfigSnapshotHeader)) != pHeader->m_checksum)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	//snapshot of other group or key map (config IDs or types might be different)
+	uint64_t keyMapChecksum = 0;
+	MSV_RETURN_FAILED(ComputeKeyMapChecksum(database, keyMapChecksum));
+	if (keyMapChecksum != pHeader->m_keyMapChecksum || pHeader->m_entryCount != database.m_spConfigKeyMap->GetMap().size())
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	//values are copied to temporary cache first (database cache is changed only when whole snapshot is valid)
+	MsvActiveConfigDatabase loaded;
+	const MsvActiveConfigSnapshotEntry* pEntries = reinterpret_cast<const MsvActiveConfigSnapshotEntry*>(pData + pHeader->m_entriesOffset);
+	const char* pStringPool = reinterpret_cast<const char*>(pData + pHeader->m_stringPoolOffset);
+
+	for (uint64_t i = 0; i < pHeader->m_entryCount; ++i)
+	{
+		const MsvActiveConfigSnapshotEntry& entry = pEntries[i];
+
+		//sorted unique config IDs of key map -> cache contains each value exactly once
+		if ((i > 0 && pEntries[i - 1].m_cfgId >= entry.m_cfgId) || database.m_spConfigKeyMap->GetMap().find(entry.m_cfgId) == database.m_spConfigKeyMap->GetMap().end())
+		{
+			return MSV_INVALID_DATA_ERROR;
+		}
+
+		switch (static_cast<MsvActiveConfigSnapshotType>(entry.m_type))
+		{
+		case MsvActiveConfigSnapshotType::MSV_SNAPSHOT_BOOL:
+			loaded.m_boolValues[entry.m_cfgId] = (entry.m_value != 0);
+			break;
+		case MsvActiveConfigSnapshotType::MSV_SNAPSHOT_DOUBLE:
+		{
+			double value;
+			memcpy(&value, &entry.m_value, sizeof(value));
+			loaded.m_doubleValues[entry.m_cfgId] = value;
+			break;
+		}
+		case MsvActiveConfigSnapshotType::MSV_SNAPSHOT_INTEGER:
+			loaded.m_integerValues[entry.m_cfgId] = static_cast<int64_t>(entry.m_value);
+			break;
+		case MsvActiveConfigSnapshotType::MSV_SNAPSHOT_STRING:
+			if (entry.m_value >= pHeader->m_stringPoolSize || entry.m_size >= pHeader->m_stringPoolSize - entry.m_value || pStringPool[entry.m_value + entry.m_size] != '\0')
+			{
+				return MSV_INVALID_DATA_ERROR;
+			}
+
+			loaded.m_stringValues[entry.m_cfgId] = std::make_shared<const std::string>(pStringPool + entry.m_value, static_cast<size_t>(entry.m_size));
+			break;
+		case MsvActiveConfigSnapshotType::MSV_SNAPSHOT_UNSIGNED:
+			loaded.m_unsignedValues[entry.m_cfgId] = entry.m_value;
+			break;
+		default:
+			return MSV_INVALID_DATA_ERROR;
+		}
+	}
+
+	{
+		std::unique_lock<std::shared_mutex> valuesLock(database.m_valuesLock);
+		database.m_boolValues.swap(loaded.m_boolValues);
+		database.m_doubleValues.swap(loaded.m_doubleValues);
+		database.m_integerValues.swap(loaded.m_integerValues);
+		database.m_stringValues.swap(loaded.m_stringValues);
+		database.m_unsignedValues.swap(loaded.m_unsignedValues);
+	}
+
+	storageRevision = pHeader->m_storageRevision;
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfigSnapshot::GetStorageRevision(const char* configPath, uint64_t& revision)
+{
+	//SQLite header: magic (16 bytes), ..., file change counter (offset 24) and page count (offset 28), big endian
+	uint8_t header[32];
+	std::ifstream configFile(configPath, std::ifstream::in | std::ifstream::binary);
+	if (!configFile.is_open() || !configFile.read(reinterpret_cast<char*>(header), sizeof(header)))
+	{
+		return MSV_OPEN_ERROR;
+	}
+
+	if (memcmp(header, "SQLite format 3", 16) != 0)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	revision = 0;
+	for (size_t i = 24; i < 32; ++i)
+	{
+		revision = (revision << 8) | header[i];
+	}
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfigSnapshot::GetStorageRevision(const MsvActiveConfigDatabase& database, uint64_t& revision)
+{
+	//change counter is in upper half of partition revision -> sum changes with each write of any partition
+	revision = 0;
+	size_t partitionCount = database.m_writeLock.GetShardCount();
+	for (size_t i = 0; i < partitionCount; ++i)
+	{
+		uint64_t partitionRevision = 0;
+		MSV_RETURN_FAILED(GetStorageRevision(MsvActiveConfigShardedStorage::GetPartitionPath(database.m_configPath.c_str(), i).c_str(), partitionRevision));
+		revision += partitionRevision;
+	}
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvActiveConfigSnapshot::ComputeKeyMapChecksum(const MsvActiveConfigDatabase& database, uint64_t& checksum)
+{
+	checksum = MsvChecksum::INITIAL_VALUE;
+
+	if (!database.m_spConfigKeyMap)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	//strings are hashed with terminating null (to separate them)
+	checksum = MsvChecksum::Compute(database.m_groupName.c_str(), database.m_groupName.size() + 1, checksum);
+
+	const std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>& configKeys = database.m_spConfigKeyMap->GetMap();
+	for (std::map<int32_t, std::shared_ptr<IMsvDefaultValue>>::const_iterator it = configKeys.begin(); it != configKeys.end(); ++it)
+	{
+		std::string defaultValue;
+		MsvActiveConfigSnapshotType type;
+
+		if (it->second->IsBool())
+		{
+			bool value;
+			MSV_RETURN_FAILED(it->second->GetDefaultValue(value));
+			type = MsvActiveConfigSnapshotType::MSV_SNAPSHOT_BOOL;
+			defaultValue = value ? "1" : "0";
+		}
+		else if (it->second->IsDouble())
+		{
+			double value;
+			MSV_RETURN_FAILED(it->second->GetDefaultValue(value));
+			type = MsvActiveConfigSnapshotType::MSV_SNAPSHOT_DOUBLE;
+			defaultValue.assign(reinterpret_cast<const char*>(&value), sizeof(value));
+		}
+		else if (it->second->IsInteger())
+		{
+			int64_t value;
+			MSV_RETURN_FAILED(it->second->GetDefaultValue(value));
+			type = MsvActiveConfigSnapshotType::MSV_SNAPSHOT_INTEGER;
+			defaultValue = std::to_string(value);
+		}
+		else if (it->second->IsString())
+		{
+			MSV_RETURN_FAILED(it->second->GetDefaultValue(defaultValue));
+			type = MsvActiveConfigSnapshotType::MSV_SNAPSHOT_STRING;
+		}
+		else if (it->second->IsUnsigned())
+		{
+			uint64_t value;
+			MSV_RETURN_FAILED(it->second->GetDefaultValue(value));
+			type = MsvActiveConfigSnapshotType::MSV_SNAPSHOT_UNSIGNED;
+			defaultValue = std::to_string(value);
+		}
+		else
+		{
+			return MSV_UNKNOWN_ERROR;
+		}
+
+		checksum = MsvChecksum::Compute(&it->first, sizeof(it->first), checksum);
+		checksum = MsvChecksum::Compute(&type, sizeof(type), checksum);
+		checksum = MsvChecksum::Compute(defaultValue.c_str(), defaultValue.size() + 1, checksum);
+	}
+
+	return MSV_SUCCESS;
+}
+
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,182 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Active Config Snapshot
+* @details		Contains declaration of @ref MsvActiveConfigSnapshot which saves and loads binary snapshot of active config cache.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_ACTIVECONFIGSNAPSHOT_H
+#define MARSTECH_ACTIVECONFIGSNAPSHOT_H
+
+
+#include "MsvActiveConfigRegistry.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstdint>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Snapshot magic.
+* @details	First four bytes of each snapshot ("MSVA").
+******************************************************************************************************/
+#define MSV_ACTIVECONFIG_SNAPSHOT_MAGIC 0x4156534dU
+
+/**************************************************************************************************//**
+* @brief		Snapshot version.
+* @details	Version of snapshot format (it must be increased when format changes).
+******************************************************************************************************/
+#define MSV_ACTIVECONFIG_SNAPSHOT_VERSION 1U
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Snapshot Value Type.
+* @details	Type of value stored in snapshot entry.
+******************************************************************************************************/
+enum class MsvActiveConfigSnapshotType: uint32_t
+{
+	MSV_SNAPSHOT_BOOL = 0,
+	MSV_SNAPSHOT_DOUBLE,
+	MSV_SNAPSHOT_INTEGER,
+	MSV_SNAPSHOT_STRING,
+	MSV_SNAPSHOT_UNSIGNED
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Snapshot Header.
+* @details	Header at the beginning of snapshot. Snapshot layout is: header, entries (sorted by config ID)
+*				and string pool (null terminated strings). All offsets are from the beginning of snapshot.
+* @note		Snapshot uses native byte order and alignment, it is a local cache of active config database
+*				(it must not be shared between different platforms).
+******************************************************************************************************/
+struct MsvActiveConfigSnapshotHeader
+{
+	uint32_t m_magic;							//!< Snapshot magic (@ref MSV_ACTIVECONFIG_SNAPSHOT_MAGIC).
+	uint32_t m_version;						//!< Snapshot version (@ref MSV_ACTIVECONFIG_SNAPSHOT_VERSION).
+	uint64_t m_snapshotSize;				//!< Size of whole snapshot (in bytes).
+	uint64_t m_checksum;						//!< Checksum of snapshot content (everything behind header).
+	uint64_t m_storageRevision;			//!< Revision of storage when snapshot has been saved (0 -> unknown).
+	uint64_t m_keyMapChecksum;				//!< Checksum of group name and config key map (config IDs, types and default values).
+	uint64_t m_entriesOffset;				//!< Offset of entries.
+	uint64_t m_entryCount;					//!< Number of entries.
+	uint64_t m_stringPoolOffset;			//!< Offset of string pool.
+	uint64_t m_stringPoolSize;				//!< Size of string pool (in bytes).
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Snapshot Entry.
+* @details	One cached value. Scalar values are stored directly, strings are stored in string pool.
+******************************************************************************************************/
+struct MsvActiveConfigSnapshotEntry
+{
+	int32_t m_cfgId;							//!< Config ID.
+	uint32_t m_type;							//!< Value type (@ref MsvActiveConfigSnapshotType).
+	uint64_t m_value;							//!< Scalar value (bit copy) or string offset in string pool.
+	uint64_t m_size;							//!< String length (without terminating null), 0 for scalar values.
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Snapshot.
+* @details	Saves value cache of active config database to binary snapshot and loads it back (snapshot is
+*				mapped, checked and copied to cache). Snapshot lets config serve reads before storage is opened.
+******************************************************************************************************/
+class MsvActiveConfigSnapshot
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Save snapshot.
+	* @details		Writes all cached values of database to snapshot (temporary file is renamed, snapshot is
+	*					replaced atomically). Database write lock should be locked (revision must match values).
+	* @param[in]	snapshotPath	Path to snapshot.
+	* @param[in]	database			Database to save its cache.
+	* @retval		MSV_OPEN_ERROR		When snapshot could not be written.
+	* @retval		other_error_code	When failed.
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	static MsvErrorCode Save(const char* snapshotPath, const MsvActiveConfigDatabase& database);
+
+	/**************************************************************************************************//**
+	* @brief			Load snapshot.
+	* @details		Maps snapshot, checks it and copies its values to database cache. Snapshot must be saved
+	*					with the same group and config key map as database has.
+	* @param[in]	snapshotPath		Path to snapshot.
+	* @param[out]	database				Database to load cache (cache is changed only on success).
+	* @param[out]	storageRevision	Revision of storage when snapshot has been saved.
+	* @retval		MSV_OPEN_ERROR				When snapshot could not be mapped.
+	* @retval		MSV_INVALID_DATA_ERROR	When snapshot is corrupted or it has been saved for other key map.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	static MsvErrorCode Load(const char* snapshotPath, MsvActiveConfigDatabase& database, uint64_t& storageRevision);
+
+	/**************************************************************************************************//**
+	* @brief			Get storage revision.
+	* @details		Reads revision of SQLite database from its header (file change counter and page count),
+	*					it changes with each committed write. It reads only header, it does not open database.
+	* @param[in]	configPath		Path to active config database.
+	* @param[out]	revision			Storage revision.
+	* @retval		MSV_OPEN_ERROR				When database could not be read.
+	* @retval		MSV_INVALID_DATA_ERROR	When file is not SQLite database.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	static MsvErrorCode GetStorageRevision(const char* configPath, uint64_t& revision);
+
+	/**************************************************************************************************//**
+	* @brief			Get storage revision.
+	* @details		Reads revision of all storage partitions of database (sum of their revisions, it changes with
+	*					each committed write of any partition).
+	* @param[in]	database		Active config database.
+	* @param[out]	revision		Storage revision.
+	* @retval		MSV_OPEN_ERROR				When some partition could not be read.
+	* @retval		MSV_INVALID_DATA_ERROR	When some partition is not SQLite database.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	static MsvErrorCode GetStorageRevision(const MsvActiveConfigDatabase& database, uint64_t& revision);
+
+	/**************************************************************************************************//**
+	* @brief			Compute key map checksum.
+	* @details		Computes checksum of group name and config key map (config IDs, types and default values).
+	*					Snapshot saved for different group or key map is not used.
+	* @param[in]	database			Database with group name and config key map.
+	* @param[out]	checksum			Computed checksum.
+	* @retval		other_error_code	When failed.
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	static MsvErrorCode ComputeKeyMapChecksum(const MsvActiveConfigDatabase& database, uint64_t& checksum);
+};
+
+
+#endif // !MARSTECH_ACTIVECONFIGSNAPSHOT_H
+
+/** @} */	//End of group MCONFIG.
@@ -38,6 +38,7 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 
 MSV_DISABLE_ALL_WARNINGS
 
+#include <chrono>
 #include <vector>
 #include <sstream>
 
@@ -172,15 +173,12 @@ MsvErrorCode MsvActiveConfigStorage::Uninitialize()
 
 bool MsvActiveConfigStorage::Initialized() const
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
-
 	return m_initialized;
 }
 
 MsvErrorCode MsvActiveConfigStorage::GetValue(int32_t cfgId, bool& value) const
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
-
+	//no lock -> string value is read under lock, conversion does not need it
 	std::string valueStr;
 	MSV_RETURN_FAILED(GetValue(cfgId, valueStr));
 
@@ -192,8 +190,6 @@ MsvErrorCode MsvActiveConfigStorage::GetValue(int32_t cfgId, bool& value) const
 
 MsvErrorCode MsvActiveConfigStorage::GetValue(int32_t cfgId, double& value) const
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
-
 	std::string valueStr;
 	MSV_RETURN_FAILED(GetValue(cfgId, valueStr));
 
@@ -205,8 +201,6 @@ MsvErrorCode MsvActiveConfigStorage::GetValue(int32_t cfgId, double& value) cons
 
 MsvErrorCode MsvActiveConfigStorage::GetValue(int32_t cfgId, int64_t& value) const
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
-
 	std::string valueStr;
 	MSV_RETURN_FAILED(GetValue(cfgId, valueStr));
 
@@ -271,8 +265,6 @@ MsvErrorCode MsvActiveConfigStorage::GetValue(int32_t cfgId, std::string& value)
 
 MsvErrorCode MsvActiveConfigStorage::GetValue(int32_t cfgId, uint64_t& value) const
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
-
 	std::string valueStr;
 	MSV_RETURN_FAILED(GetValue(cfgId, valueStr));
 
@@ -311,16 +303,31 @@ MsvErrorCode MsvActiveConfigStorage::StoreValue(int32_t cfgId, int64_t value)
 
 MsvErrorCode MsvActiveConfigStorage::StoreValue(int32_t cfgId, const std::string& value)
 {
-	MSV_RETURN_FAILED(StoreValue<std::string>(cfgId, "'" + value + "'"));
+	MSV_RETURN_FAILED(StoreStringValue(cfgId, value));
+
+	OnChange<const char*>(cfgId, value.c_str());
+
+	return MSV_SUCCESS;
+}
 
-	//OnChange<char>(cfgId, value.c_str());
-	std::forward_list<std::shared_ptr<IMsvActiveConfigStorageCallback>>::iterator endCallbackIt = m_callbacks.end();
-	for (std::forward_list<std::shared_ptr<IMsvActiveConfigStorageCallback>>::iterator callbackIt = m_callbacks.begin(); callbackIt != endCallbackIt; ++callbackIt)
+MsvErrorCode MsvActiveConfigStorage::StoreValue(int32_t cfgId, std::string&& value)
+{
+	//value is moved (not copied) -> callbacks share it
+	return StoreValue(cfgId, std::make_shared<const std::string>(std::move(value)));
+}
+
+MsvErrorCode MsvActiveConfigStorage::StoreValue(int32_t cfgId, const std::shared_ptr<const std::string>& spValue)
+{
+	if (!spValue)
 	{
-		//config ID is everywhere defined as int32_t -> we can static_cast without worries
-		(*callbackIt)->OnValueChanged(cfgId, value.c_str());
+		MSV_LOG_ERROR(m_spLogger, "Active configuration value {} is null - error:", cfgId, MSV_INVALID_DATA_ERROR);
+		return MSV_INVALID_DATA_ERROR;
 	}
 
+	MSV_RETURN_FAILED(StoreStringValue(cfgId, *spValue));
+
+	OnChange<std::shared_ptr<const std::string>>(cfgId, spValue);
+
 	return MSV_SUCCESS;
 }
 
@@ -335,25 +342,21 @@ MsvErrorCode MsvActiveConfigStorage::StoreValue(int32_t cfgId, uint64_t value)
 
 MsvErrorCode MsvActiveConfigStorage::RegisterCallback(std::shared_ptr<IMsvActiveConfigStorageCallback> spCallback)
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
-
 	//there is no check if is initilized or not (it is possible to register callback before initialized - weard, but OK)
 
 	MSV_LOG_INFO(m_spLogger, "Registering Config Storage callback.");
 
-	std::forward_list<std::shared_ptr<IMsvActiveConfigStorageCallback>>::iterator endIt = m_callbacks.end();
-	for (std::forward_list<std::shared_ptr<IMsvActiveConfigStorageCallback>>::iterator it = m_callbacks.begin(); it != endIt; ++it)
+	MsvErrorCode errorCode = m_callbacks.Register(spCallback);
+	if (errorCode == MSV_ALREADY_REGISTERED_INFO)
 	{
-		if (*it == spCallback)
-		{
-			//callback is already registered
-			MSV_LOG_INFO(m_spLogger, "Config Storage callback has been already registered.");
-			return MSV_ALREADY_REGISTERED_INFO;
-		}
+		MSV_LOG_INFO(m_spLogger, "Config Storage callback has been already registered.");
+		return errorCode;
+	}
+	else if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Register Config Storage callback failed with error: {0:x}", errorCode);
+		return errorCode;
 	}
-
-	//register callback
-	m_callbacks.push_front(spCallback);
 
 	MSV_LOG_INFO(m_spLogger, "Config Storage callback has been successfully registered.");
 
@@ -362,17 +365,32 @@ MsvErrorCode MsvActiveConfigStorage::RegisterCallback(std::shared_ptr<IMsvActive
 
 MsvErrorCode MsvActiveConfigStorage::UnregisterCallback(std::shared_ptr<IMsvActiveConfigStorageCallback> spCallback)
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
-
 	MSV_LOG_INFO(m_spLogger, "Unregistering Config Storage callback.");
 
-	m_callbacks.remove(spCallback);
+	MsvErrorCode errorCode = m_callbacks.Unregister(spCallback);
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Unregister Config Storage callback failed with error: {0:x}", errorCode);
+		return errorCode;
+	}
+
+	m_watchdog.Remove(spCallback.get());
 
 	MSV_LOG_INFO(m_spLogger, "Config Storage callback has been successfully unregistered.");
 
 	return MSV_SUCCESS;
 }
 
+void MsvActiveConfigStorage::SetCallbackBudget(uint32_t budgetUs)
+{
+	m_watchdog.SetBudget(std::chrono::microseconds(budgetUs));
+}
+
+void MsvActiveConfigStorage::GetCallbackReport(std::vector<MsvCallbackReport>& report) const
+{
+	m_watchdog.GetReport(report);
+}
+
 
 /********************************************************************************************************************************
 *															MsvActiveConfigStorage protected methods
@@ -381,15 +399,24 @@ MsvErrorCode MsvActiveConfigStorage::UnregisterCallback(std::shared_ptr<IMsvActi
 
 template<class T> void MsvActiveConfigStorage::OnChange(int32_t cfgId, const T& newValue) const
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
-
 	//MSV_LOG_DEBUG(m_spLogger, "Config data changed (cfgId: {}, value: \"{}\").", cfgId, value);
 
-	std::forward_list<std::shared_ptr<IMsvActiveConfigStorageCallback>>::const_iterator endCallbackIt = m_callbacks.end();
-	for (std::forward_list<std::shared_ptr<IMsvActiveConfigStorageCallback>>::const_iterator callbackIt = m_callbacks.begin(); callbackIt != endCallbackIt; ++callbackIt)
+	//no lock -> callbacks array is immutable (callback might unregister itself meanwhile)
+	std::shared_ptr<const std::vector<std::shared_ptr<IMsvActiveConfigStorageCallback>>> spCallbacks = m_callbacks.Load();
+
+	std::vector<std::shared_ptr<IMsvActiveConfigStorageCallback>>::const_iterator endCallbackIt = spCallbacks->end();
+	for (std::vector<std::shared_ptr<IMsvActiveConfigStorageCallback>>::const_iterator callbackIt = spCallbacks->begin(); callbackIt != endCallbackIt; ++callbackIt)
 	{
-		//config ID is everywhere defined as int32_t -> we can static_cast without worries
+		//each call is measured -> time added to SetValue is attributed to its subscriber
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 		(*callbackIt)->OnValueChanged(cfgId, newValue);
+		std::chrono::nanoseconds duration = std::chrono::steady_clock::now() - start;
+
+		if (m_watchdog.Record(callbackIt->get(), duration))
+		{
+			MSV_LOG_ERROR(m_spLogger, "Config Storage callback {} exceeded budget {} us (cfgId: {}, duration: {} us).", static_cast<const void*>(callbackIt->get()), m_watchdog.GetBudget().count(),
+				cfgId, std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+		}
 	}
 }
 
@@ -473,6 +500,31 @@ MsvErrorCode MsvActiveConfigStorage::StoreDefaultValue(int32_t cfgId)
 	return MSV_SUCCESS;
 }
 
+MsvErrorCode MsvActiveConfigStorage::StoreStringValue(int32_t cfgId, const std::string& value)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	if (!Initialized())
+	{
+		MSV_LOG_ERROR(m_spLogger, "Active configuration storage is not initialized - error:", MSV_NOT_INITIALIZED_ERROR);
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	//value is bound (it is not quoted and copied to query)
+	std::stringstream sqlQuery;
+	sqlQuery << "INSERT OR REPLACE INTO " << m_tableName << "(Id, Value) VALUES(" << cfgId << ", ?1);";
+
+	MsvSQLiteResult sqlResult;
+	MsvErrorCode errorCode = m_spSQLite->Execute(sqlQuery.str().c_str(), value, sqlResult);
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Store configuration value {} to SQLite failed with error:", cfgId, errorCode);
+		return errorCode;
+	}
+
+	return MSV_SUCCESS;
+}
+
 template<class T> MsvErrorCode MsvActiveConfigStorage::StoreValue(int32_t cfgId, const T& value)
 {
 	std::lock_guard<std::recursive_mutex> lock(m_lock);
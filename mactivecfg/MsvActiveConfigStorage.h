@@ -36,6 +36,7 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 
 
 #include "IMsvActiveConfigStorage.h"
+#include "mconfig/common/MsvCopyOnWrite.h"
 #include "mconfig/msqlitewrapper/IMsvSQLite.h"
 #include "mconfig/msqlitewrapper/IMsvSQLiteCallback.h"
 
@@ -43,8 +44,8 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 
 MSV_DISABLE_ALL_WARNINGS
 
+#include <atomic>
 #include <mutex>
-#include <forward_list>
 
 MSV_ENABLE_WARNINGS
 
@@ -146,6 +147,16 @@ public:
 	******************************************************************************************************/
 	virtual MsvErrorCode StoreValue(int32_t cfgId, const std::string& value) override;
 
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::StoreValue(int32_t cfgId, std::string&& value)
+	******************************************************************************************************/
+	virtual MsvErrorCode StoreValue(int32_t cfgId, std::string&& value) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::StoreValue(int32_t cfgId, const std::shared_ptr<const std::string>& spValue)
+	******************************************************************************************************/
+	virtual MsvErrorCode StoreValue(int32_t cfgId, const std::shared_ptr<const std::string>& spValue) override;
+
 	/**************************************************************************************************//**
 	* @copydoc IMsvActiveConfigStorage::StoreValue(int32_t cfgId, uint64_t value)
 	******************************************************************************************************/
@@ -161,6 +172,16 @@ public:
 	******************************************************************************************************/
 	virtual MsvErrorCode UnregisterCallback(std::shared_ptr<IMsvActiveConfigStorageCallback> spCallback) override;
 
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::SetCallbackBudget(uint32_t budgetUs)
+	******************************************************************************************************/
+	virtual void SetCallbackBudget(uint32_t budgetUs) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvActiveConfigStorage::GetCallbackReport(std::vector<MsvCallbackReport>& report) const
+	******************************************************************************************************/
+	virtual void GetCallbackReport(std::vector<MsvCallbackReport>& report) const override;
+
 	/*-----------------------------------------------------------------------------------------------------
 	**											MsvActiveConfigStorage protected methods
 	**---------------------------------------------------------------------------------------------------*/
@@ -195,6 +216,17 @@ protected:
 	******************************************************************************************************/
 	template<class T> MsvErrorCode StoreValue(int32_t cfgId, const T& value);
 
+	/**************************************************************************************************//**
+	* @brief			Store string value.
+	* @details		Stores string value with bound query parameter (value is not copied).
+	* @param[in]	cfgId		Config ID to set its value.
+	* @param[in]	value		New value of config ID.
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		other_error_code				When failed.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	MsvErrorCode StoreStringValue(int32_t cfgId, const std::string& value);
+
 protected:
 	/**************************************************************************************************//**
 	* @brief		Config storage mutex.
@@ -204,20 +236,29 @@ protected:
 
 	/**************************************************************************************************//**
 	* @brief		Registered callbacks.
-	* @details	Contains all registered callbacks which will be notified about data changes.
+	* @details	Contains all registered callbacks which will be notified about data changes (copy on write,
+	*				notification does not lock).
 	* @see		RegisterCallback
 	* @see		UnregisterCallback
 	******************************************************************************************************/
-	std::forward_list<std::shared_ptr<IMsvActiveConfigStorageCallback>> m_callbacks;
+	MsvCallbackList<IMsvActiveConfigStorageCallback> m_callbacks;
+
+	/**************************************************************************************************//**
+	* @brief		Callback watchdog.
+	* @details	Time spent in registered callbacks (it is updated by const notification).
+	* @see		SetCallbackBudget
+	* @see		GetCallbackReport
+	******************************************************************************************************/
+	mutable MsvCallbackWatchdog m_watchdog;
 
 	/**************************************************************************************************//**
 	* @brief		Initialize flag.
-	* @details	Flag if config is initialized (true) or not (false).
+	* @details	Flag if config is initialized (true) or not (false). It is atomic, check does not lock.
 	* @see		Initialize
 	* @see		Uninitialize
 	* @see		Initialized
 	******************************************************************************************************/
-	bool m_initialized;
+	std::atomic<bool> m_initialized;
 
 	/**************************************************************************************************//**
 	* @brief		Config key map.
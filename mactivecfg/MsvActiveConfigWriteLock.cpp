@@ -0,0 +1,215 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Active Config Write Lock
+* @details		Write lock of active config database with key shards.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "MsvActiveConfigWriteLock.h"
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvActiveConfigWriteLock::MsvActiveConfigWriteLock():
+	m_depth(0),
+	m_lockedShards(0),
+	m_waitingWriters(0)
+{
+
+}
+
+
+/********************************************************************************************************************************
+*															MsvActiveConfigWriteLock public methods
+********************************************************************************************************************************/
+
+
+void MsvActiveConfigWriteLock::SetShardCount(size_t shardCount)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	//one shard is exclusive lock -> shards are not needed
+	m_shards.assign(shardCount > 1 ? shardCount : 0, MsvWriteShard{ std::thread::id(), 0 });
+}
+
+size_t MsvActiveConfigWriteLock::GetShardCount() const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	return m_shards.empty() ? 1 : m_shards.size();
+}
+
+size_t MsvActiveConfigWriteLock::GetShard(int32_t cfgId, size_t shardCount)
+{
+	//negative config IDs are spread as well
+	return shardCount > 1 ? static_cast<size_t>(static_cast<uint32_t>(cfgId) % shardCount) : 0;
+}
+
+void MsvActiveConfigWriteLock::lock()
+{
+	std::unique_lock<std::mutex> lock(m_lock);
+
+	std::thread::id threadId = std::this_thread::get_id();
+	if (m_owner == threadId)
+	{
+		++m_depth;
+		return;
+	}
+
+	++m_waitingWriters;
+	m_condition.wait(lock, [this]() { return m_owner == std::thread::id() && m_lockedShards == 0; });
+	--m_waitingWriters;
+
+	m_owner = threadId;
+	m_depth = 1;
+}
+
+void MsvActiveConfigWriteLock::unlock()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	if (--m_depth == 0)
+	{
+		m_owner = std::thread::id();
+		m_condition.notify_all();
+	}
+}
+
+MsvErrorCode MsvActiveConfigWriteLock::LockKey(int32_t cfgId)
+{
+	std::unique_lock<std::mutex> lock(m_lock);
+
+	std::thread::id threadId = std::this_thread::get_id();
+	if (m_shards.empty() || m_owner == threadId)
+	{
+		//one shard or write inside of exclusive write (batch callback) -> exclusive lock
+		lock.unlock();
+		this->lock();
+		return MSV_SUCCESS;
+	}
+
+	MsvWriteShard& shard = m_shards[GetShard(cfgId, m_shards.size())];
+	if (shard.m_owner == threadId)
+	{
+		++shard.m_depth;
+		return MSV_SUCCESS;
+	}
+
+	if (HoldsShard(threadId))
+	{
+		return MSV_BUSY_ERROR;
+	}
+
+	m_condition.wait(lock, [this, &shard]() { return m_owner == std::thread::id() && m_waitingWriters == 0 && shard.m_owner == std::thread::id(); });
+
+	shard.m_owner = threadId;
+	shard.m_depth = 1;
+	++m_lockedShards;
+
+	return MSV_SUCCESS;
+}
+
+void MsvActiveConfigWriteLock::UnlockKey(int32_t cfgId)
+{
+	std::unique_lock<std::mutex> lock(m_lock);
+
+	if (m_shards.empty() || m_owner == std::this_thread::get_id())
+	{
+		lock.unlock();
+		unlock();
+		return;
+	}
+
+	MsvWriteShard& shard = m_shards[GetShard(cfgId, m_shards.size())];
+	if (--shard.m_depth == 0)
+	{
+		shard.m_owner = std::thread::id();
+		--m_lockedShards;
+		m_condition.notify_all();
+	}
+}
+
+bool MsvActiveConfigWriteLock::HoldsKey() const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	return HoldsShard(std::this_thread::get_id());
+}
+
+
+/********************************************************************************************************************************
+*															MsvActiveConfigWriteLock protected methods
+********************************************************************************************************************************/
+
+
+bool MsvActiveConfigWriteLock::HoldsShard(std::thread::id threadId) const
+{
+	for (std::vector<MsvWriteShard>::const_iterator it = m_shards.begin(); it != m_shards.end(); ++it)
+	{
+		if (it->m_owner == threadId)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+/********************************************************************************************************************************
+*															MsvActiveConfigKeyWriteGuard public methods
+********************************************************************************************************************************/
+
+
+MsvActiveConfigKeyWriteGuard::MsvActiveConfigKeyWriteGuard(MsvActiveConfigWriteLock& writeLock, int32_t cfgId):
+	m_writeLock(writeLock),
+	m_cfgId(cfgId),
+	m_errorCode(writeLock.LockKey(cfgId))
+{
+
+}
+
+MsvActiveConfigKeyWriteGuard::~MsvActiveConfigKeyWriteGuard()
+{
+	if (MSV_SUCCEEDED(m_errorCode))
+	{
+		m_writeLock.UnlockKey(m_cfgId);
+	}
+}
+
+MsvErrorCode MsvActiveConfigKeyWriteGuard::GetErrorCode() const
+{
+	return m_errorCode;
+}
+
+/** @} */	//End of group MCONFIG.
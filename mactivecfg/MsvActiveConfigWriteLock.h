@@ -0,0 +1,230 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Active Config Write Lock
+* @details		Write lock of active config database with key shards.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_ACTIVECONFIGWRITELOCK_H
+#define MARSTECH_ACTIVECONFIGWRITELOCK_H
+
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Write Lock.
+* @details	Serializes writes of active config database. Writes of one key lock only shard of the key, so
+*				writes of keys from different shards run concurrently. Exclusive lock (lock/unlock, it might be
+*				used by std::lock_guard) waits for all shards and blocks new key writes (batches, retarget).
+*				Both locks are recursive for owning thread (callbacks called under lock might write). With one
+*				shard (default) key lock is exclusive lock, so writes behave like before sharding.
+* @warning	Thread which holds key lock must not lock exclusively (see @ref HoldsKey) and it must not lock key
+*				from other shard (@ref LockKey returns @ref MSV_BUSY_ERROR, two such threads would deadlock).
+* @note		It is thread safe.
+******************************************************************************************************/
+class MsvActiveConfigWriteLock
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	* @details	Creates lock with one shard.
+	******************************************************************************************************/
+	MsvActiveConfigWriteLock();
+
+	/**************************************************************************************************//**
+	* @brief			Set shard count.
+	* @details		Sets count of key shards. It must be set before lock is used for the first time.
+	* @param[in]	shardCount		Count of key shards (0 is the same as 1).
+	******************************************************************************************************/
+	void SetShardCount(size_t shardCount);
+
+	/**************************************************************************************************//**
+	* @brief			Get shard count.
+	* @returns		Count of key shards.
+	******************************************************************************************************/
+	size_t GetShardCount() const;
+
+	/**************************************************************************************************//**
+	* @brief			Get shard.
+	* @details		Returns shard of config ID (config IDs are spread by modulo, neighbouring IDs are in
+	*					different shards).
+	* @param[in]	cfgId				Config ID.
+	* @param[in]	shardCount		Count of shards.
+	* @returns		Shard index.
+	******************************************************************************************************/
+	static size_t GetShard(int32_t cfgId, size_t shardCount);
+
+	/**************************************************************************************************//**
+	* @brief		Lock.
+	* @details	Locks exclusively (waits for all key writes, new key writes wait for unlock).
+	******************************************************************************************************/
+	void lock();
+
+	/**************************************************************************************************//**
+	* @brief		Unlock.
+	* @details	Unlocks exclusive lock.
+	******************************************************************************************************/
+	void unlock();
+
+	/**************************************************************************************************//**
+	* @brief			Lock key.
+	* @details		Locks shard of config ID. Thread which owns exclusive lock or shard of config ID locks it
+	*					recursively.
+	* @param[in]	cfgId		Config ID.
+	* @retval		MSV_BUSY_ERROR		When calling thread holds other shard (it would deadlock).
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	MsvErrorCode LockKey(int32_t cfgId);
+
+	/**************************************************************************************************//**
+	* @brief			Unlock key.
+	* @details		Unlocks shard of config ID (locked by successful @ref LockKey).
+	* @param[in]	cfgId		Config ID.
+	******************************************************************************************************/
+	void UnlockKey(int32_t cfgId);
+
+	/**************************************************************************************************//**
+	* @brief			Holds key.
+	* @returns		True when calling thread holds some key shard (it can not lock exclusively), false otherwise.
+	******************************************************************************************************/
+	bool HoldsKey() const;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Write shard.
+	* @details	Owner of key shard.
+	******************************************************************************************************/
+	struct MsvWriteShard
+	{
+		std::thread::id m_owner;		//!< Thread which holds shard (default ID -> shard is free).
+		size_t m_depth;					//!< Recursion depth of owner.
+	};
+
+	/**************************************************************************************************//**
+	* @brief			Holds shard.
+	* @details		Checks if thread holds some shard (lock must be locked).
+	* @param[in]	threadId		Thread ID.
+	* @returns		True when thread holds some shard, false otherwise.
+	******************************************************************************************************/
+	bool HoldsShard(std::thread::id threadId) const;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Lock.
+	* @details	Locks ownership state (it is held only while state is checked or changed).
+	******************************************************************************************************/
+	mutable std::mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Condition.
+	* @details	Signals released shard or exclusive lock.
+	******************************************************************************************************/
+	std::condition_variable m_condition;
+
+	/**************************************************************************************************//**
+	* @brief		Shards.
+	* @details	Key shards (empty -> one shard, key lock is exclusive lock).
+	******************************************************************************************************/
+	std::vector<MsvWriteShard> m_shards;
+
+	/**************************************************************************************************//**
+	* @brief		Owner.
+	* @details	Thread which holds exclusive lock (default ID -> exclusive lock is free).
+	******************************************************************************************************/
+	std::thread::id m_owner;
+
+	/**************************************************************************************************//**
+	* @brief		Depth.
+	* @details	Recursion depth of exclusive owner.
+	******************************************************************************************************/
+	size_t m_depth;
+
+	/**************************************************************************************************//**
+	* @brief		Locked shards.
+	* @details	Count of currently locked shards.
+	******************************************************************************************************/
+	size_t m_lockedShards;
+
+	/**************************************************************************************************//**
+	* @brief		Waiting writers.
+	* @details	Count of threads waiting for exclusive lock (new key writes wait for them -> no starvation).
+	******************************************************************************************************/
+	size_t m_waitingWriters;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Active Config Key Write Guard.
+* @details	Locks key in constructor and unlocks it in destructor (when it has been locked).
+******************************************************************************************************/
+class MsvActiveConfigKeyWriteGuard
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @details		Locks key (result is returned by @ref GetErrorCode).
+	* @param[in]	writeLock		Write lock (it must outlive guard).
+	* @param[in]	cfgId				Config ID.
+	******************************************************************************************************/
+	MsvActiveConfigKeyWriteGuard(MsvActiveConfigWriteLock& writeLock, int32_t cfgId);
+
+	/**************************************************************************************************//**
+	* @brief		Destructor.
+	* @details	Unlocks key (when it has been locked).
+	******************************************************************************************************/
+	~MsvActiveConfigKeyWriteGuard();
+
+	/**************************************************************************************************//**
+	* @brief			Get error code.
+	* @returns		Result of key lock.
+	******************************************************************************************************/
+	MsvErrorCode GetErrorCode() const;
+
+protected:
+	MsvActiveConfigWriteLock& m_writeLock;		//!< Write lock.
+	int32_t m_cfgId;									//!< Locked config ID.
+	MsvErrorCode m_errorCode;						//!< Result of key lock.
+};
+
+
+#endif // !MARSTECH_ACTIVECONFIGWRITELOCK_H
+
+/** @} */	//End of group MCONFIG.
@@ -37,6 +37,15 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 
 #include "mconfig/common/IMsvConfigKey.h"
 #include "mconfig/common/IMsvConfigKeyMap.h"
+#include "mconfig/common/MsvConfigOverrides.h"
+#include "mconfig/common/MsvConfigSnapshot.h"
+#include "IMsvPassiveConfigCallback.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <vector>
+
+MSV_ENABLE_WARNINGS
 
 
 /**************************************************************************************************//**
@@ -116,6 +125,7 @@ public:
 	* @retval		MSV_PARSE_ERROR					When parsing configuration file failed.
 	* @retval		MSV_INVALID_DATA_ERROR			When value has different type then requested.
 	* @retval		MSV_UNKNOWN_ERROR					Unknown value type (not supported).
+	* @retval		MSV_ALLOCATION_ERROR				When allocation of scalar values failed.
 	* @retval		MSV_SUCCESS							On success.
 	******************************************************************************************************/
 	virtual MsvErrorCode Initialize(std::shared_ptr<IMsvConfigKeyMap<IMsvConfigKey>> spConfigKeyMap, const char* configPath = "config.ini") = 0;
@@ -141,6 +151,103 @@ public:
 	******************************************************************************************************/
 	virtual MsvErrorCode ReloadConfiguration() = 0;
 
+	/**************************************************************************************************//**
+	* @brief			Reload configuration.
+	* @details		Reloads configuration from config file and reports which values have been changed. Only
+	*					changed values are updated, unchanged values are kept untouched.
+	* @param[out]	changedCfgIds	Sorted config IDs of changed values (empty when nothing has changed).
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_PARSE_ERROR				When parsing configuration file failed.
+	* @retval		MSV_INVALID_DATA_ERROR		When value has different type then requested.
+	* @retval		MSV_UNKNOWN_ERROR				Unknown value type (not supported).
+	* @retval		MSV_SUCCESS						On success.
+	* @see			ReloadConfiguration()
+	******************************************************************************************************/
+	virtual MsvErrorCode ReloadConfiguration(std::vector<int32_t>& changedCfgIds) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Register passive config callback.
+	* @details		Registers passive config callback which is called when configuration has been changed by
+	*					reload.
+	* @param[in]	spCallback		Callback to register.
+	* @retval		MSV_ALREADY_REGISTERED_INFO	When callback has been already registered (this is info, not error).
+	* @retval		MSV_SUCCESS							On success.
+	* @see			IMsvPassiveConfigCallback
+	******************************************************************************************************/
+	virtual MsvErrorCode RegisterCallback(std::shared_ptr<IMsvPassiveConfigCallback> spCallback) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Unregister passive config callback.
+	* @details		Unregisters passive config callback which is called when configuration has been changed by
+	*					reload.
+	* @param[in]	spCallback		Callback to unregister.
+	* @retval		MSV_SUCCESS		On success.
+	* @see			IMsvPassiveConfigCallback
+	******************************************************************************************************/
+	virtual MsvErrorCode UnregisterCallback(std::shared_ptr<IMsvPassiveConfigCallback> spCallback) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Get notification handle.
+	* @details		Returns pollable handle (eventfd) which is readable (POLLIN) while some changes made by reload
+	*					are pending, so config changes might be handled by event loop (epoll, io_uring, etc.) without
+	*					callbacks and extra threads. Changes are collected after first call. Use @ref DrainChanges to
+	*					get pending changes and to reset handle. Handle is owned by config (do not read or close it).
+	* @param[out]	handle		Pollable file descriptor.
+	* @retval		MSV_NOT_FOUND_ERROR		When pollable handle is not supported (eventfd is available only on Linux).
+	* @retval		MSV_OPEN_ERROR				When handle could not be opened.
+	* @retval		MSV_SUCCESS					On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode GetNotificationHandle(int& handle) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Drain changes.
+	* @details		Returns config IDs changed since last drain and resets notification handle. It never blocks,
+	*					current values are read by GetValue.
+	* @param[out]	changedCfgIds		Changed config IDs (sorted, each only once, empty when nothing is pending).
+	* @retval		MSV_SUCCESS		On success.
+	* @see			GetNotificationHandle
+	******************************************************************************************************/
+	virtual MsvErrorCode DrainChanges(std::vector<int32_t>& changedCfgIds) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Get snapshot.
+	* @details		Returns immutable view of all loaded values. Values are read from it without locks and they
+	*					are consistent (they are from the same reload). Snapshot is cached until next reload which
+	*					changes values, so taking it is cheap (shared pointer copy) and it might be held as long as needed.
+	* @param[out]	spSnapshot		Current snapshot.
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_ALLOCATION_ERROR			When snapshot allocation failed.
+	* @retval		MSV_SUCCESS						On success.
+	* @see			MsvConfigSnapshot
+	******************************************************************************************************/
+	virtual MsvErrorCode GetSnapshot(std::shared_ptr<const MsvConfigSnapshot>& spSnapshot) const = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Push overrides.
+	* @details		Overrides values for calling thread only (other threads still read stored values). Overrides
+	*					are not changed by reload and they are not notified. The most recently pushed value wins.
+	*					When calling thread has no overrides, reads check only one thread local pointer.
+	* @param[in]	values		Overridden values.
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_NOT_FOUND_ERROR			When some config ID does not exist.
+	* @retval		MSV_INVALID_DATA_ERROR		When some value has other type.
+	* @retval		MSV_ALLOCATION_ERROR		When allocation failed.
+	* @retval		MSV_SUCCESS						On success.
+	* @note		Snapshots do not contain overrides.
+	* @warning		Pushed overrides must be popped by the same thread (@ref MsvConfigOverrideScope).
+	* @see			PopOverrides
+	******************************************************************************************************/
+	virtual MsvErrorCode PushOverrides(const std::vector<MsvConfigValueUpdate>& values) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Pop overrides.
+	* @details		Removes overrides pushed last by calling thread.
+	* @retval		MSV_NOT_FOUND_ERROR			When calling thread has no overrides.
+	* @retval		MSV_SUCCESS						On success.
+	* @see			PushOverrides
+	******************************************************************************************************/
+	virtual MsvErrorCode PopOverrides() = 0;
+
 	template<class T, class T1> MsvErrorCode GetValue(int32_t cfgId, T& value)
 	{
 		T1 tempValue;
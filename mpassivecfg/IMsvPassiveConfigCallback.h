@@ -0,0 +1,74 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Passive Config Callback Interface
+* @details		Contains declaration of interface for passive configuration callback.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_IPASSIVECONFIG_CALLBACK_H
+#define MARSTECH_IPASSIVECONFIG_CALLBACK_H
+
+
+#include "mconfig/common/MsvConfigValue.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Passive Config Callback Interface.
+* @details	Interface for passive configuration callback which notifies about data changes after
+*				configuration reload.
+* @note		It is not called by initial load (@ref IMsvPassiveConfig::Initialize).
+******************************************************************************************************/
+class IMsvPassiveConfigCallback
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~IMsvPassiveConfigCallback() {}
+
+	/**************************************************************************************************//**
+	* @brief			Configuration has been changed.
+	* @details		This method is called once per reload when at least one value has been changed (callback
+	*					must be registered before).
+	* @param[in]	changes		Changed values with its old and new values (sorted by config ID).
+	******************************************************************************************************/
+	virtual void OnConfigurationChanged(const std::vector<MsvConfigValueChange>& changes) = 0;
+};
+
+
+#endif // !MARSTECH_IPASSIVECONFIG_CALLBACK_H
+
+/** @} */	//End of group MCONFIG.
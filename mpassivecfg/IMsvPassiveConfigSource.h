@@ -0,0 +1,92 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Passive Config Source Interface
+* @details		Contains declaration of interface for passive configuration source (layer).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_IPASSIVECONFIGSOURCE_H
+#define MARSTECH_IPASSIVECONFIGSOURCE_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <string>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Passive Config Source Interface.
+* @details	Interface for one source (layer) of passive configuration (INI file, environment variables,
+*				command line, etc.). Source returns raw (string) values, which are converted by
+*				@ref MsvPassiveConfigLayered.
+* @see		MsvPassiveConfigLayered
+******************************************************************************************************/
+class IMsvPassiveConfigSource
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~IMsvPassiveConfigSource() {}
+
+	/**************************************************************************************************//**
+	* @brief			Load source.
+	* @details		Loads (or reloads) source values. It is called once per configuration (re)load.
+	* @param[out]	lineNumber		Line number on which parsing failed (INT32_MIN if not failed).
+	* @retval		MSV_PARSE_ERROR	When parsing source failed.
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Load(int32_t& lineNumber) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Get value.
+	* @details		Returns raw value of config key (when it is specified in this source).
+	* @param[in]	group		Config key group.
+	* @param[in]	key		Config key name.
+	* @param[out]	value		Raw value (valid only when true is returned).
+	* @returns		True when value is specified in this source, false otherwise.
+	******************************************************************************************************/
+	virtual bool GetValue(const std::string& group, const std::string& key, std::string& value) const = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Get source name.
+	* @returns		Name of source (used to report which source supplied value).
+	******************************************************************************************************/
+	virtual const char* GetName() const = 0;
+};
+
+
+#endif // !MARSTECH_IPASSIVECONFIGSOURCE_H
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,76 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Passive Config Watcher Callback Interface
+* @details		Contains interface of MarsTech Passive Config Watcher Callback.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_IPASSIVECONFIGWATCHER_CALLBACK_H
+#define MARSTECH_IPASSIVECONFIGWATCHER_CALLBACK_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Passive Config Watcher Callback Interface.
+* @details	Interface for passive config watcher callback which notifies about reloads of passive config
+*				caused by changes of config file.
+* @see		MsvPassiveConfigWatcher
+******************************************************************************************************/
+class IMsvPassiveConfigWatcherCallback
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~IMsvPassiveConfigWatcherCallback() {}
+
+	/**************************************************************************************************//**
+	* @brief			Configuration has been reloaded.
+	* @details		This method is called (from watcher thread) when config file has changed and passive
+	*					configuration has been reloaded. It is called with MSV_OPEN_ERROR when config directory has
+	*					been removed or moved (current configuration is kept).
+	* @param[in]	errorCode		Result of reload (see @ref IMsvPassiveConfig::ReloadConfiguration).
+	* @param[in]	changedCfgIds	Sorted config IDs of changed values (empty when reload failed).
+	******************************************************************************************************/
+	virtual void OnConfigurationReloaded(MsvErrorCode errorCode, const std::vector<int32_t>& changedCfgIds) = 0;
+};
+
+
+#endif // !MARSTECH_IPASSIVECONFIGWATCHER_CALLBACK_H
+
+/** @} */	//End of group MCONFIG.
@@ -60,28 +60,14 @@ MsvPassiveConfig::~MsvPassiveConfig()
 
 
 /********************************************************************************************************************************
-*															IMsvPassiveConfig public methods
+*															MsvPassiveConfigBase protected methods
 ********************************************************************************************************************************/
 
 
-MsvErrorCode MsvPassiveConfig::ReloadConfiguration()
+MsvErrorCode MsvPassiveConfig::LoadConfiguration(MsvConfigValues& values)
 {
 	std::lock_guard<std::recursive_mutex> lock(m_lock);
 
-	//check if config has been already initialized (we need these two values for successfull reload)
-	if (m_configPath.empty() || !m_spConfigKeyMap)
-	{
-		//config is not initialized -> return error
-		return MSV_NOT_INITIALIZED_ERROR;
-	}
-
-	//clear all values (they might be already loaded)
-	m_boolValues.clear();
-	m_doubleValues.clear();
-	m_integerValues.clear();
-	m_stringValues.clear();
-	m_unsignedValues.clear();
-
 	//open INI file and parse it
 	INIReader reader(m_configPath);
 	if (reader.ParseError() != 0)
@@ -111,7 +97,7 @@ MsvErrorCode MsvPassiveConfig::ReloadConfiguration()
 				m_cfgIdWithError = it->first;
 				break;
 			}
-			m_boolValues.insert(std::pair<int32_t, bool>(it->first, reader.GetBoolean(group, key, defaultValue)));
+			values.m_boolValues.insert(std::pair<int32_t, bool>(it->first, reader.GetBoolean(group, key, defaultValue)));
 		}
 		else if (spConfigKey->IsDouble())
 		{
@@ -123,7 +109,7 @@ MsvErrorCode MsvPassiveConfig::ReloadConfiguration()
 				m_cfgIdWithError = it->first;
 				break;
 			}
-			m_doubleValues.insert(std::pair<int32_t, double>(it->first, reader.GetReal(group, key, defaultValue)));
+			values.m_doubleValues.insert(std::pair<int32_t, double>(it->first, reader.GetReal(group, key, defaultValue)));
 		}
 		else if (spConfigKey->IsInteger())
 		{
@@ -135,7 +121,7 @@ MsvErrorCode MsvPassiveConfig::ReloadConfiguration()
 				m_cfgIdWithError = it->first;
 				break;
 			}
-			m_integerValues.insert(std::pair<int32_t, int64_t>(it->first, reader.GetInteger(group, key, static_cast<long>(defaultValue))));
+			values.m_integerValues.insert(std::pair<int32_t, int64_t>(it->first, reader.GetInteger(group, key, static_cast<long>(defaultValue))));
 		}
 		else if (spConfigKey->IsString())
 		{
@@ -147,7 +133,7 @@ MsvErrorCode MsvPassiveConfig::ReloadConfiguration()
 				m_cfgIdWithError = it->first;
 				break;
 			}
-			m_stringValues.insert(std::pair<int32_t, std::string>(it->first, reader.Get(group, key, defaultValue)));
+			values.m_stringValues.insert(std::pair<int32_t, std::string>(it->first, reader.Get(group, key, defaultValue)));
 		}
 		else if (spConfigKey->IsUnsigned())
 		{
@@ -161,7 +147,7 @@ MsvErrorCode MsvPassiveConfig::ReloadConfiguration()
 			}
 			//working as string (inih does not have support for unsigned types)
 			uint64_t value = strtoull(reader.Get(group, key, std::to_string(defaultValue)).c_str(), nullptr, 10);
-			m_unsignedValues.insert(std::pair<int32_t, int64_t>(it->first, value));
+			values.m_unsignedValues.insert(std::pair<int32_t, int64_t>(it->first, value));
 		}
 		else
 		{
@@ -172,17 +158,6 @@ MsvErrorCode MsvPassiveConfig::ReloadConfiguration()
 		}
 	}
 
-	//check if all succeeded
-	if (MSV_FAILED(errorCode))
-	{
-		//somethink failed -> clear all values (they might not be valid)
-		m_boolValues.clear();
-		m_doubleValues.clear();
-		m_integerValues.clear();
-		m_stringValues.clear();
-		m_unsignedValues.clear();
-	}
-
 	return errorCode;
 }
 
@@ -66,13 +66,13 @@ public:
 	virtual ~MsvPassiveConfig();
 
 	/*-----------------------------------------------------------------------------------------------------
-	**											IMsvPassiveConfig public methods
+	**											MsvPassiveConfigBase protected methods
 	**---------------------------------------------------------------------------------------------------*/
-public:
+protected:
 	/**************************************************************************************************//**
-	* @copydoc IMsvPassiveConfig::ReloadConfiguration()
+	* @copydoc MsvPassiveConfigBase::LoadConfiguration(MsvConfigValues& values)
 	******************************************************************************************************/
-	virtual MsvErrorCode ReloadConfiguration() override;
+	virtual MsvErrorCode LoadConfiguration(MsvConfigValues& values) override;
 };
 
 
@@ -0,0 +1,133 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Passive Config Command Line Source Implementation
+* @details		Contains implementation of @ref MsvPassiveConfigArgsSource.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "MsvPassiveConfigArgsSource.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cctype>
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvPassiveConfigArgsSource::MsvPassiveConfigArgsSource(int argc, const char* const* argv, const char* prefix):
+	m_prefix(prefix)
+{
+	for (int i = 0; i < argc; ++i)
+	{
+		m_args.push_back(argv[i] ? argv[i] : "");
+	}
+}
+
+MsvPassiveConfigArgsSource::~MsvPassiveConfigArgsSource()
+{
+
+}
+
+
+/********************************************************************************************************************************
+*															IMsvPassiveConfigSource public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvPassiveConfigArgsSource::Load(int32_t& lineNumber)
+{
+	lineNumber = INT32_MIN;
+	m_values.clear();
+
+	for (std::vector<std::string>::const_iterator it = m_args.begin(); it != m_args.end(); ++it)
+	{
+		if (it->compare(0, m_prefix.size(), m_prefix) != 0)
+		{
+			//not a config argument
+			continue;
+		}
+
+		std::string::size_type separator = it->find('=', m_prefix.size());
+		std::string::size_type dot = it->find('.', m_prefix.size());
+		if (separator == std::string::npos || dot == std::string::npos || dot > separator)
+		{
+			//not a config argument
+			continue;
+		}
+
+		m_values[MakeKey(it->substr(m_prefix.size(), dot - m_prefix.size()), it->substr(dot + 1, separator - dot - 1))] = it->substr(separator + 1);
+	}
+
+	return MSV_SUCCESS;
+}
+
+bool MsvPassiveConfigArgsSource::GetValue(const std::string& group, const std::string& key, std::string& value) const
+{
+	std::map<std::string, std::string>::const_iterator it = m_values.find(MakeKey(group, key));
+	if (it == m_values.end())
+	{
+		return false;
+	}
+
+	value = it->second;
+	return true;
+}
+
+const char* MsvPassiveConfigArgsSource::GetName() const
+{
+	return "cmdline";
+}
+
+
+/********************************************************************************************************************************
+*															MsvPassiveConfigArgsSource protected methods
+********************************************************************************************************************************/
+
+
+std::string MsvPassiveConfigArgsSource::MakeKey(const std::string& group, const std::string& key)
+{
+	std::string mapKey = group + "." + key;
+
+	for (std::string::iterator it = mapKey.begin(); it != mapKey.end(); ++it)
+	{
+		*it = static_cast<char>(tolower(static_cast<unsigned char>(*it)));
+	}
+
+	return mapKey;
+}
+
+/** @} */	//End of group MCONFIG.
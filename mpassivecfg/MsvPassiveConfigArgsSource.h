@@ -0,0 +1,126 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Passive Config Command Line Source
+* @details		Contains declaration of @ref MsvPassiveConfigArgsSource (command line layer of passive configuration).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_PASSIVECONFIGARGSSOURCE_H
+#define MARSTECH_PASSIVECONFIGARGSSOURCE_H
+
+
+#include "IMsvPassiveConfigSource.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <map>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Passive Config Command Line Source.
+* @details	Passive configuration source which reads values from command line arguments in format
+*				"<prefix><group>.<key>=<value>" (e.g. "--GROUP_1.bool_value=true"). Group and key are case
+*				insensitive (as in INI file), other arguments are ignored and last occurrence wins.
+* @see		IMsvPassiveConfigSource
+* @see		MsvPassiveConfigLayered
+******************************************************************************************************/
+class MsvPassiveConfigArgsSource:
+	public IMsvPassiveConfigSource
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	argc		Number of arguments.
+	* @param[in]	argv		Arguments (they are copied).
+	* @param[in]	prefix	Config argument prefix.
+	******************************************************************************************************/
+	MsvPassiveConfigArgsSource(int argc, const char* const* argv, const char* prefix = "--");
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvPassiveConfigArgsSource();
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvPassiveConfigSource public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfigSource::Load(int32_t& lineNumber)
+	******************************************************************************************************/
+	virtual MsvErrorCode Load(int32_t& lineNumber) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfigSource::GetValue(const std::string& group, const std::string& key, std::string& value) const
+	******************************************************************************************************/
+	virtual bool GetValue(const std::string& group, const std::string& key, std::string& value) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfigSource::GetName() const
+	******************************************************************************************************/
+	virtual const char* GetName() const override;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Make key.
+	* @details		Creates (lower case) map key from group and key.
+	* @param[in]	group		Config key group.
+	* @param[in]	key		Config key name.
+	* @returns		Map key ("<group>.<key>").
+	******************************************************************************************************/
+	static std::string MakeKey(const std::string& group, const std::string& key);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Arguments.
+	* @details	Copy of command line arguments.
+	******************************************************************************************************/
+	std::vector<std::string> m_args;
+
+	/**************************************************************************************************//**
+	* @brief		Prefix.
+	* @details	Config argument prefix.
+	******************************************************************************************************/
+	std::string m_prefix;
+
+	/**************************************************************************************************//**
+	* @brief		Values.
+	* @details	Parsed values (key is "<group>.<key>" in lower case).
+	******************************************************************************************************/
+	std::map<std::string, std::string> m_values;
+};
+
+
+#endif // !MARSTECH_PASSIVECONFIGARGSSOURCE_H
+
+/** @} */	//End of group MCONFIG.
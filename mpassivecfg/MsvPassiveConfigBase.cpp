@@ -42,7 +42,8 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 
 MsvPassiveConfigBase::MsvPassiveConfigBase():
 	m_cfgIdWithError(INT32_MIN),
-	m_lineNumberWithError(INT32_MIN)
+	m_lineNumberWithError(INT32_MIN),
+	m_pScalarValues(nullptr)
 {
 
 }
@@ -61,27 +62,27 @@ MsvPassiveConfigBase::~MsvPassiveConfigBase()
 
 MsvErrorCode MsvPassiveConfigBase::GetValue(int32_t cfgId, bool& value) const
 {
-	return GetValue<bool>(cfgId, m_boolValues, value);
+	return GetScalarValue<bool>(cfgId, value);
 }
 
 MsvErrorCode MsvPassiveConfigBase::GetValue(int32_t cfgId, double& value) const
 {
-	return GetValue<double>(cfgId, m_doubleValues, value);
+	return GetScalarValue<double>(cfgId, value);
 }
 
 MsvErrorCode MsvPassiveConfigBase::GetValue(int32_t cfgId, int64_t& value) const
 {
-	return GetValue<int64_t>(cfgId, m_integerValues, value);
+	return GetScalarValue<int64_t>(cfgId, value);
 }
 
 MsvErrorCode MsvPassiveConfigBase::GetValue(int32_t cfgId, std::string& value) const
 {
-	return GetValue<std::string>(cfgId, m_stringValues, value);
+	return GetValue<std::string>(cfgId, m_values.m_stringValues, value);
 }
 
 MsvErrorCode MsvPassiveConfigBase::GetValue(int32_t cfgId, uint64_t& value) const
 {
-	return GetValue<uint64_t>(cfgId, m_unsignedValues, value);
+	return GetScalarValue<uint64_t>(cfgId, value);
 }
 
 MsvErrorCode MsvPassiveConfigBase::Initialize(std::shared_ptr<IMsvConfigKeyMap<IMsvConfigKey>> spConfigKeyMap, const char* configPath)
@@ -99,15 +100,40 @@ MsvErrorCode MsvPassiveConfigBase::Initialize(std::shared_ptr<IMsvConfigKeyMap<I
 	m_configPath.assign(configPath);
 	m_spConfigKeyMap = spConfigKeyMap;
 
-	//load configuration from real storage implementation
-	MsvErrorCode errorCode = ReloadConfiguration();
+	//create slots for all scalar config keys (slots are immutable -> lock free readers)
+	std::vector<int32_t> scalarCfgIds;
+	const std::map<int32_t, std::shared_ptr<IMsvConfigKey>>& keyMap = m_spConfigKeyMap->GetMap();
+	for (std::map<int32_t, std::shared_ptr<IMsvConfigKey>>::const_iterator it = keyMap.begin(); it != keyMap.end(); ++it)
+	{
+		if (!it->second->IsString())
+		{
+			scalarCfgIds.push_back(it->first);
+		}
+	}
+	std::unique_ptr<MsvScalarValues> spScalarValues(new (std::nothrow) MsvScalarValues(std::move(scalarCfgIds)));
+	if (!spScalarValues || !spScalarValues->IsValid())
+	{
+		m_configPath.clear();
+		m_spConfigKeyMap.reset();
+		return MSV_ALLOCATION_ERROR;
+	}
+	m_scalarValues.push_front(std::move(spScalarValues));
+
+	//load configuration from real storage implementation (initial load is not notified)
+	std::vector<int32_t> changedCfgIds;
+	MsvErrorCode errorCode = ReloadValues(changedCfgIds, nullptr);
 	if (MSV_FAILED(errorCode))
 	{
-		//load failed -> reset file name config key map
+		//load failed -> reset file name config key map (slots have not been published, retry creates new ones)
+		m_scalarValues.pop_front();
 		m_configPath.clear();
 		m_spConfigKeyMap.reset();
+		return errorCode;
 	}
 
+	//publish scalar values for lock free readers
+	m_pScalarValues.store(m_scalarValues.front().get(), std::memory_order_release);
+
 	return errorCode;
 }
 
@@ -119,23 +145,201 @@ void MsvPassiveConfigBase::ReadFailedData(int32_t& lineNumber, int32_t& cfgId) c
 	cfgId = m_cfgIdWithError;
 }
 
+MsvErrorCode MsvPassiveConfigBase::ReloadConfiguration()
+{
+	std::vector<int32_t> changedCfgIds;
+	return ReloadConfiguration(changedCfgIds);
+}
+
+MsvErrorCode MsvPassiveConfigBase::ReloadConfiguration(std::vector<int32_t>& changedCfgIds)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	changedCfgIds.clear();
+
+	//check if config has been already initialized (we need these two values for successfull reload)
+	if (m_configPath.empty() || !m_spConfigKeyMap)
+	{
+		//config is not initialized -> return error
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	//old and new values are needed only when someone is listening
+	std::vector<MsvConfigValueChange> changes;
+	MsvErrorCode errorCode = ReloadValues(changedCfgIds, m_callbacks.empty() ? nullptr : &changes);
+
+	if (MSV_SUCCEEDED(errorCode) && !changes.empty())
+	{
+		NotifyCallbacks(changes);
+	}
+
+	if (MSV_SUCCEEDED(errorCode))
+	{
+		//event loops are signaled after values have been applied
+		m_notifier.Notify(changedCfgIds);
+	}
+
+	return errorCode;
+}
+
+MsvErrorCode MsvPassiveConfigBase::RegisterCallback(std::shared_ptr<IMsvPassiveConfigCallback> spCallback)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	//there is no check if is initilized or not (it is possible to register callback before initialized)
+
+	std::forward_list<std::shared_ptr<IMsvPassiveConfigCallback>>::iterator endIt = m_callbacks.end();
+	for (std::forward_list<std::shared_ptr<IMsvPassiveConfigCallback>>::iterator it = m_callbacks.begin(); it != endIt; ++it)
+	{
+		if (*it == spCallback)
+		{
+			//callback is already registered
+			return MSV_ALREADY_REGISTERED_INFO;
+		}
+	}
+
+	//register callback
+	m_callbacks.push_front(spCallback);
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvPassiveConfigBase::UnregisterCallback(std::shared_ptr<IMsvPassiveConfigCallback> spCallback)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	m_callbacks.remove(spCallback);
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvPassiveConfigBase::GetNotificationHandle(int& handle)
+{
+	return m_notifier.GetHandle(handle);
+}
+
+MsvErrorCode MsvPassiveConfigBase::DrainChanges(std::vector<int32_t>& changedCfgIds)
+{
+	m_notifier.Drain(changedCfgIds);
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvPassiveConfigBase::GetSnapshot(std::shared_ptr<const MsvConfigSnapshot>& spSnapshot) const
+{
+	//check if config is initialized (scalar values are published at the end of successful initialization)
+	if (!m_pScalarValues.load(std::memory_order_acquire))
+	{
+		//config is not initilized -> return error
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	//snapshot is cached until next reload which changes values -> no lock and no copy
+	spSnapshot = m_snapshot.Load();
+	if (spSnapshot)
+	{
+		return MSV_SUCCESS;
+	}
+
+	//snapshot is published under shared lock -> reload (it invalidates snapshot under exclusive lock) can not make it stale
+	std::shared_lock<std::shared_mutex> valuesLock(m_valuesLock);
+
+	MsvConfigValues values(m_values);
+	spSnapshot = m_snapshot.Publish(std::move(values));
+
+	return spSnapshot ? MSV_SUCCESS : MSV_ALLOCATION_ERROR;
+}
+
+MsvErrorCode MsvPassiveConfigBase::PushOverrides(const std::vector<MsvConfigValueUpdate>& values)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	if (!m_spConfigKeyMap)
+	{
+		//config is not initilized -> return error
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	return MsvConfigOverrides::Push(this, m_spConfigKeyMap->GetMap(), values);
+}
+
+MsvErrorCode MsvPassiveConfigBase::PopOverrides()
+{
+	return MsvConfigOverrides::Pop(this);
+}
+
 
 /********************************************************************************************************************************
 *															MsvPassiveConfigBase protected methods
 ********************************************************************************************************************************/
 
 
-template<class T> MsvErrorCode MsvPassiveConfigBase::GetValue(int32_t cfgId, const std::map<int32_t, T>& values, T& value) const
+MsvErrorCode MsvPassiveConfigBase::ReloadValues(std::vector<int32_t>& changedCfgIds, std::vector<MsvConfigValueChange>* pChanges)
 {
 	std::lock_guard<std::recursive_mutex> lock(m_lock);
 
-	//check if config is initialized
-	if (m_configPath.empty())
+	//load new values from real storage implementation
+	MsvConfigValues newValues;
+	MsvErrorCode errorCode = LoadConfiguration(newValues);
+	if (MSV_FAILED(errorCode))
+	{
+		//somethink failed -> clear all values (they might not be valid)
+		{
+			std::unique_lock<std::shared_mutex> valuesLock(m_valuesLock);
+			m_values.Clear();
+			m_snapshot.Invalidate();
+		}
+		UpdateScalarValues();
+		return errorCode;
+	}
+
+	//update only changed values (readers wait only for apply, not for load)
+	{
+		std::unique_lock<std::shared_mutex> valuesLock(m_valuesLock);
+		m_values.Apply(newValues, changedCfgIds, pChanges);
+
+		if (!changedCfgIds.empty())
+		{
+			m_snapshot.Invalidate();
+		}
+	}
+
+	if (!changedCfgIds.empty())
+	{
+		UpdateScalarValues();
+	}
+
+	return errorCode;
+}
+
+void MsvPassiveConfigBase::NotifyCallbacks(const std::vector<MsvConfigValueChange>& changes)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	std::forward_list<std::shared_ptr<IMsvPassiveConfigCallback>>::iterator endIt = m_callbacks.end();
+	for (std::forward_list<std::shared_ptr<IMsvPassiveConfigCallback>>::iterator it = m_callbacks.begin(); it != endIt; ++it)
+	{
+		(*it)->OnConfigurationChanged(changes);
+	}
+}
+
+template<class T> MsvErrorCode MsvPassiveConfigBase::GetValue(int32_t cfgId, const std::map<int32_t, T>& values, T& value) const
+{
+	//overrides of calling thread (one thread local load when thread has none)
+	if (MsvConfigOverrides::GetValue(this, cfgId, value))
+	{
+		return MSV_SUCCESS;
+	}
+
+	//check if config is initialized (scalar values are published at the end of successful initialization)
+	if (!m_pScalarValues.load(std::memory_order_acquire))
 	{
 		//config is not initilized -> return error
 		return MSV_NOT_INITIALIZED_ERROR;
 	}
 
+	std::shared_lock<std::shared_mutex> valuesLock(m_valuesLock);
+
 	//find value
 	typename std::map<int32_t, T>::const_iterator it = values.find(cfgId);
 
@@ -150,4 +354,33 @@ template<class T> MsvErrorCode MsvPassiveConfigBase::GetValue(int32_t cfgId, con
 	return MSV_NOT_FOUND_ERROR;
 }
 
+template<class T> MsvErrorCode MsvPassiveConfigBase::GetScalarValue(int32_t cfgId, T& value) const
+{
+	//overrides of calling thread (one thread local load when thread has none)
+	if (MsvConfigOverrides::GetValue(this, cfgId, value))
+	{
+		return MSV_SUCCESS;
+	}
+
+	//no lock -> scalar values are published when config is initialized and never released
+	const MsvScalarValues* pScalarValues = m_pScalarValues.load(std::memory_order_acquire);
+	if (!pScalarValues)
+	{
+		//config is not initilized -> return error
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	return pScalarValues->GetValue(cfgId, value);
+}
+
+void MsvPassiveConfigBase::UpdateScalarValues()
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	if (!m_scalarValues.empty())
+	{
+		m_scalarValues.front()->Update(m_values);
+	}
+}
+
 /** @} */	//End of group MCONFIG.
@@ -36,11 +36,18 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 
 
 #include "IMsvPassiveConfig.h"
+#include "mconfig/common/MsvChangeNotifier.h"
+#include "mconfig/common/MsvConfigValues.h"
+#include "mconfig/common/MsvScalarValues.h"
 
 MSV_DISABLE_ALL_WARNINGS
 
+#include <atomic>
+#include <forward_list>
+#include <memory>
 #include <mutex>
 #include <map>
+#include <shared_mutex>
 
 MSV_ENABLE_WARNINGS
 
@@ -48,8 +55,10 @@ MSV_ENABLE_WARNINGS
 /**************************************************************************************************//**
 * @brief		MarsTech Passive Config Base Implementation.
 * @details	Base implementation for passive configuration.
-* @note		It does not implement @ref IMsvPassiveConfig::ReloadConfiguration(). It should be implemented
-*				by a child class.
+* @note		It does not load configuration values. Loading is implemented by a child class in
+*				@ref LoadConfiguration, reload logic (comparing and updating changed values) is common.
+*				Scalar values (bool, double, int64_t and uint64_t) are read lock free (@ref MsvScalarValues),
+*				readers retry when reload is updating values. String values are read under lock.
 * @see		IMsvPassiveConfig
 ******************************************************************************************************/
 class MsvPassiveConfigBase:
@@ -105,14 +114,91 @@ public:
 	******************************************************************************************************/
 	virtual void ReadFailedData(int32_t& lineNumber, int32_t& cfgId) const override;
 
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::ReloadConfiguration()
+	******************************************************************************************************/
+	virtual MsvErrorCode ReloadConfiguration() override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::ReloadConfiguration(std::vector<int32_t>& changedCfgIds)
+	******************************************************************************************************/
+	virtual MsvErrorCode ReloadConfiguration(std::vector<int32_t>& changedCfgIds) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::RegisterCallback(std::shared_ptr<IMsvPassiveConfigCallback> spCallback)
+	******************************************************************************************************/
+	virtual MsvErrorCode RegisterCallback(std::shared_ptr<IMsvPassiveConfigCallback> spCallback) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::UnregisterCallback(std::shared_ptr<IMsvPassiveConfigCallback> spCallback)
+	******************************************************************************************************/
+	virtual MsvErrorCode UnregisterCallback(std::shared_ptr<IMsvPassiveConfigCallback> spCallback) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::GetNotificationHandle(int& handle)
+	******************************************************************************************************/
+	virtual MsvErrorCode GetNotificationHandle(int& handle) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::DrainChanges(std::vector<int32_t>& changedCfgIds)
+	******************************************************************************************************/
+	virtual MsvErrorCode DrainChanges(std::vector<int32_t>& changedCfgIds) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::GetSnapshot(std::shared_ptr<const MsvConfigSnapshot>& spSnapshot) const
+	******************************************************************************************************/
+	virtual MsvErrorCode GetSnapshot(std::shared_ptr<const MsvConfigSnapshot>& spSnapshot) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::PushOverrides(const std::vector<MsvConfigValueUpdate>& values)
+	******************************************************************************************************/
+	virtual MsvErrorCode PushOverrides(const std::vector<MsvConfigValueUpdate>& values) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::PopOverrides()
+	******************************************************************************************************/
+	virtual MsvErrorCode PopOverrides() override;
+
 
 	/*-----------------------------------------------------------------------------------------------------
 	**											MsvPassiveConfigBase protected methods
 	**---------------------------------------------------------------------------------------------------*/
 protected:
+	/**************************************************************************************************//**
+	* @brief			Load configuration.
+	* @details		Loads all configuration values (specified in config key map) from real configuration
+	*					storage (file, etc.). It is called (locked) by @ref ReloadConfiguration.
+	* @param[out]	values		Loaded values.
+	* @retval		MSV_PARSE_ERROR				When parsing configuration file failed.
+	* @retval		MSV_INVALID_DATA_ERROR		When value has different type then requested.
+	* @retval		MSV_UNKNOWN_ERROR				Unknown value type (not supported).
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode LoadConfiguration(MsvConfigValues& values) = 0;
+
+	/**************************************************************************************************//**
+	* @brief			Reload values.
+	* @details		Loads configuration (@ref LoadConfiguration) and updates changed values. It does not check
+	*					initialization and it does not notify callbacks.
+	* @param[out]	changedCfgIds	Sorted config IDs of changed values.
+	* @param[out]	pChanges			Changed values with old and new values (not filled when nullptr).
+	* @retval		MSV_PARSE_ERROR				When parsing configuration file failed.
+	* @retval		MSV_INVALID_DATA_ERROR		When value has different type then requested.
+	* @retval		MSV_UNKNOWN_ERROR				Unknown value type (not supported).
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode ReloadValues(std::vector<int32_t>& changedCfgIds, std::vector<MsvConfigValueChange>* pChanges);
+
+	/**************************************************************************************************//**
+	* @brief			Notify callbacks.
+	* @details		Notifies all registered callbacks about changed values.
+	* @param[in]	changes		Changed values.
+	******************************************************************************************************/
+	virtual void NotifyCallbacks(const std::vector<MsvConfigValueChange>& changes);
+
 	/**************************************************************************************************//**
 	* @brief			Get value.
-	* @details		Template method used in virtual Get methods.
+	* @details		Template method used in virtual Get methods. Readers proceed in parallel (shared lock).
 	* @param[in]	cfgId		Config ID to get its value.
 	* @param[in]	values	Config key storage with loaded values.
 	* @param[out]	value		Found and returned value.
@@ -122,6 +208,23 @@ protected:
 	******************************************************************************************************/
 	template<class T> MsvErrorCode GetValue(int32_t cfgId, const std::map<int32_t, T>& values, T& value) const;
 
+	/**************************************************************************************************//**
+	* @brief			Get scalar value.
+	* @details		Template method used in virtual Get methods of scalar values. It does not lock.
+	* @param[in]	cfgId		Config ID to get its value.
+	* @param[out]	value		Found and returned value.
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_NOT_FOUND_ERROR			When config ID (cfgId) does not exist.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	template<class T> MsvErrorCode GetScalarValue(int32_t cfgId, T& value) const;
+
+	/**************************************************************************************************//**
+	* @brief		Update scalar values.
+	* @details	Copies scalar values from @ref m_values to lock free storage (readers retry meanwhile).
+	******************************************************************************************************/
+	virtual void UpdateScalarValues();
+
 protected:
 	/**************************************************************************************************//**
 	* @brief		Config mutex.
@@ -129,6 +232,13 @@ protected:
 	******************************************************************************************************/
 	mutable std::recursive_mutex m_lock;
 
+	/**************************************************************************************************//**
+	* @brief		Values mutex.
+	* @details	Reader/writer lock of @ref m_values. Readers share it (they do not lock @ref m_lock), reload
+	*				locks it exclusively only while values are changed.
+	******************************************************************************************************/
+	mutable std::shared_mutex m_valuesLock;
+
 	/**************************************************************************************************//**
 	* @brief		Failed config ID.
 	* @details	Contains config ID which reading failed.
@@ -157,49 +267,51 @@ protected:
 	******************************************************************************************************/
 	std::shared_ptr<IMsvConfigKeyMap<IMsvConfigKey>> m_spConfigKeyMap;
 
-	/*-----------------------------------------------------------------------------------------------------
-	**										MsvPassiveConfigBase value storages (maps)
-	**---------------------------------------------------------------------------------------------------*/
-
 	/**************************************************************************************************//**
-	* @brief		Bool values.
-	* @details	Storage (map) of bool values.
+	* @brief		Config values.
+	* @details	Storage (maps) of loaded config values.
 	* @see		ReloadConfiguration
-	* @see		GetValue(int32_t cfgId, bool& value) 
+	* @see		GetValue
 	******************************************************************************************************/
-	std::map<int32_t, bool> m_boolValues;
+	MsvConfigValues m_values;
 
 	/**************************************************************************************************//**
-	* @brief		Double values.
-	* @details	Storage (map) of double values.
-	* @see		ReloadConfiguration
-	* @see		GetValue(int32_t cfgId, double& value)
+	* @brief		Registered callbacks.
+	* @details	Contains all registered callbacks which will be notified about data changes.
+	* @see		RegisterCallback
+	* @see		UnregisterCallback
 	******************************************************************************************************/
-	std::map<int32_t, double> m_doubleValues;
+	std::forward_list<std::shared_ptr<IMsvPassiveConfigCallback>> m_callbacks;
 
 	/**************************************************************************************************//**
-	* @brief		Integer values.
-	* @details	Storage (map) of int64_t values.
-	* @see		ReloadConfiguration
-	* @see		GetValue(int32_t cfgId, int64_t& value)
+	* @brief		Change notifier.
+	* @details	Collects config IDs changed by reload and signals them by pollable handle.
+	* @see		GetNotificationHandle
+	* @see		DrainChanges
 	******************************************************************************************************/
-	std::map<int32_t, int64_t> m_integerValues;
+	MsvChangeNotifier m_notifier;
 
 	/**************************************************************************************************//**
-	* @brief		String values.
-	* @details	Storage (map) of string values.
-	* @see		ReloadConfiguration
-	* @see		GetValue(int32_t cfgId, std::string& value)
+	* @brief		Snapshot cache.
+	* @details	Snapshot of current values (invalidated when reload changes values, rebuilt by next reader).
+	* @see		GetSnapshot
 	******************************************************************************************************/
-	std::map<int32_t, std::string> m_stringValues;
+	mutable MsvConfigSnapshotCache m_snapshot;
 
 	/**************************************************************************************************//**
-	* @brief		Unsigned integer values.
-	* @details	Storage (map) of uint64_t values.
-	* @see		ReloadConfiguration
-	* @see		GetValue(int32_t cfgId, uint64_t& value)
+	* @brief		Scalar values storage.
+	* @details	Owns scalar values (created in @ref Initialize). The first one is the current one, older ones
+	*				(from failed initialization) are kept alive because lock free reader might still use them.
+	* @see		m_pScalarValues
+	******************************************************************************************************/
+	std::forward_list<std::unique_ptr<MsvScalarValues>> m_scalarValues;
+
+	/**************************************************************************************************//**
+	* @brief		Scalar values.
+	* @details	Published scalar values for lock free reads (nullptr when config is not initialized).
+	* @see		GetScalarValue
 	******************************************************************************************************/
-	std::map<int32_t, uint64_t> m_unsignedValues;
+	std::atomic<MsvScalarValues*> m_pScalarValues;
 };
 
 
@@ -0,0 +1,132 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Passive Config Binding
+* @details		Contains @ref MsvPassiveConfigBinding which mirrors passive config values into user-defined struct.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_PASSIVECONFIGBINDING_H
+#define MARSTECH_PASSIVECONFIGBINDING_H
+
+
+#include "IMsvPassiveConfig.h"
+#include "IMsvPassiveConfigCallback.h"
+
+#include "mconfig/common/MsvConfigBinding.h"
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Passive Config Binding Callback.
+* @details	Callback registered to passive config, it applies changes to parent binding.
+* @see		IMsvPassiveConfigCallback
+******************************************************************************************************/
+template<class T>
+class MsvPassiveConfigBindingCallback:
+	public IMsvPassiveConfigCallback
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	spLink		Shared pointer to link to parent (@ref MsvPassiveConfigBinding).
+	******************************************************************************************************/
+	MsvPassiveConfigBindingCallback(std::shared_ptr<MsvConfigBindingLink<T>> spLink):
+		m_spLink(spLink)
+	{
+
+	}
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfigCallback::OnConfigurationChanged(const std::vector<MsvConfigValueChange>& changes)
+	******************************************************************************************************/
+	virtual void OnConfigurationChanged(const std::vector<MsvConfigValueChange>& changes) override
+	{
+		m_spLink->OnValuesChanged(changes);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Register callback.
+	* @param[in]	config		Passive config.
+	* @param[in]	spCallback	Callback to register.
+	* @retval		other_error_code	When register failed.
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	static MsvErrorCode Register(IMsvPassiveConfig& config, std::shared_ptr<MsvPassiveConfigBindingCallback<T>> spCallback)
+	{
+		return config.RegisterCallback(spCallback);
+	}
+
+	/**************************************************************************************************//**
+	* @brief			Unregister callback.
+	* @param[in]	config		Passive config.
+	* @param[in]	spCallback	Callback to unregister.
+	* @retval		other_error_code	When unregister failed.
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	static MsvErrorCode Unregister(IMsvPassiveConfig& config, std::shared_ptr<MsvPassiveConfigBindingCallback<T>> spCallback)
+	{
+		return config.UnregisterCallback(spCallback);
+	}
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Link to parent.
+	* @details	Link to object which creates this one (it is unlinked when parent is detached).
+	******************************************************************************************************/
+	std::shared_ptr<MsvConfigBindingLink<T>> m_spLink;
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Passive Config Binding.
+* @details	Mirrors passive config values into fields of user-defined struct. Bound fields are loaded when
+*				binding is attached and updated by reload notifications (all values of one reload are
+*				updated together).
+* @see		MsvConfigBindingBase
+******************************************************************************************************/
+template<class T>
+class MsvPassiveConfigBinding:
+	public MsvConfigBindingBase<T, IMsvPassiveConfig, MsvPassiveConfigBindingCallback<T>>
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	spLogger			Shared pointer to logger for logging.
+	******************************************************************************************************/
+	MsvPassiveConfigBinding(std::shared_ptr<MsvLogger> spLogger = nullptr):
+		MsvConfigBindingBase<T, IMsvPassiveConfig, MsvPassiveConfigBindingCallback<T>>(spLogger)
+	{
+
+	}
+};
+
+
+#endif // !MARSTECH_PASSIVECONFIGBINDING_H
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,387 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Passive Config Compiler Implementation
+* @details		Contains implementation of @ref MsvPassiveConfigCompiler.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "MsvPassiveConfigCompiler.h"
+#include "MsvPassiveConfig.h"
+#include "mconfig/common/MsvChecksum.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvPassiveConfigCompiler::MsvPassiveConfigCompiler():
+	m_cfgIdWithError(INT32_MIN),
+	m_lineNumberWithError(INT32_MIN)
+{
+
+}
+
+MsvPassiveConfigCompiler::~MsvPassiveConfigCompiler()
+{
+
+}
+
+
+/********************************************************************************************************************************
+*															MsvPassiveConfigCompiler public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvPassiveConfigCompiler::Compile(std::shared_ptr<IMsvConfigKeyMap<IMsvConfigKey>> spConfigKeyMap, const char* configPath, const char* imagePath)
+{
+	m_cfgIdWithError = INT32_MIN;
+	m_lineNumberWithError = INT32_MIN;
+
+	if (!spConfigKeyMap || !configPath || !imagePath)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	MsvPassiveConfigImageHeader header;
+	memset(&header, 0, sizeof(header));
+	header.m_magic = MSV_PASSIVECONFIG_IMAGE_MAGIC;
+	header.m_version = MSV_PASSIVECONFIG_IMAGE_VERSION;
+
+	//source checksum must be computed before parsing (when file changes during parsing, image will be stale)
+	if (!MsvChecksum::ComputeFile(configPath, header.m_sourceChecksum, header.m_sourceSize))
+	{
+		//same as INI parser does when file could not be opened
+		m_lineNumberWithError = -1;
+		return MSV_PARSE_ERROR;
+	}
+
+	MSV_RETURN_FAILED(ComputeKeyMapChecksum(spConfigKeyMap, header.m_keyMapChecksum));
+
+	//parse config file (image values are the same as values of standard passive config)
+	MsvPassiveConfig config;
+	MsvErrorCode errorCode = config.Initialize(spConfigKeyMap, configPath);
+	if (MSV_FAILED(errorCode))
+	{
+		config.ReadFailedData(m_lineNumberWithError, m_cfgIdWithError);
+		return errorCode;
+	}
+
+	//config key map is sorted by config ID -> entries are sorted as well
+	const std::map<int32_t, std::shared_ptr<IMsvConfigKey>>& configKeys = spConfigKeyMap->GetMap();
+	std::vector<MsvPassiveConfigImageEntry> entries;
+	std::string stringPool;
+	entries.reserve(configKeys.size());
+
+	for (std::map<int32_t, std::shared_ptr<IMsvConfigKey>>::const_iterator it = configKeys.begin(); it != configKeys.end(); ++it)
+	{
+		MsvPassiveConfigImageEntry entry;
+		memset(&entry, 0, sizeof(entry));
+		entry.m_cfgId = it->first;
+
+		if (it->second->IsBool())
+		{
+			bool value;
+			errorCode = config.GetValue(it->first, value);
+			entry.m_type = static_cast<uint32_t>(MsvPassiveConfigImageType::MSV_IMAGE_BOOL);
+			entry.m_value = value ? 1 : 0;
+		}
+		else if (it->second->IsDouble())
+		{
+			double value;
+			errorCode = config.GetValue(it->first, value);
+			entry.m_type = static_cast<uint32_t>(MsvPassiveConfigImageType::MSV_IMAGE_DOUBLE);
+			memcpy(&entry.m_value, &value, sizeof(value));
+		}
+		else if (it->second->IsInteger())
+		{
+			int64_t value;
+			errorCode = config.GetValue(it->first, value);
+			entry.m_type = static_cast<uint32_t>(MsvPassiveConfigImageType::MSV_IMAGE_INTEGER);
+			entry.m_value = static_cast<uint64_t>(value);
+		}
+		else if (it->second->IsString())
+		{
+			std::string value;
+			errorCode = config.GetValue(it->first, value);
+			entry.m_type = static_cast<uint32_t>(MsvPassiveConfigImageType::MSV_IMAGE_STRING);
+			entry.m_value = stringPool.size();
+			entry.m_size = value.size();
+
+			//strings are null terminated (they might be returned directly from image)
+			stringPool.append(value);
+			stringPool.push_back('\0');
+		}
+		else if (it->second->IsUnsigned())
+		{
+			errorCode = config.GetValue(it->first, entry.m_value);
+			entry.m_type = static_cast<uint32_t>(MsvPassiveConfigImageType::MSV_IMAGE_UNSIGNED);
+		}
+		else
+		{
+			errorCode = MSV_UNKNOWN_ERROR;
+		}
+
+		if (MSV_FAILED(errorCode))
+		{
+			m_cfgIdWithError = it->first;
+			return errorCode;
+		}
+
+		entries.push_back(entry);
+	}
+
+	//layout: header, entries, string pool
+	header.m_entriesOffset = sizeof(MsvPassiveConfigImageHeader);
+	header.m_entryCount = entries.size();
+	header.m_stringPoolOffset = header.m_entriesOffset + entries.size() * sizeof(MsvPassiveConfigImageEntry);
+	header.m_stringPoolSize = stringPool.size();
+	header.m_imageSize = header.m_stringPoolOffset + header.m_stringPoolSize;
+
+	std::vector<uint8_t> image(static_cast<size_t>(header.m_imageSize));
+	if (!entries.empty())
+	{
+		memcpy(image.data() + header.m_entriesOffset, entries.data(), entries.size() * sizeof(MsvPassiveConfigImageEntry));
+	}
+	if (!stringPool.empty())
+	{
+		memcpy(image.data() + header.m_stringPoolOffset, stringPool.data(), stringPool.size());
+	}
+
+	header.m_checksum = MsvChecksum::Compute(image.data() + sizeof(MsvPassiveConfigImageHeader), image.size() - sizeof(MsvPassiveConfigImageHeader));
+	memcpy(image.data(), &header, sizeof(header));
+
+	return WriteImage(imagePath, image);
+}
+
+void MsvPassiveConfigCompiler::ReadFailedData(int32_t& lineNumber, int32_t& cfgId) const
+{
+	lineNumber = m_lineNumberWithError;
+	cfgId = m_cfgIdWithError;
+}
+
+MsvErrorCode MsvPassiveConfigCompiler::CheckImage(const uint8_t* pData, size_t size, const char* configPath, uint64_t keyMapChecksum)
+{
+	if (!pData || size < sizeof(MsvPassiveConfigImageHeader))
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	const MsvPassiveConfigImageHeader* pHeader = reinterpret_cast<const MsvPassiveConfigImageHeader*>(pData);
+
+	//check header (all offsets must be inside of image)
+	if (pHeader->m_magic != MSV_PASSIVECONFIG_IMAGE_MAGIC || pHeader->m_version != MSV_PASSIVECONFIG_IMAGE_VERSION || pHeader->m_imageSize != size
+		|| pHeader->m_entriesOffset != sizeof(MsvPassiveConfigImageHeader) || pHeader->m_entryCount > (size - pHeader->m_entriesOffset) / sizeof(MsvPassiveConfigImageEntry)
+		|| pHeader->m_stringPoolOffset != pHeader->m_entriesOffset + pHeader->m_entryCount * sizeof(MsvPassiveConfigImageEntry)
+		|| pHeader->m_stringPoolOffset + pHeader->m_stringPoolSize != size)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	if (MsvChecksum::Compute(pData + sizeof(MsvPassiveConfigImageHeader), size - sizeof(MsvPassiveConfigImageHeader)) != pHeader->m_checksum)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	//check entries (sorted config IDs, known types and strings inside of string pool) -> reads do not have to check it
+	const MsvPassiveConfigImageEntry* pEntries = reinterpret_cast<const MsvPassiveConfigImageEntry*>(pData + pHeader->m_entriesOffset);
+	const char* pStringPool = reinterpret_cast<const char*>(pData + pHeader->m_stringPoolOffset);
+	for (uint64_t i = 0; i < pHeader->m_entryCount; ++i)
+	{
+		if ((i > 0 && pEntries[i - 1].m_cfgId >= pEntries[i].m_cfgId) || pEntries[i].m_type > static_cast<uint32_t>(MsvPassiveConfigImageType::MSV_IMAGE_UNSIGNED))
+		{
+			return MSV_INVALID_DATA_ERROR;
+		}
+
+		if (pEntries[i].m_type == static_cast<uint32_t>(MsvPassiveConfigImageType::MSV_IMAGE_STRING)
+			&& (pEntries[i].m_value >= pHeader->m_stringPoolSize || pEntries[i].m_size >= pHeader->m_stringPoolSize - pEntries[i].m_value
+				|| pStringPool[pEntries[i].m_value + pEntries[i].m_size] != '\0'))
+		{
+			return MSV_INVALID_DATA_ERROR;
+		}
+	}
+
+	//check if image is up to date
+	uint64_t sourceChecksum, sourceSize;
+	if (!MsvChecksum::ComputeFile(configPath, sourceChecksum, sourceSize))
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	if (sourceChecksum != pHeader->m_sourceChecksum || sourceSize != pHeader->m_sourceSize || keyMapChecksum != pHeader->m_keyMapChecksum)
+	{
+		return MSV_ALREADY_EXISTS_INFO;
+	}
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvPassiveConfigCompiler::ComputeKeyMapChecksum(std::shared_ptr<IMsvConfigKeyMap<IMsvConfigKey>> spConfigKeyMap, uint64_t& checksum)
+{
+	checksum = MsvChecksum::INITIAL_VALUE;
+
+	if (!spConfigKeyMap)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	const std::map<int32_t, std::shared_ptr<IMsvConfigKey>>& configKeys = spConfigKeyMap->GetMap();
+	for (std::map<int32_t, std::shared_ptr<IMsvConfigKey>>::const_iterator it = configKeys.begin(); it != configKeys.end(); ++it)
+	{
+		std::string group, key, defaultValue;
+		MsvPassiveConfigImageType type;
+
+		if (it->second->IsBool())
+		{
+			bool value;
+			MSV_RETURN_FAILED(it->second->GetData(group, key, value));
+			type = MsvPassiveConfigImageType::MSV_IMAGE_BOOL;
+			defaultValue = value ? "1" : "0";
+		}
+		else if (it->second->IsDouble())
+		{
+			double value;
+			MSV_RETURN_FAILED(it->second->GetData(group, key, value));
+			type = MsvPassiveConfigImageType::MSV_IMAGE_DOUBLE;
+			defaultValue.assign(reinterpret_cast<const char*>(&value), sizeof(value));
+		}
+		else if (it->second->IsInteger())
+		{
+			int64_t value;
+			MSV_RETURN_FAILED(it->second->GetData(group, key, value));
+			type = MsvPassiveConfigImageType::MSV_IMAGE_INTEGER;
+			defaultValue = std::to_string(value);
+		}
+		else if (it->second->IsString())
+		{
+			MSV_RETURN_FAILED(it->second->GetData(group, key, defaultValue));
+			type = MsvPassiveConfigImageType::MSV_IMAGE_STRING;
+		}
+		else if (it->second->IsUnsigned())
+		{
+			uint64_t value;
+			MSV_RETURN_FAILED(it->second->GetData(group, key, value));
+			type = MsvPassiveConfigImageType::MSV_IMAGE_UNSIGNED;
+			defaultValue = std::to_string(value);
+		}
+		else
+		{
+			return MSV_UNKNOWN_ERROR;
+		}
+
+		//strings are hashed with terminating null (to separate them)
+		checksum = MsvChecksum::Compute(&it->first, sizeof(it->first), checksum);
+		checksum = MsvChecksum::Compute(&type, sizeof(type), checksum);
+		checksum = MsvChecksum::Compute(group.c_str(), group.size() + 1, checksum);
+		checksum = MsvChecksum::Compute(key.c_str(), key.size() + 1, checksum);
+		checksum = MsvChecksum::Compute(defaultValue.c_str(), defaultValue.size() + 1, checksum);
+	}
+
+	return MSV_SUCCESS;
+}
+
+
+std::string MsvPassiveConfigCompiler::GetVersionedImagePath(const char* imagePath, const char* configPath, uint64_t keyMapChecksum)
+{
+	//missing config file has its own version too (compilation reports parse error)
+	uint64_t sourceChecksum, sourceSize;
+	MsvChecksum::ComputeFile(configPath, sourceChecksum, sourceSize);
+
+	uint64_t version = MsvChecksum::Compute(&sourceSize, sizeof(sourceSize), sourceChecksum);
+	version = MsvChecksum::Compute(&keyMapChecksum, sizeof(keyMapChecksum), version);
+
+	std::stringstream versionedPath;
+	versionedPath << imagePath << "." << std::hex << std::setw(16) << std::setfill('0') << version;
+
+	return versionedPath.str();
+}
+
+
+/********************************************************************************************************************************
+*															MsvPassiveConfigCompiler protected methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvPassiveConfigCompiler::WriteImage(const char* imagePath, const std::vector<uint8_t>& image) const
+{
+	//temporary file is unique per process (more processes might compile the same image at the same time)
+#ifdef _WIN32
+	std::string tempPath = std::string(imagePath) + "." + std::to_string(GetCurrentProcessId()) + ".tmp";
+#else
+	std::string tempPath = std::string(imagePath) + "." + std::to_string(getpid()) + ".tmp";
+#endif
+
+	std::ofstream imageFile(tempPath, std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+	if (!imageFile.is_open())
+	{
+		return MSV_OPEN_ERROR;
+	}
+
+	imageFile.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+	imageFile.close();
+	if (imageFile.fail())
+	{
+		remove(tempPath.c_str());
+		return MSV_OPEN_ERROR;
+	}
+
+	//rename publishes complete image (image path is versioned -> it does not replace image mapped by other version readers)
+#ifdef _WIN32
+	if (!MoveFileExA(tempPath.c_str(), imagePath, MOVEFILE_REPLACE_EXISTING))
+#else
+	if (rename(tempPath.c_str(), imagePath) != 0)
+#endif
+	{
+		remove(tempPath.c_str());
+		return MSV_OPEN_ERROR;
+	}
+
+	return MSV_SUCCESS;
+}
+
+/** @} */	//End of group MCONFIG.
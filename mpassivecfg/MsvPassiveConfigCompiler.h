@@ -0,0 +1,168 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Passive Config Compiler
+* @details		Contains declaration of @ref MsvPassiveConfigCompiler which compiles config file to binary image.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_PASSIVECONFIGCOMPILER_H
+#define MARSTECH_PASSIVECONFIGCOMPILER_H
+
+
+#include "MsvPassiveConfigImage.h"
+#include "mconfig/common/IMsvConfigKey.h"
+#include "mconfig/common/IMsvConfigKeyMap.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <memory>
+#include <string>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Passive Config Compiler.
+* @details	Compiles INI config file (and config key map) to binary image which can be mapped by
+*				@ref MsvPassiveConfigMapped without parsing. It also validates existing images.
+* @see		MsvPassiveConfigImageHeader
+******************************************************************************************************/
+class MsvPassiveConfigCompiler
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	******************************************************************************************************/
+	MsvPassiveConfigCompiler();
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvPassiveConfigCompiler();
+
+	/**************************************************************************************************//**
+	* @brief			Compile image.
+	* @details		Loads config file and writes its values (specified by config key map) to binary image.
+	*					Image is written to temporary file which is renamed to image path (readers never see
+	*					partially written image). Image path should be versioned (see @ref GetVersionedImagePath),
+	*					mapped image is never replaced (it is not possible on Windows).
+	* @param[in]	spConfigKeyMap		Config key map (config IDs with its config file paths and default values).
+	* @param[in]	configPath			Path to config file.
+	* @param[in]	imagePath			Path to image.
+	* @retval		MSV_PARSE_ERROR				When parsing configuration file failed.
+	* @retval		MSV_INVALID_DATA_ERROR		When value has different type then requested.
+	* @retval		MSV_UNKNOWN_ERROR				Unknown value type (not supported).
+	* @retval		MSV_ALLOCATION_ERROR			When allocation failed.
+	* @retval		MSV_OPEN_ERROR					When image could not be written.
+	* @retval		MSV_SUCCESS						On success.
+	* @see			ReadFailedData
+	******************************************************************************************************/
+	virtual MsvErrorCode Compile(std::shared_ptr<IMsvConfigKeyMap<IMsvConfigKey>> spConfigKeyMap, const char* configPath, const char* imagePath);
+
+	/**************************************************************************************************//**
+	* @brief			Read failed data.
+	* @details		Returns line number and config ID which failed during last compilation.
+	* @param[out]	lineNumber		Line number in config file where parsing failed.
+	* @param[out]	cfgId				Config ID which failed.
+	* @see			IMsvPassiveConfig::ReadFailedData
+	******************************************************************************************************/
+	virtual void ReadFailedData(int32_t& lineNumber, int32_t& cfgId) const;
+
+	/**************************************************************************************************//**
+	* @brief			Check image.
+	* @details		Checks image integrity (header, checksum, entries) and if it is up to date with config
+	*					file and config key map.
+	* @param[in]	pData					Pointer to image data.
+	* @param[in]	size					Size of image data.
+	* @param[in]	configPath			Path to config file (image source).
+	* @param[in]	keyMapChecksum		Checksum of config key map (see @ref ComputeKeyMapChecksum).
+	* @retval		MSV_INVALID_DATA_ERROR		When image is corrupted.
+	* @retval		MSV_NOT_FOUND_ERROR			When config file does not exist.
+	* @retval		MSV_ALREADY_EXISTS_INFO		When image is valid but stale (config file or key map has changed).
+	* @retval		MSV_SUCCESS						When image is valid and up to date.
+	******************************************************************************************************/
+	static MsvErrorCode CheckImage(const uint8_t* pData, size_t size, const char* configPath, uint64_t keyMapChecksum);
+
+	/**************************************************************************************************//**
+	* @brief			Compute config key map checksum.
+	* @details		Computes checksum of config IDs, value types, config file paths (groups and keys) and
+	*					default values. Image compiled with different config key map is stale.
+	* @param[in]	spConfigKeyMap		Config key map.
+	* @param[out]	checksum				Computed checksum.
+	* @retval		MSV_INVALID_DATA_ERROR		When config key data could not be read.
+	* @retval		MSV_UNKNOWN_ERROR				Unknown value type (not supported).
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	static MsvErrorCode ComputeKeyMapChecksum(std::shared_ptr<IMsvConfigKeyMap<IMsvConfigKey>> spConfigKeyMap, uint64_t& checksum);
+
+	/**************************************************************************************************//**
+	* @brief			Get versioned image path.
+	* @details		Returns image path with version suffix computed from config file content and config key
+	*					map checksum. Each version of config has its own image file -> new image never replaces
+	*					mapped one and all processes find the same image for the same config.
+	* @param[in]	imagePath			Base path to image.
+	* @param[in]	configPath			Path to config file (image source).
+	* @param[in]	keyMapChecksum		Checksum of config key map (see @ref ComputeKeyMapChecksum).
+	* @returns		Versioned image path.
+	******************************************************************************************************/
+	static std::string GetVersionedImagePath(const char* imagePath, const char* configPath, uint64_t keyMapChecksum);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Write image.
+	* @details		Writes image data to temporary file and renames it to image path.
+	* @param[in]	imagePath		Path to image.
+	* @param[in]	image				Image data.
+	* @retval		MSV_OPEN_ERROR		When image could not be written.
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode WriteImage(const char* imagePath, const std::vector<uint8_t>& image) const;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Failed config ID.
+	* @details	Contains config ID which reading failed.
+	* @see		ReadFailedData
+	******************************************************************************************************/
+	int32_t m_cfgIdWithError;
+
+	/**************************************************************************************************//**
+	* @brief		Failed line number.
+	* @details	Contains line number on which parsing config file failed.
+	* @see		ReadFailedData
+	******************************************************************************************************/
+	int32_t m_lineNumberWithError;
+};
+
+
+#endif // !MARSTECH_PASSIVECONFIGCOMPILER_H
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,111 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Passive Config Environment Source Implementation
+* @details		Contains implementation of @ref MsvPassiveConfigEnvSource.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "MsvPassiveConfigEnvSource.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cctype>
+#include <cstdlib>
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvPassiveConfigEnvSource::MsvPassiveConfigEnvSource(const char* prefix):
+	m_prefix(prefix)
+{
+
+}
+
+MsvPassiveConfigEnvSource::~MsvPassiveConfigEnvSource()
+{
+
+}
+
+
+/********************************************************************************************************************************
+*															IMsvPassiveConfigSource public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvPassiveConfigEnvSource::Load(int32_t& lineNumber)
+{
+	//environment is read directly (values are resolved once per configuration load)
+	lineNumber = INT32_MIN;
+	return MSV_SUCCESS;
+}
+
+bool MsvPassiveConfigEnvSource::GetValue(const std::string& group, const std::string& key, std::string& value) const
+{
+	const char* envValue = getenv(GetVariableName(group, key).c_str());
+	if (!envValue)
+	{
+		return false;
+	}
+
+	value.assign(envValue);
+	return true;
+}
+
+const char* MsvPassiveConfigEnvSource::GetName() const
+{
+	return "env";
+}
+
+
+/********************************************************************************************************************************
+*															MsvPassiveConfigEnvSource public methods
+********************************************************************************************************************************/
+
+
+std::string MsvPassiveConfigEnvSource::GetVariableName(const std::string& group, const std::string& key) const
+{
+	std::string name = group + "_" + key;
+
+	for (std::string::iterator it = name.begin(); it != name.end(); ++it)
+	{
+		*it = isalnum(static_cast<unsigned char>(*it)) ? static_cast<char>(toupper(static_cast<unsigned char>(*it))) : '_';
+	}
+
+	return m_prefix + name;
+}
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,109 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Passive Config Environment Source
+* @details		Contains declaration of @ref MsvPassiveConfigEnvSource (environment variables layer of passive configuration).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_PASSIVECONFIGENVSOURCE_H
+#define MARSTECH_PASSIVECONFIGENVSOURCE_H
+
+
+#include "IMsvPassiveConfigSource.h"
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Passive Config Environment Source.
+* @details	Passive configuration source which reads values from environment variables. Variable name is
+*				prefix followed by group and key separated by underscore, upper cased and all characters
+*				except letters and digits are replaced by underscore (e.g. group "GROUP_1" and key
+*				"bool_value" with prefix "MSV_" is "MSV_GROUP_1_BOOL_VALUE").
+* @see		IMsvPassiveConfigSource
+* @see		MsvPassiveConfigLayered
+******************************************************************************************************/
+class MsvPassiveConfigEnvSource:
+	public IMsvPassiveConfigSource
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	prefix		Environment variable name prefix.
+	******************************************************************************************************/
+	MsvPassiveConfigEnvSource(const char* prefix = "");
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvPassiveConfigEnvSource();
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvPassiveConfigSource public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfigSource::Load(int32_t& lineNumber)
+	******************************************************************************************************/
+	virtual MsvErrorCode Load(int32_t& lineNumber) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfigSource::GetValue(const std::string& group, const std::string& key, std::string& value) const
+	******************************************************************************************************/
+	virtual bool GetValue(const std::string& group, const std::string& key, std::string& value) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfigSource::GetName() const
+	******************************************************************************************************/
+	virtual const char* GetName() const override;
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											MsvPassiveConfigEnvSource public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @brief			Get variable name.
+	* @details		Returns environment variable name of config key.
+	* @param[in]	group		Config key group.
+	* @param[in]	key		Config key name.
+	* @returns		Environment variable name.
+	******************************************************************************************************/
+	virtual std::string GetVariableName(const std::string& group, const std::string& key) const;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Prefix.
+	* @details	Environment variable name prefix.
+	******************************************************************************************************/
+	std::string m_prefix;
+};
+
+
+#endif // !MARSTECH_PASSIVECONFIGENVSOURCE_H
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,113 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Passive Config Image
+* @details		Contains binary image format of precompiled passive configuration (see @ref MsvPassiveConfigCompiler and @ref MsvPassiveConfigMapped).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_PASSIVECONFIGIMAGE_H
+#define MARSTECH_PASSIVECONFIGIMAGE_H
+
+
+#include "merror/MsvError.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <cstdint>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		Image magic.
+* @details	First four bytes of each image ("MSVC").
+******************************************************************************************************/
+#define MSV_PASSIVECONFIG_IMAGE_MAGIC 0x4356534dU
+
+/**************************************************************************************************//**
+* @brief		Image version.
+* @details	Version of image format (it must be increased when format changes).
+******************************************************************************************************/
+#define MSV_PASSIVECONFIG_IMAGE_VERSION 1U
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Passive Config Image Value Type.
+* @details	Type of value stored in image entry.
+******************************************************************************************************/
+enum class MsvPassiveConfigImageType: uint32_t
+{
+	MSV_IMAGE_BOOL = 0,
+	MSV_IMAGE_DOUBLE,
+	MSV_IMAGE_INTEGER,
+	MSV_IMAGE_STRING,
+	MSV_IMAGE_UNSIGNED
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Passive Config Image Header.
+* @details	Header at the beginning of image. Image layout is: header, entries (sorted by config ID) and
+*				string pool (null terminated strings). All offsets are from the beginning of image.
+* @note		Image uses native byte order and alignment, it is a local cache of config file (it must not
+*				be shared between different platforms).
+******************************************************************************************************/
+struct MsvPassiveConfigImageHeader
+{
+	uint32_t m_magic;							//!< Image magic (@ref MSV_PASSIVECONFIG_IMAGE_MAGIC).
+	uint32_t m_version;						//!< Image version (@ref MSV_PASSIVECONFIG_IMAGE_VERSION).
+	uint64_t m_imageSize;					//!< Size of whole image (in bytes).
+	uint64_t m_checksum;						//!< Checksum of image content (everything behind header).
+	uint64_t m_sourceSize;					//!< Size of source config file (in bytes).
+	uint64_t m_sourceChecksum;				//!< Checksum of source config file content.
+	uint64_t m_keyMapChecksum;				//!< Checksum of config key map (config IDs, types, keys and default values).
+	uint64_t m_entriesOffset;				//!< Offset of entries.
+	uint64_t m_entryCount;					//!< Number of entries.
+	uint64_t m_stringPoolOffset;			//!< Offset of string pool.
+	uint64_t m_stringPoolSize;				//!< Size of string pool (in bytes).
+};
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Passive Config Image Entry.
+* @details	One config value. Scalar values are stored directly, strings are stored in string pool.
+******************************************************************************************************/
+struct MsvPassiveConfigImageEntry
+{
+	int32_t m_cfgId;							//!< Config ID.
+	uint32_t m_type;							//!< Value type (@ref MsvPassiveConfigImageType).
+	uint64_t m_value;							//!< Scalar value (bit copy) or string offset in string pool.
+	uint64_t m_size;							//!< String length (without terminating null), 0 for scalar values.
+};
+
+
+#endif // !MARSTECH_PASSIVECONFIGIMAGE_H
+
+/** @} */	//End of group MCONFIG.
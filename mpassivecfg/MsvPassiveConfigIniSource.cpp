@@ -0,0 +1,117 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Passive Config INI Source Implementation
+* @details		Contains implementation of @ref MsvPassiveConfigIniSource.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "MsvPassiveConfigIniSource.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include "3rdParty/inih/INIReader.h"
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvPassiveConfigIniSource::MsvPassiveConfigIniSource(const char* configPath, bool optional):
+	m_configPath(configPath),
+	m_name(std::string("ini:") + configPath),
+	m_optional(optional)
+{
+
+}
+
+MsvPassiveConfigIniSource::~MsvPassiveConfigIniSource()
+{
+
+}
+
+
+/********************************************************************************************************************************
+*															IMsvPassiveConfigSource public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvPassiveConfigIniSource::Load(int32_t& lineNumber)
+{
+	lineNumber = INT32_MIN;
+	m_spReader.reset();
+
+	//open INI file and parse it
+	std::shared_ptr<INIReader> spReader(new (std::nothrow) INIReader(m_configPath));
+	if (!spReader)
+	{
+		return MSV_ALLOCATION_ERROR;
+	}
+
+	if (spReader->ParseError() != 0)
+	{
+		if (m_optional && spReader->ParseError() == -1)
+		{
+			//optional file does not exist -> it has no values
+			return MSV_SUCCESS;
+		}
+
+		//parse INI file failed (or does not exist)
+		lineNumber = spReader->ParseError();
+		return MSV_PARSE_ERROR;
+	}
+
+	m_spReader = spReader;
+
+	return MSV_SUCCESS;
+}
+
+bool MsvPassiveConfigIniSource::GetValue(const std::string& group, const std::string& key, std::string& value) const
+{
+	if (!m_spReader)
+	{
+		return false;
+	}
+
+	//INI reader returns default value for missing keys -> two different defaults mean key is missing
+	value = m_spReader->Get(group, key, "0");
+	return value != "0" || m_spReader->Get(group, key, "1") == "0";
+}
+
+const char* MsvPassiveConfigIniSource::GetName() const
+{
+	return m_name.c_str();
+}
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,121 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Passive Config INI Source
+* @details		Contains declaration of @ref MsvPassiveConfigIniSource (INI file layer of passive configuration).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_PASSIVECONFIGINISOURCE_H
+#define MARSTECH_PASSIVECONFIGINISOURCE_H
+
+
+#include "IMsvPassiveConfigSource.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <memory>
+
+MSV_ENABLE_WARNINGS
+
+
+class INIReader;
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Passive Config INI Source.
+* @details	Passive configuration source which reads values from INI file.
+* @see		IMsvPassiveConfigSource
+* @see		MsvPassiveConfigLayered
+******************************************************************************************************/
+class MsvPassiveConfigIniSource:
+	public IMsvPassiveConfigSource
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	configPath		Path to INI file.
+	* @param[in]	optional			Flag if INI file is optional (missing file is not an error, it has no values).
+	******************************************************************************************************/
+	MsvPassiveConfigIniSource(const char* configPath, bool optional = false);
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvPassiveConfigIniSource();
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvPassiveConfigSource public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfigSource::Load(int32_t& lineNumber)
+	******************************************************************************************************/
+	virtual MsvErrorCode Load(int32_t& lineNumber) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfigSource::GetValue(const std::string& group, const std::string& key, std::string& value) const
+	******************************************************************************************************/
+	virtual bool GetValue(const std::string& group, const std::string& key, std::string& value) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfigSource::GetName() const
+	******************************************************************************************************/
+	virtual const char* GetName() const override;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Config file path.
+	* @details	File path to INI file.
+	******************************************************************************************************/
+	std::string m_configPath;
+
+	/**************************************************************************************************//**
+	* @brief		Source name.
+	* @details	Name of source ("ini:" with config file path).
+	******************************************************************************************************/
+	std::string m_name;
+
+	/**************************************************************************************************//**
+	* @brief		Optional flag.
+	* @details	Flag if INI file is optional.
+	******************************************************************************************************/
+	bool m_optional;
+
+	/**************************************************************************************************//**
+	* @brief		INI reader.
+	* @details	Parsed INI file (nullptr when it has not been loaded or optional file does not exist).
+	******************************************************************************************************/
+	std::shared_ptr<INIReader> m_spReader;
+};
+
+
+#endif // !MARSTECH_PASSIVECONFIGINISOURCE_H
+
+/** @} */	//End of group MCONFIG.
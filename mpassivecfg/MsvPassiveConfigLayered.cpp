@@ -0,0 +1,282 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Layered Passive Config Implementation
+* @details		Contains implementation of @ref MsvPassiveConfigLayered.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "MsvPassiveConfigLayered.h"
+#include "MsvPassiveConfigIniSource.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvPassiveConfigLayered::MsvPassiveConfigLayered():
+	MsvPassiveConfigBase()
+{
+
+}
+
+MsvPassiveConfigLayered::~MsvPassiveConfigLayered()
+{
+
+}
+
+
+/********************************************************************************************************************************
+*															MsvPassiveConfigLayered public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvPassiveConfigLayered::AddSource(std::shared_ptr<IMsvPassiveConfigSource> spSource)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	if (!spSource)
+	{
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	m_sources.push_back(spSource);
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvPassiveConfigLayered::GetValueSource(int32_t cfgId, std::string& source) const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	//check if config is initialized
+	if (m_configPath.empty())
+	{
+		//config is not initilized -> return error
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	std::map<int32_t, std::string>::const_iterator it = m_valueSources.find(cfgId);
+	if (it == m_valueSources.end())
+	{
+		return MSV_NOT_FOUND_ERROR;
+	}
+
+	source = it->second;
+	return MSV_SUCCESS;
+}
+
+
+/********************************************************************************************************************************
+*															MsvPassiveConfigBase protected methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvPassiveConfigLayered::LoadConfiguration(MsvConfigValues& values)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	m_valueSources.clear();
+
+	if (!m_spConfigFileSource)
+	{
+		m_spConfigFileSource.reset(new (std::nothrow) MsvPassiveConfigIniSource(m_configPath.c_str()));
+		if (!m_spConfigFileSource)
+		{
+			return MSV_ALLOCATION_ERROR;
+		}
+	}
+
+	//all sources sorted by precedence (from the lowest), default values are used when no source has value
+	std::vector<std::shared_ptr<IMsvPassiveConfigSource>> sources;
+	sources.push_back(m_spConfigFileSource);
+	sources.insert(sources.end(), m_sources.begin(), m_sources.end());
+
+	for (std::vector<std::shared_ptr<IMsvPassiveConfigSource>>::iterator it = sources.begin(); it != sources.end(); ++it)
+	{
+		int32_t lineNumber;
+		MsvErrorCode errorCode = (*it)->Load(lineNumber);
+		if (MSV_FAILED(errorCode))
+		{
+			m_lineNumberWithError = lineNumber;
+			return errorCode;
+		}
+	}
+
+	MsvErrorCode errorCode = MSV_SUCCESS;
+	std::map<int32_t, std::string> valueSources;
+
+	//resolve all values specified in m_spConfigKeyMap
+	const std::map<int32_t, std::shared_ptr<IMsvConfigKey>>& configKeys = m_spConfigKeyMap->GetMap();
+	for (std::map<int32_t, std::shared_ptr<IMsvConfigKey>>::const_iterator it = configKeys.begin(); it != configKeys.end(); ++it)
+	{
+		if (it->second->IsBool())
+		{
+			errorCode = ResolveValue(it->first, it->second, sources, values.m_boolValues, valueSources);
+		}
+		else if (it->second->IsDouble())
+		{
+			errorCode = ResolveValue(it->first, it->second, sources, values.m_doubleValues, valueSources);
+		}
+		else if (it->second->IsInteger())
+		{
+			errorCode = ResolveValue(it->first, it->second, sources, values.m_integerValues, valueSources);
+		}
+		else if (it->second->IsString())
+		{
+			errorCode = ResolveValue(it->first, it->second, sources, values.m_stringValues, valueSources);
+		}
+		else if (it->second->IsUnsigned())
+		{
+			errorCode = ResolveValue(it->first, it->second, sources, values.m_unsignedValues, valueSources);
+		}
+		else
+		{
+			//unknown type
+			errorCode = MSV_UNKNOWN_ERROR;
+		}
+
+		if (MSV_FAILED(errorCode))
+		{
+			//failed -> set failed cfgId and break
+			m_cfgIdWithError = it->first;
+			break;
+		}
+	}
+
+	if (MSV_SUCCEEDED(errorCode))
+	{
+		m_valueSources.swap(valueSources);
+	}
+
+	return errorCode;
+}
+
+
+/********************************************************************************************************************************
+*															MsvPassiveConfigLayered protected methods
+********************************************************************************************************************************/
+
+
+template<class T> MsvErrorCode MsvPassiveConfigLayered::ResolveValue(int32_t cfgId, const std::shared_ptr<IMsvConfigKey>& spConfigKey, const std::vector<std::shared_ptr<IMsvPassiveConfigSource>>& sources, std::map<int32_t, T>& values, std::map<int32_t, std::string>& valueSources)
+{
+	std::string group, key;
+	T value;
+	MSV_RETURN_FAILED(spConfigKey->GetData(group, key, value));
+
+	//source with the highest precedence wins
+	for (std::vector<std::shared_ptr<IMsvPassiveConfigSource>>::const_reverse_iterator it = sources.rbegin(); it != sources.rend(); ++it)
+	{
+		std::string rawValue;
+		if ((*it)->GetValue(group, key, rawValue))
+		{
+			if (!ParseValue(rawValue, value))
+			{
+				return MSV_INVALID_DATA_ERROR;
+			}
+
+			values.insert(std::pair<int32_t, T>(cfgId, value));
+			valueSources.insert(std::pair<int32_t, std::string>(cfgId, (*it)->GetName()));
+			return MSV_SUCCESS;
+		}
+	}
+
+	//no source has value -> use default value
+	values.insert(std::pair<int32_t, T>(cfgId, value));
+	valueSources.insert(std::pair<int32_t, std::string>(cfgId, "default"));
+
+	return MSV_SUCCESS;
+}
+
+bool MsvPassiveConfigLayered::ParseValue(const std::string& rawValue, bool& value)
+{
+	std::string lowerValue(rawValue);
+	std::transform(lowerValue.begin(), lowerValue.end(), lowerValue.begin(), [](unsigned char c) { return static_cast<char>(tolower(c)); });
+
+	if (lowerValue == "true" || lowerValue == "yes" || lowerValue == "on" || lowerValue == "1")
+	{
+		value = true;
+		return true;
+	}
+
+	if (lowerValue == "false" || lowerValue == "no" || lowerValue == "off" || lowerValue == "0")
+	{
+		value = false;
+		return true;
+	}
+
+	return false;
+}
+
+bool MsvPassiveConfigLayered::ParseValue(const std::string& rawValue, double& value)
+{
+	char* pEnd;
+	errno = 0;
+	value = strtod(rawValue.c_str(), &pEnd);
+
+	return !rawValue.empty() && *pEnd == '\0' && errno == 0;
+}
+
+bool MsvPassiveConfigLayered::ParseValue(const std::string& rawValue, int64_t& value)
+{
+	char* pEnd;
+	errno = 0;
+	value = strtoll(rawValue.c_str(), &pEnd, 0);
+
+	return !rawValue.empty() && *pEnd == '\0' && errno == 0;
+}
+
+bool MsvPassiveConfigLayered::ParseValue(const std::string& rawValue, std::string& value)
+{
+	value = rawValue;
+	return true;
+}
+
+bool MsvPassiveConfigLayered::ParseValue(const std::string& rawValue, uint64_t& value)
+{
+	char* pEnd;
+	errno = 0;
+	value = strtoull(rawValue.c_str(), &pEnd, 10);
+
+	return !rawValue.empty() && *pEnd == '\0' && errno == 0;
+}
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,198 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Layered Passive Config
+* @details		Contains declaration of @ref MsvPassiveConfigLayered (passive configuration composed of more sources).
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_PASSIVECONFIGLAYERED_H
+#define MARSTECH_PASSIVECONFIGLAYERED_H
+
+
+#include "MsvPassiveConfigBase.h"
+#include "IMsvPassiveConfigSource.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <map>
+#include <memory>
+#include <vector>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Layered Passive Config Implementation.
+* @details	Passive configuration composed of more sources (layers). Precedence from the lowest is:
+*				default values, config file (INI file passed to @ref Initialize) and sources added by
+*				@ref AddSource (later added source has higher precedence). Precedence is resolved once per
+*				(re)load to flat value storage, so reads cost the same as in @ref MsvPassiveConfig.
+* @note		Source which supplied each value is recorded and it can be read by @ref GetValueSource.
+* @see		IMsvPassiveConfig
+* @see		MsvPassiveConfigBase
+* @see		IMsvPassiveConfigSource
+******************************************************************************************************/
+class MsvPassiveConfigLayered:
+	public MsvPassiveConfigBase
+{
+public:
+	/**************************************************************************************************//**
+	* @brief		Constructor.
+	******************************************************************************************************/
+	MsvPassiveConfigLayered();
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvPassiveConfigLayered();
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											MsvPassiveConfigLayered public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @brief			Add source.
+	* @details		Adds source with higher precedence than all previously added sources. It is used from
+	*					next (re)load.
+	* @param[in]	spSource		Config source.
+	* @retval		MSV_INVALID_DATA_ERROR		When source is nullptr.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode AddSource(std::shared_ptr<IMsvPassiveConfigSource> spSource);
+
+	/**************************************************************************************************//**
+	* @brief			Get value source.
+	* @details		Returns name of source which supplied value ("default" for default values).
+	* @param[in]	cfgId		Config ID.
+	* @param[out]	source	Source name.
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_NOT_FOUND_ERROR			When config ID (cfgId) does not exist.
+	* @retval		MSV_SUCCESS						On success.
+	* @see			IMsvPassiveConfigSource::GetName
+	******************************************************************************************************/
+	virtual MsvErrorCode GetValueSource(int32_t cfgId, std::string& source) const;
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											MsvPassiveConfigBase protected methods
+	**---------------------------------------------------------------------------------------------------*/
+protected:
+	/**************************************************************************************************//**
+	* @copydoc MsvPassiveConfigBase::LoadConfiguration(MsvConfigValues& values)
+	******************************************************************************************************/
+	virtual MsvErrorCode LoadConfiguration(MsvConfigValues& values) override;
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											MsvPassiveConfigLayered protected methods
+	**---------------------------------------------------------------------------------------------------*/
+protected:
+	/**************************************************************************************************//**
+	* @brief			Resolve value.
+	* @details		Finds value in sources with the highest precedence (or uses default value) and converts it.
+	* @param[in]	cfgId				Config ID.
+	* @param[in]	spConfigKey		Config key.
+	* @param[in]	sources			All sources sorted by precedence (from the lowest).
+	* @param[out]	values			Resolved values.
+	* @param[out]	valueSources	Names of sources which supplied values.
+	* @retval		MSV_INVALID_DATA_ERROR		When value has different type then requested.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	template<class T> MsvErrorCode ResolveValue(int32_t cfgId, const std::shared_ptr<IMsvConfigKey>& spConfigKey, const std::vector<std::shared_ptr<IMsvPassiveConfigSource>>& sources, std::map<int32_t, T>& values, std::map<int32_t, std::string>& valueSources);
+
+	/**************************************************************************************************//**
+	* @brief			Parse value.
+	* @details		Converts raw bool value ("true", "yes", "on", "1", "false", "no", "off", "0").
+	* @param[in]	rawValue		Raw value.
+	* @param[out]	value			Converted value.
+	* @returns		True on success, false when raw value is not valid.
+	******************************************************************************************************/
+	static bool ParseValue(const std::string& rawValue, bool& value);
+
+	/**************************************************************************************************//**
+	* @brief			Parse value.
+	* @details		Converts raw double value.
+	* @param[in]	rawValue		Raw value.
+	* @param[out]	value			Converted value.
+	* @returns		True on success, false when raw value is not valid.
+	******************************************************************************************************/
+	static bool ParseValue(const std::string& rawValue, double& value);
+
+	/**************************************************************************************************//**
+	* @brief			Parse value.
+	* @details		Converts raw int64_t value (decimal, hexadecimal with "0x" prefix or octal with "0" prefix).
+	* @param[in]	rawValue		Raw value.
+	* @param[out]	value			Converted value.
+	* @returns		True on success, false when raw value is not valid.
+	******************************************************************************************************/
+	static bool ParseValue(const std::string& rawValue, int64_t& value);
+
+	/**************************************************************************************************//**
+	* @brief			Parse value.
+	* @details		String value is used as it is.
+	* @param[in]	rawValue		Raw value.
+	* @param[out]	value			Converted value.
+	* @returns		Always true.
+	******************************************************************************************************/
+	static bool ParseValue(const std::string& rawValue, std::string& value);
+
+	/**************************************************************************************************//**
+	* @brief			Parse value.
+	* @details		Converts raw uint64_t value (decimal).
+	* @param[in]	rawValue		Raw value.
+	* @param[out]	value			Converted value.
+	* @returns		True on success, false when raw value is not valid.
+	******************************************************************************************************/
+	static bool ParseValue(const std::string& rawValue, uint64_t& value);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Config file source.
+	* @details	Source of config file passed to @ref Initialize (created with first load).
+	******************************************************************************************************/
+	std::shared_ptr<IMsvPassiveConfigSource> m_spConfigFileSource;
+
+	/**************************************************************************************************//**
+	* @brief		Sources.
+	* @details	Added sources sorted by precedence (from the lowest).
+	* @see		AddSource
+	******************************************************************************************************/
+	std::vector<std::shared_ptr<IMsvPassiveConfigSource>> m_sources;
+
+	/**************************************************************************************************//**
+	* @brief		Value sources.
+	* @details	Names of sources which supplied loaded values.
+	* @see		GetValueSource
+	******************************************************************************************************/
+	std::map<int32_t, std::string> m_valueSources;
+};
+
+
+#endif // !MARSTECH_PASSIVECONFIGLAYERED_H
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,696 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Mapped Passive Config Implementation
+* @details		Contains implementation of @ref MsvPassiveConfigMapped.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "MsvPassiveConfigMapped.h"
+#include "MsvPassiveConfigCompiler.h"
+
+#include "mconfig/common/MsvChecksum.h"
+
+#include "merror/MsvErrorCodes.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvPassiveConfigMapped::MsvPassiveConfigMapped(const char* imagePath):
+	m_cfgIdWithError(INT32_MIN),
+	m_lineNumberWithError(INT32_MIN),
+	m_imagePath(imagePath ? imagePath : ""),
+	m_pEntries(nullptr),
+	m_entryCount(0),
+	m_pStringPool(nullptr)
+{
+
+}
+
+MsvPassiveConfigMapped::~MsvPassiveConfigMapped()
+{
+
+}
+
+
+/********************************************************************************************************************************
+*															IMsvPassiveConfig public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvPassiveConfigMapped::GetValue(int32_t cfgId, bool& value) const
+{
+	//overrides of calling thread (one thread local load when thread has none)
+	if (MsvConfigOverrides::GetValue(this, cfgId, value))
+	{
+		return MSV_SUCCESS;
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	const MsvPassiveConfigImageEntry* pEntry;
+	MSV_RETURN_FAILED(FindEntry(cfgId, MsvPassiveConfigImageType::MSV_IMAGE_BOOL, pEntry));
+
+	value = pEntry->m_value != 0;
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvPassiveConfigMapped::GetValue(int32_t cfgId, double& value) const
+{
+	//overrides of calling thread (one thread local load when thread has none)
+	if (MsvConfigOverrides::GetValue(this, cfgId, value))
+	{
+		return MSV_SUCCESS;
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	const MsvPassiveConfigImageEntry* pEntry;
+	MSV_RETURN_FAILED(FindEntry(cfgId, MsvPassiveConfigImageType::MSV_IMAGE_DOUBLE, pEntry));
+
+	memcpy(&value, &pEntry->m_value, sizeof(value));
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvPassiveConfigMapped::GetValue(int32_t cfgId, int64_t& value) const
+{
+	//overrides of calling thread (one thread local load when thread has none)
+	if (MsvConfigOverrides::GetValue(this, cfgId, value))
+	{
+		return MSV_SUCCESS;
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	const MsvPassiveConfigImageEntry* pEntry;
+	MSV_RETURN_FAILED(FindEntry(cfgId, MsvPassiveConfigImageType::MSV_IMAGE_INTEGER, pEntry));
+
+	value = static_cast<int64_t>(pEntry->m_value);
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvPassiveConfigMapped::GetValue(int32_t cfgId, std::string& value) const
+{
+	//overrides of calling thread (one thread local load when thread has none)
+	if (MsvConfigOverrides::GetValue(this, cfgId, value))
+	{
+		return MSV_SUCCESS;
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	const MsvPassiveConfigImageEntry* pEntry;
+	MSV_RETURN_FAILED(FindEntry(cfgId, MsvPassiveConfigImageType::MSV_IMAGE_STRING, pEntry));
+
+	value.assign(m_pStringPool + pEntry->m_value, static_cast<size_t>(pEntry->m_size));
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvPassiveConfigMapped::GetValue(int32_t cfgId, uint64_t& value) const
+{
+	//overrides of calling thread (one thread local load when thread has none)
+	if (MsvConfigOverrides::GetValue(this, cfgId, value))
+	{
+		return MSV_SUCCESS;
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	const MsvPassiveConfigImageEntry* pEntry;
+	MSV_RETURN_FAILED(FindEntry(cfgId, MsvPassiveConfigImageType::MSV_IMAGE_UNSIGNED, pEntry));
+
+	value = pEntry->m_value;
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvPassiveConfigMapped::Initialize(std::shared_ptr<IMsvConfigKeyMap<IMsvConfigKey>> spConfigKeyMap, const char* configPath)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	//check if config has been already initialized
+	if (!m_configPath.empty() || m_spConfigKeyMap)
+	{
+		//config has been already initialized -> return INFO
+		return MSV_ALREADY_INITIALIZED_INFO;
+	}
+
+	//set required values for initialization
+	m_configPath.assign(configPath);
+	m_spConfigKeyMap = spConfigKeyMap;
+
+	bool defaultImagePath = m_imagePath.empty();
+	if (defaultImagePath)
+	{
+		m_imagePath = m_configPath + ".img";
+	}
+
+	//map (or compile) image (initial load is not notified)
+	std::vector<int32_t> changedCfgIds;
+	MsvErrorCode errorCode = ReloadImage(changedCfgIds, nullptr);
+	if (errorCode == MSV_OPEN_ERROR && defaultImagePath)
+	{
+		//config directory is not writable (image can not be compiled next to config file) -> use temp directory
+		std::string tempImagePath = GetTempImagePath();
+		if (!tempImagePath.empty())
+		{
+			m_imagePath = tempImagePath;
+			changedCfgIds.clear();
+			errorCode = ReloadImage(changedCfgIds, nullptr);
+		}
+	}
+
+	if (MSV_FAILED(errorCode))
+	{
+		//load failed -> reset file name config key map
+		m_configPath.clear();
+		m_spConfigKeyMap.reset();
+
+		if (defaultImagePath)
+		{
+			m_imagePath.clear();
+		}
+
+		return errorCode;
+	}
+
+	//images of old versions are not removed by their last user when it has been killed -> remove them now
+	RemoveStaleImages();
+
+	return errorCode;
+}
+
+void MsvPassiveConfigMapped::ReadFailedData(int32_t& lineNumber, int32_t& cfgId) const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	lineNumber = m_lineNumberWithError;
+	cfgId = m_cfgIdWithError;
+}
+
+MsvErrorCode MsvPassiveConfigMapped::ReloadConfiguration()
+{
+	std::vector<int32_t> changedCfgIds;
+	return ReloadConfiguration(changedCfgIds);
+}
+
+MsvErrorCode MsvPassiveConfigMapped::ReloadConfiguration(std::vector<int32_t>& changedCfgIds)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	changedCfgIds.clear();
+
+	//check if config has been already initialized (we need these two values for successfull reload)
+	if (m_configPath.empty() || !m_spConfigKeyMap)
+	{
+		//config is not initialized -> return error
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	//old and new values are needed only when someone is listening
+	std::vector<MsvConfigValueChange> changes;
+	MsvErrorCode errorCode = ReloadImage(changedCfgIds, m_callbacks.empty() ? nullptr : &changes);
+
+	if (MSV_SUCCEEDED(errorCode) && !changes.empty())
+	{
+		std::forward_list<std::shared_ptr<IMsvPassiveConfigCallback>>::iterator endIt = m_callbacks.end();
+		for (std::forward_list<std::shared_ptr<IMsvPassiveConfigCallback>>::iterator it = m_callbacks.begin(); it != endIt; ++it)
+		{
+			(*it)->OnConfigurationChanged(changes);
+		}
+	}
+
+	if (MSV_SUCCEEDED(errorCode))
+	{
+		//event loops are signaled after image has been replaced
+		m_notifier.Notify(changedCfgIds);
+	}
+
+	return errorCode;
+}
+
+MsvErrorCode MsvPassiveConfigMapped::RegisterCallback(std::shared_ptr<IMsvPassiveConfigCallback> spCallback)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	//there is no check if is initilized or not (it is possible to register callback before initialized)
+
+	std::forward_list<std::shared_ptr<IMsvPassiveConfigCallback>>::iterator endIt = m_callbacks.end();
+	for (std::forward_list<std::shared_ptr<IMsvPassiveConfigCallback>>::iterator it = m_callbacks.begin(); it != endIt; ++it)
+	{
+		if (*it == spCallback)
+		{
+			//callback is already registered
+			return MSV_ALREADY_REGISTERED_INFO;
+		}
+	}
+
+	//register callback
+	m_callbacks.push_front(spCallback);
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvPassiveConfigMapped::UnregisterCallback(std::shared_ptr<IMsvPassiveConfigCallback> spCallback)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	m_callbacks.remove(spCallback);
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvPassiveConfigMapped::GetNotificationHandle(int& handle)
+{
+	return m_notifier.GetHandle(handle);
+}
+
+MsvErrorCode MsvPassiveConfigMapped::DrainChanges(std::vector<int32_t>& changedCfgIds)
+{
+	m_notifier.Drain(changedCfgIds);
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvPassiveConfigMapped::GetSnapshot(std::shared_ptr<const MsvConfigSnapshot>& spSnapshot) const
+{
+	//snapshot is cached until next reload which changes values -> no lock and no copy
+	spSnapshot = m_snapshot.Load();
+	if (spSnapshot)
+	{
+		return MSV_SUCCESS;
+	}
+
+	//snapshot is published under config lock -> reload (it invalidates snapshot under the same lock) can not make it stale
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	//check if config is initialized
+	if (m_configPath.empty())
+	{
+		//config is not initilized -> return error
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	//image entries are sorted by config ID -> values are appended to the end of maps
+	MsvConfigValues values;
+	for (size_t i = 0; i < m_entryCount; ++i)
+	{
+		const MsvPassiveConfigImageEntry& entry = m_pEntries[i];
+
+		switch (static_cast<MsvPassiveConfigImageType>(entry.m_type))
+		{
+		case MsvPassiveConfigImageType::MSV_IMAGE_BOOL:
+			values.m_boolValues.emplace_hint(values.m_boolValues.end(), entry.m_cfgId, std::get<bool>(GetEntryValue(entry, m_pStringPool)));
+			break;
+		case MsvPassiveConfigImageType::MSV_IMAGE_DOUBLE:
+			values.m_doubleValues.emplace_hint(values.m_doubleValues.end(), entry.m_cfgId, std::get<double>(GetEntryValue(entry, m_pStringPool)));
+			break;
+		case MsvPassiveConfigImageType::MSV_IMAGE_INTEGER:
+			values.m_integerValues.emplace_hint(values.m_integerValues.end(), entry.m_cfgId, std::get<int64_t>(GetEntryValue(entry, m_pStringPool)));
+			break;
+		case MsvPassiveConfigImageType::MSV_IMAGE_STRING:
+			values.m_stringValues.emplace_hint(values.m_stringValues.end(), entry.m_cfgId, std::get<std::string>(GetEntryValue(entry, m_pStringPool)));
+			break;
+		case MsvPassiveConfigImageType::MSV_IMAGE_UNSIGNED:
+			values.m_unsignedValues.emplace_hint(values.m_unsignedValues.end(), entry.m_cfgId, std::get<uint64_t>(GetEntryValue(entry, m_pStringPool)));
+			break;
+		default:
+			//image is checked when it is loaded -> unknown type is skipped
+			break;
+		}
+	}
+
+	spSnapshot = m_snapshot.Publish(std::move(values));
+
+	return spSnapshot ? MSV_SUCCESS : MSV_ALLOCATION_ERROR;
+}
+
+MsvErrorCode MsvPassiveConfigMapped::PushOverrides(const std::vector<MsvConfigValueUpdate>& values)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	if (!m_spConfigKeyMap)
+	{
+		//config is not initilized -> return error
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	return MsvConfigOverrides::Push(this, m_spConfigKeyMap->GetMap(), values);
+}
+
+MsvErrorCode MsvPassiveConfigMapped::PopOverrides()
+{
+	return MsvConfigOverrides::Pop(this);
+}
+
+
+/********************************************************************************************************************************
+*															MsvPassiveConfigMapped public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvPassiveConfigMapped::GetValue(int32_t cfgId, const char*& value) const
+{
+	//overridden string lives in frame of calling thread -> it is valid until frame is popped
+	const std::string* pOverride = MsvConfigOverrides::Find<std::string>(this, cfgId);
+	if (pOverride)
+	{
+		value = pOverride->c_str();
+		return MSV_SUCCESS;
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	const MsvPassiveConfigImageEntry* pEntry;
+	MSV_RETURN_FAILED(FindEntry(cfgId, MsvPassiveConfigImageType::MSV_IMAGE_STRING, pEntry));
+
+	value = m_pStringPool + pEntry->m_value;
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvPassiveConfigMapped::GetMappedImagePath(std::string& imagePath) const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	if (m_configPath.empty())
+	{
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	imagePath = m_mappedImagePath;
+	return MSV_SUCCESS;
+}
+
+
+/********************************************************************************************************************************
+*															MsvPassiveConfigMapped protected methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvPassiveConfigMapped::ReloadImage(std::vector<int32_t>& changedCfgIds, std::vector<MsvConfigValueChange>* pChanges)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	//map new image (current image is still mapped)
+	MsvMappedFile mappedFile;
+	std::string imagePath;
+	MsvErrorCode errorCode = LoadImage(mappedFile, imagePath);
+	if (MSV_FAILED(errorCode))
+	{
+		//somethink failed -> retire current image (values might not be valid, returned strings stay valid)
+		RetireImage();
+		m_pEntries = nullptr;
+		m_entryCount = 0;
+		m_pStringPool = nullptr;
+		m_snapshot.Invalidate();
+		return errorCode;
+	}
+
+	if (imagePath == m_mappedImagePath && m_mappedFile.GetData())
+	{
+		//the same image version has the same values -> keep current image (returned strings stay valid), new mapping is unmapped
+		return errorCode;
+	}
+
+	const MsvPassiveConfigImageHeader* pHeader = reinterpret_cast<const MsvPassiveConfigImageHeader*>(mappedFile.GetData());
+	const MsvPassiveConfigImageEntry* pEntries = reinterpret_cast<const MsvPassiveConfigImageEntry*>(mappedFile.GetData() + pHeader->m_entriesOffset);
+	size_t entryCount = static_cast<size_t>(pHeader->m_entryCount);
+	const char* pStringPool = reinterpret_cast<const char*>(mappedFile.GetData() + pHeader->m_stringPoolOffset);
+
+	//both images are sorted by config ID -> walk them together and find changed values
+	size_t i = 0, j = 0;
+	while (i < m_entryCount || j < entryCount)
+	{
+		if (j == entryCount || (i < m_entryCount && m_pEntries[i].m_cfgId < pEntries[j].m_cfgId))
+		{
+			//value does not exist anymore
+			changedCfgIds.push_back(m_pEntries[i].m_cfgId);
+			if (pChanges)
+			{
+				pChanges->push_back(MsvConfigValueChange{ m_pEntries[i].m_cfgId, GetEntryValue(m_pEntries[i], m_pStringPool), MsvConfigValue() });
+			}
+			++i;
+		}
+		else if (i == m_entryCount || pEntries[j].m_cfgId < m_pEntries[i].m_cfgId)
+		{
+			//new value
+			changedCfgIds.push_back(pEntries[j].m_cfgId);
+			if (pChanges)
+			{
+				pChanges->push_back(MsvConfigValueChange{ pEntries[j].m_cfgId, MsvConfigValue(), GetEntryValue(pEntries[j], pStringPool) });
+			}
+			++j;
+		}
+		else
+		{
+			if (!EqualEntries(m_pEntries[i], m_pStringPool, pEntries[j], pStringPool))
+			{
+				//changed value
+				changedCfgIds.push_back(pEntries[j].m_cfgId);
+				if (pChanges)
+				{
+					pChanges->push_back(MsvConfigValueChange{ pEntries[j].m_cfgId, GetEntryValue(m_pEntries[i], m_pStringPool), GetEntryValue(pEntries[j], pStringPool) });
+				}
+			}
+
+			++i;
+			++j;
+		}
+	}
+
+	//use new image (old one is retired -> strings returned from it stay valid)
+	RetireImage();
+	m_mappedFile.Swap(mappedFile);
+	m_pEntries = pEntries;
+	m_entryCount = entryCount;
+	m_pStringPool = pStringPool;
+
+	if (m_mappedImagePath != imagePath)
+	{
+		//old version is not used by new readers -> remove it (mapping stays valid, on Windows it fails while it is mapped and
+		//it is removed by the next initialization)
+		if (!m_mappedImagePath.empty())
+		{
+			remove(m_mappedImagePath.c_str());
+		}
+		m_mappedImagePath = imagePath;
+	}
+
+	if (!changedCfgIds.empty())
+	{
+		m_snapshot.Invalidate();
+	}
+
+	return errorCode;
+}
+
+MsvErrorCode MsvPassiveConfigMapped::LoadImage(MsvMappedFile& mappedFile, std::string& imagePath)
+{
+	uint64_t keyMapChecksum;
+	MsvErrorCode errorCode = MsvPassiveConfigCompiler::ComputeKeyMapChecksum(m_spConfigKeyMap, keyMapChecksum);
+	if (MSV_FAILED(errorCode))
+	{
+		return errorCode;
+	}
+
+	//image of current config version (changed config has new image path -> mapped image is never replaced)
+	imagePath = MsvPassiveConfigCompiler::GetVersionedImagePath(m_imagePath.c_str(), m_configPath.c_str(), keyMapChecksum);
+
+	//try to use existing image (fast path, compiled by this or another process)
+	if (MSV_SUCCEEDED(mappedFile.Map(imagePath.c_str())) && MsvPassiveConfigCompiler::CheckImage(mappedFile.GetData(), mappedFile.GetSize(), m_configPath.c_str(), keyMapChecksum) == MSV_SUCCESS)
+	{
+		return MSV_SUCCESS;
+	}
+
+	//image does not exist or it is corrupted -> compile it
+	mappedFile.Unmap();
+
+	MsvPassiveConfigCompiler compiler;
+	errorCode = compiler.Compile(m_spConfigKeyMap, m_configPath.c_str(), imagePath.c_str());
+	if (MSV_FAILED(errorCode))
+	{
+		compiler.ReadFailedData(m_lineNumberWithError, m_cfgIdWithError);
+		return errorCode;
+	}
+
+	MSV_RETURN_FAILED(mappedFile.Map(imagePath.c_str()));
+
+	//image is new -> it might be stale only if config file has been changed in the meantime (next reload will update it)
+	errorCode = MsvPassiveConfigCompiler::CheckImage(mappedFile.GetData(), mappedFile.GetSize(), m_configPath.c_str(), keyMapChecksum);
+	if (MSV_FAILED(errorCode))
+	{
+		mappedFile.Unmap();
+		return errorCode;
+	}
+
+	return MSV_SUCCESS;
+}
+
+void MsvPassiveConfigMapped::RetireImage()
+{
+	if (!m_mappedFile.GetData())
+	{
+		//nothing is mapped -> nothing to retire
+		return;
+	}
+
+	m_retiredFiles.emplace_front();
+	m_retiredFiles.front().Swap(m_mappedFile);
+}
+
+void MsvPassiveConfigMapped::RemoveStaleImages() const
+{
+	std::filesystem::path imagePath(m_imagePath);
+	std::filesystem::path imageDirectory = imagePath.parent_path();
+	if (imageDirectory.empty())
+	{
+		imageDirectory = ".";
+	}
+
+	//versioned image name is image name with "." and 16 hex digits (temporary files of running compilations do not match)
+	std::string imagePrefix = imagePath.filename().string() + ".";
+	std::string mappedImageName = std::filesystem::path(m_mappedImagePath).filename().string();
+
+	//files are removed after iteration (directory must not be changed while it is iterated)
+	std::error_code errorCode;
+	std::vector<std::filesystem::path> staleImages;
+	for (std::filesystem::directory_iterator it(imageDirectory, errorCode); !errorCode && it != std::filesystem::directory_iterator(); it.increment(errorCode))
+	{
+		std::string fileName = it->path().filename().string();
+		if (fileName.size() == imagePrefix.size() + 16 && fileName.compare(0, imagePrefix.size(), imagePrefix) == 0
+			&& fileName.find_first_not_of("0123456789abcdef", imagePrefix.size()) == std::string::npos && fileName != mappedImageName)
+		{
+			staleImages.push_back(it->path());
+		}
+	}
+
+	for (std::vector<std::filesystem::path>::const_iterator it = staleImages.begin(); it != staleImages.end(); ++it)
+	{
+		//image might be still mapped by other process (it fails on Windows, mapping stays valid on Linux)
+		std::filesystem::remove(*it, errorCode);
+	}
+}
+
+std::string MsvPassiveConfigMapped::GetTempImagePath() const
+{
+	std::error_code errorCode;
+	std::filesystem::path tempDirectory = std::filesystem::temp_directory_path(errorCode);
+	if (errorCode)
+	{
+		return std::string();
+	}
+
+	//config files with the same name in different directories must not share image -> checksum of absolute config path is part of name
+	std::filesystem::path configPath = std::filesystem::absolute(std::filesystem::path(m_configPath), errorCode);
+	if (errorCode)
+	{
+		configPath = m_configPath;
+	}
+	std::string configPathString = configPath.string();
+
+	std::stringstream imageName;
+	imageName << configPath.filename().string() << "." << std::hex << std::setw(16) << std::setfill('0') << MsvChecksum::Compute(configPathString.data(), configPathString.size()) << ".img";
+
+	return (tempDirectory / imageName.str()).string();
+}
+
+MsvErrorCode MsvPassiveConfigMapped::FindEntry(int32_t cfgId, MsvPassiveConfigImageType type, const MsvPassiveConfigImageEntry*& pEntry) const
+{
+	//check if config is initialized
+	if (m_configPath.empty())
+	{
+		//config is not initilized -> return error
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	const MsvPassiveConfigImageEntry* pEnd = m_pEntries + m_entryCount;
+	pEntry = std::lower_bound(m_pEntries, pEnd, cfgId, [](const MsvPassiveConfigImageEntry& entry, int32_t id) { return entry.m_cfgId < id; });
+
+	if (pEntry != pEnd && pEntry->m_cfgId == cfgId && pEntry->m_type == static_cast<uint32_t>(type))
+	{
+		//value has been found
+		return MSV_SUCCESS;
+	}
+
+	//value has not been found -> return error
+	return MSV_NOT_FOUND_ERROR;
+}
+
+bool MsvPassiveConfigMapped::EqualEntries(const MsvPassiveConfigImageEntry& entry1, const char* pStringPool1, const MsvPassiveConfigImageEntry& entry2, const char* pStringPool2)
+{
+	if (entry1.m_type != entry2.m_type)
+	{
+		return false;
+	}
+
+	if (entry1.m_type == static_cast<uint32_t>(MsvPassiveConfigImageType::MSV_IMAGE_STRING))
+	{
+		return entry1.m_size == entry2.m_size && memcmp(pStringPool1 + entry1.m_value, pStringPool2 + entry2.m_value, static_cast<size_t>(entry1.m_size)) == 0;
+	}
+
+	return entry1.m_value == entry2.m_value;
+}
+
+MsvConfigValue MsvPassiveConfigMapped::GetEntryValue(const MsvPassiveConfigImageEntry& entry, const char* pStringPool)
+{
+	switch (static_cast<MsvPassiveConfigImageType>(entry.m_type))
+	{
+	case MsvPassiveConfigImageType::MSV_IMAGE_BOOL:
+		return MsvConfigValue(entry.m_value != 0);
+	case MsvPassiveConfigImageType::MSV_IMAGE_DOUBLE:
+	{
+		double value;
+		memcpy(&value, &entry.m_value, sizeof(value));
+		return MsvConfigValue(value);
+	}
+	case MsvPassiveConfigImageType::MSV_IMAGE_INTEGER:
+		return MsvConfigValue(static_cast<int64_t>(entry.m_value));
+	case MsvPassiveConfigImageType::MSV_IMAGE_STRING:
+		return MsvConfigValue(std::string(pStringPool + entry.m_value, static_cast<size_t>(entry.m_size)));
+	case MsvPassiveConfigImageType::MSV_IMAGE_UNSIGNED:
+		return MsvConfigValue(entry.m_value);
+	default:
+		return MsvConfigValue();
+	}
+}
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,380 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Mapped Passive Config
+* @details		Contains declaration of @ref MsvPassiveConfigMapped which serves values directly from memory mapped image.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_PASSIVECONFIGMAPPED_H
+#define MARSTECH_PASSIVECONFIGMAPPED_H
+
+
+#include "IMsvPassiveConfig.h"
+#include "MsvPassiveConfigImage.h"
+#include "mconfig/common/MsvChangeNotifier.h"
+#include "mconfig/common/MsvMappedFile.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <forward_list>
+#include <mutex>
+
+MSV_ENABLE_WARNINGS
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Mapped Passive Config Implementation.
+* @details	Passive configuration which serves values directly from memory mapped binary image (see
+*				@ref MsvPassiveConfigCompiler). Image is compiled from config file only when it does not exist,
+*				it is corrupted or stale (config file or config key map has changed). Otherwise values are
+*				read without parsing, conversion and heap allocation and mapped pages are shared by all
+*				processes using the same image.
+* @note		Image path is config path with ".img" suffix when it is not specified (when config directory is not
+*				writable, image is compiled to temp directory instead). Each config version has its own image file
+*				(image path with version suffix), so new image never replaces mapped one. Images of other versions
+*				are removed when config is initialized.
+* @see		IMsvPassiveConfig
+* @see		MsvPassiveConfigCompiler
+******************************************************************************************************/
+class MsvPassiveConfigMapped:
+	public IMsvPassiveConfig
+{
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	imagePath		Path to binary image (nullptr -> config path with ".img" suffix).
+	******************************************************************************************************/
+	MsvPassiveConfigMapped(const char* imagePath = nullptr);
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	******************************************************************************************************/
+	virtual ~MsvPassiveConfigMapped();
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											IMsvPassiveConfig public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::GetValue(int32_t cfgId, bool& value) const
+	******************************************************************************************************/
+	virtual MsvErrorCode GetValue(int32_t cfgId, bool& value) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::GetValue(int32_t cfgId, double& value) const
+	******************************************************************************************************/
+	virtual MsvErrorCode GetValue(int32_t cfgId, double& value) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::GetValue(int32_t cfgId, int64_t& value) const
+	******************************************************************************************************/
+	virtual MsvErrorCode GetValue(int32_t cfgId, int64_t& value) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::GetValue(int32_t cfgId, std::string& value) const
+	******************************************************************************************************/
+	virtual MsvErrorCode GetValue(int32_t cfgId, std::string& value) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::GetValue(int32_t cfgId, uint64_t& value) const
+	******************************************************************************************************/
+	virtual MsvErrorCode GetValue(int32_t cfgId, uint64_t& value) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::Initialize(std::shared_ptr<IMsvConfigKeyMap<IMsvConfigKey>> spConfigKeyMap, const char* configPath)
+	* @retval		MSV_OPEN_ERROR						When image could not be written or mapped (default image path falls back
+	*															to temp directory first).
+	******************************************************************************************************/
+	virtual MsvErrorCode Initialize(std::shared_ptr<IMsvConfigKeyMap<IMsvConfigKey>> spConfigKeyMap, const char* configPath = "config.ini") override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::ReadFailedData(int32_t& lineNumber, int32_t& cfgId) const
+	******************************************************************************************************/
+	virtual void ReadFailedData(int32_t& lineNumber, int32_t& cfgId) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::ReloadConfiguration()
+	******************************************************************************************************/
+	virtual MsvErrorCode ReloadConfiguration() override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::ReloadConfiguration(std::vector<int32_t>& changedCfgIds)
+	******************************************************************************************************/
+	virtual MsvErrorCode ReloadConfiguration(std::vector<int32_t>& changedCfgIds) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::RegisterCallback(std::shared_ptr<IMsvPassiveConfigCallback> spCallback)
+	******************************************************************************************************/
+	virtual MsvErrorCode RegisterCallback(std::shared_ptr<IMsvPassiveConfigCallback> spCallback) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::UnregisterCallback(std::shared_ptr<IMsvPassiveConfigCallback> spCallback)
+	******************************************************************************************************/
+	virtual MsvErrorCode UnregisterCallback(std::shared_ptr<IMsvPassiveConfigCallback> spCallback) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::GetNotificationHandle(int& handle)
+	******************************************************************************************************/
+	virtual MsvErrorCode GetNotificationHandle(int& handle) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::DrainChanges(std::vector<int32_t>& changedCfgIds)
+	******************************************************************************************************/
+	virtual MsvErrorCode DrainChanges(std::vector<int32_t>& changedCfgIds) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::GetSnapshot(std::shared_ptr<const MsvConfigSnapshot>& spSnapshot) const
+	******************************************************************************************************/
+	virtual MsvErrorCode GetSnapshot(std::shared_ptr<const MsvConfigSnapshot>& spSnapshot) const override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::PushOverrides(const std::vector<MsvConfigValueUpdate>& values)
+	******************************************************************************************************/
+	virtual MsvErrorCode PushOverrides(const std::vector<MsvConfigValueUpdate>& values) override;
+
+	/**************************************************************************************************//**
+	* @copydoc IMsvPassiveConfig::PopOverrides()
+	******************************************************************************************************/
+	virtual MsvErrorCode PopOverrides() override;
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											MsvPassiveConfigMapped public methods
+	**---------------------------------------------------------------------------------------------------*/
+public:
+	/**************************************************************************************************//**
+	* @brief			Get string value.
+	* @details		Finds and returns string value directly from image (without copy).
+	* @param[in]	cfgId		Config ID to get its value.
+	* @param[out]	value		Found and returned value (null terminated).
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_NOT_FOUND_ERROR			When config ID (cfgId) does not exist.
+	* @retval		MSV_SUCCESS						On success.
+	* @note		Returned pointer is valid until this object is destroyed (replaced images stay mapped).
+	******************************************************************************************************/
+	virtual MsvErrorCode GetValue(int32_t cfgId, const char*& value) const;
+
+	/**************************************************************************************************//**
+	* @brief			Get mapped image path.
+	* @details		Returns versioned path of currently mapped image.
+	* @param[out]	imagePath	Path to mapped image.
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized (no image is mapped).
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	MsvErrorCode GetMappedImagePath(std::string& imagePath) const;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief			Reload image.
+	* @details		Loads image (@ref LoadImage) and replaces currently mapped image. It does not check
+	*					initialization and it does not notify callbacks.
+	* @param[out]	changedCfgIds	Sorted config IDs of changed values.
+	* @param[out]	pChanges			Changed values with old and new values (not filled when nullptr).
+	* @retval		MSV_PARSE_ERROR				When parsing configuration file failed.
+	* @retval		MSV_INVALID_DATA_ERROR		When value has different type then requested (or image is invalid).
+	* @retval		MSV_UNKNOWN_ERROR				Unknown value type (not supported).
+	* @retval		MSV_OPEN_ERROR					When image could not be written or mapped.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode ReloadImage(std::vector<int32_t>& changedCfgIds, std::vector<MsvConfigValueChange>* pChanges);
+
+	/**************************************************************************************************//**
+	* @brief			Load image.
+	* @details		Maps image of current config version and checks it. When image is not valid (or it does
+	*					not exist) it is compiled from config file and mapped again.
+	* @param[out]	mappedFile		Mapped image.
+	* @param[out]	imagePath		Path to mapped image (versioned image path).
+	* @retval		MSV_PARSE_ERROR				When parsing configuration file failed.
+	* @retval		MSV_INVALID_DATA_ERROR		When value has different type then requested (or image is invalid).
+	* @retval		MSV_UNKNOWN_ERROR				Unknown value type (not supported).
+	* @retval		MSV_OPEN_ERROR					When image could not be written or mapped.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode LoadImage(MsvMappedFile& mappedFile, std::string& imagePath);
+
+	/**************************************************************************************************//**
+	* @brief		Retire image.
+	* @details	Moves currently mapped image to retired images (it stays mapped until this object is destroyed).
+	******************************************************************************************************/
+	void RetireImage();
+
+	/**************************************************************************************************//**
+	* @brief		Remove stale images.
+	* @details	Removes versioned images of image path except currently mapped one (images of other config
+	*				versions left by killed processes or by processes of other key map version).
+	******************************************************************************************************/
+	void RemoveStaleImages() const;
+
+	/**************************************************************************************************//**
+	* @brief		Get temp image path.
+	* @details	Returns image path in temp directory (used when default image path is not writable).
+	* @returns	Image path in temp directory (empty when temp directory is not available).
+	******************************************************************************************************/
+	std::string GetTempImagePath() const;
+
+	/**************************************************************************************************//**
+	* @brief			Find entry.
+	* @details		Finds image entry (binary search in sorted entries) with requested type.
+	* @param[in]	cfgId		Config ID to find.
+	* @param[in]	type		Requested value type.
+	* @param[out]	pEntry	Found entry.
+	* @retval		MSV_NOT_INITIALIZED_ERROR	When config has not been initialized.
+	* @retval		MSV_NOT_FOUND_ERROR			When config ID (cfgId) with requested type does not exist.
+	* @retval		MSV_SUCCESS						On success.
+	******************************************************************************************************/
+	MsvErrorCode FindEntry(int32_t cfgId, MsvPassiveConfigImageType type, const MsvPassiveConfigImageEntry*& pEntry) const;
+
+	/**************************************************************************************************//**
+	* @brief			Compare entries.
+	* @details		Compares values (and types) of two image entries.
+	* @param[in]	entry1			First entry.
+	* @param[in]	pStringPool1	String pool of first entry.
+	* @param[in]	entry2			Second entry.
+	* @param[in]	pStringPool2	String pool of second entry.
+	* @returns		True when entries have the same type and value, false otherwise.
+	******************************************************************************************************/
+	static bool EqualEntries(const MsvPassiveConfigImageEntry& entry1, const char* pStringPool1, const MsvPassiveConfigImageEntry& entry2, const char* pStringPool2);
+
+	/**************************************************************************************************//**
+	* @brief			Get entry value.
+	* @details		Converts image entry to config value.
+	* @param[in]	entry				Image entry.
+	* @param[in]	pStringPool		String pool of entry.
+	* @returns		Config value.
+	******************************************************************************************************/
+	static MsvConfigValue GetEntryValue(const MsvPassiveConfigImageEntry& entry, const char* pStringPool);
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Config mutex.
+	* @details	Locks this object for thread safety access.
+	******************************************************************************************************/
+	mutable std::recursive_mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Failed config ID.
+	* @details	Contains config ID which reading failed.
+	* @see		ReadFailedData
+	******************************************************************************************************/
+	int32_t m_cfgIdWithError;
+
+	/**************************************************************************************************//**
+	* @brief		Failed line number.
+	* @details	Contains line number on which parsing config file failed.
+	* @see		ReadFailedData
+	******************************************************************************************************/
+	int32_t m_lineNumberWithError;
+
+	/**************************************************************************************************//**
+	* @brief		Config file path.
+	* @details	File path to configuration stored in file (image source).
+	* @see		Initialize
+	******************************************************************************************************/
+	std::string m_configPath;
+
+	/**************************************************************************************************//**
+	* @brief		Image path.
+	* @details	Base file path to binary image (images are versioned, see @ref MsvPassiveConfigCompiler::GetVersionedImagePath).
+	* @see		Initialize
+	******************************************************************************************************/
+	std::string m_imagePath;
+
+	/**************************************************************************************************//**
+	* @brief		Mapped image path.
+	* @details	Versioned file path of currently mapped image (it is removed when other version is mapped).
+	* @see		GetMappedImagePath
+	******************************************************************************************************/
+	std::string m_mappedImagePath;
+
+	/**************************************************************************************************//**
+	* @brief		Config key map.
+	* @details	Contains config keys with default values and its definitions (config file path IDs).
+	* @see		Initialize
+	******************************************************************************************************/
+	std::shared_ptr<IMsvConfigKeyMap<IMsvConfigKey>> m_spConfigKeyMap;
+
+	/**************************************************************************************************//**
+	* @brief		Mapped image.
+	* @details	Currently used (mapped) image.
+	******************************************************************************************************/
+	MsvMappedFile m_mappedFile;
+
+	/**************************************************************************************************//**
+	* @brief		Retired images.
+	* @details	Images replaced by reload (strings returned by @ref GetValue point to them, one image per config version).
+	* @see		RetireImage
+	******************************************************************************************************/
+	std::forward_list<MsvMappedFile> m_retiredFiles;
+
+	/**************************************************************************************************//**
+	* @brief		Image entries.
+	* @details	Pointer to entries in mapped image (sorted by config ID).
+	******************************************************************************************************/
+	const MsvPassiveConfigImageEntry* m_pEntries;
+
+	/**************************************************************************************************//**
+	* @brief		Image entry count.
+	* @details	Number of entries in mapped image.
+	******************************************************************************************************/
+	size_t m_entryCount;
+
+	/**************************************************************************************************//**
+	* @brief		String pool.
+	* @details	Pointer to string pool in mapped image.
+	******************************************************************************************************/
+	const char* m_pStringPool;
+
+	/**************************************************************************************************//**
+	* @brief		Registered callbacks.
+	* @details	Contains all registered callbacks which will be notified about data changes.
+	* @see		RegisterCallback
+	* @see		UnregisterCallback
+	******************************************************************************************************/
+	std::forward_list<std::shared_ptr<IMsvPassiveConfigCallback>> m_callbacks;
+
+	/**************************************************************************************************//**
+	* @brief		Change notifier.
+	* @details	Collects config IDs changed by reload and signals them by pollable handle.
+	* @see		GetNotificationHandle
+	* @see		DrainChanges
+	******************************************************************************************************/
+	MsvChangeNotifier m_notifier;
+
+	/**************************************************************************************************//**
+	* @brief		Snapshot cache.
+	* @details	Snapshot of current values (invalidated when reload changes values, rebuilt by next reader).
+	* @see		GetSnapshot
+	******************************************************************************************************/
+	mutable MsvConfigSnapshotCache m_snapshot;
+};
+
+
+#endif // !MARSTECH_PASSIVECONFIGMAPPED_H
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,409 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Passive Config Watcher Implementation
+* @details		Contains implementation of @ref MsvPassiveConfigWatcher.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include "MsvPassiveConfigWatcher.h"
+#include "mconfig/common/MsvChecksum.h"
+
+#include "merror/MsvErrorCodes.h"
+
+
+#ifdef __linux__
+
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+
+MSV_ENABLE_WARNINGS
+
+
+/********************************************************************************************************************************
+*															Constructors and destructors
+********************************************************************************************************************************/
+
+
+MsvPassiveConfigWatcher::MsvPassiveConfigWatcher(std::shared_ptr<MsvLogger> spLogger):
+	m_initialized(false),
+	m_inotifyFd(-1),
+	m_watchDescriptor(-1),
+	m_stopFd(-1),
+	m_signature(),
+	m_threadId(),
+	m_spLogger(spLogger)
+{
+
+}
+
+MsvPassiveConfigWatcher::~MsvPassiveConfigWatcher()
+{
+	Uninitialize();
+}
+
+
+/********************************************************************************************************************************
+*															MsvPassiveConfigWatcher public methods
+********************************************************************************************************************************/
+
+
+MsvErrorCode MsvPassiveConfigWatcher::Initialize(std::shared_ptr<IMsvPassiveConfig> spPassiveConfig, const char* configPath, std::shared_ptr<IMsvPassiveConfigWatcherCallback> spCallback)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	MSV_LOG_INFO(m_spLogger, "Initializing passive configuration watcher (configPath: \"{}\").", configPath);
+
+	if (Initialized())
+	{
+		MSV_LOG_INFO(m_spLogger, "Passive configuration watcher has been already initialized.");
+		return MSV_ALREADY_INITIALIZED_INFO;
+	}
+
+	if (!spPassiveConfig || !configPath || !*configPath)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Invalid passive configuration watcher data - error: {0:x}", MSV_INVALID_DATA_ERROR);
+		return MSV_INVALID_DATA_ERROR;
+	}
+
+	//watch directory (not the file) -> file might be replaced (renamed over) and watch on file would be lost
+	std::string directory(configPath);
+	std::string::size_type separator = directory.find_last_of('/');
+	directory = (separator == std::string::npos) ? "." : (separator == 0 ? "/" : directory.substr(0, separator));
+
+	int inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotifyFd < 0)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Initialize inotify failed with errno: {}", errno);
+		return MSV_OPEN_ERROR;
+	}
+
+	//close write -> file has been rewritten, moved to -> file (or symbolic link) has been replaced
+	//delete self, move self -> directory has been lost (handled by watcher thread)
+	int watchDescriptor = inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF);
+	if (watchDescriptor < 0)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Watch directory \"{}\" failed with errno: {}", directory, errno);
+		close(inotifyFd);
+		return MSV_OPEN_ERROR;
+	}
+
+	int stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (stopFd < 0)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Create stop event failed with errno: {}", errno);
+		close(inotifyFd);
+		return MSV_OPEN_ERROR;
+	}
+
+	m_configPath.assign(configPath);
+	m_directory = directory;
+	m_spPassiveConfig = spPassiveConfig;
+	m_spCallback = spCallback;
+	m_inotifyFd = inotifyFd;
+	m_watchDescriptor = watchDescriptor;
+	m_stopFd = stopFd;
+
+	//passive config has been loaded from current file -> it is the base for change detection
+	ReadFileSignature(m_signature, true);
+
+	try
+	{
+		m_thread = std::thread(&MsvPassiveConfigWatcher::WatchThread, this);
+	}
+	catch (...)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Create watcher thread failed with error: {0:x}", MSV_ALLOCATION_ERROR);
+		close(m_inotifyFd);
+		close(m_stopFd);
+		m_inotifyFd = -1;
+		m_watchDescriptor = -1;
+		m_stopFd = -1;
+		m_spPassiveConfig.reset();
+		m_spCallback.reset();
+		m_directory.clear();
+		return MSV_ALLOCATION_ERROR;
+	}
+
+	m_initialized = true;
+
+	MSV_LOG_INFO(m_spLogger, "Passive configuration watcher has been successfully initialized.");
+
+	return MSV_SUCCESS;
+}
+
+MsvErrorCode MsvPassiveConfigWatcher::Uninitialize()
+{
+	//checked before lock (other thread might hold lock while it waits for watcher thread)
+	if (m_threadId.load() == std::this_thread::get_id())
+	{
+		//called from watcher callback -> watcher thread can not join itself
+		MSV_LOG_ERROR(m_spLogger, "Passive configuration watcher can not be uninitialized from watcher thread - error: {0:x}", MSV_BUSY_ERROR);
+		return MSV_BUSY_ERROR;
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	MSV_LOG_INFO(m_spLogger, "Uninitializing passive configuration watcher.");
+
+	if (!Initialized())
+	{
+		MSV_LOG_INFO(m_spLogger, "Passive configuration watcher has not been initialized.");
+		return MSV_NOT_INITIALIZED_INFO;
+	}
+
+	//wake up watcher thread and wait for it
+	uint64_t stop = 1;
+	if (write(m_stopFd, &stop, sizeof(stop)) != sizeof(stop))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Signal stop event failed with errno: {}", errno);
+	}
+
+	if (m_thread.joinable())
+	{
+		m_thread.join();
+	}
+	m_threadId.store(std::thread::id());
+
+	close(m_inotifyFd);
+	close(m_stopFd);
+	m_inotifyFd = -1;
+	m_watchDescriptor = -1;
+	m_stopFd = -1;
+
+	m_spPassiveConfig.reset();
+	m_spCallback.reset();
+	m_configPath.clear();
+	m_directory.clear();
+	m_initialized = false;
+
+	MSV_LOG_INFO(m_spLogger, "Passive configuration watcher has been successfully uninitialized.");
+
+	return MSV_SUCCESS;
+}
+
+bool MsvPassiveConfigWatcher::Initialized() const
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	return m_initialized;
+}
+
+
+/********************************************************************************************************************************
+*															MsvPassiveConfigWatcher protected methods
+********************************************************************************************************************************/
+
+
+void MsvPassiveConfigWatcher::WatchThread()
+{
+	m_threadId.store(std::this_thread::get_id());
+
+	pollfd fds[2] = { { m_inotifyFd, POLLIN, 0 }, { m_stopFd, POLLIN, 0 } };
+	bool watchLost = false;
+	bool lostReported = false;
+
+	for (;;)
+	{
+		//lost watch is re-armed periodically (directory might be created again)
+		if (poll(fds, 2, watchLost ? MSV_PASSIVECONFIG_WATCH_RETRY_MS : -1) < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			MSV_LOG_ERROR(m_spLogger, "Wait for config file events failed with errno: {}", errno);
+			return;
+		}
+
+		if (fds[1].revents)
+		{
+			//stop requested
+			return;
+		}
+
+		bool fileEvent = false;
+		if (fds[0].revents & POLLIN)
+		{
+			//drain all pending events (more events are usually generated by one file update)
+			alignas(inotify_event) char buffer[4096];
+			ssize_t size;
+			while ((size = read(m_inotifyFd, buffer, sizeof(buffer))) > 0)
+			{
+				for (ssize_t offset = 0; offset < size; offset += static_cast<ssize_t>(sizeof(inotify_event) + reinterpret_cast<const inotify_event*>(buffer + offset)->len))
+				{
+					const inotify_event* pEvent = reinterpret_cast<const inotify_event*>(buffer + offset);
+					if (pEvent->wd == m_watchDescriptor && (pEvent->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)))
+					{
+						//directory has been removed or moved (events of old watch are not matched after re-arm)
+						watchLost = true;
+					}
+					else
+					{
+						fileEvent = true;
+					}
+				}
+			}
+		}
+
+		if (watchLost)
+		{
+			if (MSV_FAILED(RearmWatch()))
+			{
+				if (!lostReported)
+				{
+					//directory does not exist -> report it once and keep current configuration
+					lostReported = true;
+					MSV_LOG_ERROR(m_spLogger, "Passive configuration directory \"{}\" has been lost - error: {:x}", m_directory, MSV_OPEN_ERROR);
+					if (m_spCallback)
+					{
+						m_spCallback->OnConfigurationReloaded(MSV_OPEN_ERROR, std::vector<int32_t>());
+					}
+				}
+				continue;
+			}
+
+			//config file might have changed while directory was not watched
+			watchLost = false;
+			lostReported = false;
+			fileEvent = true;
+		}
+
+		if (fileEvent)
+		{
+			OnConfigFileEvent();
+		}
+	}
+}
+
+MsvErrorCode MsvPassiveConfigWatcher::RearmWatch()
+{
+	if (m_watchDescriptor >= 0)
+	{
+		//moved directory is still watched under new path -> remove old watch (removed directory has no watch anymore)
+		inotify_rm_watch(m_inotifyFd, m_watchDescriptor);
+		m_watchDescriptor = -1;
+	}
+
+	int watchDescriptor = inotify_add_watch(m_inotifyFd, m_directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF);
+	if (watchDescriptor < 0)
+	{
+		return MSV_OPEN_ERROR;
+	}
+
+	m_watchDescriptor = watchDescriptor;
+
+	MSV_LOG_INFO(m_spLogger, "Passive configuration directory \"{}\" is watched again.", m_directory);
+
+	return MSV_SUCCESS;
+}
+
+void MsvPassiveConfigWatcher::OnConfigFileEvent()
+{
+	MsvFileSignature signature;
+	ReadFileSignature(signature, false);
+
+	if (!signature.m_exists)
+	{
+		//file has been removed (or it is being replaced) -> keep current configuration
+		MSV_LOG_INFO(m_spLogger, "Passive configuration file \"{}\" does not exist - keeping current configuration.", m_configPath);
+		return;
+	}
+
+	if (m_signature.m_exists && signature.m_device == m_signature.m_device && signature.m_inode == m_signature.m_inode
+		&& signature.m_size == m_signature.m_size && signature.m_modifiedNs == m_signature.m_modifiedNs)
+	{
+		//event on another file in the same directory
+		return;
+	}
+
+	ReadFileSignature(signature, true);
+	if (m_signature.m_exists && signature.m_checksum == m_signature.m_checksum && signature.m_size == m_signature.m_size)
+	{
+		//file has been touched or rewritten with the same content -> do not reload
+		m_signature = signature;
+		return;
+	}
+
+	m_signature = signature;
+
+	MSV_LOG_INFO(m_spLogger, "Passive configuration file \"{}\" has changed - reloading.", m_configPath);
+
+	std::vector<int32_t> changedCfgIds;
+	MsvErrorCode errorCode = m_spPassiveConfig->ReloadConfiguration(changedCfgIds);
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Reload passive configuration failed with error: {0:x}", errorCode);
+	}
+	else
+	{
+		MSV_LOG_INFO(m_spLogger, "Passive configuration has been reloaded ({} changed values).", changedCfgIds.size());
+	}
+
+	if (m_spCallback && (MSV_FAILED(errorCode) || !changedCfgIds.empty()))
+	{
+		m_spCallback->OnConfigurationReloaded(errorCode, changedCfgIds);
+	}
+}
+
+void MsvPassiveConfigWatcher::ReadFileSignature(MsvFileSignature& signature, bool withChecksum) const
+{
+	signature = MsvFileSignature();
+
+	struct stat fileStat;
+	if (stat(m_configPath.c_str(), &fileStat) != 0)
+	{
+		return;
+	}
+
+	signature.m_exists = true;
+	signature.m_device = static_cast<uint64_t>(fileStat.st_dev);
+	signature.m_inode = static_cast<uint64_t>(fileStat.st_ino);
+	signature.m_size = static_cast<int64_t>(fileStat.st_size);
+	signature.m_modifiedNs = static_cast<int64_t>(fileStat.st_mtim.tv_sec) * 1000000000ll + fileStat.st_mtim.tv_nsec;
+
+	if (withChecksum)
+	{
+		uint64_t size;
+		MsvChecksum::ComputeFile(m_configPath.c_str(), signature.m_checksum, size);
+	}
+}
+
+
+#endif // __linux__
+
+/** @} */	//End of group MCONFIG.
@@ -0,0 +1,259 @@
+/**************************************************************************************************//**
+* @addtogroup	MCONFIG
+* @{
+******************************************************************************************************/
+
+/**************************************************************************************************//**
+* @file
+* @brief			MarsTech Passive Config Watcher Implementation
+* @details		Contains implementation @ref MsvPassiveConfigWatcher which reloads passive config when its file has changed.
+* @author		Martin Svoboda
+* @date			18.10.2026
+* @copyright	GNU General Public License (GPLv3).
+******************************************************************************************************/
+
+
+/*
+This file is part of MarsTech Config.
+
+MarsTech Config is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MarsTech Promise Like Syntax is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Foobar. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MARSTECH_PASSIVECONFIGWATCHER_H
+#define MARSTECH_PASSIVECONFIGWATCHER_H
+
+
+#include "IMsvPassiveConfig.h"
+#include "IMsvPassiveConfigWatcherCallback.h"
+
+#include "mlogging/mlogging.h"
+
+MSV_DISABLE_ALL_WARNINGS
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+MSV_ENABLE_WARNINGS
+
+
+#ifdef __linux__
+
+
+/**************************************************************************************************//**
+* @brief		Watch re-arm delay.
+* @details	Delay (in milliseconds) between attempts to watch config directory again when it has been removed
+*				or moved.
+******************************************************************************************************/
+#define MSV_PASSIVECONFIG_WATCH_RETRY_MS 1000
+
+
+/**************************************************************************************************//**
+* @brief		MarsTech Passive Config Watcher Implementation.
+* @details	Watches passive config file (inotify) and reloads passive config when the file has really
+*				changed (different content). Directory of the config file is watched (not the file itself),
+*				so atomic replacement of the file (write temporary file and rename it over the config file)
+*				and symbolic link swaps are handled correctly. When the directory itself is removed or moved,
+*				callback is notified with MSV_OPEN_ERROR and the directory path is watched again as soon as it exists.
+* @note		Available only on Linux.
+* @see		IMsvPassiveConfig
+* @see		IMsvPassiveConfigWatcherCallback
+******************************************************************************************************/
+class MsvPassiveConfigWatcher
+{
+protected:
+	/**************************************************************************************************//**
+	* @brief		Config file signature.
+	* @details	Identifies content of config file (used to detect real changes).
+	******************************************************************************************************/
+	struct MsvFileSignature
+	{
+		bool m_exists;					//!< Flag if file exists (true) or not (false).
+		uint64_t m_device;			//!< Device ID of the file.
+		uint64_t m_inode;				//!< Inode number of the file.
+		int64_t m_size;				//!< Size of the file.
+		int64_t m_modifiedNs;		//!< Last modification time (nanoseconds).
+		uint64_t m_checksum;			//!< Checksum of the file content.
+	};
+
+public:
+	/**************************************************************************************************//**
+	* @brief			Constructor.
+	* @param[in]	spLogger			Shared pointer to logger for logging.
+	******************************************************************************************************/
+	MsvPassiveConfigWatcher(std::shared_ptr<MsvLogger> spLogger = nullptr);
+
+	/**************************************************************************************************//**
+	* @brief		Virtual destructor.
+	* @warning	Watcher must not be destroyed from watcher callback (watcher thread can not be stopped).
+	******************************************************************************************************/
+	virtual ~MsvPassiveConfigWatcher();
+
+	/**************************************************************************************************//**
+	* @brief			Initialize watcher.
+	* @details		Starts watching config file. Passive config should be already initialized with the same
+	*					config file.
+	* @param[in]	spPassiveConfig	Passive config to reload when config file changes.
+	* @param[in]	configPath			Path to passive config file.
+	* @param[in]	spCallback			Callback notified about reloads (optional).
+	* @retval		MSV_ALREADY_INITIALIZED_INFO	When watcher has been already initialized (this is info, not error).
+	* @retval		MSV_INVALID_DATA_ERROR			When passive config is not valid.
+	* @retval		MSV_OPEN_ERROR						When inotify initialization failed.
+	* @retval		MSV_ALLOCATION_ERROR				When watcher thread creation failed.
+	* @retval		MSV_SUCCESS							On success.
+	* @warning		Callback is called from watcher thread.
+	******************************************************************************************************/
+	virtual MsvErrorCode Initialize(std::shared_ptr<IMsvPassiveConfig> spPassiveConfig, const char* configPath = "config.ini", std::shared_ptr<IMsvPassiveConfigWatcherCallback> spCallback = nullptr);
+
+	/**************************************************************************************************//**
+	* @brief			Uninitialize watcher.
+	* @details		Stops watching config file and waits for watcher thread.
+	* @retval		MSV_NOT_INITIALIZED_INFO		When watcher has not been initialized (this is info, not error).
+	* @retval		MSV_BUSY_ERROR						When it is called from watcher callback (watcher thread can not
+	*															wait for itself, watcher stays initialized).
+	* @retval		MSV_SUCCESS							On success.
+	* @warning		Do not call it from watcher callback (it waits for watcher thread).
+	******************************************************************************************************/
+	virtual MsvErrorCode Uninitialize();
+
+	/**************************************************************************************************//**
+	* @brief			Initialize check.
+	* @details		Returns flag if watcher is initialized (true) or not (false).
+	* @retval		true		When initialized.
+	* @retval		false		When not initialized.
+	******************************************************************************************************/
+	virtual bool Initialized() const;
+
+	/*-----------------------------------------------------------------------------------------------------
+	**											MsvPassiveConfigWatcher protected methods
+	**---------------------------------------------------------------------------------------------------*/
+protected:
+	/**************************************************************************************************//**
+	* @brief			Watcher thread.
+	* @details		Waits for inotify events (or stop request) and checks config file when an event arrives.
+	******************************************************************************************************/
+	void WatchThread();
+
+	/**************************************************************************************************//**
+	* @brief			Re-arm watch.
+	* @details		Removes watch of lost (removed or moved) config directory and watches directory path again.
+	* @retval		MSV_OPEN_ERROR		When directory could not be watched (it does not exist).
+	* @retval		MSV_SUCCESS			On success.
+	******************************************************************************************************/
+	MsvErrorCode RearmWatch();
+
+	/**************************************************************************************************//**
+	* @brief			Config file event.
+	* @details		Called by watcher thread when something has happened in config file directory. Reloads
+	*					passive config when the file content has really changed.
+	******************************************************************************************************/
+	void OnConfigFileEvent();
+
+	/**************************************************************************************************//**
+	* @brief			Read file signature.
+	* @details		Reads signature of config file.
+	* @param[out]	signature		Read signature.
+	* @param[in]	withChecksum	Flag if checksum of file content should be computed (true) or not (false).
+	******************************************************************************************************/
+	void ReadFileSignature(MsvFileSignature& signature, bool withChecksum) const;
+
+protected:
+	/**************************************************************************************************//**
+	* @brief		Watcher mutex.
+	* @details	Locks this object for thread safety access.
+	******************************************************************************************************/
+	mutable std::recursive_mutex m_lock;
+
+	/**************************************************************************************************//**
+	* @brief		Initialize flag.
+	* @details	Flag if watcher is initialized (true) or not (false).
+	******************************************************************************************************/
+	bool m_initialized;
+
+	/**************************************************************************************************//**
+	* @brief		Config file path.
+	* @details	Path to watched config file.
+	******************************************************************************************************/
+	std::string m_configPath;
+
+	/**************************************************************************************************//**
+	* @brief		Config directory.
+	* @details	Path to watched directory of config file.
+	******************************************************************************************************/
+	std::string m_directory;
+
+	/**************************************************************************************************//**
+	* @brief		Inotify file descriptor.
+	******************************************************************************************************/
+	int m_inotifyFd;
+
+	/**************************************************************************************************//**
+	* @brief		Watch descriptor.
+	* @details	Inotify watch descriptor of config directory (-1 when watch has been lost, used only by watcher
+	*				thread after initialization).
+	******************************************************************************************************/
+	int m_watchDescriptor;
+
+	/**************************************************************************************************//**
+	* @brief		Stop event file descriptor.
+	* @details	Event file descriptor used to wake up and stop watcher thread.
+	******************************************************************************************************/
+	int m_stopFd;
+
+	/**************************************************************************************************//**
+	* @brief		Config file signature.
+	* @details	Signature of last loaded config file (used only by watcher thread).
+	******************************************************************************************************/
+	MsvFileSignature m_signature;
+
+	/**************************************************************************************************//**
+	* @brief		Watcher thread.
+	******************************************************************************************************/
+	std::thread m_thread;
+
+	/**************************************************************************************************//**
+	* @brief		Watcher thread ID.
+	* @details	ID of running watcher thread (it is set by watcher thread, used to detect calls from watcher callback).
+	* @see		Uninitialize
+	******************************************************************************************************/
+	std::atomic<std::thread::id> m_threadId;
+
+	/**************************************************************************************************//**
+	* @brief		Passive config.
+	* @details	Passive config which is reloaded when config file changes.
+	******************************************************************************************************/
+	std::shared_ptr<IMsvPassiveConfig> m_spPassiveConfig;
+
+	/**************************************************************************************************//**
+	* @brief		Watcher callback.
+	* @details	Callback notified about reloads (might be null).
+	******************************************************************************************************/
+	std::shared_ptr<IMsvPassiveConfigWatcherCallback> m_spCallback;
+
+	/**************************************************************************************************//**
+	* @brief		Logger.
+	* @details	Shared pointer to logger for logging.
+	******************************************************************************************************/
+	std::shared_ptr<MsvLogger> m_spLogger;
+};
+
+
+#endif // __linux__
+
+
+#endif // !MARSTECH_PASSIVECONFIGWATCHER_H
+
+/** @} */	//End of group MCONFIG.
@@ -118,6 +118,19 @@ public:
 	******************************************************************************************************/
 	virtual MsvErrorCode Execute(const char* query, MsvSQLiteResult& result) = 0;
 
+	/**************************************************************************************************//**
+	* @brief			Execute SQL query with text parameter.
+	* @details		Execute SQL query with bound text parameter (?1) and converts its result to @ref MsvSQLiteResult.
+	*					Parameter is bound without copy and it does not have to be quoted or escaped.
+	* @param[in]	query			SQL query to execute (one statement).
+	* @param[in]	parameter	Text bound to parameter ?1.
+	* @param[out]	result		Result of executed SQL query.
+	* @retval		MSV_NOT_INITIALIZED_ERROR		When SQLite has not been initialized.
+	* @retval		MSV_EXECUTE_ERROR					When execute SQL query failed.
+	* @retval		MSV_SUCCESS							On success.
+	******************************************************************************************************/
+	virtual MsvErrorCode Execute(const char* query, const std::string& parameter, MsvSQLiteResult& result) = 0;
+
 	/**************************************************************************************************//**
 	* @brief			Register SQLite callback.
 	* @details		Registers SQLite callback which is called when data has been changed.
@@ -125,8 +125,6 @@ MsvErrorCode MsvSQLite::Uninitialize()
 
 bool MsvSQLite::Initialized() const
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
-
 	return m_initialized;
 }
 
@@ -191,6 +189,57 @@ MsvErrorCode MsvSQLite::Execute(const char* query, MsvSQLiteResult& result)
 	return MSV_SUCCESS;
 }
 
+MsvErrorCode MsvSQLite::Execute(const char* query, const std::string& parameter, MsvSQLiteResult& result)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+	if (!Initialized())
+	{
+		MSV_LOG_ERROR(m_spLogger, "Trying to execute query from uninitialized SQLite.");
+		return MSV_NOT_INITIALIZED_ERROR;
+	}
+
+	sqlite3_stmt* pStatement = nullptr;
+	if (sqlite3_prepare_v2(m_pConnection, query, -1, &pStatement, nullptr) != SQLITE_OK)
+	{
+		//do not log query, it might contain sensitive data
+		MSV_LOG_ERROR(m_spLogger, "Prepare query failed with error: {}", sqlite3_errmsg(m_pConnection));
+		return MSV_EXECUTE_ERROR;
+	}
+
+	//parameter is alive until statement is finalized -> SQLite does not have to copy it
+	int stepResult = sqlite3_bind_text(pStatement, 1, parameter.data(), static_cast<int>(parameter.size()), SQLITE_STATIC);
+	if (stepResult == SQLITE_OK)
+	{
+		while ((stepResult = sqlite3_step(pStatement)) == SQLITE_ROW)
+		{
+			//create row
+			MsvSQLiteRow row;
+			int columnCount = sqlite3_column_count(pStatement);
+			for (int i = 0; i < columnCount; i++)
+			{
+				const char* pColumn = reinterpret_cast<const char*>(sqlite3_column_text(pStatement, i));
+				row.push_back(pColumn ? pColumn : "");
+			}
+
+			//insert row to result
+			result.push_back(row);
+		}
+	}
+
+	if (stepResult != SQLITE_DONE)
+	{
+		MSV_LOG_ERROR(m_spLogger, "Execute query failed with error: {}", sqlite3_errmsg(m_pConnection));
+		sqlite3_finalize(pStatement);
+
+		return MSV_EXECUTE_ERROR;
+	}
+
+	sqlite3_finalize(pStatement);
+
+	return MSV_SUCCESS;
+}
+
 MsvErrorCode MsvSQLite::RegisterCallback(std::shared_ptr<IMsvSQLiteCallback> spCallback)
 {
 	std::lock_guard<std::recursive_mutex> lock(m_lock);
@@ -199,25 +248,23 @@ MsvErrorCode MsvSQLite::RegisterCallback(std::shared_ptr<IMsvSQLiteCallback> spC
 
 	MSV_LOG_INFO(m_spLogger, "Registering SQLite callback.");
 
-	if (m_callbacks.empty())
+	MsvErrorCode errorCode = m_callbacks.Register(spCallback);
+	if (errorCode == MSV_ALREADY_REGISTERED_INFO)
 	{
-		//it is the first callback -> register to SQLite
-		sqlite3_update_hook(m_pConnection, &OnChangeCallback, this);
+		MSV_LOG_INFO(m_spLogger, "SQLite callback has been already registered.");
+		return errorCode;
 	}
-
-	std::forward_list<std::shared_ptr<IMsvSQLiteCallback>>::iterator endIt = m_callbacks.end();
-	for (std::forward_list<std::shared_ptr<IMsvSQLiteCallback>>::iterator it = m_callbacks.begin(); it != endIt; ++it)
+	else if (MSV_FAILED(errorCode))
 	{
-		if (*it == spCallback)
-		{
-			//callback is already registered
-			MSV_LOG_INFO(m_spLogger, "SQLite callback has been already registered.");
-			return MSV_ALREADY_REGISTERED_INFO;
-		}
+		MSV_LOG_ERROR(m_spLogger, "Register SQLite callback failed with error: {0:x}", errorCode);
+		return errorCode;
 	}
 
-	//register callback
-	m_callbacks.push_front(spCallback);
+	if (m_callbacks.Load()->size() == 1)
+	{
+		//it is the first callback -> register to SQLite
+		sqlite3_update_hook(m_pConnection, &OnChangeCallback, this);
+	}
 
 	MSV_LOG_INFO(m_spLogger, "SQLite callback has been successfully registered.");
 
@@ -230,9 +277,14 @@ MsvErrorCode MsvSQLite::UnregisterCallback(std::shared_ptr<IMsvSQLiteCallback> s
 
 	MSV_LOG_INFO(m_spLogger, "Unregistering SQLite callback.");
 
-	m_callbacks.remove(spCallback);
+	MsvErrorCode errorCode = m_callbacks.Unregister(spCallback);
+	if (MSV_FAILED(errorCode))
+	{
+		MSV_LOG_ERROR(m_spLogger, "Unregister SQLite callback failed with error: {0:x}", errorCode);
+		return errorCode;
+	}
 
-	if (m_callbacks.empty())
+	if (m_callbacks.Load()->empty())
 	{
 		//it was the last callback -> unregister from SQLite
 		sqlite3_update_hook(m_pConnection, nullptr, nullptr);
@@ -251,12 +303,13 @@ MsvErrorCode MsvSQLite::UnregisterCallback(std::shared_ptr<IMsvSQLiteCallback> s
 
 void MsvSQLite::OnDataChanged(int operationType, const char *databaseName, const char *tableName, sqlite3_int64 rowId)
 {
-	std::lock_guard<std::recursive_mutex> lock(m_lock);
-
 	MSV_LOG_DEBUG(m_spLogger, "SQLite data has changed (operationType: {}, dbName: \"{}\", tableName: \"{}\", rowid: {}).", operationType, databaseName, tableName, rowId);
 
-	std::forward_list<std::shared_ptr<IMsvSQLiteCallback>>::iterator endIt = m_callbacks.end();
-	for (std::forward_list<std::shared_ptr<IMsvSQLiteCallback>>::iterator it = m_callbacks.begin(); it != endIt; ++it)
+	//no lock -> callbacks array is immutable (callback might unregister itself meanwhile)
+	std::shared_ptr<const std::vector<std::shared_ptr<IMsvSQLiteCallback>>> spCallbacks = m_callbacks.Load();
+
+	std::vector<std::shared_ptr<IMsvSQLiteCallback>>::const_iterator endIt = spCallbacks->end();
+	for (std::vector<std::shared_ptr<IMsvSQLiteCallback>>::const_iterator it = spCallbacks->begin(); it != endIt; ++it)
 	{
 		(*it)->OnChange(operationType, databaseName, tableName, rowId);
 	}
@@ -36,6 +36,7 @@ along with Foobar. If not, see <https://www.gnu.org/licenses/>.
 
 
 #include "IMsvSQLite.h"
+#include "mconfig/common/MsvCopyOnWrite.h"
 
 #include "mlogging/mlogging.h"
 
@@ -43,8 +44,8 @@ MSV_DISABLE_ALL_WARNINGS
 
 #include "3rdParty/sqlite/sqlite3.h"
 
+#include <atomic>
 #include <mutex>
-#include <forward_list>
 
 MSV_ENABLE_WARNINGS
 
@@ -98,6 +99,11 @@ public:
 	******************************************************************************************************/
 	virtual MsvErrorCode Execute(const char* query, MsvSQLiteResult& result) override;
 
+	/**************************************************************************************************//**
+	* @copydoc IMsvSQLite::Execute(const char* query, const std::string& parameter, MsvSQLiteResult& result)
+	******************************************************************************************************/
+	virtual MsvErrorCode Execute(const char* query, const std::string& parameter, MsvSQLiteResult& result) override;
+
 	/**************************************************************************************************//**
 	* @copydoc IMsvSQLite::RegisterCallback(std::shared_ptr<IMsvSQLiteCallback> spCallback)
 	******************************************************************************************************/
@@ -153,20 +159,21 @@ protected:
 
 	/**************************************************************************************************//**
 	* @brief		Registered callbacks.
-	* @details	Contains all registered callbacks which will be notified about data changes.
+	* @details	Contains all registered callbacks which will be notified about data changes (copy on write,
+	*				notification does not lock).
 	* @see		RegisterCallback
 	* @see		UnregisterCallback
 	******************************************************************************************************/
-	std::forward_list<std::shared_ptr<IMsvSQLiteCallback>> m_callbacks;
+	MsvCallbackList<IMsvSQLiteCallback> m_callbacks;
 
 	/**************************************************************************************************//**
 	* @brief		Initialize flag.
-	* @details	Flag if config is initialized (true) or not (false).
+	* @details	Flag if config is initialized (true) or not (false). It is atomic, check does not lock.
 	* @see		Initialize
 	* @see		Uninitialize
 	* @see		Initialized
 	******************************************************************************************************/
-	bool m_initialized;
+	std::atomic<bool> m_initialized;
 
 	/**************************************************************************************************//**
 	* @brief		SQLite connection.